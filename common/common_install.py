@@ -55,7 +55,19 @@ INSTALLED_SO_FILE = [{"makefile_path": os.path.join(CURRENT_PATH, "presenter/age
                        "so_file" : os.path.join(CURRENT_PATH, "presenter/agent/out/libpresenteragent.so")},
                       {"makefile_path": os.path.join(CURRENT_PATH, "utils/ascend_ezdvpp"),
                        "engine_setting": "-lascend_ezdvpp \\",
-                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_ezdvpp/out/libascend_ezdvpp.so")}]
+                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_ezdvpp/out/libascend_ezdvpp.so")},
+                      {"makefile_path": os.path.join(CURRENT_PATH, "utils/ascend_face_gallery"),
+                       "engine_setting": "-lascend_face_gallery \\",
+                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_face_gallery/out/libascend_face_gallery.so")},
+                      {"makefile_path": os.path.join(CURRENT_PATH, "utils/ascend_face_preprocess"),
+                       "engine_setting": "-lascend_face_preprocess \\",
+                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_face_preprocess/out/libascend_face_preprocess.so")},
+                      {"makefile_path": os.path.join(CURRENT_PATH, "utils/ascend_tensor_arena"),
+                       "engine_setting": "-lascend_tensor_arena \\",
+                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_tensor_arena/out/libascend_tensor_arena.so")},
+                      {"makefile_path": os.path.join(CURRENT_PATH, "utils/ascend_face_tracker"),
+                       "engine_setting": "-lascend_face_tracker \\",
+                       "so_file" : os.path.join(CURRENT_PATH, "utils/ascend_face_tracker/out/libascend_face_tracker.so")}]
 
 ENGINE_INCLUDE = ["-I$(HOME)/ascend_ddk/include \\"]
 DEVICE_ENGINE_LINK_DIR = ["-L$(HOME)/ascend_ddk/device/lib "]
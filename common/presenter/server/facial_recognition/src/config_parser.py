@@ -36,6 +36,7 @@ import os
 import logging
 import configparser
 import common.parameter_validation as validate
+from facial_recognition.src.face_gallery import FEATURE_ENCODINGS
 
 
 class ConfigParser():
@@ -71,6 +72,29 @@ class ConfigParser():
             logging.warning("Face match threshold should be 0-1.")
             return False
 
+        if not validate.validate_integer(ConfigParser.face_index_list_num,
+                                         0, 65536):
+            print("Face index list num should be 0-65536.")
+            logging.warning("Face index list num should be 0-65536.")
+            return False
+
+        if not validate.validate_integer(ConfigParser.face_index_probe_num,
+                                         1, 65536):
+            print("Face index probe num should be 1-65536.")
+            logging.warning("Face index probe num should be 1-65536.")
+            return False
+
+        if ConfigParser.face_feature_encoding not in FEATURE_ENCODINGS:
+            print("Face feature encoding should be float32, fp16 or int8.")
+            logging.warning(
+                "Face feature encoding should be float32, fp16 or int8.")
+            return False
+
+        if ConfigParser.device_face_match not in ("true", "false"):
+            print("Device face match should be true or false.")
+            logging.warning("Device face match should be true or false.")
+            return False
+
         if not os.path.isdir(ConfigParser.storage_dir):
             print("You should create directory \"%s\" manually."
                   %(ConfigParser.storage_dir))
@@ -99,6 +123,14 @@ class ConfigParser():
         cls.max_face_num = config_parser.get('baseconf', 'max_face_num')
         cls.face_match_threshold = \
             config_parser.get('baseconf', 'face_match_threshold')
+        cls.face_index_list_num = config_parser.get(
+            'baseconf', 'face_index_list_num', fallback="0")
+        cls.face_index_probe_num = config_parser.get(
+            'baseconf', 'face_index_probe_num', fallback="8")
+        cls.face_feature_encoding = config_parser.get(
+            'baseconf', 'face_feature_encoding', fallback="float32")
+        cls.device_face_match = config_parser.get(
+            'baseconf', 'device_face_match', fallback="false")
 
     @staticmethod
     def get_rootpath():
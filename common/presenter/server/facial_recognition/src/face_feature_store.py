@@ -0,0 +1,398 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+
+"""binary face feature store, see ascend_face_gallery/face_feature_store.h"""
+
+import os
+import struct
+import ctypes
+import logging
+import numpy as np
+from facial_recognition.src.face_gallery import FACE_GALLERY_LIB_ENV
+from facial_recognition.src.face_gallery import FACE_GALLERY_LIB_NAME
+
+# "FFST" and version of the store file
+STORE_FILE_MAGIC = 0x54534646
+STORE_FILE_VERSION = 1
+
+# header: magic, version, dim, record size, record number, zero padding
+HEADER_SIZE = 64
+HEADER_FORMAT = "<IIIIQ"
+RECORD_NUMBER_OFFSET = 16
+
+# max bytes of a face name and number of face box coordinates
+FACE_NAME_SIZE = 64
+FACE_COORDINATE_NUM = 4
+
+# record states
+RECORD_LIVE = 1
+RECORD_TOMBSTONE = 2
+
+# records are padded to a multiple of this
+RECORD_ALIGNMENT = 64
+
+# suffix of the file written by compact before it replaces the store
+COMPACT_SUFFIX = ".compact"
+
+def _load_library():
+    """
+    Description: load the C++ face feature store library
+    Input: NA
+    Returns: library or None if it is not installed
+    """
+    lib_path = os.environ.get(FACE_GALLERY_LIB_ENV, FACE_GALLERY_LIB_NAME)
+    try:
+        lib = ctypes.CDLL(lib_path)
+        lib.FaceFeatureStoreOpen.restype = ctypes.c_void_p
+        lib.FaceFeatureStoreOpen.argtypes = [ctypes.c_char_p, ctypes.c_uint32]
+    except (OSError, AttributeError):
+        logging.info("%s not found, store faces with numpy", lib_path)
+        return None
+
+    lib.FaceFeatureStoreClose.restype = None
+    lib.FaceFeatureStoreClose.argtypes = [ctypes.c_void_p]
+    lib.FaceFeatureStoreAppend.restype = ctypes.c_int
+    lib.FaceFeatureStoreAppend.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
+                                           ctypes.c_void_p, ctypes.c_void_p]
+    lib.FaceFeatureStoreRemove.restype = ctypes.c_int
+    lib.FaceFeatureStoreRemove.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.FaceFeatureStoreCompact.restype = ctypes.c_int
+    lib.FaceFeatureStoreCompact.argtypes = [ctypes.c_void_p]
+    lib.FaceFeatureStoreSize.restype = ctypes.c_uint64
+    lib.FaceFeatureStoreSize.argtypes = [ctypes.c_void_p]
+    lib.FaceFeatureStoreTombstoneNumber.restype = ctypes.c_uint64
+    lib.FaceFeatureStoreTombstoneNumber.argtypes = [ctypes.c_void_p]
+    lib.FaceFeatureStoreNames.restype = ctypes.c_uint64
+    lib.FaceFeatureStoreNames.argtypes = [ctypes.c_void_p, ctypes.c_void_p,
+                                          ctypes.c_uint64]
+    lib.FaceFeatureStoreRead.restype = ctypes.c_int
+    lib.FaceFeatureStoreRead.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
+                                         ctypes.c_void_p, ctypes.c_void_p]
+    return lib
+
+def _record_dtype(dim):
+    """
+    Description: numpy layout of a store record
+    Input:
+        dim: length of face feature vector
+    Returns: record dtype
+    """
+    feature_offset = 8 + FACE_NAME_SIZE + 4 * FACE_COORDINATE_NUM
+    record_size = feature_offset + 4 * dim
+    record_size = -(-record_size // RECORD_ALIGNMENT) * RECORD_ALIGNMENT
+    return np.dtype({
+        "names": ["state", "name_length", "name", "coordinate", "feature"],
+        "formats": ["<u4", "<u4", "S%d" % FACE_NAME_SIZE,
+                    ("<i4", FACE_COORDINATE_NUM), ("<f4", dim)],
+        "offsets": [0, 4, 8, 8 + FACE_NAME_SIZE, feature_offset],
+        "itemsize": record_size})
+
+class FaceFeatureStore():
+    '''
+    Registered faces in an append-only binary file. Registering a face
+    appends one record and tombstones the previous record of the same name,
+    deleting a face only writes its tombstone, so neither rewrites the file.
+    The C++ FaceFeatureStore is used when its library can be loaded,
+    otherwise the same layout is read through a numpy memmap, so opening a
+    large store does not parse it.
+    Calls are not thread safe, the caller holds its face lock.
+    '''
+    _shared_lib = None
+    _shared_lib_loaded = False
+
+    def __init__(self, path, dim):
+        """
+        Description: class init func
+        Input:
+            path: store file
+            dim: length of face feature vector
+        Returns: NA
+        """
+        self.path = path
+        self.dim = dim
+        self._dtype = _record_dtype(dim)
+        self._file = None
+        self._record_num = 0
+        # record slot of each live face
+        self._slots = {}
+
+        if not FaceFeatureStore._shared_lib_loaded:
+            FaceFeatureStore._shared_lib = _load_library()
+            FaceFeatureStore._shared_lib_loaded = True
+        self._lib = FaceFeatureStore._shared_lib
+        self._handle = None
+
+    def __len__(self):
+        if self._lib is not None:
+            return self._lib.FaceFeatureStoreSize(self._handle)
+        return len(self._slots)
+
+    def __contains__(self, name):
+        if self._lib is not None:
+            return self._lib.FaceFeatureStoreRead(
+                self._handle, name.encode("utf-8"), None, None) == 0
+        return name in self._slots
+
+    def names(self):
+        """
+        Description: names of the live faces
+        Input: NA
+        Returns: name list
+        """
+        if self._lib is None:
+            return list(self._slots)
+        max_num = len(self)
+        buffer = ctypes.create_string_buffer(max_num * FACE_NAME_SIZE)
+        num = self._lib.FaceFeatureStoreNames(self._handle, buffer, max_num)
+        # names are zero padded as in the records
+        return [buffer.raw[i * FACE_NAME_SIZE:(i + 1) * FACE_NAME_SIZE]
+                .rstrip(b"\0").decode("utf-8") for i in range(num)]
+
+    def tombstone_number(self):
+        """
+        Description: number of tombstoned records
+        Input: NA
+        Returns: tombstone number
+        """
+        if self._lib is not None:
+            return self._lib.FaceFeatureStoreTombstoneNumber(self._handle)
+        return self._record_num - len(self._slots)
+
+    def open(self):
+        """
+        Description: open the store file, it is created if it does not exist
+        Input: NA
+        Returns: True or False if open failed or the file is not a store
+                 of dim features
+        """
+        self.close()
+        if self._lib is not None:
+            self._handle = self._lib.FaceFeatureStoreOpen(
+                self.path.encode("utf-8"), self.dim)
+            if self._handle is None:
+                logging.error("%s is not a face store of %d features",
+                              self.path, self.dim)
+                return False
+            return True
+
+        try:
+            if not os.path.isfile(self.path) or \
+               os.path.getsize(self.path) == 0:
+                with open(self.path, "wb") as f:
+                    f.write(struct.pack(HEADER_FORMAT, STORE_FILE_MAGIC,
+                                        STORE_FILE_VERSION, self.dim,
+                                        self._dtype.itemsize, 0)
+                            .ljust(HEADER_SIZE, b"\0"))
+            self._file = open(self.path, "r+b")
+            header = self._file.read(HEADER_SIZE)
+            (magic, version, dim, record_size, record_num) = struct.unpack(
+                HEADER_FORMAT, header[:struct.calcsize(HEADER_FORMAT)])
+        except (OSError, struct.error) as exp:
+            logging.error("open face store %s failed: %s", self.path, exp)
+            self.close()
+            return False
+
+        file_records = (os.path.getsize(self.path) - HEADER_SIZE) // \
+            self._dtype.itemsize
+        if magic != STORE_FILE_MAGIC or version != STORE_FILE_VERSION or \
+           dim != self.dim or record_size != self._dtype.itemsize or \
+           record_num > file_records:
+            logging.error("%s is not a face store of %d features",
+                          self.path, self.dim)
+            self.close()
+            return False
+
+        self._record_num = record_num
+        records = self._records()
+        if records is not None:
+            # names are zero padded, numpy strips the padding. a later live
+            # record of a name wins, see append
+            live = np.nonzero(records["state"] == RECORD_LIVE)[0]
+            names = records["name"][live]
+            self._slots = dict(zip((i.decode("utf-8") for i in names),
+                                   live.tolist()))
+        return True
+
+    def close(self):
+        """
+        Description: close the store file
+        Input: NA
+        Returns: NA
+        """
+        if self._handle is not None:
+            self._lib.FaceFeatureStoreClose(self._handle)
+            self._handle = None
+        if self._file is not None:
+            self._file.close()
+            self._file = None
+        self._record_num = 0
+        self._slots = {}
+
+    def _records(self):
+        if self._record_num == 0:
+            return None
+        return np.memmap(self.path, dtype=self._dtype, mode="r",
+                         offset=HEADER_SIZE, shape=(self._record_num,))
+
+    def _write(self, offset, data):
+        self._file.seek(offset)
+        self._file.write(data)
+
+    def _set_state(self, slot, state):
+        self._write(HEADER_SIZE + slot * self._dtype.itemsize,
+                    struct.pack("<I", state))
+
+    def items(self):
+        """
+        Description: iterate the live faces
+        Input: NA
+        Returns: iterator of (name, coordinate, feature array)
+        """
+        if self._lib is not None:
+            for name in self.names():
+                coordinate = np.zeros(FACE_COORDINATE_NUM, dtype=np.int32)
+                feature = np.zeros(self.dim, dtype=np.float32)
+                self._lib.FaceFeatureStoreRead(
+                    self._handle, name.encode("utf-8"),
+                    coordinate.ctypes.data, feature.ctypes.data)
+                yield (name, coordinate.tolist(), feature)
+            return
+
+        records = self._records()
+        for name in list(self._slots):
+            record = records[self._slots[name]]
+            yield (name, record["coordinate"].tolist(), record["feature"])
+
+    def append(self, name, coordinate, feature):
+        """
+        Description: append a face, the face of the same name is replaced
+        Input:
+            name: face name
+            coordinate: face box coordinates
+            feature: face feature vector
+        Returns: True or False if the input is invalid
+        Raises: OSError if write failed
+        """
+        name_bytes = name.encode("utf-8")
+        if (self._file is None and self._handle is None) or \
+           not name_bytes or len(name_bytes) > FACE_NAME_SIZE or \
+           b"\0" in name_bytes:
+            return False
+        try:
+            coordinate = np.ascontiguousarray(coordinate, dtype=np.int32)
+            feature = np.ascontiguousarray(feature, dtype=np.float32)
+        except (TypeError, ValueError):
+            return False
+        if coordinate.shape != (FACE_COORDINATE_NUM,) or \
+           feature.shape != (self.dim,):
+            return False
+        if self._handle is not None:
+            if self._lib.FaceFeatureStoreAppend(
+                    self._handle, name_bytes, coordinate.ctypes.data,
+                    feature.ctypes.data) != 0:
+                raise OSError("append face {} to store {} failed".format(
+                    name, self.path))
+            return True
+
+        record = np.zeros(1, dtype=self._dtype)
+        record["coordinate"] = coordinate
+        record["feature"] = feature
+        record["state"] = RECORD_LIVE
+        record["name_length"] = len(name_bytes)
+        record["name"] = name_bytes
+
+        # publish the record before the old one is tombstoned, an
+        # interrupted replace then leaves two live records and open keeps
+        # the later one
+        slot = self._record_num
+        self._write(HEADER_SIZE + slot * self._dtype.itemsize,
+                    record.tobytes())
+        self._file.flush()
+        self._write(RECORD_NUMBER_OFFSET, struct.pack("<Q", slot + 1))
+        self._record_num = slot + 1
+        if name in self._slots:
+            self._set_state(self._slots[name], RECORD_TOMBSTONE)
+        self._slots[name] = slot
+        self._file.flush()
+        return True
+
+    def remove(self, name):
+        """
+        Description: tombstone a face
+        Input:
+            name: face name
+        Returns: True or False if there is no such face
+        Raises: OSError if write failed
+        """
+        if self._lib is not None:
+            return self._lib.FaceFeatureStoreRemove(
+                self._handle, name.encode("utf-8")) == 0
+        if name not in self._slots:
+            return False
+        self._set_state(self._slots[name], RECORD_TOMBSTONE)
+        self._file.flush()
+        del self._slots[name]
+        return True
+
+    def compact(self):
+        """
+        Description: rewrite the store without tombstones
+        Input: NA
+        Returns: True or False if write failed, the store is unchanged
+        """
+        if self._handle is not None:
+            if self._lib.FaceFeatureStoreCompact(self._handle) != 0:
+                logging.error("compact face store %s failed", self.path)
+                return False
+            return True
+        if self._file is None:
+            return False
+        compact_path = self.path + COMPACT_SUFFIX
+        records = self._records()
+        slots = sorted(self._slots.values())
+        try:
+            with open(compact_path, "wb") as f:
+                f.write(struct.pack(HEADER_FORMAT, STORE_FILE_MAGIC,
+                                    STORE_FILE_VERSION, self.dim,
+                                    self._dtype.itemsize, len(slots))
+                        .ljust(HEADER_SIZE, b"\0"))
+                if slots:
+                    f.write(records[slots].tobytes())
+                f.flush()
+                os.fsync(f.fileno())
+            os.replace(compact_path, self.path)
+        except OSError as exp:
+            logging.error("compact face store %s failed: %s", self.path, exp)
+            if os.path.isfile(compact_path):
+                os.remove(compact_path)
+            return False
+        return self.open()
@@ -0,0 +1,446 @@
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+
+"""face gallery for cosine similarity search of registered faces"""
+
+import os
+import json
+import ctypes
+import logging
+import numpy as np
+
+# library built from common/utils/ascend_face_gallery in Host mode,
+# the environment variable overrides the library path
+FACE_GALLERY_LIB_ENV = "ASCEND_FACE_GALLERY_LIB"
+FACE_GALLERY_LIB_NAME = "libascend_face_gallery.so"
+
+# scan threads of one search of the C++ gallery
+FACE_GALLERY_THREAD_NUM = 4
+
+# C interfaces of the exact gallery and of the IVF index
+EXACT_API = "FaceGallery"
+IVF_API = "FaceIvfIndex"
+
+# feature encodings, the values match FeatureEncoding of
+# facial_recognition_message.proto and ascend_face_gallery/feature_codec.h
+FEATURE_FLOAT32 = 0
+FEATURE_FP16 = 1
+FEATURE_INT8 = 2
+FEATURE_ENCODINGS = {"float32": FEATURE_FLOAT32, "fp16": FEATURE_FP16,
+                     "int8": FEATURE_INT8}
+
+# largest int8 code, the largest element of a feature maps to it
+INT8_MAX_CODE = 127.0
+
+def encode_int8(feature):
+    """
+    Description: encode a feature as int8 codes and one scale
+    Input:
+        feature: float32 array
+    Returns: (codes, scale), a code times scale is the element
+    """
+    max_abs = float(np.max(np.abs(feature))) if feature.size else 0.0
+    if not max_abs > 0 or not np.isfinite(max_abs):
+        return (np.zeros(feature.shape, dtype=np.int8), 0.0)
+    codes = np.rint(feature * (INT8_MAX_CODE / max_abs)).astype(np.int8)
+    return (codes, max_abs / INT8_MAX_CODE)
+
+def _load_library():
+    """
+    Description: load the C++ face gallery library
+    Input: NA
+    Returns: library or None if it is not installed
+    """
+    lib_path = os.environ.get(FACE_GALLERY_LIB_ENV, FACE_GALLERY_LIB_NAME)
+    try:
+        lib = ctypes.CDLL(lib_path)
+    except OSError:
+        logging.info("%s not found, match faces with numpy", lib_path)
+        return None
+
+    lib.FaceGalleryCreate.restype = ctypes.c_void_p
+    lib.FaceGalleryCreate.argtypes = [ctypes.c_uint32, ctypes.c_uint32,
+                                      ctypes.c_uint32]
+    lib.FaceIvfIndexCreate.restype = ctypes.c_void_p
+    lib.FaceIvfIndexCreate.argtypes = [ctypes.c_uint32, ctypes.c_uint32,
+                                       ctypes.c_uint32]
+    lib.FaceIvfIndexSave.restype = ctypes.c_int
+    lib.FaceIvfIndexSave.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.FaceIvfIndexLoad.restype = ctypes.c_int
+    lib.FaceIvfIndexLoad.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.FaceIvfIndexNeedsTraining.restype = ctypes.c_int
+    lib.FaceIvfIndexNeedsTraining.argtypes = [ctypes.c_void_p]
+    lib.FaceIvfTrainerCreate.restype = ctypes.c_void_p
+    lib.FaceIvfTrainerCreate.argtypes = [ctypes.c_void_p]
+    lib.FaceIvfTrainerDestroy.restype = None
+    lib.FaceIvfTrainerDestroy.argtypes = [ctypes.c_void_p]
+    lib.FaceIvfTrainerRun.restype = ctypes.c_int
+    lib.FaceIvfTrainerRun.argtypes = [ctypes.c_void_p]
+    lib.FaceIvfTrainerApply.restype = ctypes.c_int
+    lib.FaceIvfTrainerApply.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+    for api in (EXACT_API, IVF_API):
+        func = getattr(lib, api + "Destroy")
+        func.restype = None
+        func.argtypes = [ctypes.c_void_p]
+        func = getattr(lib, api + "Add")
+        func.restype = ctypes.c_int
+        func.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.c_void_p]
+        func = getattr(lib, api + "Remove")
+        func.restype = ctypes.c_int
+        func.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+        func = getattr(lib, api + "Clear")
+        func.restype = None
+        func.argtypes = [ctypes.c_void_p]
+        func = getattr(lib, api + "Size")
+        func.restype = ctypes.c_uint32
+        func.argtypes = [ctypes.c_void_p]
+        func = getattr(lib, api + "Search")
+        func.restype = ctypes.c_uint32
+        func.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint32,
+                         ctypes.c_float, ctypes.c_void_p, ctypes.c_void_p]
+    return lib
+
+class FaceGallery():
+    '''
+    Registered face features searched by cosine similarity.
+    Features are normalized once when they are added, so a search is a
+    single matrix product. The C++ gallery is used when its library can be
+    loaded, otherwise the same search is done with numpy.
+    With list_num > 0 the C++ IVF index is used instead of the exact
+    gallery, a search then only scans the faces of probe_num clusters.
+    The index does not train itself when faces are added, the caller
+    trains it with train once needs_training is True.
+    The exact gallery may keep features as fp16 or int8 to save memory,
+    the IVF index keeps float32 features.
+    Calls are not thread safe, the caller holds its face lock.
+    '''
+    _shared_lib = None
+    _shared_lib_loaded = False
+
+    def __init__(self, dim, list_num=0, probe_num=1,
+                 encoding=FEATURE_FLOAT32):
+        """
+        Description: class init func
+        Input:
+            dim: length of face feature vector
+            list_num: clusters of the IVF index, 0 for an exact search
+            probe_num: clusters scanned by one search of the IVF index
+            encoding: FEATURE_FLOAT32, FEATURE_FP16 or FEATURE_INT8
+        Returns: NA
+        """
+        self.dim = dim
+        self.encoding = encoding
+        # face name of each id and id of each face name
+        self._names = {}
+        self._ids = {}
+        self._next_id = 0
+
+        if not FaceGallery._shared_lib_loaded:
+            FaceGallery._shared_lib = _load_library()
+            FaceGallery._shared_lib_loaded = True
+        self._lib = FaceGallery._shared_lib
+        self._handle = None
+        self._api = IVF_API if list_num > 0 else EXACT_API
+        if self._lib is not None:
+            if self._api == IVF_API:
+                self._handle = self._lib.FaceIvfIndexCreate(dim, list_num,
+                                                            probe_num)
+            else:
+                self._handle = self._lib.FaceGalleryCreate(
+                    dim, FACE_GALLERY_THREAD_NUM, encoding)
+        elif list_num > 0:
+            logging.warning("face index needs %s, search all faces",
+                            FACE_GALLERY_LIB_NAME)
+        if self._handle is not None and self._api == IVF_API and \
+           encoding != FEATURE_FLOAT32:
+            logging.info("face index keeps float32 features")
+            self.encoding = FEATURE_FLOAT32
+
+        # numpy fallback: one normalized feature per row, int8 rows have a
+        # scale each
+        self._matrix = self._empty_matrix()
+        self._scales = np.zeros(0, dtype=np.float32)
+        self._row_names = []
+
+    def __del__(self):
+        if self._handle is not None:
+            self._call("Destroy", self._handle)
+            self._handle = None
+
+    def __len__(self):
+        return len(self._ids)
+
+    def _call(self, func_name, *args):
+        return getattr(self._lib, self._api + func_name)(*args)
+
+    def _empty_matrix(self):
+        dtypes = {FEATURE_FP16: np.float16, FEATURE_INT8: np.int8}
+        return np.zeros((0, self.dim),
+                        dtype=dtypes.get(self.encoding, np.float32))
+
+    def _encode_row(self, row):
+        """
+        Description: encode a normalized feature for the numpy matrix
+        Input:
+            row: normalized float32 feature
+        Returns: (encoded row, scale)
+        """
+        if self.encoding == FEATURE_FP16:
+            return (row.astype(np.float16), 1.0)
+        if self.encoding == FEATURE_INT8:
+            return encode_int8(row)
+        return (row, 1.0)
+
+    def _scores(self, query):
+        """
+        Description: cosine similarity of a normalized query with every row
+        Input:
+            query: normalized float32 feature
+        Returns: float32 array of scores
+        """
+        if self.encoding == FEATURE_FP16:
+            return self._matrix.dot(query.astype(np.float32))
+        if self.encoding == FEATURE_INT8:
+            (codes, scale) = encode_int8(query)
+            dots = self._matrix.astype(np.int32).dot(codes.astype(np.int32))
+            return (dots * np.float32(scale) * self._scales).astype(np.float32)
+        return self._matrix.dot(query)
+    def _to_feature(self, vector):
+        """
+        Description: convert a feature to a float32 array
+        Input:
+            vector: face feature vector
+        Returns: array or None if the feature is invalid
+        """
+        try:
+            feature = np.ascontiguousarray(vector, dtype=np.float32)
+        except (TypeError, ValueError):
+            return None
+        if feature.shape != (self.dim,) or not np.all(np.isfinite(feature)):
+            return None
+        return feature
+
+    def add(self, name, vector):
+        """
+        Description: add a face, the face of the same name is replaced
+        Input:
+            name: face name
+            vector: face feature vector
+        Returns: True or False if the feature is invalid
+        """
+        feature = self._to_feature(vector)
+        if feature is None:
+            return False
+        if self._handle is not None:
+            return self._add_to_lib(name, feature)
+
+        norm = np.linalg.norm(feature)
+        if norm == 0:
+            return False
+        (row, scale) = self._encode_row(feature / norm)
+        if name in self._ids:
+            self._matrix[self._ids[name]] = row
+            self._scales[self._ids[name]] = scale
+        else:
+            self._ids[name] = len(self._row_names)
+            self._row_names.append(name)
+            self._matrix = np.vstack((self._matrix, row))
+            self._scales = np.append(self._scales, np.float32(scale))
+        return True
+
+    def _add_to_lib(self, name, feature):
+        face_id = self._ids.get(name, self._next_id)
+        ret = self._call("Add", self._handle, face_id, feature.ctypes.data)
+        if ret != 0:
+            return False
+        if name not in self._ids:
+            self._ids[name] = face_id
+            self._names[face_id] = name
+            self._next_id += 1
+        return True
+
+    def remove(self, name):
+        """
+        Description: remove a face
+        Input:
+            name: face name
+        Returns: True or False if there is no such face
+        """
+        if name not in self._ids:
+            return False
+        face_id = self._ids.pop(name)
+        if self._handle is not None:
+            del self._names[face_id]
+            self._call("Remove", self._handle, face_id)
+            return True
+
+        # move the last row into the hole, as the C++ gallery does
+        last = len(self._row_names) - 1
+        if face_id != last:
+            self._matrix[face_id] = self._matrix[last]
+            self._scales[face_id] = self._scales[last]
+            self._row_names[face_id] = self._row_names[last]
+            self._ids[self._row_names[face_id]] = face_id
+        self._row_names.pop()
+        self._matrix = self._matrix[:last]
+        self._scales = self._scales[:last]
+        return True
+
+    def clear(self):
+        """
+        Description: remove all faces
+        Input: NA
+        Returns: NA
+        """
+        self._ids.clear()
+        self._names.clear()
+        if self._handle is not None:
+            self._call("Clear", self._handle)
+        self._matrix = self._empty_matrix()
+        self._scales = np.zeros(0, dtype=np.float32)
+        self._row_names = []
+
+    def search(self, vector, top_k, threshold):
+        """
+        Description: search the faces most similar to a feature
+        Input:
+            vector: face feature vector
+            top_k: max number of results
+            threshold: faces scoring below it are not returned
+        Returns: list of (name, score), the highest score first
+        """
+        feature = self._to_feature(vector)
+        if feature is None or top_k <= 0 or not self._ids:
+            return []
+        if self._handle is not None:
+            ids = (ctypes.c_uint32 * top_k)()
+            scores = (ctypes.c_float * top_k)()
+            num = self._call("Search", self._handle, feature.ctypes.data,
+                             top_k, threshold, ctypes.addressof(ids),
+                             ctypes.addressof(scores))
+            return [(self._names[ids[i]], float(scores[i]))
+                    for i in range(num)]
+
+        norm = np.linalg.norm(feature)
+        if norm == 0:
+            return []
+        scores = self._scores(feature / norm)
+        if top_k < len(scores):
+            rows = np.argpartition(-scores, top_k - 1)[:top_k]
+        else:
+            rows = np.arange(len(scores))
+        rows = rows[np.argsort(-scores[rows])]
+        return [(self._row_names[i], float(scores[i]))
+                for i in rows if scores[i] >= threshold]
+
+    def needs_training(self):
+        """
+        Description: whether the IVF index has enough new faces to be trained
+        Input: NA
+        Returns: True or False
+        """
+        if self._handle is None or self._api != IVF_API:
+            return False
+        return self._lib.FaceIvfIndexNeedsTraining(self._handle) == 1
+
+    def train(self, lock):
+        """
+        Description: train the IVF index, the clustering runs without the
+                     lock so that faces can be added and searched meanwhile
+        Input:
+            lock: the face lock of the caller, not held when called
+        Returns: True or False if there is no IVF index or training failed
+        """
+        with lock:
+            if not self.needs_training():
+                return False
+            trainer = self._lib.FaceIvfTrainerCreate(self._handle)
+        if trainer is None:
+            return False
+        try:
+            if self._lib.FaceIvfTrainerRun(trainer) != 0:
+                return False
+            with lock:
+                return self._lib.FaceIvfTrainerApply(trainer,
+                                                     self._handle) == 0
+        finally:
+            self._lib.FaceIvfTrainerDestroy(trainer)
+
+    def save(self, path):
+        """
+        Description: write the IVF index and the ids of face names to disk
+        Input:
+            path: index file, the ids are written to path + ".json"
+        Returns: True or False if there is no IVF index or write failed
+        """
+        if self._handle is None or self._api != IVF_API:
+            return False
+        try:
+            with open(path + ".json", "w") as f:
+                json.dump({"next_id": self._next_id, "ids": self._ids}, f)
+        except OSError as exp:
+            logging.error(exp)
+            return False
+        return self._lib.FaceIvfIndexSave(self._handle,
+                                          path.encode("utf-8")) == 0
+
+    def load(self, path, names):
+        """
+        Description: replace the faces by an IVF index written by save
+        Input:
+            path: index file
+            names: face names the index has to hold
+        Returns: True or False if there is no IVF index, read failed or
+                 the index does not hold exactly the names
+        """
+        if self._handle is None or self._api != IVF_API:
+            return False
+        try:
+            with open(path + ".json", "r") as f:
+                data = json.load(f)
+            next_id = int(data["next_id"])
+            ids = {name: int(data["ids"][name]) for name in data["ids"]}
+        except (OSError, ValueError, KeyError, TypeError) as exp:
+            logging.info("face index %s not loaded: %s", path, exp)
+            return False
+        if set(ids) != set(names):
+            return False
+        if self._lib.FaceIvfIndexLoad(self._handle,
+                                      path.encode("utf-8")) != 0:
+            return False
+        if self._lib.FaceIvfIndexSize(self._handle) != len(ids):
+            self._lib.FaceIvfIndexClear(self._handle)
+            return False
+        self._next_id = next_id
+        self._ids = ids
+        self._names = {ids[name]: name for name in ids}
+        return True
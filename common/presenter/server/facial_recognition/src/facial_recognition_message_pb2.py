@@ -53,7 +53,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   name='facial_recognition_message.proto',
   package='ascend.presenter.facial_recognition',
   syntax='proto3',
-  serialized_pb=_b('\n facial_recognition_message.proto\x12#ascend.presenter.facial_recognition\"^\n\x0e\x43ommonResponse\x12;\n\x03ret\x18\x01 \x01(\x0e\x32..ascend.presenter.facial_recognition.ErrorCode\x12\x0f\n\x07message\x18\x02 \x01(\t\"\'\n\x0bRegisterApp\x12\n\n\x02id\x18\x01 \x01(\t\x12\x0c\n\x04type\x18\x02 \x01(\t\"=\n\x03\x42ox\x12\x0c\n\x04lt_x\x18\x01 \x01(\r\x12\x0c\n\x04lt_y\x18\x02 \x01(\r\x12\x0c\n\x04rb_x\x18\x03 \x01(\r\x12\x0c\n\x04rb_y\x18\x04 \x01(\r\"T\n\x0b\x46\x61\x63\x65\x46\x65\x61ture\x12\x35\n\x03\x62ox\x18\x01 \x01(\x0b\x32(.ascend.presenter.facial_recognition.Box\x12\x0e\n\x06vector\x18\x02 \x03(\x02\"%\n\x08\x46\x61\x63\x65Info\x12\n\n\x02id\x18\x01 \x01(\t\x12\r\n\x05image\x18\x02 \x01(\x0c\"\xa2\x01\n\nFaceResult\x12\n\n\x02id\x18\x01 \x01(\t\x12\x45\n\x08response\x18\x02 \x01(\x0b\x32\x33.ascend.presenter.facial_recognition.CommonResponse\x12\x41\n\x07\x66\x65\x61ture\x18\x03 \x03(\x0b\x32\x30.ascend.presenter.facial_recognition.FaceFeature\"]\n\tFrameInfo\x12\r\n\x05image\x18\x01 \x01(\x0c\x12\x41\n\x07\x66\x65\x61ture\x18\x02 \x03(\x0b\x32\x30.ascend.presenter.facial_recognition.FaceFeature*\x7f\n\tErrorCode\x12\x0e\n\nkErrorNone\x10\x00\x12\x1a\n\x16kErrorAppRegisterExist\x10\x01\x12\x19\n\x15kErrorAppRegisterType\x10\x02\x12\x1a\n\x16kErrorAppRegisterLimit\x10\x03\x12\x0f\n\x0bkErrorOther\x10\x05\x62\x06proto3')
+  serialized_pb=_b('\n facial_recognition_message.proto\x12#ascend.presenter.facial_recognition\"^\n\x0e\x43ommonResponse\x12;\n\x03ret\x18\x01 \x01(\x0e\x32..ascend.presenter.facial_recognition.ErrorCode\x12\x0f\n\x07message\x18\x02 \x01(\t\"\'\n\x0bRegisterApp\x12\n\n\x02id\x18\x01 \x01(\t\x12\x0c\n\x04type\x18\x02 \x01(\t\"=\n\x03\x42ox\x12\x0c\n\x04lt_x\x18\x01 \x01(\r\x12\x0c\n\x04lt_y\x18\x02 \x01(\r\x12\x0c\n\x04rb_x\x18\x03 \x01(\r\x12\x0c\n\x04rb_y\x18\x04 \x01(\r\"\xdf\x01\n\x0b\x46\x61\x63\x65\x46\x65\x61ture\x12\x35\n\x03\x62ox\x18\x01 \x01(\x0b\x32(.ascend.presenter.facial_recognition.Box\x12\x0e\n\x06vector\x18\x02 \x03(\x02\x12\x46\n\x08\x65ncoding\x18\x03 \x01(\x0e\x32\x34.ascend.presenter.facial_recognition.FeatureEncoding\x12\r\n\x05scale\x18\x04 \x01(\x02\x12\x15\n\rpacked_vector\x18\x05 \x01(\x0c\x12\x0c\n\x04name\x18\x06 \x01(\t\x12\r\n\x05score\x18\x07 \x01(\x02\"%\n\x08\x46\x61\x63\x65Info\x12\n\n\x02id\x18\x01 \x01(\t\x12\r\n\x05image\x18\x02 \x01(\x0c\"\xa2\x01\n\nFaceResult\x12\n\n\x02id\x18\x01 \x01(\t\x12\x45\n\x08response\x18\x02 \x01(\x0b\x32\x33.ascend.presenter.facial_recognition.CommonResponse\x12\x41\n\x07\x66\x65\x61ture\x18\x03 \x03(\x0b\x32\x30.ascend.presenter.facial_recognition.FaceFeature\"]\n\tFrameInfo\x12\r\n\x05image\x18\x01 \x01(\x0c\x12\x41\n\x07\x66\x65\x61ture\x18\x02 \x03(\x0b\x32\x30.ascend.presenter.facial_recognition.FaceFeature\"o\n\x0bGallerySync\x12\r\n\x05reset\x18\x01 \x01(\x08\x12>\n\x04\x66\x61\x63\x65\x18\x02 \x03(\x0b\x32\x30.ascend.presenter.facial_recognition.FaceFeature\x12\x11\n\tthreshold\x18\x03 \x01(\x02*\x7f\n\tErrorCode\x12\x0e\n\nkErrorNone\x10\x00\x12\x1a\n\x16kErrorAppRegisterExist\x10\x01\x12\x19\n\x15kErrorAppRegisterType\x10\x02\x12\x1a\n\x16kErrorAppRegisterLimit\x10\x03\x12\x0f\n\x0bkErrorOther\x10\x05*J\n\x0f\x46\x65\x61tureEncoding\x12\x13\n\x0fkFeatureFloat32\x10\x00\x12\x10\n\x0ckFeatureFp16\x10\x01\x12\x10\n\x0ckFeatureInt8\x10\x02\x62\x06proto3')
 )
 
 _ERRORCODE = _descriptor.EnumDescriptor(
@@ -85,17 +85,47 @@ _ERRORCODE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=658,
-  serialized_end=785,
+  serialized_start=911,
+  serialized_end=1038,
 )
 _sym_db.RegisterEnumDescriptor(_ERRORCODE)
 
 ErrorCode = enum_type_wrapper.EnumTypeWrapper(_ERRORCODE)
+_FEATUREENCODING = _descriptor.EnumDescriptor(
+  name='FeatureEncoding',
+  full_name='ascend.presenter.facial_recognition.FeatureEncoding',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='kFeatureFloat32', index=0, number=0,
+      options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='kFeatureFp16', index=1, number=1,
+      options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='kFeatureInt8', index=2, number=2,
+      options=None,
+      type=None),
+  ],
+  containing_type=None,
+  options=None,
+  serialized_start=1040,
+  serialized_end=1114,
+)
+_sym_db.RegisterEnumDescriptor(_FEATUREENCODING)
+
+FeatureEncoding = enum_type_wrapper.EnumTypeWrapper(_FEATUREENCODING)
 kErrorNone = 0
 kErrorAppRegisterExist = 1
 kErrorAppRegisterType = 2
 kErrorAppRegisterLimit = 3
 kErrorOther = 5
+kFeatureFloat32 = 0
+kFeatureFp16 = 1
+kFeatureInt8 = 2
 
 
 
@@ -248,6 +278,41 @@ _FACEFEATURE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='encoding', full_name='ascend.presenter.facial_recognition.FaceFeature.encoding', index=2,
+      number=3, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='scale', full_name='ascend.presenter.facial_recognition.FaceFeature.scale', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='packed_vector', full_name='ascend.presenter.facial_recognition.FaceFeature.packed_vector', index=4,
+      number=5, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ascend.presenter.facial_recognition.FaceFeature.name', index=5,
+      number=6, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='score', full_name='ascend.presenter.facial_recognition.FaceFeature.score', index=6,
+      number=7, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -260,8 +325,8 @@ _FACEFEATURE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=273,
-  serialized_end=357,
+  serialized_start=274,
+  serialized_end=497,
 )
 
 
@@ -298,8 +363,8 @@ _FACEINFO = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=359,
-  serialized_end=396,
+  serialized_start=499,
+  serialized_end=536,
 )
 
 
@@ -343,8 +408,8 @@ _FACERESULT = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=399,
-  serialized_end=561,
+  serialized_start=539,
+  serialized_end=701,
 )
 
 
@@ -381,15 +446,62 @@ _FRAMEINFO = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=563,
-  serialized_end=656,
+  serialized_start=703,
+  serialized_end=796,
+)
+
+
+_GALLERYSYNC = _descriptor.Descriptor(
+  name='GallerySync',
+  full_name='ascend.presenter.facial_recognition.GallerySync',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='reset', full_name='ascend.presenter.facial_recognition.GallerySync.reset', index=0,
+      number=1, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='face', full_name='ascend.presenter.facial_recognition.GallerySync.face', index=1,
+      number=2, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='threshold', full_name='ascend.presenter.facial_recognition.GallerySync.threshold', index=2,
+      number=3, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=798,
+  serialized_end=909,
 )
 
 _COMMONRESPONSE.fields_by_name['ret'].enum_type = _ERRORCODE
 _FACEFEATURE.fields_by_name['box'].message_type = _BOX
+_FACEFEATURE.fields_by_name['encoding'].enum_type = _FEATUREENCODING
 _FACERESULT.fields_by_name['response'].message_type = _COMMONRESPONSE
 _FACERESULT.fields_by_name['feature'].message_type = _FACEFEATURE
 _FRAMEINFO.fields_by_name['feature'].message_type = _FACEFEATURE
+_GALLERYSYNC.fields_by_name['face'].message_type = _FACEFEATURE
 DESCRIPTOR.message_types_by_name['CommonResponse'] = _COMMONRESPONSE
 DESCRIPTOR.message_types_by_name['RegisterApp'] = _REGISTERAPP
 DESCRIPTOR.message_types_by_name['Box'] = _BOX
@@ -397,7 +509,9 @@ DESCRIPTOR.message_types_by_name['FaceFeature'] = _FACEFEATURE
 DESCRIPTOR.message_types_by_name['FaceInfo'] = _FACEINFO
 DESCRIPTOR.message_types_by_name['FaceResult'] = _FACERESULT
 DESCRIPTOR.message_types_by_name['FrameInfo'] = _FRAMEINFO
+DESCRIPTOR.message_types_by_name['GallerySync'] = _GALLERYSYNC
 DESCRIPTOR.enum_types_by_name['ErrorCode'] = _ERRORCODE
+DESCRIPTOR.enum_types_by_name['FeatureEncoding'] = _FEATUREENCODING
 _sym_db.RegisterFileDescriptor(DESCRIPTOR)
 
 CommonResponse = _reflection.GeneratedProtocolMessageType('CommonResponse', (_message.Message,), dict(
@@ -449,5 +563,12 @@ FrameInfo = _reflection.GeneratedProtocolMessageType('FrameInfo', (_message.Mess
   ))
 _sym_db.RegisterMessage(FrameInfo)
 
+GallerySync = _reflection.GeneratedProtocolMessageType('GallerySync', (_message.Message,), dict(
+  DESCRIPTOR = _GALLERYSYNC,
+  __module__ = 'facial_recognition_message_pb2'
+  # @@protoc_insertion_point(class_scope:ascend.presenter.facial_recognition.GallerySync)
+  ))
+_sym_db.RegisterMessage(GallerySync)
+
 
 # @@protoc_insertion_point(module_scope)
@@ -37,8 +37,8 @@ import threading
 import random
 import logging
 from logging.config import fileConfig
-import numpy as np
 from json.decoder import JSONDecodeError
+import numpy as np
 from google.protobuf.message import DecodeError
 import common.presenter_message_pb2 as presenter_message_pb2
 from common.channel_manager import ChannelManager
@@ -46,6 +46,10 @@ from common.presenter_socket_server import PresenterSocketServer
 from common.app_manager import AppManager
 import facial_recognition.src.facial_recognition_message_pb2 as pb2
 from facial_recognition.src.config_parser import ConfigParser
+from facial_recognition.src.face_gallery import FaceGallery
+from facial_recognition.src.face_gallery import FEATURE_ENCODINGS
+from facial_recognition.src.face_gallery import encode_int8
+from facial_recognition.src.face_feature_store import FaceFeatureStore
 from facial_recognition.src.facial_recognition_handler import FacialRecognitionHandler
 
 
@@ -64,6 +68,10 @@ MAX_APP_NUM = 2
 # length of face feature vector
 FEATURE_VECTOR_LENGTH = 1024
 
+# the face store is compacted once it has more tombstones than this and
+# than live faces
+FACE_STORE_COMPACT_TOMBSTONES = 1000
+
 # Face Registration Status code
 FACE_REGISTER_STATUS_WAITING = 1
 FACE_REGISTER_STATUS_SUCCEED = 2
@@ -84,35 +92,133 @@ class FacialRecognitionServer(PresenterSocketServer):
         self.storage_dir = config.storage_dir
         self.max_face_num = int(config.max_face_num)
         self.face_match_threshold = float(config.face_match_threshold)
+        self.face_index_list_num = int(config.face_index_list_num)
+        self.face_index_probe_num = int(config.face_index_probe_num)
+        self.face_feature_encoding = \
+            FEATURE_ENCODINGS[config.face_feature_encoding]
+        self.device_face_match = config.device_face_match == "true"
         self.register_dict = {}
         self.app_manager = AppManager()
         self.channel_manager = ChannelManager()
+        # gallery syncs are sent from web threads and the epoll thread,
+        # so each connection serializes its sends with a lock
+        self.send_locks = {}
+        self.send_locks_lock = threading.Lock()
+        # json file of older versions, imported into the face store
         self.face_register_file = os.path.join(self.storage_dir,
                                                "registered_faces.json")
+        self.face_store_file = os.path.join(self.storage_dir,
+                                            "registered_faces.bin")
+        self.face_index_file = os.path.join(self.storage_dir,
+                                            "face_index.bin")
         self._init_face_database()
 
     def _init_face_database(self):
         """
         Description: Init face recognition database,
-                     read information from face_register_file
+                     read information from face_store_file
+        Input: NA
+        Returns: NA
+        """
+        self.face_lock = threading.Lock()
+        # whether a thread is training the face index
+        self.face_index_training = False
+        self.face_store = FaceFeatureStore(self.face_store_file,
+                                           FEATURE_VECTOR_LENGTH)
+        if not self.face_store.open():
+            logging.error("face store %s unavailable, faces can not be "
+                          "registered", self.face_store_file)
+        self._import_face_register_file()
+        self._filter_registration_data()
+        self._init_face_gallery()
+
+    def _import_face_register_file(self):
+        """
+        Description: import faces of the json file of older versions into
+                     face store, the file is then renamed to *.bak
         Input: NA
         Returns: NA
         """
         if not os.path.isfile(self.face_register_file):
-            with open(self.face_register_file, "w", encoding="utf-8") as f:
-                f.write("{}")
-
-        with open(self.face_register_file, "r") as f:
-            self.face_lock = threading.Lock()
-            self.registered_faces = json.load(f)
-            self._filter_registration_data()
+            return
+        try:
+            with open(self.face_register_file, "r") as f:
+                registered_faces = json.load(f)
+            for i in registered_faces:
+                if not self.face_store.append(
+                        i, registered_faces[i].get("coordinate"),
+                        registered_faces[i].get("feature")):
+                    logging.warning("face %s is invalid, skip it", i)
+            os.replace(self.face_register_file,
+                       self.face_register_file + ".bak")
+        except (OSError, JSONDecodeError, AttributeError) as exp:
+            logging.error("import %s failed: %s",
+                          self.face_register_file, exp)
 
     def _filter_registration_data(self):
-        face_dict = self.registered_faces.copy()
-        for i in face_dict:
+        for i in self.face_store.names():
             image_path = os.path.join(self.storage_dir, i + ".jpg")
             if not os.path.isfile(image_path):
-                del self.registered_faces[i]
+                self.face_store.remove(i)
+
+    def _compact_face_store(self):
+        tombstone_num = self.face_store.tombstone_number()
+        if tombstone_num > FACE_STORE_COMPACT_TOMBSTONES and \
+           tombstone_num > len(self.face_store):
+            self.face_store.compact()
+
+    def _init_face_gallery(self):
+        """
+        Description: add the features of registered faces to face gallery
+        Input: NA
+        Returns: NA
+        """
+        self.face_gallery = FaceGallery(FEATURE_VECTOR_LENGTH,
+                                        self.face_index_list_num,
+                                        self.face_index_probe_num,
+                                        self.face_feature_encoding)
+        # the index file is written when the server stops and removed once
+        # it is loaded, so a stale one is never used after a crash
+        if self.face_gallery.load(self.face_index_file,
+                                  self.face_store.names()):
+            logging.info("load face index of %d faces", len(self.face_gallery))
+            self._remove_face_index_file()
+            return
+
+        for (name, _, feature) in self.face_store.items():
+            if not self.face_gallery.add(name, feature):
+                logging.warning("face %s has invalid feature, skip it", name)
+        if self.face_gallery.train(self.face_lock):
+            logging.info("train face index of %d faces",
+                         len(self.face_gallery))
+
+    def _train_face_index_async(self):
+        """
+        Description: train the face index in a thread when it has enough
+                     new faces, registration and recognition go on meanwhile
+        Input: NA
+        Returns: NA
+        """
+        with self.face_lock:
+            if self.face_index_training or \
+               not self.face_gallery.needs_training():
+                return
+            self.face_index_training = True
+        threading.Thread(target=self._train_face_index, daemon=True).start()
+
+    def _train_face_index(self):
+        if self.face_gallery.train(self.face_lock):
+            logging.info("train face index of %d faces",
+                         len(self.face_gallery))
+        with self.face_lock:
+            self.face_index_training = False
+
+    def _remove_face_index_file(self):
+        for i in (self.face_index_file, self.face_index_file + ".json"):
+            try:
+                os.remove(i)
+            except OSError:
+                pass
 
     def get_all_face(self):
         """
@@ -121,7 +227,7 @@ class FacialRecognitionServer(PresenterSocketServer):
         Returns: NA
         """
         with self.face_lock:
-            return [i for i in self.registered_faces]
+            return self.face_store.names()
 
     def save_face_image(self, name, image):
         """
@@ -165,22 +271,28 @@ class FacialRecognitionServer(PresenterSocketServer):
             name_list: a name list
         Returns: True or False
         """
+        removed = []
+        ret = True
         with self.face_lock:
             for i in name_list:
-                if self.registered_faces.get(i):
-                    backup = self.registered_faces[i]
-                    del self.registered_faces[i]
+                if i in self.face_store:
                     try:
-                        with open(self.face_register_file, "w") as f:
-                            json.dump(self.registered_faces, f)
+                        self.face_store.remove(i)
+                        self.face_gallery.remove(i)
+                        removed.append((i, None))
                         image_file = os.path.join(
                             self.storage_dir, i + ".jpg")
                         os.remove(image_file)
-                    except (OSError, JSONDecodeError) as exp:
+                    except OSError as exp:
                         logging.error(exp)
-                        self.registered_faces[i] = backup
-                        return False
-        return True
+                        ret = False
+                        break
+            if ret:
+                self._compact_face_store()
+        if removed:
+            self._broadcast_gallery_sync(
+                self._build_gallery_sync(removed, False))
+        return ret
 
     def _clean_connect(self, sock_fileno, epoll, conns, msgs):
         """
@@ -193,12 +305,39 @@ class FacialRecognitionServer(PresenterSocketServer):
         """
         logging.info("clean fd:%s, conns:%s", sock_fileno, conns)
         self.app_manager.unregister_app_by_fd(sock_fileno)
+        with self.send_locks_lock:
+            self.send_locks.pop(sock_fileno, None)
         epoll.unregister(sock_fileno)
         conns[sock_fileno].close()
         del conns[sock_fileno]
         del msgs[sock_fileno]
 
 
+    def _get_send_lock(self, conn):
+        """
+        Description: get the send lock of a connection
+        Input:
+            conn: a socket connection
+        Returns: a reentrant lock
+        """
+        with self.send_locks_lock:
+            return self.send_locks.setdefault(conn.fileno(),
+                                              threading.RLock())
+
+    def send_message(self, conn, protobuf, msg_name):
+        """
+        Description: send a message, messages sent to the same connection
+                     from different threads are never interleaved
+        Input:
+            conn: a socket connection
+            protobuf: message body defined in protobuf
+            msg_name: msg name
+        Returns: NA
+        """
+        with self._get_send_lock(conn):
+            PresenterSocketServer.send_message(self, conn, protobuf,
+                                               msg_name)
+
     def _process_msg(self, conn, msg_name, msg_data):
         """
         Total entrance to process protobuf msg
@@ -310,6 +449,16 @@ class FacialRecognitionServer(PresenterSocketServer):
             response.ret = pb2.kErrorNone
             response.message = "Register app {} succeed".format(app_id)
             self.send_message(conn, response, msg_name)
+            if self.device_face_match:
+                # the snapshot is taken under the send lock, so gallery
+                # updates broadcast meanwhile arrive after the reset
+                with self._get_send_lock(conn):
+                    with self.face_lock:
+                        faces = [(name, feature) for (name, _, feature)
+                                 in self.face_store.items()]
+                    sync = self._build_gallery_sync(faces, True)
+                    self.send_message(conn, sync,
+                                      pb2._GALLERYSYNC.full_name)
             return True
 
         return False
@@ -351,18 +500,95 @@ class FacialRecognitionServer(PresenterSocketServer):
         else:
             box = face_result.feature[0].box
             face_coordinate = [box.lt_x, box.lt_y, box.rb_x, box.rb_x]
-            feature_vector = [i for i in face_result.feature[0].vector]
+            feature_vector = self._decode_feature_vector(
+                face_result.feature[0])
             if len(feature_vector) != FEATURE_VECTOR_LENGTH:
                 logging.error("feature_vector length not equal 1024")
                 status = FACE_REGISTER_STATUS_FAILED
                 message = "Face feature vector length invalid"
                 self._update_register_dict(face_id, status, message)
                 return True
-            return self._save_face_feature(face_id, face_coordinate,
-                                           feature_vector)
+            if not self._save_face_feature(face_id, face_coordinate,
+                                           feature_vector):
+                return False
+            self._train_face_index_async()
+            self._broadcast_gallery_sync(self._build_gallery_sync(
+                [(face_id, feature_vector)], False))
 
         return True
 
+    def _build_gallery_sync(self, faces, reset):
+        """
+        Description: build a GallerySync message which updates the copy of
+                     the face gallery kept by apps matching on device
+        Input:
+            faces: list of (name, feature array), feature None to remove
+            reset: True to replace the whole gallery of the app
+        Returns: GallerySync message
+        """
+        sync = pb2.GallerySync()
+        sync.reset = reset
+        sync.threshold = self.face_match_threshold
+        for (name, feature) in faces:
+            face = sync.face.add()
+            face.name = name
+            if feature is None:
+                continue
+            feature = np.asarray(feature, dtype=np.float32)
+            face.encoding = self.face_feature_encoding
+            if self.face_feature_encoding == pb2.kFeatureFp16:
+                face.packed_vector = feature.astype("<f2").tobytes()
+            elif self.face_feature_encoding == pb2.kFeatureInt8:
+                (codes, scale) = encode_int8(feature)
+                face.packed_vector = codes.tobytes()
+                face.scale = scale
+            else:
+                face.vector.extend(feature.tolist())
+        return sync
+
+    def _broadcast_gallery_sync(self, sync):
+        """
+        Description: send a GallerySync message to all registered apps
+                     when faces are matched on device
+        Input:
+            sync: GallerySync message
+        Returns: NA
+        """
+        if not self.device_face_match:
+            return
+        msg_name = pb2._GALLERYSYNC.full_name
+        for app_id in self.app_manager.list_app():
+            conn = self.app_manager.get_socket_by_app_id(app_id)
+            if conn is None:
+                continue
+            try:
+                self.send_message(conn, sync, msg_name)
+            except OSError as exp:
+                logging.error("send gallery to app %s failed: %s",
+                              app_id, exp)
+
+    @staticmethod
+    def _decode_feature_vector(face_feature):
+        """
+        Description: decode the feature vector of a FaceFeature message,
+                     fp16 and int8 vectors are packed in bytes
+        Input:
+            face_feature: FaceFeature message
+        Returns: float32 array, empty if the packed vector is invalid
+        """
+        try:
+            if face_feature.encoding == pb2.kFeatureFp16:
+                return np.frombuffer(face_feature.packed_vector,
+                                     dtype="<f2").astype(np.float32)
+            if face_feature.encoding == pb2.kFeatureInt8:
+                codes = np.frombuffer(face_feature.packed_vector,
+                                      dtype=np.int8)
+                return codes * np.float32(face_feature.scale)
+        except ValueError as exp:
+            logging.error("invalid packed feature vector: %s", exp)
+            return np.zeros(0, dtype=np.float32)
+        return np.array(face_feature.vector, dtype=np.float32)
+
     def _update_register_dict(self, face_id, status, message):
         """
         Description: update register_dict
@@ -387,25 +613,25 @@ class FacialRecognitionServer(PresenterSocketServer):
         Returns: True or False
         """
         with self.face_lock:
-            self.registered_faces[face_id] = {
-                "coordinate": face_coordinate,
-                "feature": feature_vector
-            }
             try:
-                with open(self.face_register_file, "w") as f:
-                    json.dump(self.registered_faces, f)
-                status = FACE_REGISTER_STATUS_SUCCEED
-                message = "Successful registration"
-                self._update_register_dict(face_id, status, message)
-                return True
-            except (OSError, JSONDecodeError) as exp:
+                saved = self.face_store.append(face_id, face_coordinate,
+                                               feature_vector)
+            except OSError as exp:
                 logging.error(exp)
-                del self.registered_faces[face_id]
+                saved = False
+            if not saved:
                 status = FACE_REGISTER_STATUS_FAILED
-                message = "save face feature to json file failed"
+                message = "save face feature to face store failed"
                 self._update_register_dict(face_id, status, message)
                 return False
 
+            self.face_gallery.add(face_id, feature_vector)
+            self._compact_face_store()
+            status = FACE_REGISTER_STATUS_SUCCEED
+            message = "Successful registration"
+            self._update_register_dict(face_id, status, message)
+            return True
+
     def _process_open_channel(self, conn, msg_data):
         """
         Description: process open channel message
@@ -497,12 +723,15 @@ class FacialRecognitionServer(PresenterSocketServer):
             face_info = {}
             box = i.box
             coordinate = [box.lt_x, box.lt_y, box.rb_x, box.rb_y]
-            feature_vector = i.vector
-            if len(feature_vector) != FEATURE_VECTOR_LENGTH:
-                logging.error("feature_vector length not equal 1024")
-                continue
-
-            (name, score) = self._compute_face_feature(feature_vector)
+            if i.name and not i.vector and not i.packed_vector:
+                # matched on device, only the identity is sent
+                (name, score) = (i.name, i.score)
+            else:
+                feature_vector = self._decode_feature_vector(i)
+                if len(feature_vector) != FEATURE_VECTOR_LENGTH:
+                    logging.error("feature_vector length not equal 1024")
+                    continue
+                (name, score) = self._compute_face_feature(feature_vector)
             face_info["coordinate"] = coordinate
             face_info["name"] = name
             face_info["confidence"] = score
@@ -517,33 +746,12 @@ class FacialRecognitionServer(PresenterSocketServer):
             feture_vector: face feature vector
         Returns: face name and score
         """
-        highest_score_face = "Unknown"
-        highest_score = 0
         with self.face_lock:
-            for i in self.registered_faces:
-                feature = self.registered_faces[i]["feature"]
-                score = self._compute_similar_degree(feature, feture_vector)
-                if score < self.face_match_threshold:
-                    continue
-
-                if score > highest_score:
-                    highest_score = score
-                    highest_score_face = i
-        return (highest_score_face, highest_score)
-
-    def _compute_similar_degree(self, feture_vector1, feture_vector2):
-        """
-        Description: compute cosine similarity of two vectors
-        Input:
-            feture_vector1: face feature vector
-            feture_vector2: face feature vector
-        Returns: score
-        """
-        vector1 = np.array(feture_vector1)
-        vector2 = np.array(feture_vector2)
-        square_diff = ((np.linalg.norm(vector1)) * (np.linalg.norm(vector2)))
-        score = np.dot(vector1, vector2) / square_diff
-        return score
+            result = self.face_gallery.search(feture_vector, 1,
+                                              self.face_match_threshold)
+        if not result:
+            return ("Unknown", 0)
+        return result[0]
 
 
     def stop_thread(self):
@@ -555,6 +763,10 @@ class FacialRecognitionServer(PresenterSocketServer):
         channel_manager = ChannelManager([])
         channel_manager.close_all_thread()
         self.set_exit_switch()
+        with self.face_lock:
+            if self.face_gallery.save(self.face_index_file):
+                logging.info("save face index of %d faces",
+                             len(self.face_gallery))
         self.app_manager.set_thread_switch()
 
 
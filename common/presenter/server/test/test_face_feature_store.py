@@ -0,0 +1,209 @@
+"""utest face feature store module"""
+
+# -*- coding: UTF-8 -*-
+#
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+import os
+import sys
+import struct
+import tempfile
+import unittest
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server/")
+sys.path.append(path)
+
+import facial_recognition.src.face_feature_store as face_feature_store
+from facial_recognition.src.face_feature_store import FaceFeatureStore
+
+DIM = 16
+
+class TestFaceFeatureStore(unittest.TestCase):
+
+    def setUp(self):
+        self.tmp_dir = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.tmp_dir.name, "faces.bin")
+        # tests use the numpy store unless they switch to the library
+        self.lib = face_feature_store._load_library()
+        self.use_lib(False)
+
+    def tearDown(self):
+        FaceFeatureStore._shared_lib = None
+        FaceFeatureStore._shared_lib_loaded = False
+        self.tmp_dir.cleanup()
+
+    def use_lib(self, enabled):
+        if enabled and self.lib is None:
+            self.skipTest("libascend_face_gallery.so not found")
+        FaceFeatureStore._shared_lib = self.lib if enabled else None
+        FaceFeatureStore._shared_lib_loaded = True
+
+    def test_append_and_reopen(self):
+        self.check_append_and_reopen()
+
+    def test_lib_store(self):
+        self.use_lib(True)
+        self.check_append_and_reopen()
+        os.remove(self.path)
+        self.check_invalid_input()
+
+    def check_append_and_reopen(self):
+        store = FaceFeatureStore(self.path, DIM)
+        self.assertEqual(store.open(), True)
+        for i in range(10):
+            ret = store.append("face%d" % i, [i, 0, 0, 0], [i] * DIM)
+            self.assertEqual(ret, True)
+        store.append("face3", [30, 0, 0, 0], [30] * DIM)
+        store.remove("face5")
+        self.assertEqual(store.remove("face5"), False)
+        self.assertEqual(len(store), 9)
+        self.assertEqual(store.tombstone_number(), 2)
+        store.close()
+
+        store = FaceFeatureStore(self.path, DIM)
+        self.assertEqual(store.open(), True)
+        self.assertEqual(len(store), 9)
+        self.assertEqual(store.tombstone_number(), 2)
+        self.assertEqual("face5" in store, False)
+        faces = {name: (coordinate, list(feature))
+                 for (name, coordinate, feature) in store.items()}
+        self.assertEqual(faces["face3"], ([30, 0, 0, 0], [30] * DIM))
+        self.assertEqual(faces["face9"], ([9, 0, 0, 0], [9] * DIM))
+
+        self.assertEqual(store.compact(), True)
+        self.assertEqual(len(store), 9)
+        self.assertEqual(store.tombstone_number(), 0)
+        if FaceFeatureStore._shared_lib is None:
+            self.assertEqual(os.path.getsize(self.path),
+                             64 + 9 * store._dtype.itemsize)
+        faces = {name: list(feature)
+                 for (name, _, feature) in store.items()}
+        self.assertEqual(faces["face3"], [30] * DIM)
+        store.close()
+
+    def test_invalid_input(self):
+        self.check_invalid_input()
+
+    def check_invalid_input(self):
+        store = FaceFeatureStore(self.path, DIM)
+        self.assertEqual(store.append("face", [1, 2, 3, 4], [1] * DIM), False)
+        store.open()
+        self.assertEqual(store.append("", [1, 2, 3, 4], [1] * DIM), False)
+        self.assertEqual(store.append("x" * 65, [1, 2, 3, 4], [1] * DIM),
+                         False)
+        self.assertEqual(store.append("face", None, [1] * DIM), False)
+        self.assertEqual(store.append("face", [1, 2, 3, 4], [1] * 3), False)
+        self.assertEqual(store.append("face", [1, 2, 3, 4], None), False)
+        self.assertEqual(store.append("fa\0ce", [1, 2, 3, 4], [1] * DIM),
+                         False)
+        self.assertEqual(len(store), 0)
+        store.close()
+
+        self.assertEqual(FaceFeatureStore(self.path, DIM + 1).open(), False)
+        with open(self.path, "r+b") as f:
+            f.write(struct.pack("<I", 0))
+        self.assertEqual(FaceFeatureStore(self.path, DIM).open(), False)
+
+    def test_interrupted_append(self):
+        store = FaceFeatureStore(self.path, DIM)
+        store.open()
+        store.append("face", [1, 2, 3, 4], [1] * DIM)
+        store.append("face", [1, 2, 3, 4], [2] * DIM)
+        # a replace interrupted before the old record is tombstoned
+        store._set_state(0, 1)
+        # an append interrupted before the record number is raised
+        store._write(64 + 2 * store._dtype.itemsize, b"\1")
+        store.close()
+
+        store.open()
+        self.assertEqual(len(store), 1)
+        faces = {name: list(feature)
+                 for (name, _, feature) in store.items()}
+        self.assertEqual(faces["face"], [2] * DIM)
+        store.close()
+
+    def read_faces(self):
+        store = FaceFeatureStore(self.path, DIM)
+        self.assertEqual(store.open(), True)
+        faces = {name: (coordinate, list(feature))
+                 for (name, coordinate, feature) in store.items()}
+        self.assertEqual(sorted(store.names()), sorted(faces))
+        tombstone_num = store.tombstone_number()
+        store.close()
+        return (faces, tombstone_num)
+
+    def test_cross_language(self):
+        # the numpy store and the C++ one read each other's files
+        self.use_lib(False)
+        store = FaceFeatureStore(self.path, DIM)
+        store.open()
+        for i in range(5):
+            store.append("face%d" % i, [i, 1, 2, 3], [i + 0.5] * DIM)
+        store.append("face1", [10, 1, 2, 3], [-1.25] * DIM)
+        store.remove("face2")
+        store.append("\u4eba\u8138", [7, 7, 7, 7], [0.25] * DIM)
+        store.close()
+        expected = self.read_faces()
+
+        self.use_lib(True)
+        self.assertEqual(self.read_faces(), expected)
+        store = FaceFeatureStore(self.path, DIM)
+        store.open()
+        self.assertEqual("face1" in store, True)
+        self.assertEqual("face2" in store, False)
+        store.append("face5", [5, 1, 2, 3], [5.5] * DIM)
+        store.remove("face0")
+        store.append("face3", [30, 1, 2, 3], [3.75] * DIM)
+        store.close()
+        expected = self.read_faces()
+
+        self.use_lib(False)
+        self.assertEqual(self.read_faces(), expected)
+        self.assertEqual(expected[0]["face3"], ([30, 1, 2, 3], [3.75] * DIM))
+        self.assertEqual(expected[0]["\u4eba\u8138"],
+                         ([7, 7, 7, 7], [0.25] * DIM))
+        self.assertEqual(expected[1], 4)
+
+        # files compacted by either side
+        for compact_with_lib in (True, False):
+            self.use_lib(compact_with_lib)
+            store = FaceFeatureStore(self.path, DIM)
+            store.open()
+            self.assertEqual(store.compact(), True)
+            store.close()
+            self.use_lib(not compact_with_lib)
+            self.assertEqual(self.read_faces(), (expected[0], 0))
+
+if __name__ == '__main__':
+    unittest.main()
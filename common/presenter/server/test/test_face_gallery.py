@@ -0,0 +1,173 @@
+"""utest face gallery module"""
+
+# -*- coding: UTF-8 -*-
+#
+#   =======================================================================
+#
+# Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1 Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+#   2 Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+#   3 Neither the names of the copyright holders nor the names of the
+#   contributors may be used to endorse or promote products derived from this
+#   software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#   =======================================================================
+#
+import os
+import sys
+import random
+import tempfile
+import threading
+import unittest
+path = os.path.dirname(__file__)
+index = path.rfind("ascenddk")
+workspace = path[0: index]
+path = os.path.join(workspace, "ascenddk/common/presenter/server/")
+sys.path.append(path)
+
+import facial_recognition.src.face_gallery as face_gallery
+
+DIM = 64
+
+# decimal places of the best score of each encoding
+ENCODING_PLACES = {face_gallery.FEATURE_FLOAT32: 4,
+                   face_gallery.FEATURE_FP16: 3,
+                   face_gallery.FEATURE_INT8: 2}
+
+def random_feature():
+    return [random.uniform(-1, 1) for i in range(DIM)]
+
+class TestFaceGallery(unittest.TestCase):
+
+    def check_gallery(self, gallery, places=4):
+        features = {"face%d" % i: random_feature() for i in range(100)}
+        for name in features:
+            self.assertEqual(gallery.add(name, features[name]), True)
+        self.assertEqual(len(gallery), 100)
+
+        self.assertEqual(gallery.add("face_zero", [0] * DIM), False)
+        self.assertEqual(gallery.add("face_short", [1] * (DIM - 1)), False)
+        self.assertEqual(gallery.add("face_none", None), False)
+
+        result = gallery.search(features["face7"], 3, 0.5)
+        self.assertEqual(result[0][0], "face7")
+        self.assertAlmostEqual(result[0][1], 1, places=places)
+        self.assertEqual(gallery.search([1] * (DIM - 1), 1, 0), [])
+
+        negative = [-i for i in features["face7"]]
+        self.assertEqual(gallery.search(negative, 1, 0.5), [])
+
+        self.assertEqual(gallery.remove("face7"), True)
+        self.assertEqual(gallery.remove("face7"), False)
+        result = gallery.search(features["face7"], 1, 0.9)
+        self.assertEqual(result, [])
+        result = gallery.search(features["face99"], 1, 0.9)
+        self.assertEqual(result[0][0], "face99")
+
+        gallery.add("face99", features["face0"])
+        result = gallery.search(features["face0"], 2, 0.9)
+        self.assertEqual(sorted(i[0] for i in result), ["face0", "face99"])
+
+        gallery.clear()
+        self.assertEqual(len(gallery), 0)
+        self.assertEqual(gallery.search(features["face0"], 1, 0), [])
+
+    def test_numpy_gallery(self):
+        lib = face_gallery.FaceGallery._shared_lib
+        loaded = face_gallery.FaceGallery._shared_lib_loaded
+        face_gallery.FaceGallery._shared_lib = None
+        face_gallery.FaceGallery._shared_lib_loaded = True
+        try:
+            for encoding in ENCODING_PLACES:
+                gallery = face_gallery.FaceGallery(DIM, encoding=encoding)
+                self.check_gallery(gallery, ENCODING_PLACES[encoding])
+            gallery = face_gallery.FaceGallery(DIM, 4, 2)
+            self.assertEqual(gallery.save("xxx"), False)
+            self.assertEqual(gallery.needs_training(), False)
+            self.assertEqual(gallery.train(threading.Lock()), False)
+        finally:
+            face_gallery.FaceGallery._shared_lib = lib
+            face_gallery.FaceGallery._shared_lib_loaded = loaded
+
+    def test_lib_gallery(self):
+        gallery = face_gallery.FaceGallery(DIM)
+        if face_gallery.FaceGallery._shared_lib is None:
+            self.skipTest("libascend_face_gallery.so not found")
+        for encoding in ENCODING_PLACES:
+            gallery = face_gallery.FaceGallery(DIM, encoding=encoding)
+            self.check_gallery(gallery, ENCODING_PLACES[encoding])
+
+    def test_encode_int8(self):
+        feature = face_gallery.np.array([0.5, -1.0, 0.25, 0], dtype="float32")
+        (codes, scale) = face_gallery.encode_int8(feature)
+        self.assertEqual(list(codes), [64, -127, 32, 0])
+        self.assertAlmostEqual(scale, 1 / 127)
+        (codes, scale) = face_gallery.encode_int8(feature * 0)
+        self.assertEqual(list(codes), [0, 0, 0, 0])
+        self.assertEqual(scale, 0)
+
+    def test_ivf_index(self):
+        gallery = face_gallery.FaceGallery(DIM, 2, 2)
+        if face_gallery.FaceGallery._shared_lib is None:
+            self.skipTest("libascend_face_gallery.so not found")
+        self.check_gallery(gallery)
+
+        features = {"face%d" % i: random_feature() for i in range(200)}
+        for name in features:
+            gallery.add(name, features[name])
+        self.assertEqual(gallery.needs_training(), True)
+        self.assertEqual(gallery.train(threading.Lock()), True)
+        self.assertEqual(gallery.needs_training(), False)
+        self.assertEqual(gallery.train(threading.Lock()), False)
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            index_file = os.path.join(tmp_dir, "face_index.bin")
+            self.assertEqual(gallery.save(index_file), True)
+
+            loaded = face_gallery.FaceGallery(DIM, 2, 2)
+            self.assertEqual(loaded.load(index_file, ["face0"]), False)
+            with open(index_file, "rb") as f:
+                data = f.read()
+            with open(index_file, "wb") as f:
+                f.write(data[:len(data) // 2])
+            self.assertEqual(loaded.load(index_file, features), False)
+            # row number of the first list, after the header and centroids
+            offset = 8 * 4 + 2 * DIM * 4
+            with open(index_file, "wb") as f:
+                f.write(data[:offset] + b"\xff" * 8 + data[offset + 8:])
+            self.assertEqual(loaded.load(index_file, features), False)
+            with open(index_file, "wb") as f:
+                f.write(data)
+            self.assertEqual(loaded.load(index_file, features), True)
+            self.assertEqual(len(loaded), 200)
+            for name in ("face0", "face100", "face199"):
+                result = loaded.search(features[name], 1, 0.9)
+                self.assertEqual(result[0][0], name)
+
+            loaded.remove("face0")
+            self.assertEqual(loaded.search(features["face0"], 1, 0.9), [])
+            loaded.add("face_new", features["face0"])
+            result = loaded.search(features["face0"], 1, 0.9)
+            self.assertEqual(result[0][0], "face_new")
+
+if __name__ == '__main__':
+    unittest.main()
@@ -105,6 +105,30 @@ class TestConfigReader(unittest.TestCase):
 
         config_parser.ConfigParser.max_face_num = 100
 
+        config_parser.ConfigParser.face_index_list_num = -1
+        ret = config.config_verify()
+        self.assertEqual(ret, False)
+
+        config_parser.ConfigParser.face_index_list_num = 256
+
+        config_parser.ConfigParser.face_index_probe_num = 0
+        ret = config.config_verify()
+        self.assertEqual(ret, False)
+
+        config_parser.ConfigParser.face_index_probe_num = 8
+
+        config_parser.ConfigParser.face_feature_encoding = "int4"
+        ret = config.config_verify()
+        self.assertEqual(ret, False)
+
+        config_parser.ConfigParser.face_feature_encoding = "int8"
+
+        config_parser.ConfigParser.device_face_match = "yes"
+        ret = config.config_verify()
+        self.assertEqual(ret, False)
+
+        config_parser.ConfigParser.device_face_match = "false"
+
         config_parser.ConfigParser.storage_dir = '/xx/xx/xx'
         ret = config.config_verify()
         self.assertEqual(ret, False)
@@ -73,9 +73,6 @@ APP_NAME = "facial_recognition"
 def mock_join_exp(a, b):
     raise OSError 
 
-def mock_dump_exp(a, b):
-    raise OSError
-
 def mock_parse_proto_exp(a):
     raise DecodeError
 
@@ -307,9 +304,9 @@ class Test_FacialRecognitionServer(unittest.TestCase):
         (ret, msg) = manager.register_face(name, image)
         self.assertEqual(ret, True)
 
-        @patch('json.dump')
-        def test_delete_faces(mock_dump):
-            mock_dump.side_effect = mock_dump_exp
+        @patch('facial_recognition.src.face_feature_store.FaceFeatureStore.remove')
+        def test_delete_faces(mock_remove):
+            mock_remove.side_effect = OSError
             ret = server.delete_faces([name])
             self.assertEqual(ret, False)
 
@@ -369,11 +366,25 @@ class Test_FacialRecognitionServer(unittest.TestCase):
     @patch("os.path.isfile")
     def test_filter_registration_data(self, mock):
         server = Test_FacialRecognitionServer.server
-        ori_registered_faces = server.registered_faces
-        server.registered_faces = {"face_name":"face_data"}
-        mock.return_value = False
+        server.face_store.append("face_name", [1, 1, 1, 1], [1] * 1024)
+        mock.side_effect = lambda path: not path.endswith("face_name.jpg")
         server._filter_registration_data()
-        server.registered_faces = ori_registered_faces
+        self.assertEqual("face_name" in server.face_store, False)
+
+    def test_import_face_register_file(self):
+        server = Test_FacialRecognitionServer.server
+        faces = {"face_json": {"coordinate": [1, 2, 3, 4],
+                               "feature": [1] * 1024},
+                 "face_invalid": {"coordinate": None, "feature": None}}
+        with open(server.face_register_file, "w") as f:
+            json.dump(faces, f)
+        server._import_face_register_file()
+        self.assertEqual("face_json" in server.face_store, True)
+        self.assertEqual("face_invalid" in server.face_store, False)
+        self.assertEqual(os.path.isfile(server.face_register_file), False)
+        self.assertEqual(
+            os.path.isfile(server.face_register_file + ".bak"), True)
+        server.face_store.remove("face_json")
 
     @patch("os.path.join")
     def test_save_face_image(self, mock):
@@ -605,7 +616,7 @@ class Test_FacialRecognitionServer(unittest.TestCase):
         ret = server._recognize_face([feature])
         self.assertEqual(ret, [])
 
-    @patch("facial_recognition.src.facial_recognition_server.FacialRecognitionServer._compute_similar_degree", return_value=0.1)
+    @patch("facial_recognition.src.face_gallery.FaceGallery.search", return_value=[])
     def test_compute_face_feature_fail(self, mock):
         server = Test_FacialRecognitionServer.server
         def produce_face_feature():
@@ -617,11 +628,142 @@ class Test_FacialRecognitionServer(unittest.TestCase):
             for j in range(100):
                 face.vector.append(100)
             return face
-        backup = server.registered_faces
-        server.registered_faces["face_test"] = {"feature":None}
+        server.face_gallery.add("face_test", [1] * 1024)
         feature = produce_face_feature()
         (_, score) = server._compute_face_feature(feature.vector)
         self.assertEqual(score, 0)
+        server.face_gallery.remove("face_test")
+
+    def test_compute_face_feature(self):
+        server = Test_FacialRecognitionServer.server
+        feature = [random.random() for j in range(1024)]
+        server.face_gallery.add("face_match", feature)
+        server.face_gallery.add("face_other", [-i for i in feature])
+        (name, score) = server._compute_face_feature(feature)
+        self.assertEqual(name, "face_match")
+        self.assertAlmostEqual(score, 1, places=4)
+
+        (name, score) = server._compute_face_feature([-i for i in feature])
+        self.assertEqual(name, "face_other")
+        server.face_gallery.remove("face_other")
+        (name, score) = server._compute_face_feature([-i for i in feature])
+        self.assertEqual(name, "Unknown")
+        self.assertEqual(score, 0)
+        server.face_gallery.remove("face_match")
+
+    def test_decode_feature_vector(self):
+        server = Test_FacialRecognitionServer.server
+        vector = [0.5, -1.0, 0.25, 0]
+        face = facial_pb.FaceFeature()
+        face.vector.extend(vector)
+        self.assertEqual(list(server._decode_feature_vector(face)), vector)
+
+        face = facial_pb.FaceFeature()
+        face.encoding = facial_pb.kFeatureFp16
+        face.packed_vector = struct.pack("<4e", *vector)
+        self.assertEqual(list(server._decode_feature_vector(face)), vector)
+        face.packed_vector = b'xxx'
+        self.assertEqual(len(server._decode_feature_vector(face)), 0)
+
+        face = facial_pb.FaceFeature()
+        face.encoding = facial_pb.kFeatureInt8
+        face.scale = 1 / 127
+        face.packed_vector = struct.pack("4b", 64, -127, 32, 0)
+        decoded = server._decode_feature_vector(face)
+        for (i, j) in zip(decoded, vector):
+            self.assertAlmostEqual(i, j, places=2)
+
+    def test_build_gallery_sync(self):
+        server = Test_FacialRecognitionServer.server
+        vector = [0.5, -1.0, 0.25, 0]
+        encoding = server.face_feature_encoding
+        server.face_feature_encoding = facial_pb.kFeatureFp16
+        sync = server._build_gallery_sync([("face_a", vector),
+                                           ("face_b", None)], True)
+        self.assertEqual(sync.reset, True)
+        self.assertAlmostEqual(sync.threshold, server.face_match_threshold)
+        self.assertEqual([i.name for i in sync.face], ["face_a", "face_b"])
+        self.assertEqual(sync.face[0].packed_vector,
+                         struct.pack("<4e", *vector))
+        self.assertEqual(list(server._decode_feature_vector(sync.face[0])),
+                         vector)
+        self.assertEqual(len(sync.face[1].vector), 0)
+        self.assertEqual(len(sync.face[1].packed_vector), 0)
+
+        server.face_feature_encoding = facial_pb.kFeatureInt8
+        sync = server._build_gallery_sync([("face_a", vector)], False)
+        self.assertEqual(sync.reset, False)
+        decoded = server._decode_feature_vector(sync.face[0])
+        for (i, j) in zip(decoded, vector):
+            self.assertAlmostEqual(i, j, places=2)
+
+        server.face_feature_encoding = facial_pb.kFeatureFloat32
+        sync = server._build_gallery_sync([("face_a", vector)], False)
+        self.assertEqual(list(sync.face[0].vector), vector)
+        server.face_feature_encoding = encoding
+
+    @patch("facial_recognition.src.facial_recognition_server.FacialRecognitionServer.send_message")
+    def test_broadcast_gallery_sync(self, mock):
+        server = Test_FacialRecognitionServer.server
+        sync = server._build_gallery_sync([("face_a", None)], False)
+        server.device_face_match = False
+        server._broadcast_gallery_sync(sync)
+        self.assertEqual(mock.call_count, 0)
+
+        server.device_face_match = True
+        mock.side_effect = OSError
+        server._broadcast_gallery_sync(sync)
+        self.assertEqual(mock.call_count,
+                         len(server.app_manager.list_app()))
+        server.device_face_match = False
+
+    def test_send_message_serialized(self):
+        class SlowConn():
+            def __init__(self):
+                self.active = 0
+                self.overlapped = False
+                self.sent = 0
+
+            def fileno(self):
+                return 12345
+
+            def sendall(self, data):
+                self.active += 1
+                if self.active > 1:
+                    self.overlapped = True
+                time.sleep(0.01)
+                self.active -= 1
+                self.sent += 1
+
+        server = Test_FacialRecognitionServer.server
+        conn = SlowConn()
+        sync = server._build_gallery_sync([("face_a", None)], False)
+        threads = [threading.Thread(
+            target=server.send_message,
+            args=(conn, sync, facial_pb._GALLERYSYNC.full_name))
+                   for _ in range(4)]
+        for i in threads:
+            i.start()
+        for i in threads:
+            i.join()
+        self.assertEqual(conn.sent, 4)
+        self.assertFalse(conn.overlapped)
+        server.send_locks.pop(conn.fileno(), None)
+
+    def test_recognize_face_on_device(self):
+        server = Test_FacialRecognitionServer.server
+        face = facial_pb.FaceFeature()
+        face.box.lt_x = 1
+        face.box.lt_y = 2
+        face.box.rb_x = 3
+        face.box.rb_y = 4
+        face.name = "face_device"
+        face.score = 0.75
+        ret = server._recognize_face([face])
+        self.assertEqual(len(ret), 1)
+        self.assertEqual(ret[0]["name"], "face_device")
+        self.assertAlmostEqual(ret[0]["confidence"], 0.75)
+        self.assertEqual(ret[0]["coordinate"], [1, 2, 3, 4])
 
     @patch("facial_recognition.src.config_parser.ConfigParser.config_verify", return_value=False)
     def test_run_fail(self, mock):
@@ -38,7 +38,7 @@ import threading
 import unittest
 import select
 import socket
-from unittest.mock import patch
+from unittest.mock import patch, MagicMock
 import struct
 import shutil
 from json.decoder import JSONDecodeError
@@ -407,6 +407,47 @@ class Test_VideoAnalysisServer(unittest.TestCase):
         ret = server._parse_protobuf(request, b'xxx')
         self.assertEqual(ret, False)
 
+    def test_get_object_images(self):
+        server = Test_VideoAnalysisServer.server
+        request = video_pb.ImageSet()
+        object = request.object.add()
+        object.id = "car_1"
+        object.image = IMG
+        object = request.object.add()
+        object.id = "car_2"
+        object = request.object.add()
+        object.id = "bus_1"
+
+        # images of car_2 and bus_1 arrive as tlvs behind the message
+        message = request.SerializeToString()
+        for image in (b'car_2', b'bus_1'):
+            tlv = video_pb.ImageSet()
+            tlv.object_image.append(image)
+            message += tlv.SerializeToString()
+        request = video_pb.ImageSet()
+        request.ParseFromString(message)
+        ret = server._get_object_images(request)
+        self.assertEqual(ret, [IMG, b'car_2', b'bus_1'])
+
+        del request.object_image[-1]
+        ret = server._get_object_images(request)
+        self.assertEqual(ret, None)
+
+    def test_get_compact_id(self):
+        server = Test_VideoAnalysisServer.server
+        frame_index = video_pb.FrameIndex()
+        frame_index.frame_number = 12
+        self.assertEqual(server._get_frame_id(frame_index), "12")
+        frame_index.frame_id = FRAME_ID
+        self.assertEqual(server._get_frame_id(frame_index), FRAME_ID)
+
+        # class in the high 8 bits and index in the low 24 bits
+        self.assertEqual(server._get_object_id("", (1 << 24) | 3), "car_3")
+        self.assertEqual(server._get_object_id("", (2 << 24) | 1), "bus_1")
+        self.assertEqual(server._get_object_id("", (3 << 24) | 7), "person_7")
+        self.assertEqual(server._get_object_id("", (9 << 24) | 7), "object_7")
+        self.assertEqual(server._get_object_id("car_1", (3 << 24) | 7), "car_1")
+
     @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer._parse_protobuf")
     @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer.send_message", return_value=True)
     def test_process_register_app_fail(self, mock1, mock2):
@@ -629,6 +670,93 @@ class Test_VideoAnalysisServer(unittest.TestCase):
         ret = server._process_human_inference_result(None, b'xxx')
         self.assertEqual(ret, False)
 
+    @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer._save_frame_result")
+    @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer.send_message", return_value=True)
+    def test_process_frame_result(self, mock1, mock2):
+        server = Test_VideoAnalysisServer.server
+        conn = MagicMock()
+        conn.fileno.return_value = 100
+        request = video_pb.FrameResult()
+        request.frame_index.frame_id = FRAME_ID
+
+        # no response until a message requires ack
+        mock2.return_value = (video_pb.kErrorNone, "")
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        self.assertEqual(ret, True)
+        mock2.return_value = (video_pb.kErrorAppLost, "app lost")
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        self.assertEqual(ret, True)
+        self.assertEqual(mock1.call_count, 0)
+
+        request.ack_required = True
+        mock2.return_value = (video_pb.kErrorNone, "")
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        self.assertEqual(ret, True)
+        self.assertEqual(mock1.call_count, 1)
+        response = mock1.call_args[0][1]
+        self.assertEqual(response.ret, video_pb.kErrorAppLost)
+        self.assertEqual(response.message,
+                         "1 of 3 frame results failed, app lost")
+
+        # failure of previous window is not reported again
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        response = mock1.call_args[0][1]
+        self.assertEqual(response.ret, video_pb.kErrorNone)
+        self.assertEqual(response.message, "1 frame results process succeed")
+
+        # a bad message is answered with an error at once and the
+        # connection is closed
+        request.ack_required = False
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        ret = server._process_frame_result(conn, b'\xff')
+        self.assertEqual(ret, False)
+        self.assertEqual(mock1.call_count, 3)
+        response = mock1.call_args[0][1]
+        self.assertEqual(response.ret, video_pb.kErrorOther)
+        self.assertEqual(response.message, "frame result can not be parsed "
+                         "after 1 frame results, 0 of them failed")
+        self.assertNotIn(100, server.stream_window)
+
+        # a message without frame index flushes the partial window
+        ret = server._process_frame_result(conn, request.SerializeToString())
+        flush = video_pb.FrameResult()
+        flush.ack_required = True
+        ret = server._process_frame_result(conn, flush.SerializeToString())
+        self.assertEqual(ret, True)
+        self.assertEqual(mock1.call_count, 4)
+        self.assertEqual(mock2.call_count, 6)
+        response = mock1.call_args[0][1]
+        self.assertEqual(response.ret, video_pb.kErrorNone)
+        self.assertEqual(response.message, "1 frame results process succeed")
+
+    @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer._save_human_inference_result")
+    @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer._save_car_inference_result")
+    @patch("video_analysis.src.video_analysis_server.VideoAnalysisServer._save_image_set")
+    def test_save_frame_result(self, mock1, mock2, mock3):
+        server = Test_VideoAnalysisServer.server
+        request = video_pb.FrameResult()
+        request.frame_index.app_id = APP_NAME
+        request.frame_index.frame_id = FRAME_ID
+        car_result = request.car_result.add()
+        car_result.object_id = "car_1"
+        human_result = request.human_result.add()
+        human_result.object_id = "person_1"
+        mock2.return_value = (video_pb.kErrorNone, "")
+        mock3.return_value = (video_pb.kErrorNone, "")
+
+        # results without frame image are saved to the frame
+        ret = server._save_frame_result(None, request)
+        self.assertEqual(ret, (video_pb.kErrorNone, ""))
+        self.assertEqual(mock1.call_count, 0)
+        self.assertEqual(mock2.call_args[0][1].frame_index.frame_id, FRAME_ID)
+        self.assertEqual(mock3.call_args[0][1].frame_index.app_id, APP_NAME)
+
+        request.frame_image = IMG
+        mock1.return_value = (video_pb.kErrorStorageLimit, "no space")
+        ret = server._save_frame_result(None, request)
+        self.assertEqual(ret, (video_pb.kErrorStorageLimit, "no space"))
+        self.assertEqual(mock2.call_count, 1)
+
     @patch("os.path.isdir", side_effect=mock_oserr)
     def test_save_image_fail(self, mock):
         server = Test_VideoAnalysisServer.server
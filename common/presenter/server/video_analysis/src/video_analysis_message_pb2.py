@@ -52,7 +52,7 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   name='video_analysis_message.proto',
   package='ascend.presenter.video_analysis',
   syntax='proto3',
-  serialized_pb=_b('\n\x1cvideo_analysis_message.proto\x12\x1f\x61scend.presenter.video_analysis\"\'\n\x0bRegisterApp\x12\n\n\x02id\x18\x01 \x01(\t\x12\x0c\n\x04type\x18\x02 \x01(\t\"Z\n\x0e\x43ommonResponse\x12\x37\n\x03ret\x18\x01 \x01(\x0e\x32*.ascend.presenter.video_analysis.ErrorCode\x12\x0f\n\x07message\x18\x02 \x01(\t\"X\n\nFrameIndex\x12\x0e\n\x06\x61pp_id\x18\x01 \x01(\t\x12\x12\n\nchannel_id\x18\x02 \x01(\t\x12\x14\n\x0c\x63hannel_name\x18\x03 \x01(\t\x12\x10\n\x08\x66rame_id\x18\x04 \x01(\t\"7\n\x06Object\x12\n\n\x02id\x18\x01 \x01(\t\x12\x12\n\nconfidence\x18\x02 \x01(\x02\x12\r\n\x05image\x18\x03 \x01(\x0c\"\x9a\x01\n\x08ImageSet\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x13\n\x0b\x66rame_image\x18\x02 \x01(\x0c\x12\x37\n\x06object\x18\x03 \x03(\x0b\x32\'.ascend.presenter.video_analysis.Object\"\xcd\x01\n\x12\x43\x61rInferenceResult\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x11\n\tobject_id\x18\x02 \x01(\t\x12?\n\x04type\x18\x03 \x01(\x0e\x32\x31.ascend.presenter.video_analysis.CarInferenceType\x12\x12\n\nconfidence\x18\x04 \x01(\x02\x12\r\n\x05value\x18\x05 \x01(\t\"%\n\x07MapType\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\x02\"\xad\x01\n\x14HumanInferenceResult\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x11\n\tobject_id\x18\x02 \x01(\t\x12@\n\x0ehuman_property\x18\x03 \x03(\x0b\x32(.ascend.presenter.video_analysis.MapType*\xdf\x01\n\tErrorCode\x12\x0e\n\nkErrorNone\x10\x00\x12\x1a\n\x16kErrorAppRegisterExist\x10\x01\x12\x1e\n\x1akErrorAppRegisterNoStorage\x10\x02\x12\x19\n\x15kErrorAppRegisterType\x10\x03\x12\x1a\n\x16kErrorAppRegisterLimit\x10\x04\x12\x13\n\x0fkErrorAppDelete\x10\x05\x12\x11\n\rkErrorAppLost\x10\x06\x12\x16\n\x12kErrorStorageLimit\x10\x07\x12\x0f\n\x0bkErrorOther\x10\x08*0\n\x10\x43\x61rInferenceType\x12\r\n\tkCarColor\x10\x00\x12\r\n\tkCarBrand\x10\x01\x62\x06proto3')
+  serialized_pb=_b('\n\x1cvideo_analysis_message.proto\x12\x1f\x61scend.presenter.video_analysis\"\'\n\x0bRegisterApp\x12\n\n\x02id\x18\x01 \x01(\t\x12\x0c\n\x04type\x18\x02 \x01(\t\"Z\n\x0e\x43ommonResponse\x12\x37\n\x03ret\x18\x01 \x01(\x0e\x32*.ascend.presenter.video_analysis.ErrorCode\x12\x0f\n\x07message\x18\x02 \x01(\t\"n\n\nFrameIndex\x12\x0e\n\x06\x61pp_id\x18\x01 \x01(\t\x12\x12\n\nchannel_id\x18\x02 \x01(\t\x12\x14\n\x0c\x63hannel_name\x18\x03 \x01(\t\x12\x10\n\x08\x66rame_id\x18\x04 \x01(\t\x12\x14\n\x0c\x66rame_number\x18\x05 \x01(\r\"K\n\x06Object\x12\n\n\x02id\x18\x01 \x01(\t\x12\x12\n\nconfidence\x18\x02 \x01(\x02\x12\r\n\x05image\x18\x03 \x01(\x0c\x12\x12\n\ncompact_id\x18\x04 \x01(\r\"\xb0\x01\n\x08ImageSet\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x13\n\x0b\x66rame_image\x18\x02 \x01(\x0c\x12\x37\n\x06object\x18\x03 \x03(\x0b\x32\'.ascend.presenter.video_analysis.Object\x12\x14\n\x0cobject_image\x18\x04 \x03(\x0c\"\xe8\x01\n\x12\x43\x61rInferenceResult\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x11\n\tobject_id\x18\x02 \x01(\t\x12?\n\x04type\x18\x03 \x01(\x0e\x32\x31.ascend.presenter.video_analysis.CarInferenceType\x12\x12\n\nconfidence\x18\x04 \x01(\x02\x12\r\n\x05value\x18\x05 \x01(\t\x12\x19\n\x11\x63ompact_object_id\x18\x06 \x01(\r\"%\n\x07MapType\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\x02\"\xc8\x01\n\x14HumanInferenceResult\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x11\n\tobject_id\x18\x02 \x01(\t\x12@\n\x0ehuman_property\x18\x03 \x03(\x0b\x32(.ascend.presenter.video_analysis.MapType\x12\x19\n\x11\x63ompact_object_id\x18\x04 \x01(\r\"\xdf\x02\n\x0b\x46rameResult\x12@\n\x0b\x66rame_index\x18\x01 \x01(\x0b\x32+.ascend.presenter.video_analysis.FrameIndex\x12\x13\n\x0b\x66rame_image\x18\x02 \x01(\x0c\x12\x37\n\x06object\x18\x03 \x03(\x0b\x32\'.ascend.presenter.video_analysis.Object\x12\x14\n\x0cobject_image\x18\x04 \x03(\x0c\x12G\n\ncar_result\x18\x05 \x03(\x0b\x32\x33.ascend.presenter.video_analysis.CarInferenceResult\x12K\n\x0chuman_result\x18\x06 \x03(\x0b\x32\x35.ascend.presenter.video_analysis.HumanInferenceResult\x12\x14\n\x0c\x61\x63k_required\x18\x07 \x01(\x08*\xdf\x01\n\tErrorCode\x12\x0e\n\nkErrorNone\x10\x00\x12\x1a\n\x16kErrorAppRegisterExist\x10\x01\x12\x1e\n\x1akErrorAppRegisterNoStorage\x10\x02\x12\x19\n\x15kErrorAppRegisterType\x10\x03\x12\x1a\n\x16kErrorAppRegisterLimit\x10\x04\x12\x13\n\x0fkErrorAppDelete\x10\x05\x12\x11\n\rkErrorAppLost\x10\x06\x12\x16\n\x12kErrorStorageLimit\x10\x07\x12\x0f\n\x0bkErrorOther\x10\x08*0\n\x10\x43\x61rInferenceType\x12\r\n\tkCarColor\x10\x00\x12\r\n\tkCarBrand\x10\x01\x62\x06proto3')
 )
 
 _ERRORCODE = _descriptor.EnumDescriptor(
@@ -100,8 +100,8 @@ _ERRORCODE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=926,
-  serialized_end=1149,
+  serialized_start=1398,
+  serialized_end=1621,
 )
 _sym_db.RegisterEnumDescriptor(_ERRORCODE)
 
@@ -123,8 +123,8 @@ _CARINFERENCETYPE = _descriptor.EnumDescriptor(
   ],
   containing_type=None,
   options=None,
-  serialized_start=1151,
-  serialized_end=1199,
+  serialized_start=1623,
+  serialized_end=1671,
 )
 _sym_db.RegisterEnumDescriptor(_CARINFERENCETYPE)
 
@@ -254,6 +254,13 @@ _FRAMEINDEX = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='frame_number', full_name='ascend.presenter.video_analysis.FrameIndex.frame_number', index=4,
+      number=5, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -267,7 +274,7 @@ _FRAMEINDEX = _descriptor.Descriptor(
   oneofs=[
   ],
   serialized_start=198,
-  serialized_end=286,
+  serialized_end=308,
 )
 
 
@@ -299,6 +306,13 @@ _OBJECT = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='compact_id', full_name='ascend.presenter.video_analysis.Object.compact_id', index=3,
+      number=4, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -311,8 +325,8 @@ _OBJECT = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=288,
-  serialized_end=343,
+  serialized_start=310,
+  serialized_end=385,
 )
 
 
@@ -344,6 +358,13 @@ _IMAGESET = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='object_image', full_name='ascend.presenter.video_analysis.ImageSet.object_image', index=3,
+      number=4, type=12, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -356,8 +377,8 @@ _IMAGESET = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=346,
-  serialized_end=500,
+  serialized_start=388,
+  serialized_end=564,
 )
 
 
@@ -403,6 +424,13 @@ _CARINFERENCERESULT = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='compact_object_id', full_name='ascend.presenter.video_analysis.CarInferenceResult.compact_object_id', index=5,
+      number=6, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -415,8 +443,8 @@ _CARINFERENCERESULT = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=503,
-  serialized_end=708,
+  serialized_start=567,
+  serialized_end=799,
 )
 
 
@@ -453,8 +481,8 @@ _MAPTYPE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=710,
-  serialized_end=747,
+  serialized_start=801,
+  serialized_end=838,
 )
 
 
@@ -486,6 +514,86 @@ _HUMANINFERENCERESULT = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='compact_object_id', full_name='ascend.presenter.video_analysis.HumanInferenceResult.compact_object_id', index=3,
+      number=4, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=841,
+  serialized_end=1041,
+)
+
+
+_FRAMERESULT = _descriptor.Descriptor(
+  name='FrameResult',
+  full_name='ascend.presenter.video_analysis.FrameResult',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='frame_index', full_name='ascend.presenter.video_analysis.FrameResult.frame_index', index=0,
+      number=1, type=11, cpp_type=10, label=1,
+      has_default_value=False, default_value=None,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='frame_image', full_name='ascend.presenter.video_analysis.FrameResult.frame_image', index=1,
+      number=2, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='object', full_name='ascend.presenter.video_analysis.FrameResult.object', index=2,
+      number=3, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='object_image', full_name='ascend.presenter.video_analysis.FrameResult.object_image', index=3,
+      number=4, type=12, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='car_result', full_name='ascend.presenter.video_analysis.FrameResult.car_result', index=4,
+      number=5, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='human_result', full_name='ascend.presenter.video_analysis.FrameResult.human_result', index=5,
+      number=6, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='ack_required', full_name='ascend.presenter.video_analysis.FrameResult.ack_required', index=6,
+      number=7, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -498,8 +606,8 @@ _HUMANINFERENCERESULT = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=750,
-  serialized_end=923,
+  serialized_start=1044,
+  serialized_end=1395,
 )
 
 _COMMONRESPONSE.fields_by_name['ret'].enum_type = _ERRORCODE
@@ -509,6 +617,10 @@ _CARINFERENCERESULT.fields_by_name['frame_index'].message_type = _FRAMEINDEX
 _CARINFERENCERESULT.fields_by_name['type'].enum_type = _CARINFERENCETYPE
 _HUMANINFERENCERESULT.fields_by_name['frame_index'].message_type = _FRAMEINDEX
 _HUMANINFERENCERESULT.fields_by_name['human_property'].message_type = _MAPTYPE
+_FRAMERESULT.fields_by_name['frame_index'].message_type = _FRAMEINDEX
+_FRAMERESULT.fields_by_name['object'].message_type = _OBJECT
+_FRAMERESULT.fields_by_name['car_result'].message_type = _CARINFERENCERESULT
+_FRAMERESULT.fields_by_name['human_result'].message_type = _HUMANINFERENCERESULT
 DESCRIPTOR.message_types_by_name['RegisterApp'] = _REGISTERAPP
 DESCRIPTOR.message_types_by_name['CommonResponse'] = _COMMONRESPONSE
 DESCRIPTOR.message_types_by_name['FrameIndex'] = _FRAMEINDEX
@@ -517,6 +629,7 @@ DESCRIPTOR.message_types_by_name['ImageSet'] = _IMAGESET
 DESCRIPTOR.message_types_by_name['CarInferenceResult'] = _CARINFERENCERESULT
 DESCRIPTOR.message_types_by_name['MapType'] = _MAPTYPE
 DESCRIPTOR.message_types_by_name['HumanInferenceResult'] = _HUMANINFERENCERESULT
+DESCRIPTOR.message_types_by_name['FrameResult'] = _FRAMERESULT
 DESCRIPTOR.enum_types_by_name['ErrorCode'] = _ERRORCODE
 DESCRIPTOR.enum_types_by_name['CarInferenceType'] = _CARINFERENCETYPE
 _sym_db.RegisterFileDescriptor(DESCRIPTOR)
@@ -577,5 +690,12 @@ HumanInferenceResult = _reflection.GeneratedProtocolMessageType('HumanInferenceR
   ))
 _sym_db.RegisterMessage(HumanInferenceResult)
 
+FrameResult = _reflection.GeneratedProtocolMessageType('FrameResult', (_message.Message,), dict(
+  DESCRIPTOR = _FRAMERESULT,
+  __module__ = 'video_analysis_message_pb2'
+  # @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.FrameResult)
+  ))
+_sym_db.RegisterMessage(FrameResult)
+
 
 # @@protoc_insertion_point(module_scope)
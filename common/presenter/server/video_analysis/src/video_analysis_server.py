@@ -53,6 +53,11 @@ CHANNEL_NAME_FILE = "channel_name.txt"
 SERVER_TYPE = "video_analysis"
 CHECK_INTERCAL = 100
 MAX_SUB_DIRECTORY_NUM = 30000
+ERROR_UNKNOWN_MESSAGE = "Error unknown on Presenter Server"
+# compact object id sent by agent: object class in the high 8 bits and
+# object index in the low 24 bits, must be same as the agent
+OBJECT_INDEX_BITS = 24
+OBJECT_CLASS_NAMES = ("object", "car", "bus", "person")
 
 class VideoAnalysisServer(PresenterSocketServer):
     '''Video Analysis Server'''
@@ -64,6 +69,9 @@ class VideoAnalysisServer(PresenterSocketServer):
         self.reserved_space = int(config.reserved_space)
         self.app_manager = AppManager()
         self.frame_num = 0
+        # results of frame_result messages received since last response,
+        # key is socket fileno
+        self.stream_window = {}
         super(VideoAnalysisServer, self).__init__(server_address)
 
     def _clean_connect(self, sock_fileno, epoll, conns, msgs):
@@ -77,6 +85,14 @@ class VideoAnalysisServer(PresenterSocketServer):
         """
         logging.info("clean fd:%s, conns:%s", sock_fileno, conns)
         self.app_manager.unregister_app_by_fd(sock_fileno)
+        window = self.stream_window.pop(sock_fileno, None)
+        if window is not None:
+            # the agent acks its last window before close, frame results
+            # left here can not be acknowledged any more
+            logging.warning("%s frame results of fd:%s are not acknowledged"
+                            " before close, %s of them failed",
+                            window["frame_num"], sock_fileno,
+                            window["failed_num"])
         epoll.unregister(sock_fileno)
         conns[sock_fileno].close()
         del conns[sock_fileno]
@@ -104,6 +120,8 @@ class VideoAnalysisServer(PresenterSocketServer):
             ret = self._process_car_inference_result(conn, msg_data)
         elif msg_name == pb2._HUMANINFERENCERESULT.full_name:
             ret = self._process_human_inference_result(conn, msg_data)
+        elif msg_name == pb2._FRAMERESULT.full_name:
+            ret = self._process_frame_result(conn, msg_data)
         elif msg_name == presenter_message_pb2._HEARTBEATMESSAGE.full_name:
             ret = self._process_heartbeat(conn)
         # process image request, receive an image data from presenter agent
@@ -206,66 +224,91 @@ class VideoAnalysisServer(PresenterSocketServer):
         Returns: True or False
         '''
         request = pb2.ImageSet()
-        response = pb2.CommonResponse()
-        msg_name = msg_name = pb2._COMMONRESPONSE.full_name
         if not self._parse_protobuf(request, msg_data):
             self._response_error_unknown(conn)
             return False
 
+        ret, message = self._save_image_set(conn, request)
+        if ret == pb2.kErrorNone:
+            message = "image set process succeed"
+        return self._response(conn, ret, message)
+
+    def _save_image_set(self, conn, request):
+        '''
+        Description: save frame image and object images of a frame
+        Input:
+            conn: a socket connection
+            request: image_set or frame_result message
+        Returns: error code and error message
+        '''
         app_id = request.frame_index.app_id
         channel_id = request.frame_index.channel_id
         channel_name = request.frame_index.channel_name
-        frame_id = request.frame_index.frame_id
+        frame_id = self._get_frame_id(request.frame_index)
         frame_image = request.frame_image
+        object_images = self._get_object_images(request)
+        if object_images is None:
+            logging.error("object image of frame %s is missing.", frame_id)
+            return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
 
         if not self.app_manager.is_app_exist(app_id):
             logging.error("app_id: %s not exist", app_id)
-            response.ret = pb2.kErrorAppLost
-            response.message = "app_id: %s not exist"%(app_id)
-            self.send_message(conn, response, msg_name)
-            return False
+            return pb2.kErrorAppLost, "app_id: %s not exist"%(app_id)
 
         frame_num = self.app_manager.get_frame_num(app_id, channel_id)
         if frame_num % CHECK_INTERCAL == 0:
             if self._remain_space() <= self.reserved_space:
                 logging.error("Insufficient storage space on Server.")
-                response.ret = pb2.kErrorStorageLimit
-                response.message = "Insufficient storage space on Server."
-                self.send_message(conn, response, msg_name)
-                return False
+                return pb2.kErrorStorageLimit, \
+                    "Insufficient storage space on Server."
 
         stack_index = frame_num // MAX_SUB_DIRECTORY_NUM
         stack_directory = "stack_{}/".format(stack_index)
         frame = stack_directory + frame_id
         frame_dir = os.path.join(self.storage_dir, app_id, channel_id, frame)
         if not self._save_image(frame_dir, frame_image):
-            self._response_error_unknown(conn)
             logging.error("save_image: %s error.", frame_dir)
-            return False
+            return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
 
         app_dir = os.path.join(self.storage_dir, app_id)
         self._save_channel_name(app_dir, channel_id, channel_name)
 
-        for i in request.object:
-            object_id = i.id
+        for i, object_image in zip(request.object, object_images):
+            object_id = self._get_object_id(i.id, i.compact_id)
             object_confidence = i.confidence
-            object_image = i.image
             object_dir = os.path.join(frame_dir, object_id)
             inference_dict = {"confidence" : object_confidence}
 
             if not self._save_image(object_dir, object_image) or \
               not self._save_inference_result(object_dir, inference_dict):
-                self._response_error_unknown(conn)
                 logging.error("save image: %s error.", object_dir)
-                return False
+                return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
 
         self.app_manager.increase_frame_num(app_id, channel_id)
 
         self.app_manager.set_heartbeat(conn.fileno())
-        response.ret = pb2.kErrorNone
-        response.message = "image set process succeed"
-        self.send_message(conn, response, msg_name)
-        return True
+        return pb2.kErrorNone, ""
+
+    def _get_object_images(self, request):
+        '''
+        Description: get image of each object in image_set message. image
+            which is not set in the object is carried by object_image field,
+            in object order, without being copied on the agent.
+        Input:
+            request: image_set message
+        Returns: list of object images, None if any image is missing
+        '''
+        object_images = []
+        tlv_images = iter(request.object_image)
+        for i in request.object:
+            if i.image:
+                object_images.append(i.image)
+                continue
+            object_image = next(tlv_images, None)
+            if object_image is None:
+                return None
+            object_images.append(object_image)
+        return object_images
 
     def _process_car_inference_result(self, conn, msg_data):
         '''
@@ -276,24 +319,33 @@ class VideoAnalysisServer(PresenterSocketServer):
         Returns: True or False
         '''
         request = pb2.CarInferenceResult()
-        response = pb2.CommonResponse()
-        msg_name = msg_name = pb2._COMMONRESPONSE.full_name
-        inference_dict = {}
         if not self._parse_protobuf(request, msg_data):
             self._response_error_unknown(conn)
             return False
 
+        ret, message = self._save_car_inference_result(conn, request)
+        if ret == pb2.kErrorNone:
+            message = "car inference process succeed"
+        return self._response(conn, ret, message)
+
+    def _save_car_inference_result(self, conn, request):
+        '''
+        Description: save car inference result of an object
+        Input:
+            conn: a socket connection
+            request: car_inference_result message
+        Returns: error code and error message
+        '''
+        inference_dict = {}
         app_id = request.frame_index.app_id
         channel_id = request.frame_index.channel_id
-        frame_id = request.frame_index.frame_id
-        object_id = request.object_id
+        frame_id = self._get_frame_id(request.frame_index)
+        object_id = self._get_object_id(request.object_id,
+                                        request.compact_object_id)
 
         if not self.app_manager.is_app_exist(app_id):
             logging.error("app_id: %s not exist", app_id)
-            response.ret = pb2.kErrorAppLost
-            response.message = "app_id: %s not exist"%(app_id)
-            self.send_message(conn, response, msg_name)
-            return False
+            return pb2.kErrorAppLost, "app_id: %s not exist"%(app_id)
 
         channel_dir = os.path.join(self.storage_dir, app_id, channel_id)
         stack_list = os.listdir(channel_dir)
@@ -308,18 +360,12 @@ class VideoAnalysisServer(PresenterSocketServer):
             inference_dict["brand"] = request.value
         else:
             logging.error("unknown type %d", request.type)
-            self._response_error_unknown(conn)
-            return False
+            return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
 
         if not self._save_inference_result(object_dir, inference_dict):
-            self._response_error_unknown(conn)
-            return False
+            return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
         self.app_manager.set_heartbeat(conn.fileno())
-        response.ret = pb2.kErrorNone
-        response.message = "car inference process succeed"
-        self.send_message(conn, response, msg_name)
-
-        return True
+        return pb2.kErrorNone, ""
 
     def _process_human_inference_result(self, conn, msg_data):
         '''
@@ -330,24 +376,33 @@ class VideoAnalysisServer(PresenterSocketServer):
         Returns: True or False
         '''
         request = pb2.HumanInferenceResult()
-        response = pb2.CommonResponse()
-        msg_name = msg_name = pb2._COMMONRESPONSE.full_name
-        inference_dict = {}
         if not self._parse_protobuf(request, msg_data):
             self._response_error_unknown(conn)
             return False
 
+        ret, message = self._save_human_inference_result(conn, request)
+        if ret == pb2.kErrorNone:
+            message = "human inference process succeed"
+        return self._response(conn, ret, message)
+
+    def _save_human_inference_result(self, conn, request):
+        '''
+        Description: save human inference result of an object
+        Input:
+            conn: a socket connection
+            request: human_inference_result message
+        Returns: error code and error message
+        '''
+        inference_dict = {}
         app_id = request.frame_index.app_id
         channel_id = request.frame_index.channel_id
-        frame_id = request.frame_index.frame_id
-        object_id = request.object_id
+        frame_id = self._get_frame_id(request.frame_index)
+        object_id = self._get_object_id(request.object_id,
+                                        request.compact_object_id)
 
         if not self.app_manager.is_app_exist(app_id):
             logging.error("app_id: %s not exist", app_id)
-            response.ret = pb2.kErrorAppLost
-            response.message = "app_id: %s not exist"%(app_id)
-            self.send_message(conn, response, msg_name)
-            return False
+            return pb2.kErrorAppLost, "app_id: %s not exist"%(app_id)
 
         channel_dir = os.path.join(self.storage_dir, app_id, channel_id)
         stack_list = os.listdir(channel_dir)
@@ -360,14 +415,132 @@ class VideoAnalysisServer(PresenterSocketServer):
             inference_dict["property"][item.key] = item.value
 
         if not self._save_inference_result(object_dir, inference_dict):
-            self._response_error_unknown(conn)
-            return False
+            return pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE
         self.app_manager.set_heartbeat(conn.fileno())
-        response.ret = pb2.kErrorNone
-        response.message = "human inference process succeed"
-        self.send_message(conn, response, msg_name)
+        return pb2.kErrorNone, ""
+
+    def _process_frame_result(self, conn, msg_data):
+        '''
+        Description: process frame_result message sent in streaming mode.
+            no response is sent for each message, the results of the
+            messages are aggregated and responded when ack_required is set
+        Input:
+            conn: a socket connection
+            msg_data: message data.
+        Returns: True or False
+        '''
+        request = pb2.FrameResult()
+        window = self.stream_window.setdefault(
+            conn.fileno(), {"frame_num": 0, "failed_num": 0,
+                            "ret": pb2.kErrorNone, "message": ""})
+        if not self._parse_protobuf(request, msg_data):
+            # whether the message asks for an ack is unknown, so the window
+            # is answered with an error now and the connection is closed,
+            # the agent starts a new window on a new connection
+            del self.stream_window[conn.fileno()]
+            message = "frame result can not be parsed after {} frame " \
+                "results, {} of them failed".format(window["frame_num"],
+                                                    window["failed_num"])
+            logging.error(message)
+            self._response(conn, pb2.kErrorOther, message)
+            return False
+
+        # a frame result without frame index only asks for the response of
+        # the window, which is sent at end of stream and on close
+        if request.HasField("frame_index"):
+            ret, message = self._save_frame_result(conn, request)
+            window["frame_num"] += 1
+            if ret != pb2.kErrorNone:
+                window["failed_num"] += 1
+                window["ret"] = ret
+                window["message"] = message
+
+        if not request.ack_required:
+            return True
+
+        del self.stream_window[conn.fileno()]
+        if window["failed_num"] == 0:
+            message = "{} frame results process succeed".format(
+                window["frame_num"])
+        else:
+            message = "{} of {} frame results failed, {}".format(
+                window["failed_num"], window["frame_num"], window["message"])
+        self._response(conn, window["ret"], message)
         return True
 
+    def _save_frame_result(self, conn, request):
+        '''
+        Description: save images and inference results of a frame
+        Input:
+            conn: a socket connection
+            request: frame_result message
+        Returns: error code and error message
+        '''
+        if request.frame_image:
+            ret, message = self._save_image_set(conn, request)
+            if ret != pb2.kErrorNone:
+                return ret, message
+
+        for car_result in request.car_result:
+            car_result.frame_index.CopyFrom(request.frame_index)
+            ret, message = self._save_car_inference_result(conn, car_result)
+            if ret != pb2.kErrorNone:
+                return ret, message
+
+        for human_result in request.human_result:
+            human_result.frame_index.CopyFrom(request.frame_index)
+            ret, message = self._save_human_inference_result(conn,
+                                                             human_result)
+            if ret != pb2.kErrorNone:
+                return ret, message
+
+        return pb2.kErrorNone, ""
+
+    def _get_frame_id(self, frame_index):
+        '''
+        Description: get frame id, which is sent as frame_number when agent
+            uses compact ids
+        Input:
+            frame_index: frame_index message
+        Returns: frame id string
+        '''
+        if frame_index.frame_id:
+            return frame_index.frame_id
+        return str(frame_index.frame_number)
+
+    def _get_object_id(self, object_id, compact_id):
+        '''
+        Description: get object id string such as "car_1", which is built
+            from compact id when agent uses compact ids
+        Input:
+            object_id: object id string
+            compact_id: compact object id
+        Returns: object id string
+        '''
+        if object_id or not compact_id:
+            return object_id
+        object_class = compact_id >> OBJECT_INDEX_BITS
+        object_index = compact_id & ((1 << OBJECT_INDEX_BITS) - 1)
+        if object_class >= len(OBJECT_CLASS_NAMES):
+            object_class = 0
+        return "{}_{}".format(OBJECT_CLASS_NAMES[object_class], object_index)
+
+    def _response(self, conn, ret, message):
+        '''
+        Description: send common response
+        Input:
+            conn: a socket connection
+            ret: error code
+            message: error message
+        Returns: True if ret is kErrorNone, otherwise False
+        '''
+        msg_name = pb2._COMMONRESPONSE.full_name
+        response = pb2.CommonResponse()
+        response.ret = ret
+        response.message = message
+        self.send_message(conn, response, msg_name)
+        return ret == pb2.kErrorNone
+
     def _response_error_unknown(self, conn):
         '''
         Description: response error_unknown message
@@ -375,11 +548,7 @@ class VideoAnalysisServer(PresenterSocketServer):
             conn: a socket connection
         Returns: NA
         '''
-        msg_name = msg_name = pb2._COMMONRESPONSE.full_name
-        response = pb2.CommonResponse()
-        response.ret = pb2.kErrorOther
-        response.message = "Error unknown on Presenter Server"
-        self.send_message(conn, response, msg_name)
+        self._response(conn, pb2.kErrorOther, ERROR_UNKNOWN_MESSAGE)
 
     def _save_image(self, directory, image):
         '''
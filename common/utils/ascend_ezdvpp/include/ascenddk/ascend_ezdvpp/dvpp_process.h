@@ -91,6 +91,26 @@ class DvppProcess {
   int DvppOperationProc(const char *input_buf, int input_size,
                         DvppOutput *output_data);
 
+  /**
+   * @brief Dvpp crop or resize image into a buffer owned by the caller, such
+   *        as one image of a batch model input, so no output buffer is
+   *        allocated (only for crop or resize object)
+   * @param [in] char *input_buf: yuv data buffer
+   * @param [in] int input_size  : size of yuv data buffer
+   * @param [in] int output_size : size of output buffer, not less than
+   *             GetCropOrResizeOutputSize()
+   * @param [out] unsigned char *output_buf : output buffer
+   * @return  enum DvppErrorCode
+   */
+  int DvppCropOrResizeProc(const char *input_buf, int input_size,
+                           int output_size, unsigned char *output_buf);
+
+  /**
+   * @brief get the size of crop or resize output image
+   * @return  size in bytes, 0 if it is not a crop or resize object
+   */
+  int GetCropOrResizeOutputSize() const;
+
   /**
    * @brief Dvpp decode jpeg and change jpeg to yuv
    * @param [in] char *input_buf: jpeg data buffer
@@ -156,28 +156,7 @@ int DvppProcess::DvppOperationProc(const char *input_buf, int input_size,
     output_data->buffer = yuv_output_data;
   } else if (convert_mode_ == kCropOrResize) {  // crop or resize image
 
-    // set width of dest image
-    int dest_width = dvpp_instance_para_.crop_or_resize_para.dest_resolution
-        .width;
-
-    // set height of dest image
-    int dest_high = dvpp_instance_para_.crop_or_resize_para.dest_resolution
-        .height;
-
-    int data_size = 0;
-
-    //If output image need alignment, the memory size is calculated after width
-    // and height alignment
-    if (dvpp_instance_para_.crop_or_resize_para.is_output_align) {
-      data_size = ALIGN_UP(dest_width, kVpcWidthAlign)
-          * ALIGN_UP(dest_high, kVpcHeightAlign) *
-          DVPP_YUV420SP_SIZE_MOLECULE /
-      DVPP_YUV420SP_SIZE_DENOMINATOR;
-    } else {  // output image does not need alignment
-      data_size = dest_width * dest_high *
-      DVPP_YUV420SP_SIZE_MOLECULE /
-      DVPP_YUV420SP_SIZE_DENOMINATOR;
-    }
+    int data_size = GetCropOrResizeOutputSize();
 
     // check data size
     ret = dvpp_utils.CheckDataSize(data_size);
@@ -203,6 +182,46 @@ int DvppProcess::DvppOperationProc(const char *input_buf, int input_size,
   return ret;
 }
 
+int DvppProcess::DvppCropOrResizeProc(const char *input_buf, int input_size,
+                                      int output_size,
+                                      unsigned char *output_buf) {
+  if (convert_mode_ != kCropOrResize
+      || output_size < GetCropOrResizeOutputSize()) {
+    return kDvppErrorInvalidParameter;
+  }
+
+  // crop or resize image into the buffer of caller
+  return DvppCropOrResize(input_buf, input_size, output_size, output_buf);
+}
+
+int DvppProcess::GetCropOrResizeOutputSize() const {
+  if (convert_mode_ != kCropOrResize) {
+    return 0;
+  }
+
+  // set width of dest image
+  int dest_width = dvpp_instance_para_.crop_or_resize_para.dest_resolution
+      .width;
+
+  // set height of dest image
+  int dest_high = dvpp_instance_para_.crop_or_resize_para.dest_resolution
+      .height;
+
+  //If output image need alignment, the memory size is calculated after width
+  // and height alignment
+  if (dvpp_instance_para_.crop_or_resize_para.is_output_align) {
+    return ALIGN_UP(dest_width, kVpcWidthAlign)
+        * ALIGN_UP(dest_high, kVpcHeightAlign) *
+        DVPP_YUV420SP_SIZE_MOLECULE /
+    DVPP_YUV420SP_SIZE_DENOMINATOR;
+  }
+
+  // output image does not need alignment
+  return dest_width * dest_high *
+  DVPP_YUV420SP_SIZE_MOLECULE /
+  DVPP_YUV420SP_SIZE_DENOMINATOR;
+}
+
 int DvppProcess::DvppJpegDProc(const char *input_buf, int input_size,
                                DvppJpegDOutput *output_data) {
   int ret = kDvppOperationOk;
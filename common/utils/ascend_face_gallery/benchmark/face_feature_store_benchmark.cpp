@@ -0,0 +1,125 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_feature_store.h"
+
+using namespace std;
+
+namespace {
+const uint32_t kDefaultDim = 1024;
+
+// 100k faces of 1024 floats take 420MB of disk, 1M take 4.2GB
+const size_t kDefaultSize = 100000;
+
+const char *kDefaultPath = "face_feature_store_benchmark.bin";
+
+// share of faces removed before compaction
+const size_t kRemoveEvery = 10;
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+}
+
+/**
+ * usage: face_feature_store_benchmark [dim] [size] [path]
+ * prints the time of appends, of reopening the store, of removes and of
+ * compaction
+ */
+int main(int argc, char *argv[]) {
+  uint32_t dim = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultDim;
+  size_t size = argc > 2 ? strtoull(argv[2], nullptr, 10) : kDefaultSize;
+  string path = argc > 3 ? argv[3] : kDefaultPath;
+  remove(path.c_str());
+
+  mt19937 generator(0);
+  normal_distribution<float> distribution;
+  vector<float> feature(dim);
+  for (float &value : feature) {
+    value = distribution(generator);
+  }
+  int32_t coordinate[ascend::utils::kFaceCoordinateNumber] = { 1, 2, 3, 4 };
+
+  ascend::utils::FaceFeatureStore store;
+  if (!store.Open(path, dim)) {
+    printf("open %s failed\n", path.c_str());
+    return -1;
+  }
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (size_t id = 0; id < size; ++id) {
+    feature[0] = id;
+    if (!store.Append("face" + to_string(id), coordinate, feature.data())) {
+      printf("append failed\n");
+      return -1;
+    }
+  }
+  double append_ms = ElapsedMs(start);
+  store.Close();
+
+  start = chrono::steady_clock::now();
+  bool opened = store.Open(path, dim);
+  double open_ms = ElapsedMs(start);
+  const float *last = store.Feature("face" + to_string(size - 1));
+  bool same = opened && store.Size() == size && last != nullptr
+      && last[0] == static_cast<float>(size - 1);
+
+  start = chrono::steady_clock::now();
+  for (size_t id = 0; id < size; id += kRemoveEvery) {
+    store.Remove("face" + to_string(id));
+  }
+  double remove_ms = ElapsedMs(start);
+  size_t live_size = store.Size();
+
+  start = chrono::steady_clock::now();
+  bool compacted = store.Compact();
+  double compact_ms = ElapsedMs(start);
+  same = same && compacted && store.Size() == live_size
+      && store.tombstone_number() == 0;
+  store.Close();
+  remove(path.c_str());
+
+  printf("dim %u, faces %zu\n", dim, size);
+  printf("append: %.3f us/face\n", append_ms * 1000 / size);
+  printf("open: %.1f ms\n", open_ms);
+  printf("remove %zu faces: %.1f ms\n", size - live_size, remove_ms);
+  printf("compact: %.1f ms\n", compact_ms);
+  printf("store check: %s\n", same ? "ok" : "FAILED");
+  return same ? 0 : -1;
+}
@@ -0,0 +1,218 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+
+using namespace std;
+
+namespace {
+const uint32_t kDefaultDim = 1024;
+const uint32_t kDefaultThreadNumber = 1;
+const uint32_t kQueryNumber = 20;
+const uint32_t kTopK = 5;
+const float kThreshold = 0.0f;
+// a probe is a gallery face plus noise of this deviation
+const float kProbeNoise = 0.5f;
+
+// encodings compared against float32 rows
+const ascend::utils::FeatureEncoding kEncodings[] = {
+    ascend::utils::kFeatureFp16, ascend::utils::kFeatureInt8 };
+const char *const kEncodingNames[] = { "float32", "fp16", "int8" };
+
+// gallery sizes when none is given, 1M faces of 1024 floats need 4GB
+const size_t kDefaultSizes[] = { 10000, 100000, 1000000 };
+
+// the server matched faces this way: a cosine, norms included, per face
+float NaiveCosine(const float *lhs, const float *rhs, uint32_t dim) {
+  double dot = 0.0;
+  double lhs_norm = 0.0;
+  double rhs_norm = 0.0;
+  for (uint32_t i = 0; i < dim; ++i) {
+    dot += lhs[i] * rhs[i];
+    lhs_norm += lhs[i] * lhs[i];
+    rhs_norm += rhs[i] * rhs[i];
+  }
+  return dot / (sqrt(lhs_norm) * sqrt(rhs_norm));
+}
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// bytes of one feature sent by face_post_process in an encoding
+size_t WireSize(ascend::utils::FeatureEncoding encoding, uint32_t dim) {
+  size_t size = dim * ascend::utils::FeatureElementSize(encoding);
+  return encoding == ascend::utils::kFeatureInt8 ? size + sizeof(float)
+      : size;
+}
+
+/**
+ * @brief compare encoded galleries with the float32 one on probes
+ * @param [in] const ascend::utils::FaceGallery &reference: float32 gallery
+ * @param [in] const vector<float> &features: gallery features
+ * @param [in] uint32_t thread_number: max threads scanning one search
+ * @param [in] mt19937 &generator: random generator
+ */
+void CompareEncodings(const ascend::utils::FaceGallery &reference,
+                      const vector<float> &features, uint32_t thread_number,
+                      mt19937 &generator) {
+  uint32_t dim = reference.dim();
+  size_t size = reference.Size();
+  normal_distribution<float> distribution(0.0f, kProbeNoise);
+  uniform_int_distribution<size_t> face(0, size - 1);
+  vector<float> probes(kQueryNumber * dim);
+  for (uint32_t query = 0; query < kQueryNumber; ++query) {
+    const float *source = features.data() + face(generator) * dim;
+    for (uint32_t i = 0; i < dim; ++i) {
+      probes[query * dim + i] = source[i] + distribution(generator);
+    }
+  }
+
+  vector<vector<ascend::utils::FaceGalleryResult>> expected(kQueryNumber);
+  for (uint32_t query = 0; query < kQueryNumber; ++query) {
+    reference.Search(probes.data() + query * dim, kTopK, kThreshold,
+                     expected[query]);
+  }
+  printf("  float32: %.1f MB, %zu bytes/feature on the wire\n",
+         reference.MemorySize() / 1048576.0,
+         WireSize(ascend::utils::kFeatureFloat32, dim));
+
+  for (ascend::utils::FeatureEncoding encoding : kEncodings) {
+    ascend::utils::FaceGallery gallery(dim, thread_number, encoding);
+    for (size_t id = 0; id < size; ++id) {
+      gallery.Add(id, features.data() + id * dim);
+    }
+
+    vector<ascend::utils::FaceGalleryResult> results;
+    uint32_t same_best = 0;
+    float max_error = 0.0f;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (uint32_t query = 0; query < kQueryNumber; ++query) {
+      gallery.Search(probes.data() + query * dim, kTopK, kThreshold,
+                     results);
+      if (!results.empty() && !expected[query].empty()) {
+        same_best += results[0].id == expected[query][0].id ? 1 : 0;
+        max_error = max(max_error,
+                        fabs(results[0].score - expected[query][0].score));
+      }
+    }
+    double gallery_ms = ElapsedMs(start) / kQueryNumber;
+    printf("  %s: %.1f MB, %zu bytes/feature on the wire, %.3f ms/query, "
+           "same best match %u/%u, max score error %.5f\n",
+           kEncodingNames[encoding], gallery.MemorySize() / 1048576.0,
+           WireSize(encoding, dim), gallery_ms, same_best, kQueryNumber,
+           max_error);
+  }
+}
+}
+
+/**
+ * usage: face_gallery_benchmark [dim] [thread_number] [size ...]
+ * prints the time of one query against a naive cosine scan, then the
+ * memory, speed and accuracy of fp16 and int8 rows against float32 rows
+ */
+int main(int argc, char *argv[]) {
+  uint32_t dim = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultDim;
+  uint32_t thread_number =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultThreadNumber;
+  vector<size_t> sizes;
+  for (int i = 3; i < argc; ++i) {
+    sizes.push_back(strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes.assign(begin(kDefaultSizes), end(kDefaultSizes));
+  }
+  if (dim == 0) {
+    printf("dim must be positive\n");
+    return -1;
+  }
+
+  mt19937 generator(0);
+  normal_distribution<float> distribution;
+  vector<float> queries(kQueryNumber * dim);
+  for (float &value : queries) {
+    value = distribution(generator);
+  }
+
+  printf("dim %u, threads %u, top %u\n", dim, thread_number, kTopK);
+  for (size_t size : sizes) {
+    ascend::utils::FaceGallery gallery(dim, thread_number);
+    vector<float> features(size * dim);
+    for (float &value : features) {
+      value = distribution(generator);
+    }
+    for (size_t id = 0; id < size; ++id) {
+      gallery.Add(id, features.data() + id * dim);
+    }
+
+    vector<ascend::utils::FaceGalleryResult> results;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (uint32_t query = 0; query < kQueryNumber; ++query) {
+      gallery.Search(queries.data() + query * dim, kTopK, kThreshold,
+                     results);
+    }
+    double gallery_ms = ElapsedMs(start) / kQueryNumber;
+
+    float best_score = -1.0f;
+    size_t best_id = 0;
+    start = chrono::steady_clock::now();
+    for (uint32_t query = 0; query < kQueryNumber; ++query) {
+      best_score = -1.0f;
+      for (size_t id = 0; id < size; ++id) {
+        float score = NaiveCosine(queries.data() + query * dim,
+                                  features.data() + id * dim, dim);
+        if (score > best_score) {
+          best_score = score;
+          best_id = id;
+        }
+      }
+    }
+    double naive_ms = ElapsedMs(start) / kQueryNumber;
+
+    bool same_best = !results.empty() && results[0].id == best_id;
+    printf("faces %zu: gallery %.3f ms/query, naive %.3f ms/query, "
+           "speedup %.1fx, same best match: %s\n",
+           size, gallery_ms, naive_ms, naive_ms / gallery_ms,
+           same_best ? "yes" : "no");
+    CompareEncodings(gallery, features, thread_number, generator);
+  }
+  return 0;
+}
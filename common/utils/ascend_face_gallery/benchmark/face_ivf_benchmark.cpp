@@ -0,0 +1,191 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+#include "ascenddk/ascend_face_gallery/face_ivf_index.h"
+
+using namespace std;
+
+namespace {
+const uint32_t kDefaultDim = 1024;
+const size_t kDefaultSize = 100000;
+const uint32_t kDefaultListNumber = 256;
+const uint32_t kQueryNumber = 100;
+const uint32_t kTopK = 5;
+
+// probe numbers compared against the exact search
+const uint32_t kProbeNumbers[] = { 1, 4, 8, 16, 32 };
+
+// synthetic faces are noisy shots of people, kTopK shots per person on
+// average, so that the exact top k are mostly shots of the query person
+const size_t kFacesPerPerson = kTopK;
+const float kShotNoise = 0.5f;
+
+const char *kIndexFile = "face_ivf_benchmark.index";
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// share of the exact top k ids found by the approximate search
+double Recall(const vector<ascend::utils::FaceGalleryResult> &exact,
+              const vector<ascend::utils::FaceGalleryResult> &approximate) {
+  if (exact.empty()) {
+    return 1.0;
+  }
+  size_t found = 0;
+  for (const ascend::utils::FaceGalleryResult &result : exact) {
+    for (const ascend::utils::FaceGalleryResult &candidate : approximate) {
+      if (candidate.id == result.id) {
+        ++found;
+        break;
+      }
+    }
+  }
+  return static_cast<double>(found) / exact.size();
+}
+}
+
+/**
+ * usage: face_ivf_benchmark [dim] [size] [list_number]
+ * builds the index with Add training it as faces come, prints the slowest
+ * Add, and recall@k and time of one query per probe number against the
+ * exact gallery. then prints how long a FaceIvfTrainer keeps the index
+ * locked, and checks that a saved index loads back the same
+ */
+int main(int argc, char *argv[]) {
+  uint32_t dim = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultDim;
+  size_t size = argc > 2 ? strtoull(argv[2], nullptr, 10) : kDefaultSize;
+  uint32_t list_number =
+      argc > 3 ? strtoul(argv[3], nullptr, 10) : kDefaultListNumber;
+  if (dim == 0 || size == 0) {
+    printf("dim and size must be positive\n");
+    return -1;
+  }
+
+  mt19937 generator(0);
+  normal_distribution<float> distribution;
+  size_t person_number = max(size / kFacesPerPerson, static_cast<size_t>(1));
+  vector<float> people(person_number * dim);
+  for (float &value : people) {
+    value = distribution(generator);
+  }
+  uniform_int_distribution<size_t> random_person(0, person_number - 1);
+  vector<float> face(dim);
+  auto make_face = [&]() {
+    const float *person = &people[random_person(generator) * dim];
+    for (uint32_t i = 0; i < dim; ++i) {
+      face[i] = person[i] + kShotNoise * distribution(generator);
+    }
+  };
+
+  ascend::utils::FaceGallery gallery(dim);
+  ascend::utils::FaceIvfIndex index(dim, list_number, 1);
+  chrono::steady_clock::time_point start;
+  double build_ms = 0.0;
+  double slowest_add_ms = 0.0;
+  for (size_t id = 0; id < size; ++id) {
+    make_face();
+    gallery.Add(id, face.data());
+    start = chrono::steady_clock::now();
+    index.Add(id, face.data());
+    double add_ms = ElapsedMs(start);
+    build_ms += add_ms;
+    slowest_add_ms = max(slowest_add_ms, add_ms);
+  }
+  // the slowest Add is the one training the index
+  printf("dim %u, faces %zu, lists %u, top %u, build %.0f ms, "
+         "slowest add %.0f ms, trained %s\n", dim, size, list_number, kTopK,
+         build_ms, slowest_add_ms, index.trained() ? "yes" : "no");
+
+  vector<float> queries(kQueryNumber * dim);
+  vector<vector<ascend::utils::FaceGalleryResult>> exact(kQueryNumber);
+  start = chrono::steady_clock::now();
+  for (uint32_t query = 0; query < kQueryNumber; ++query) {
+    make_face();
+    copy(face.begin(), face.end(), queries.begin() + query * dim);
+    gallery.Search(&queries[query * dim], kTopK, -1.0f, exact[query]);
+  }
+  printf("exact: %.3f ms/query\n", ElapsedMs(start) / kQueryNumber);
+
+  vector<ascend::utils::FaceGalleryResult> results;
+  for (uint32_t probe_number : kProbeNumbers) {
+    index.set_probe_number(probe_number);
+    double recall = 0.0;
+    double search_ms = 0.0;
+    for (uint32_t query = 0; query < kQueryNumber; ++query) {
+      start = chrono::steady_clock::now();
+      index.Search(&queries[query * dim], kTopK, -1.0f, results);
+      search_ms += ElapsedMs(start);
+      recall += Recall(exact[query], results);
+    }
+    printf("ivf probe %u: %.3f ms/query, recall@%u %.3f\n", probe_number,
+           search_ms / kQueryNumber, kTopK, recall / kQueryNumber);
+  }
+
+  // the presenter server trains this way, holding its lock only while the
+  // trainer samples the faces and applies the centroids
+  start = chrono::steady_clock::now();
+  ascend::utils::FaceIvfTrainer trainer(index);
+  double sample_ms = ElapsedMs(start);
+  start = chrono::steady_clock::now();
+  bool trained = trainer.Run();
+  double run_ms = ElapsedMs(start);
+  start = chrono::steady_clock::now();
+  trained = trained && trainer.Apply(index);
+  double apply_ms = ElapsedMs(start);
+  printf("trainer: sample %.0f ms, run %.0f ms, apply %.0f ms, "
+         "trained %s\n", sample_ms, run_ms, apply_ms,
+         trained ? "yes" : "no");
+
+  index.set_probe_number(1);
+  ascend::utils::FaceIvfIndex loaded_index(dim, list_number, 1);
+  vector<ascend::utils::FaceGalleryResult> loaded_results;
+  bool same = index.Save(kIndexFile) && loaded_index.Load(kIndexFile)
+      && loaded_index.Size() == index.Size();
+  for (uint32_t query = 0; same && query < kQueryNumber; ++query) {
+    index.Search(&queries[query * dim], kTopK, -1.0f, results);
+    loaded_index.Search(&queries[query * dim], kTopK, -1.0f, loaded_results);
+    same = Recall(results, loaded_results) == 1.0;
+  }
+  remove(kIndexFile);
+  printf("save and load: %s\n", same ? "same results" : "FAILED");
+  return same ? 0 : -1;
+}
@@ -0,0 +1,246 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FACE_FEATURE_STORE_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FACE_FEATURE_STORE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace ascend {
+namespace utils {
+
+// bytes of the store file header
+const uint32_t kFaceStoreHeaderSize = 64;
+
+// max bytes of a face name in the store
+const uint32_t kFaceNameSize = 64;
+
+// number of face box coordinates: lt_x, lt_y, rb_x, rb_y
+const uint32_t kFaceCoordinateNumber = 4;
+
+// state of a store record
+enum FaceRecordState {
+  kFaceRecordEmpty = 0,
+  kFaceRecordLive = 1,
+  kFaceRecordTombstone = 2,
+};
+
+/**
+ * append-only face feature store in one memory mapped file.
+ *
+ * file layout, little endian:
+ *   header, kFaceStoreHeaderSize bytes: uint32 magic "FFST", uint32
+ *     version, uint32 dim, uint32 record size, uint64 record number,
+ *     then zeros
+ *   records of record size bytes each: uint32 state, uint32 name length,
+ *     char name[kFaceNameSize], int32 coordinate[kFaceCoordinateNumber],
+ *     float feature[dim], then zeros up to a multiple of 64 bytes
+ *
+ * a record is written before the record number in the header is raised,
+ * so an interrupted append is never read back. registering a face appends
+ * one record and tombstones the previous record of the same name, removing
+ * it only writes the tombstone, so neither rewrites the file. Compact
+ * drops the tombstones. the file may be longer than its records, it grows
+ * by doubling to avoid remapping on every append.
+ *
+ * the presenter server uses the store through the C interface below, and
+ * reads and writes the same layout with numpy when the library is not
+ * installed, see facial_recognition/src/face_feature_store.py. calls must
+ * be serialized by the caller.
+ */
+class FaceFeatureStore {
+ public:
+  FaceFeatureStore();
+
+  ~FaceFeatureStore();
+
+  FaceFeatureStore(const FaceFeatureStore &) = delete;
+  FaceFeatureStore &operator=(const FaceFeatureStore &) = delete;
+
+  /**
+   * @brief open a store file, it is created if it does not exist
+   * @param [in] const std::string &path: file path
+   * @param [in] uint32_t dim: length of feature vector
+   * @return  true: success; false: open failed or the file is not a store
+   *          of dim features
+   */
+  bool Open(const std::string &path, uint32_t dim);
+
+  /**
+   * @brief unmap and close the store file
+   */
+  void Close();
+
+  /**
+   * @brief append a face, the face of the same name is replaced
+   * @param [in] const std::string &name: face name, at most kFaceNameSize
+   *             bytes
+   * @param [in] const int32_t *coordinate: kFaceCoordinateNumber values
+   * @param [in] const float *feature: feature vector of dim floats
+   * @return  true: success; false: invalid input or write failed
+   */
+  bool Append(const std::string &name, const int32_t *coordinate,
+              const float *feature);
+
+  /**
+   * @brief tombstone a face
+   * @param [in] const std::string &name: face name
+   * @return  true: removed; false: no such face
+   */
+  bool Remove(const std::string &name);
+
+  /**
+   * @brief rewrite the store without tombstones
+   * @return  true: success; false: write failed, the store is unchanged
+   */
+  bool Compact();
+
+  /**
+   * @brief feature of a face
+   * @param [in] const std::string &name: face name
+   * @return  feature vector of dim floats, nullptr if there is no such face.
+   *          it is valid until the next Append, Compact or Close
+   */
+  const float *Feature(const std::string &name) const;
+
+  /**
+   * @brief face box of a face
+   * @param [in] const std::string &name: face name
+   * @return  kFaceCoordinateNumber values, nullptr if there is no such face.
+   *          it is valid until the next Append, Compact or Close
+   */
+  const int32_t *Coordinate(const std::string &name) const;
+
+  /**
+   * @brief call a function on every live face
+   * @param [in] function: called with name, coordinate and feature
+   */
+  void ForEach(const std::function<void(const std::string &,
+                                        const int32_t *,
+                                        const float *)> &function) const;
+
+  /**
+   * @brief number of live faces
+   */
+  size_t Size() const {
+    return slots_.size();
+  }
+
+  /**
+   * @brief length of feature vector
+   */
+  uint32_t dim() const {
+    return dim_;
+  }
+
+  /**
+   * @brief number of tombstoned records
+   */
+  uint64_t tombstone_number() const {
+    return record_number_ - slots_.size();
+  }
+
+ private:
+  /**
+   * @brief map the file with room for a number of records
+   * @param [in] uint64_t capacity: number of records
+   * @return  true: success; false: resize or map failed
+   */
+  bool Map(uint64_t capacity);
+
+  /**
+   * @brief address of a record
+   */
+  uint8_t *Record(uint64_t slot) const;
+
+  /**
+   * @brief write the record number to the header
+   */
+  void SetRecordNumber(uint64_t record_number);
+
+  std::string path_;
+  int fd_;
+  uint8_t *data_;
+  size_t mapped_size_;
+  uint32_t dim_;
+  uint32_t record_size_;
+  uint64_t record_number_;
+  uint64_t capacity_;
+
+  // record slot of each live face
+  std::unordered_map<std::string, uint64_t> slots_;
+};
+
+}
+}
+
+/**
+ * C interface for the presenter server, see the FaceGallery one.
+ * a store handle is an open FaceFeatureStore pointer, names are utf-8.
+ */
+extern "C" {
+// returns null if the file can not be opened as a store of dim features
+void *FaceFeatureStoreOpen(const char *path, uint32_t dim);
+
+// closes the file and frees the handle
+void FaceFeatureStoreClose(void *store);
+
+// returns 0 on success, -1 if the input is invalid or write failed
+int FaceFeatureStoreAppend(void *store, const char *name,
+                           const int32_t *coordinate, const float *feature);
+
+// returns 0 on success, -1 if there is no such face
+int FaceFeatureStoreRemove(void *store, const char *name);
+
+// returns 0 on success, -1 on failure
+int FaceFeatureStoreCompact(void *store);
+
+uint64_t FaceFeatureStoreSize(const void *store);
+
+uint64_t FaceFeatureStoreTombstoneNumber(const void *store);
+
+// fills the names of at most max_number live faces, kFaceNameSize bytes
+// each padded with zeros, returns the number of names
+uint64_t FaceFeatureStoreNames(const void *store, char *names,
+                               uint64_t max_number);
+
+// copies the face box and the feature of a face, either output may be
+// null, returns 0 on success, -1 if there is no such face
+int FaceFeatureStoreRead(const void *store, const char *name,
+                         int32_t *coordinate, float *feature);
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FACE_FEATURE_STORE_H_ */
@@ -0,0 +1,211 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/feature_codec.h"
+
+namespace ascend {
+namespace utils {
+
+// one matched face of a search
+struct FaceGalleryResult {
+  uint32_t id;  // id given when the face was added
+  float score;  // cosine similarity between the query and the face
+};
+
+/**
+ * gallery of registered face features for cosine similarity search.
+ * features are normalized when they are added and kept in one row major
+ * float matrix, so a search is a plain dot product of the normalized query
+ * with every row (AVX2 or NEON when available), and the best faces are
+ * kept in a top-k heap. large galleries are scanned by several threads.
+ * rows may be kept as fp16 or int8 to halve or quarter the memory and the
+ * bandwidth of a scan, an int8 search quantizes the query too and scores
+ * with integer dot products.
+ *
+ * Search may be called from several threads at the same time, Add, Remove
+ * and Clear must be serialized with any other call by the caller.
+ */
+class FaceGallery {
+ public:
+  /**
+   * @brief class constructor
+   * @param [in] uint32_t dim: length of feature vector
+   * @param [in] uint32_t thread_number: max threads scanning one search
+   * @param [in] FeatureEncoding encoding: encoding of the stored rows
+   */
+  FaceGallery(uint32_t dim, uint32_t thread_number = 1,
+              FeatureEncoding encoding = kFeatureFloat32);
+
+  /**
+   * @brief add a face, the face of the same id is replaced
+   * @param [in] uint32_t id: face id
+   * @param [in] const float *feature: feature vector of dim floats
+   * @return  true: success; false: feature is null or a zero vector
+   */
+  bool Add(uint32_t id, const float *feature);
+
+  /**
+   * @brief remove a face
+   * @param [in] uint32_t id: face id
+   * @return  true: removed; false: no such face
+   */
+  bool Remove(uint32_t id);
+
+  /**
+   * @brief remove all faces
+   */
+  void Clear();
+
+  /**
+   * @brief search the faces most similar to a query feature
+   * @param [in] const float *query: feature vector of dim floats
+   * @param [in] uint32_t top_k: max number of results
+   * @param [in] float threshold: faces scoring below it are not returned
+   * @param [out] std::vector<FaceGalleryResult> &results: results, the
+   *              highest score first
+   */
+  void Search(const float *query, uint32_t top_k, float threshold,
+              std::vector<FaceGalleryResult> &results) const;
+
+  /**
+   * @brief number of faces in the gallery
+   */
+  size_t Size() const {
+    return ids_.size();
+  }
+
+  /**
+   * @brief length of feature vector
+   */
+  uint32_t dim() const {
+    return dim_;
+  }
+
+  /**
+   * @brief encoding of the stored rows
+   */
+  FeatureEncoding encoding() const {
+    return encoding_;
+  }
+
+  /**
+   * @brief bytes taken by the stored rows and their scales
+   */
+  size_t MemorySize() const {
+    return matrix_.size() + scales_.size() * sizeof(float);
+  }
+
+ private:
+  // normalized query in the encoding of the rows
+  struct EncodedQuery {
+    std::vector<float> row;  // float32 and fp16 galleries
+    std::vector<int8_t> codes;  // int8 galleries
+    float scale;  // scale of codes
+  };
+
+  /**
+   * @brief score of one row
+   * @param [in] const EncodedQuery &query: encoded query
+   * @param [in] size_t index: row
+   * @return  cosine similarity
+   */
+  float RowScore(const EncodedQuery &query, size_t index) const;
+
+  /**
+   * @brief scan rows [begin, end) and keep the top k in a min heap
+   * @param [in] const EncodedQuery &query: encoded query
+   * @param [in] size_t begin: first row
+   * @param [in] size_t end: row after the last one
+   * @param [in] uint32_t top_k: heap size
+   * @param [in] float threshold: min score
+   * @param [out] std::vector<FaceGalleryResult> &heap: min heap of results
+   */
+  void ScanRows(const EncodedQuery &query, size_t begin, size_t end,
+                uint32_t top_k, float threshold,
+                std::vector<FaceGalleryResult> &heap) const;
+
+  uint32_t dim_;
+  // row length in floats, dim_ rounded up to a whole number of simd blocks
+  uint32_t stride_;
+  uint32_t thread_number_;
+  FeatureEncoding encoding_;
+  // bytes of one encoded row
+  size_t row_bytes_;
+
+  // encoded normalized features, one row of stride_ elements per face
+  std::vector<uint8_t> matrix_;
+  // int8 scale of each row, empty for the other encodings
+  std::vector<float> scales_;
+  // face id of each row
+  std::vector<uint32_t> ids_;
+  // row of each face id
+  std::unordered_map<uint32_t, size_t> rows_;
+};
+
+}
+}
+
+/**
+ * C interface for the presenter server, which loads the library with
+ * python ctypes. a gallery handle is a FaceGallery pointer.
+ */
+extern "C" {
+// encoding is a FeatureEncoding value, returns null if it is unknown
+void *FaceGalleryCreate(uint32_t dim, uint32_t thread_number,
+                        uint32_t encoding);
+
+void FaceGalleryDestroy(void *gallery);
+
+// returns 0 on success, -1 if the feature is invalid
+int FaceGalleryAdd(void *gallery, uint32_t id, const float *feature);
+
+// returns 0 on success, -1 if there is no such face
+int FaceGalleryRemove(void *gallery, uint32_t id);
+
+void FaceGalleryClear(void *gallery);
+
+uint32_t FaceGallerySize(const void *gallery);
+
+// fills at most top_k ids and scores, returns the number of results
+uint32_t FaceGallerySearch(const void *gallery, const float *query,
+                           uint32_t top_k, float threshold, uint32_t *ids,
+                           float *scores);
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_H_ */
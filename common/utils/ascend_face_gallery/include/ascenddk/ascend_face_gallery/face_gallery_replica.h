@@ -0,0 +1,123 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_REPLICA_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_REPLICA_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+
+namespace ascend {
+namespace utils {
+
+// length of face feature vector
+const uint32_t kReplicaFeatureDim = 1024;
+
+// name of a face which matches no registered face
+const std::string kUnknownFaceName = "Unknown";
+
+// one face of a gallery update
+struct FaceGalleryUpdate {
+  std::string name;  // name of the face
+  std::vector<float> feature;  // feature vector, empty removes the face
+};
+
+/**
+ * copy of the registered faces of presenter server, kept in sync by the
+ * gallery sync messages so that camera faces are matched on device. The
+ * engine receiving the messages and the engine matching faces share the
+ * instance of this library, so it is defined in one translation unit
+ * instead of each engine library.
+ */
+class FaceGalleryReplica {
+ public:
+  /**
+   * @brief get the instance shared by all engines of the process
+   */
+  static FaceGalleryReplica& GetInstance();
+
+  /**
+   * @brief apply a gallery update of presenter server
+   * @param [in] bool reset: remove all faces before the update
+   * @param [in] float threshold: min similarity of a matched face, kept
+   *             unchanged when not positive
+   * @param [in] const std::vector<FaceGalleryUpdate> &faces: faces without
+   *             feature are removed, the others are added or replaced
+   */
+  void Apply(bool reset, float threshold,
+             const std::vector<FaceGalleryUpdate> &faces);
+
+  /**
+   * @brief match a face feature with the registered faces
+   * @param [in] const std::vector<float> &feature: face feature vector
+   * @param [out] std::string &name: name of the best face, kUnknownFaceName
+   *              if no face reaches the threshold
+   * @param [out] float &score: similarity of the best face
+   * @return  true: matched; false: no gallery synced or invalid feature
+   */
+  bool Match(const std::vector<float> &feature, std::string &name,
+             float &score);
+
+ private:
+  FaceGalleryReplica();
+
+  std::mutex mutex_;
+
+  // registered faces, searched by id
+  FaceGallery gallery_;
+
+  // gallery id of each face name and the reverse
+  std::unordered_map<std::string, uint32_t> ids_;
+  std::unordered_map<uint32_t, std::string> names_;
+
+  // id given to the next new face
+  uint32_t next_id_;
+
+  // min similarity of a matched face, updated by presenter server
+  float threshold_;
+
+  // true once presenter server sent the gallery
+  bool synced_;
+
+  // results of the last search, kept to reuse the buffer
+  std::vector<FaceGalleryResult> results_;
+};
+
+}  // namespace utils
+}  // namespace ascend
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FACE_GALLERY_REPLICA_H_ */
@@ -0,0 +1,293 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FACE_IVF_INDEX_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FACE_IVF_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+
+namespace ascend {
+namespace utils {
+
+// default number of faces per list needed for training
+const uint32_t kIvfTrainFactor = 39;
+
+class FaceIvfTrainer;
+
+/**
+ * approximate face search with an inverted file (IVF) index.
+ * normalized features are clustered around list_number centroids by
+ * spherical k-means, and a search only scans the faces of the probe_number
+ * lists whose centroids are nearest to the query, instead of every face.
+ *
+ * until enough faces are added to train the centroids, all faces are kept
+ * in one list and a search is exact. NeedsTraining tells when the index
+ * holds train_factor faces per list, and again each time it has doubled
+ * since the last training; later faces are added to the nearest list.
+ * with auto_train, Add trains the index itself, which takes the whole
+ * k-means time. a caller serializing the calls with a lock can instead
+ * train with a FaceIvfTrainer, which only needs the lock to sample the
+ * faces and to rebuild the lists.
+ *
+ * Search may be called from several threads at the same time, other calls
+ * must be serialized with any other call by the caller.
+ */
+class FaceIvfIndex {
+ public:
+  /**
+   * @brief class constructor
+   * @param [in] uint32_t dim: length of feature vector
+   * @param [in] uint32_t list_number: number of inverted lists
+   * @param [in] uint32_t probe_number: lists scanned by one search
+   * @param [in] uint32_t train_factor: faces per list needed for training
+   * @param [in] bool auto_train: whether Add trains the index when needed
+   */
+  FaceIvfIndex(uint32_t dim, uint32_t list_number, uint32_t probe_number,
+               uint32_t train_factor = kIvfTrainFactor,
+               bool auto_train = true);
+
+  /**
+   * @brief add a face, the face of the same id is replaced
+   * @param [in] uint32_t id: face id
+   * @param [in] const float *feature: feature vector of dim floats
+   * @return  true: success; false: feature is null or a zero vector
+   */
+  bool Add(uint32_t id, const float *feature);
+
+  /**
+   * @brief remove a face
+   * @param [in] uint32_t id: face id
+   * @return  true: removed; false: no such face
+   */
+  bool Remove(uint32_t id);
+
+  /**
+   * @brief remove all faces and the trained centroids
+   */
+  void Clear();
+
+  /**
+   * @brief whether the index has enough new faces to be trained
+   */
+  bool NeedsTraining() const;
+
+  /**
+   * @brief cluster the faces in the index and rebuild the lists
+   * @return  true: trained; false: fewer faces than lists
+   */
+  bool Train();
+
+  /**
+   * @brief search the faces most similar to a query feature
+   * @param [in] const float *query: feature vector of dim floats
+   * @param [in] uint32_t top_k: max number of results
+   * @param [in] float threshold: faces scoring below it are not returned
+   * @param [out] std::vector<FaceGalleryResult> &results: results, the
+   *              highest score first
+   */
+  void Search(const float *query, uint32_t top_k, float threshold,
+              std::vector<FaceGalleryResult> &results) const;
+
+  /**
+   * @brief write the index to a file
+   * @param [in] const std::string &path: file path
+   * @return  true: success; false: write failed
+   */
+  bool Save(const std::string &path) const;
+
+  /**
+   * @brief replace the index by one written by Save, the probe number of
+   *        this index is kept
+   * @param [in] const std::string &path: file path
+   * @return  true: success; false: read failed or the file does not
+   *          match the dim of this index, which is then left unchanged
+   */
+  bool Load(const std::string &path);
+
+  /**
+   * @brief number of faces in the index
+   */
+  size_t Size() const {
+    return locations_.size();
+  }
+
+  /**
+   * @brief whether the centroids are trained
+   */
+  bool trained() const {
+    return !centroids_.empty();
+  }
+
+  /**
+   * @brief set the number of lists scanned by one search
+   */
+  void set_probe_number(uint32_t probe_number) {
+    probe_number_ = probe_number;
+  }
+
+ private:
+  friend class FaceIvfTrainer;
+
+  // faces of one centroid
+  struct InvertedList {
+    std::vector<float> rows;  // normalized features, stride_ floats each
+    std::vector<uint32_t> ids;  // face id of each row
+  };
+
+  /**
+   * @brief find the list whose centroid is nearest to a row
+   * @param [in] const float *row: normalized row
+   * @return  list index
+   */
+  uint32_t NearestList(const float *row) const;
+
+  /**
+   * @brief append a normalized row to a list
+   * @param [in] uint32_t list: list index
+   * @param [in] uint32_t id: face id
+   * @param [in] const float *row: normalized row
+   */
+  void AppendRow(uint32_t list, uint32_t id, const float *row);
+
+  uint32_t dim_;
+  // row length in floats, dim_ rounded up to a whole number of simd blocks
+  uint32_t stride_;
+  uint32_t list_number_;
+  uint32_t probe_number_;
+  uint32_t train_factor_;
+  bool auto_train_;
+  // number of faces when the index was last trained
+  size_t trained_size_;
+
+  // list_number_ rows of centroids, empty until trained
+  std::vector<float> centroids_;
+  // one list per centroid, or a single list until trained
+  std::vector<InvertedList> lists_;
+  // list and row of each face id
+  std::unordered_map<uint32_t, std::pair<uint32_t, size_t>> locations_;
+};
+
+/**
+ * trains the centroids of a FaceIvfIndex in three steps, only the first
+ * and the last one read or change the index:
+ * the constructor copies a sample of the faces, Run clusters them, and
+ * Apply moves the faces of the index to the lists of the new centroids.
+ */
+class FaceIvfTrainer {
+ public:
+  /**
+   * @brief class constructor, samples the faces of an index
+   * @param [in] const FaceIvfIndex &index: index to train
+   */
+  explicit FaceIvfTrainer(const FaceIvfIndex &index);
+
+  /**
+   * @brief cluster the sampled faces
+   * @return  true: trained; false: fewer faces than lists
+   */
+  bool Run();
+
+  /**
+   * @brief rebuild the lists of an index around the trained centroids
+   * @param [in] FaceIvfIndex &index: index to change, the sampled one
+   * @return  true: success; false: Run did not succeed or the index has
+   *          another dim or list number
+   */
+  bool Apply(FaceIvfIndex &index) const;
+
+ private:
+  uint32_t dim_;
+  uint32_t stride_;
+  uint32_t list_number_;
+  // sampled normalized rows, stride_ floats each
+  std::vector<float> samples_;
+  // list_number_ rows of centroids, empty until Run succeeds
+  std::vector<float> centroids_;
+};
+
+}
+}
+
+/**
+ * C interface for the presenter server, see the FaceGallery one.
+ * an index handle is a FaceIvfIndex pointer, an index created here does
+ * not train itself, a trainer handle is a FaceIvfTrainer pointer.
+ */
+extern "C" {
+void *FaceIvfIndexCreate(uint32_t dim, uint32_t list_number,
+                         uint32_t probe_number);
+
+void FaceIvfIndexDestroy(void *index);
+
+// returns 0 on success, -1 if the feature is invalid
+int FaceIvfIndexAdd(void *index, uint32_t id, const float *feature);
+
+// returns 0 on success, -1 if there is no such face
+int FaceIvfIndexRemove(void *index, uint32_t id);
+
+void FaceIvfIndexClear(void *index);
+
+uint32_t FaceIvfIndexSize(const void *index);
+
+// fills at most top_k ids and scores, returns the number of results
+uint32_t FaceIvfIndexSearch(const void *index, const float *query,
+                            uint32_t top_k, float threshold, uint32_t *ids,
+                            float *scores);
+
+// returns 0 on success, -1 on failure
+int FaceIvfIndexSave(const void *index, const char *path);
+
+// returns 0 on success, -1 on failure
+int FaceIvfIndexLoad(void *index, const char *path);
+
+// returns 1 if the index has enough new faces to be trained, otherwise 0
+int FaceIvfIndexNeedsTraining(const void *index);
+
+// samples the faces of an index, returns null on failure
+void *FaceIvfTrainerCreate(const void *index);
+
+void FaceIvfTrainerDestroy(void *trainer);
+
+// clusters the samples without the index, returns 0 on success, -1 if
+// there are fewer samples than lists
+int FaceIvfTrainerRun(void *trainer);
+
+// returns 0 on success, -1 on failure
+int FaceIvfTrainerApply(const void *trainer, void *index);
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FACE_IVF_INDEX_H_ */
@@ -0,0 +1,111 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_CODEC_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ascend {
+namespace utils {
+
+// encoding of feature vectors, the values match FeatureEncoding of
+// facial_recognition_message.proto
+enum FeatureEncoding {
+  kFeatureFloat32 = 0,  // 4 bytes per element
+  kFeatureFp16 = 1,  // IEEE half, 2 bytes per element
+  kFeatureInt8 = 2,  // element / scale rounded to int8, scale per vector
+};
+
+/**
+ * @brief bytes of one encoded element
+ * @param [in] FeatureEncoding encoding: feature encoding
+ * @return  element size
+ */
+size_t FeatureElementSize(FeatureEncoding encoding);
+
+/**
+ * @brief convert a float to IEEE half, rounding to nearest even
+ * @param [in] float value: value
+ * @return  half bits
+ */
+uint16_t FloatToHalf(float value);
+
+/**
+ * @brief convert IEEE half to float
+ * @param [in] uint16_t half: half bits
+ * @return  value
+ */
+float HalfToFloat(uint16_t half);
+
+/**
+ * @brief encode a feature as halves
+ * @param [in] const float *feature: feature vector of dim floats
+ * @param [in] uint32_t dim: length of feature vector
+ * @param [out] uint16_t *codes: dim halves
+ */
+void EncodeFp16(const float *feature, uint32_t dim, uint16_t *codes);
+
+/**
+ * @brief decode a feature encoded by EncodeFp16
+ * @param [in] const uint16_t *codes: dim halves
+ * @param [in] uint32_t dim: length of feature vector
+ * @param [out] float *feature: feature vector of dim floats
+ */
+void DecodeFp16(const uint16_t *codes, uint32_t dim, float *feature);
+
+/**
+ * @brief encode a feature as int8 with one scale, the largest element
+ *        maps to +-127
+ * @param [in] const float *feature: feature vector of dim floats
+ * @param [in] uint32_t dim: length of feature vector
+ * @param [out] int8_t *codes: dim codes
+ * @return  scale, a code times it is the element. 0 for a zero vector
+ */
+float EncodeInt8(const float *feature, uint32_t dim, int8_t *codes);
+
+/**
+ * @brief decode a feature encoded by EncodeInt8
+ * @param [in] const int8_t *codes: dim codes
+ * @param [in] uint32_t dim: length of feature vector
+ * @param [in] float scale: scale returned by EncodeInt8
+ * @param [out] float *feature: feature vector of dim floats
+ */
+void DecodeInt8(const int8_t *codes, uint32_t dim, float scale,
+                float *feature);
+
+}
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_CODEC_H_ */
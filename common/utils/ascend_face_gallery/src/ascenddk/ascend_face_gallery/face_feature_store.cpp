@@ -0,0 +1,452 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_feature_store.h"
+
+using namespace std;
+
+namespace {
+// "FFST" and version of the store file
+const uint32_t kStoreFileMagic = 0x54534646;
+const uint32_t kStoreFileVersion = 1;
+
+// offsets in the header
+const size_t kHeaderMagicOffset = 0;
+const size_t kHeaderVersionOffset = 4;
+const size_t kHeaderDimOffset = 8;
+const size_t kHeaderRecordSizeOffset = 12;
+const size_t kHeaderRecordNumberOffset = 16;
+
+// offsets in a record
+const size_t kRecordStateOffset = 0;
+const size_t kRecordNameLengthOffset = 4;
+const size_t kRecordNameOffset = 8;
+const size_t kRecordCoordinateOffset =
+    kRecordNameOffset + ascend::utils::kFaceNameSize;
+const size_t kRecordFeatureOffset = kRecordCoordinateOffset
+    + ascend::utils::kFaceCoordinateNumber * sizeof(int32_t);
+
+// records are padded to a multiple of this
+const uint32_t kRecordAlignment = 64;
+
+// records mapped when a store is opened, the mapping doubles when full
+const uint64_t kMinCapacity = 64;
+
+// suffix of the file written by Compact before it replaces the store
+const char *kCompactSuffix = ".compact";
+
+uint32_t RecordSize(uint32_t dim) {
+  size_t size = kRecordFeatureOffset + dim * sizeof(float);
+  return (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+template<typename T>
+T LoadValue(const uint8_t *address) {
+  T value;
+  memcpy(&value, address, sizeof(T));
+  return value;
+}
+
+template<typename T>
+void StoreValue(uint8_t *address, T value) {
+  memcpy(address, &value, sizeof(T));
+}
+
+// write a whole buffer to a file descriptor
+bool WriteAll(int fd, const uint8_t *buffer, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, buffer, size);
+    if (written <= 0) {
+      return false;
+    }
+    buffer += written;
+    size -= written;
+  }
+  return true;
+}
+}
+
+namespace ascend {
+namespace utils {
+FaceFeatureStore::FaceFeatureStore()
+    : fd_(-1),
+      data_(nullptr),
+      mapped_size_(0),
+      dim_(0),
+      record_size_(0),
+      record_number_(0),
+      capacity_(0) {
+}
+
+FaceFeatureStore::~FaceFeatureStore() {
+  Close();
+}
+
+void FaceFeatureStore::Close() {
+  if (data_ != nullptr) {
+    munmap(data_, mapped_size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  mapped_size_ = 0;
+  record_number_ = 0;
+  capacity_ = 0;
+  slots_.clear();
+}
+
+bool FaceFeatureStore::Map(uint64_t capacity) {
+  size_t size = kFaceStoreHeaderSize + capacity * record_size_;
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0
+      || (static_cast<size_t>(file_stat.st_size) < size
+          && ftruncate(fd_, size) != 0)) {
+    return false;
+  }
+
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+                    0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  if (data_ != nullptr) {
+    munmap(data_, mapped_size_);
+  }
+  data_ = static_cast<uint8_t *>(data);
+  mapped_size_ = size;
+  capacity_ = capacity;
+  return true;
+}
+
+uint8_t *FaceFeatureStore::Record(uint64_t slot) const {
+  return data_ + kFaceStoreHeaderSize + slot * record_size_;
+}
+
+void FaceFeatureStore::SetRecordNumber(uint64_t record_number) {
+  StoreValue(data_ + kHeaderRecordNumberOffset, record_number);
+  record_number_ = record_number;
+}
+
+bool FaceFeatureStore::Open(const string &path, uint32_t dim) {
+  Close();
+  if (dim == 0) {
+    return false;
+  }
+  path_ = path;
+  dim_ = dim;
+  record_size_ = RecordSize(dim);
+  fd_ = open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  struct stat file_stat;
+  if (fd_ < 0 || fstat(fd_, &file_stat) != 0) {
+    Close();
+    return false;
+  }
+
+  uint8_t header[kFaceStoreHeaderSize] = { 0 };
+  if (file_stat.st_size == 0) {
+    StoreValue(header + kHeaderMagicOffset, kStoreFileMagic);
+    StoreValue(header + kHeaderVersionOffset, kStoreFileVersion);
+    StoreValue(header + kHeaderDimOffset, dim_);
+    StoreValue(header + kHeaderRecordSizeOffset, record_size_);
+    StoreValue(header + kHeaderRecordNumberOffset, static_cast<uint64_t>(0));
+    if (!WriteAll(fd_, header, sizeof(header))) {
+      Close();
+      return false;
+    }
+    file_stat.st_size = sizeof(header);
+  } else if (pread(fd_, header, sizeof(header), 0) != sizeof(header)
+      || LoadValue<uint32_t>(header + kHeaderMagicOffset) != kStoreFileMagic
+      || LoadValue<uint32_t>(header + kHeaderVersionOffset)
+          != kStoreFileVersion
+      || LoadValue<uint32_t>(header + kHeaderDimOffset) != dim_
+      || LoadValue<uint32_t>(header + kHeaderRecordSizeOffset)
+          != record_size_) {
+    Close();
+    return false;
+  }
+
+  uint64_t record_number =
+      LoadValue<uint64_t>(header + kHeaderRecordNumberOffset);
+  uint64_t file_records =
+      (file_stat.st_size - kFaceStoreHeaderSize) / record_size_;
+  if (record_number > file_records
+      || !Map(max(max(file_records, kMinCapacity), record_number))) {
+    Close();
+    return false;
+  }
+  record_number_ = record_number;
+
+  // a later live record of a name wins, see Append
+  for (uint64_t slot = 0; slot < record_number_; ++slot) {
+    const uint8_t *record = Record(slot);
+    uint32_t name_length =
+        LoadValue<uint32_t>(record + kRecordNameLengthOffset);
+    if (LoadValue<uint32_t>(record + kRecordStateOffset) == kFaceRecordLive
+        && name_length <= kFaceNameSize) {
+      string name(reinterpret_cast<const char *>(record + kRecordNameOffset),
+                  name_length);
+      slots_[name] = slot;
+    }
+  }
+  return true;
+}
+
+bool FaceFeatureStore::Append(const string &name, const int32_t *coordinate,
+                              const float *feature) {
+  if (data_ == nullptr || name.empty() || name.size() > kFaceNameSize
+      || coordinate == nullptr || feature == nullptr) {
+    return false;
+  }
+  if (record_number_ == capacity_) {
+    // the input may point into the current mapping, e.g. from Feature,
+    // keep a copy before it is remapped
+    vector<int32_t> coordinate_copy(coordinate,
+                                    coordinate + kFaceCoordinateNumber);
+    vector<float> feature_copy(feature, feature + dim_);
+    return Map(capacity_ * 2)
+        && Append(name, coordinate_copy.data(), feature_copy.data());
+  }
+
+  uint64_t slot = record_number_;
+  uint8_t *record = Record(slot);
+  memset(record, 0, record_size_);
+  StoreValue(record + kRecordStateOffset,
+             static_cast<uint32_t>(kFaceRecordLive));
+  StoreValue(record + kRecordNameLengthOffset,
+             static_cast<uint32_t>(name.size()));
+  memcpy(record + kRecordNameOffset, name.data(), name.size());
+  memcpy(record + kRecordCoordinateOffset, coordinate,
+         kFaceCoordinateNumber * sizeof(int32_t));
+  memcpy(record + kRecordFeatureOffset, feature, dim_ * sizeof(float));
+
+  // publish the record before the old one is tombstoned, an interrupted
+  // replace then leaves two live records and Open keeps the later one
+  SetRecordNumber(record_number_ + 1);
+  unordered_map<string, uint64_t>::iterator iter = slots_.find(name);
+  if (iter != slots_.end()) {
+    StoreValue(Record(iter->second) + kRecordStateOffset,
+               static_cast<uint32_t>(kFaceRecordTombstone));
+    iter->second = slot;
+  } else {
+    slots_.emplace(name, slot);
+  }
+  return true;
+}
+
+bool FaceFeatureStore::Remove(const string &name) {
+  unordered_map<string, uint64_t>::iterator iter = slots_.find(name);
+  if (iter == slots_.end()) {
+    return false;
+  }
+  StoreValue(Record(iter->second) + kRecordStateOffset,
+             static_cast<uint32_t>(kFaceRecordTombstone));
+  slots_.erase(iter);
+  return true;
+}
+
+bool FaceFeatureStore::Compact() {
+  if (data_ == nullptr) {
+    return false;
+  }
+
+  string compact_path = path_ + kCompactSuffix;
+  int fd = open(compact_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return false;
+  }
+  vector<uint8_t> header(data_, data_ + kFaceStoreHeaderSize);
+  StoreValue(header.data() + kHeaderRecordNumberOffset,
+             static_cast<uint64_t>(slots_.size()));
+  bool written = WriteAll(fd, header.data(), header.size());
+  for (uint64_t slot = 0; written && slot < record_number_; ++slot) {
+    const uint8_t *record = Record(slot);
+    if (LoadValue<uint32_t>(record + kRecordStateOffset) != kFaceRecordLive) {
+      continue;
+    }
+    string name(reinterpret_cast<const char *>(record + kRecordNameOffset),
+                LoadValue<uint32_t>(record + kRecordNameLengthOffset));
+    // skip a live record replaced by a later one
+    unordered_map<string, uint64_t>::const_iterator iter = slots_.find(name);
+    if (iter != slots_.end() && iter->second == slot) {
+      written = WriteAll(fd, record, record_size_);
+    }
+  }
+  written = (fsync(fd) == 0) && written;
+  close(fd);
+  if (!written || rename(compact_path.c_str(), path_.c_str()) != 0) {
+    unlink(compact_path.c_str());
+    return false;
+  }
+
+  string path = path_;
+  return Open(path, dim_);
+}
+
+const float *FaceFeatureStore::Feature(const string &name) const {
+  unordered_map<string, uint64_t>::const_iterator iter = slots_.find(name);
+  if (iter == slots_.end()) {
+    return nullptr;
+  }
+  return reinterpret_cast<const float *>(Record(iter->second)
+                                         + kRecordFeatureOffset);
+}
+
+const int32_t *FaceFeatureStore::Coordinate(const string &name) const {
+  unordered_map<string, uint64_t>::const_iterator iter = slots_.find(name);
+  if (iter == slots_.end()) {
+    return nullptr;
+  }
+  return reinterpret_cast<const int32_t *>(Record(iter->second)
+                                           + kRecordCoordinateOffset);
+}
+
+void FaceFeatureStore::ForEach(
+    const function<void(const string &, const int32_t *, const float *)>
+        &function) const {
+  for (const pair<const string, uint64_t> &face : slots_) {
+    const uint8_t *record = Record(face.second);
+    function(face.first,
+             reinterpret_cast<const int32_t *>(record
+                                               + kRecordCoordinateOffset),
+             reinterpret_cast<const float *>(record + kRecordFeatureOffset));
+  }
+}
+}
+}
+
+void *FaceFeatureStoreOpen(const char *path, uint32_t dim) {
+  if (path == nullptr) {
+    return nullptr;
+  }
+  ascend::utils::FaceFeatureStore *store =
+      new (std::nothrow) ascend::utils::FaceFeatureStore();
+  if (store != nullptr && !store->Open(path, dim)) {
+    delete store;
+    return nullptr;
+  }
+  return store;
+}
+
+void FaceFeatureStoreClose(void *store) {
+  delete static_cast<ascend::utils::FaceFeatureStore *>(store);
+}
+
+int FaceFeatureStoreAppend(void *store, const char *name,
+                           const int32_t *coordinate, const float *feature) {
+  if (store == nullptr || name == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceFeatureStore *>(store)->Append(
+      name, coordinate, feature) ? 0 : -1;
+}
+
+int FaceFeatureStoreRemove(void *store, const char *name) {
+  if (store == nullptr || name == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceFeatureStore *>(store)->Remove(name)
+      ? 0 : -1;
+}
+
+int FaceFeatureStoreCompact(void *store) {
+  if (store == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceFeatureStore *>(store)->Compact()
+      ? 0 : -1;
+}
+
+uint64_t FaceFeatureStoreSize(const void *store) {
+  if (store == nullptr) {
+    return 0;
+  }
+  return static_cast<const ascend::utils::FaceFeatureStore *>(store)->Size();
+}
+
+uint64_t FaceFeatureStoreTombstoneNumber(const void *store) {
+  if (store == nullptr) {
+    return 0;
+  }
+  return static_cast<const ascend::utils::FaceFeatureStore *>(store)
+      ->tombstone_number();
+}
+
+uint64_t FaceFeatureStoreNames(const void *store, char *names,
+                               uint64_t max_number) {
+  if (store == nullptr || names == nullptr) {
+    return 0;
+  }
+  uint64_t number = 0;
+  static_cast<const ascend::utils::FaceFeatureStore *>(store)->ForEach(
+      [&](const std::string &name, const int32_t *, const float *) {
+        if (number < max_number) {
+          char *slot = names + number * ascend::utils::kFaceNameSize;
+          memset(slot, 0, ascend::utils::kFaceNameSize);
+          memcpy(slot, name.data(), name.size());
+          ++number;
+        }
+      });
+  return number;
+}
+
+int FaceFeatureStoreRead(const void *store, const char *name,
+                         int32_t *coordinate, float *feature) {
+  if (store == nullptr || name == nullptr) {
+    return -1;
+  }
+  const ascend::utils::FaceFeatureStore *face_store =
+      static_cast<const ascend::utils::FaceFeatureStore *>(store);
+  const float *stored_feature = face_store->Feature(name);
+  if (stored_feature == nullptr) {
+    return -1;
+  }
+  if (coordinate != nullptr) {
+    memcpy(coordinate, face_store->Coordinate(name),
+           ascend::utils::kFaceCoordinateNumber * sizeof(int32_t));
+  }
+  if (feature != nullptr) {
+    memcpy(feature, stored_feature, face_store->dim() * sizeof(float));
+  }
+  return 0;
+}
@@ -0,0 +1,260 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <thread>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+#include "feature_math.h"
+
+using namespace std;
+
+namespace {
+// a scan thread gets at least this number of rows, smaller galleries are
+// scanned by the calling thread only
+const size_t kMinRowsPerThread = 16384;
+}
+
+namespace ascend {
+namespace utils {
+FaceGallery::FaceGallery(uint32_t dim, uint32_t thread_number,
+                         FeatureEncoding encoding)
+    : dim_(dim),
+      stride_(FeatureStride(dim)),
+      thread_number_(max(thread_number, 1u)),
+      encoding_(encoding),
+      row_bytes_(stride_ * FeatureElementSize(encoding)) {
+}
+
+bool FaceGallery::Add(uint32_t id, const float *feature) {
+  vector<float> row(stride_);
+  if (!NormalizeFeature(feature, dim_, stride_, row.data())) {
+    return false;
+  }
+
+  unordered_map<uint32_t, size_t>::iterator iter = rows_.find(id);
+  if (iter == rows_.end()) {
+    iter = rows_.emplace(id, ids_.size()).first;
+    ids_.push_back(id);
+    matrix_.resize(ids_.size() * row_bytes_);
+    if (encoding_ == kFeatureInt8) {
+      scales_.resize(ids_.size());
+    }
+  }
+
+  uint8_t *dest = matrix_.data() + iter->second * row_bytes_;
+  switch (encoding_) {
+    case kFeatureFp16:
+      EncodeFp16(row.data(), stride_, reinterpret_cast<uint16_t *>(dest));
+      break;
+    case kFeatureInt8:
+      scales_[iter->second] = EncodeInt8(row.data(), stride_,
+                                         reinterpret_cast<int8_t *>(dest));
+      break;
+    default:
+      copy(row.begin(), row.end(), reinterpret_cast<float *>(dest));
+      break;
+  }
+  return true;
+}
+
+bool FaceGallery::Remove(uint32_t id) {
+  unordered_map<uint32_t, size_t>::iterator iter = rows_.find(id);
+  if (iter == rows_.end()) {
+    return false;
+  }
+
+  // move the last row into the hole, so rows stay contiguous
+  size_t row = iter->second;
+  size_t last_row = ids_.size() - 1;
+  rows_.erase(iter);
+  if (row != last_row) {
+    copy(matrix_.begin() + last_row * row_bytes_,
+         matrix_.begin() + (last_row + 1) * row_bytes_,
+         matrix_.begin() + row * row_bytes_);
+    if (!scales_.empty()) {
+      scales_[row] = scales_[last_row];
+    }
+    ids_[row] = ids_[last_row];
+    rows_[ids_[row]] = row;
+  }
+  ids_.pop_back();
+  matrix_.resize(ids_.size() * row_bytes_);
+  if (!scales_.empty()) {
+    scales_.pop_back();
+  }
+  return true;
+}
+
+void FaceGallery::Clear() {
+  matrix_.clear();
+  scales_.clear();
+  ids_.clear();
+  rows_.clear();
+}
+
+float FaceGallery::RowScore(const EncodedQuery &query, size_t index) const {
+  const uint8_t *row = matrix_.data() + index * row_bytes_;
+  switch (encoding_) {
+    case kFeatureFp16:
+      return DotProductFp16(query.row.data(),
+                            reinterpret_cast<const uint16_t *>(row), stride_);
+    case kFeatureInt8:
+      return DotProductInt8(query.codes.data(),
+                            reinterpret_cast<const int8_t *>(row), stride_)
+          * query.scale * scales_[index];
+    default:
+      return DotProduct(query.row.data(),
+                        reinterpret_cast<const float *>(row), stride_);
+  }
+}
+
+void FaceGallery::ScanRows(const EncodedQuery &query, size_t begin,
+                           size_t end, uint32_t top_k, float threshold,
+                           vector<FaceGalleryResult> &heap) const {
+  heap.clear();
+  for (size_t index = begin; index < end; ++index) {
+    float score = RowScore(query, index);
+    if (score < threshold) {
+      continue;
+    }
+    PushTopK({ids_[index], score}, top_k, heap);
+  }
+}
+
+void FaceGallery::Search(const float *query, uint32_t top_k, float threshold,
+                         vector<FaceGalleryResult> &results) const {
+  results.clear();
+  EncodedQuery encoded_query;
+  encoded_query.row.resize(stride_);
+  if (top_k == 0 || ids_.empty()
+      || !NormalizeFeature(query, dim_, stride_, encoded_query.row.data())) {
+    return;
+  }
+  if (encoding_ == kFeatureInt8) {
+    encoded_query.codes.resize(stride_);
+    encoded_query.scale = EncodeInt8(encoded_query.row.data(), stride_,
+                                     encoded_query.codes.data());
+  }
+
+  size_t row_number = ids_.size();
+  size_t thread_number = min(static_cast<size_t>(thread_number_),
+                             max(row_number / kMinRowsPerThread,
+                                 static_cast<size_t>(1)));
+  if (thread_number == 1) {
+    ScanRows(encoded_query, 0, row_number, top_k, threshold, results);
+  } else {
+    // every thread keeps its own top k, they are merged afterwards
+    vector<vector<FaceGalleryResult>> heaps(thread_number);
+    vector<thread> threads;
+    size_t rows_per_thread = (row_number + thread_number - 1) / thread_number;
+    for (size_t index = 1; index < thread_number; ++index) {
+      size_t begin = index * rows_per_thread;
+      size_t end = min(begin + rows_per_thread, row_number);
+      threads.emplace_back(&FaceGallery::ScanRows, this, cref(encoded_query),
+                           begin, end, top_k, threshold, ref(heaps[index]));
+    }
+    ScanRows(encoded_query, 0, rows_per_thread, top_k, threshold, heaps[0]);
+    for (thread &scan_thread : threads) {
+      scan_thread.join();
+    }
+    for (const vector<FaceGalleryResult> &heap : heaps) {
+      results.insert(results.end(), heap.begin(), heap.end());
+    }
+  }
+
+  SortTopK(top_k, results);
+}
+}
+}
+
+void *FaceGalleryCreate(uint32_t dim, uint32_t thread_number,
+                        uint32_t encoding) {
+  if (dim == 0 || encoding > ascend::utils::kFeatureInt8) {
+    return nullptr;
+  }
+  ascend::utils::FeatureEncoding feature_encoding =
+      static_cast<ascend::utils::FeatureEncoding>(encoding);
+  return new (std::nothrow) ascend::utils::FaceGallery(dim, thread_number,
+                                                       feature_encoding);
+}
+
+void FaceGalleryDestroy(void *gallery) {
+  delete static_cast<ascend::utils::FaceGallery *>(gallery);
+}
+
+int FaceGalleryAdd(void *gallery, uint32_t id, const float *feature) {
+  if (gallery == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceGallery *>(gallery)->Add(id, feature)
+      ? 0 : -1;
+}
+
+int FaceGalleryRemove(void *gallery, uint32_t id) {
+  if (gallery == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceGallery *>(gallery)->Remove(id)
+      ? 0 : -1;
+}
+
+void FaceGalleryClear(void *gallery) {
+  if (gallery != nullptr) {
+    static_cast<ascend::utils::FaceGallery *>(gallery)->Clear();
+  }
+}
+
+uint32_t FaceGallerySize(const void *gallery) {
+  if (gallery == nullptr) {
+    return 0;
+  }
+  return static_cast<const ascend::utils::FaceGallery *>(gallery)->Size();
+}
+
+uint32_t FaceGallerySearch(const void *gallery, const float *query,
+                           uint32_t top_k, float threshold, uint32_t *ids,
+                           float *scores) {
+  if (gallery == nullptr || ids == nullptr || scores == nullptr) {
+    return 0;
+  }
+  std::vector<ascend::utils::FaceGalleryResult> results;
+  static_cast<const ascend::utils::FaceGallery *>(gallery)->Search(
+      query, top_k, threshold, results);
+  for (size_t index = 0; index < results.size(); ++index) {
+    ids[index] = results[index].id;
+    scores[index] = results[index].score;
+  }
+  return results.size();
+}
@@ -0,0 +1,105 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/ascend_face_gallery/face_gallery_replica.h"
+
+using namespace std;
+
+namespace ascend {
+namespace utils {
+FaceGalleryReplica& FaceGalleryReplica::GetInstance() {
+  static FaceGalleryReplica instance;
+  return instance;
+}
+
+// fp16 rows halve the memory of the replica, the scores differ from float32
+// in the fifth decimal
+FaceGalleryReplica::FaceGalleryReplica()
+    : gallery_(kReplicaFeatureDim, 1, kFeatureFp16),
+      next_id_(0),
+      threshold_(0),
+      synced_(false) {
+}
+
+void FaceGalleryReplica::Apply(bool reset, float threshold,
+                               const vector<FaceGalleryUpdate> &faces) {
+  lock_guard<mutex> lock(mutex_);
+  if (reset) {
+    gallery_.Clear();
+    ids_.clear();
+    names_.clear();
+  }
+  if (threshold > 0) {
+    threshold_ = threshold;
+  }
+
+  for (const FaceGalleryUpdate &face : faces) {
+    auto it = ids_.find(face.name);
+    if (face.feature.size() != kReplicaFeatureDim) {
+      if (it != ids_.end()) {
+        gallery_.Remove(it->second);
+        names_.erase(it->second);
+        ids_.erase(it);
+      }
+      continue;
+    }
+
+    uint32_t id = (it != ids_.end()) ? it->second : next_id_++;
+    if (!gallery_.Add(id, face.feature.data())) {
+      continue;
+    }
+    ids_[face.name] = id;
+    names_[id] = face.name;
+  }
+  synced_ = true;
+}
+
+bool FaceGalleryReplica::Match(const vector<float> &feature, string &name,
+                               float &score) {
+  lock_guard<mutex> lock(mutex_);
+  if (!synced_ || feature.size() != kReplicaFeatureDim) {
+    return false;
+  }
+
+  gallery_.Search(feature.data(), 1, threshold_, results_);
+  if (results_.empty()) {
+    name = kUnknownFaceName;
+    score = 0;
+  } else {
+    name = names_[results_[0].id];
+    score = results_[0].score;
+  }
+  return true;
+}
+}
+}
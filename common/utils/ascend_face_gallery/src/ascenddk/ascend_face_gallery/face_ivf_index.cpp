@@ -0,0 +1,519 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <new>
+#include <random>
+#include "ascenddk/ascend_face_gallery/face_ivf_index.h"
+#include "feature_math.h"
+
+using namespace std;
+
+namespace {
+// k-means iterations of training
+const uint32_t kTrainIterations = 10;
+
+// training samples at most this number of faces per list, the centroids
+// barely move with more and the cost grows with faces * lists
+const uint32_t kMaxTrainFacesPerList = 256;
+
+// seed of training samples, fixed so that training is repeatable
+const uint32_t kTrainSeed = 1234;
+
+// a trained index needs training again once it holds this many times the
+// faces it was trained on
+const size_t kRetrainGrowth = 2;
+
+// "FIVF" and version of the index file
+const uint32_t kIndexFileMagic = 0x46564946;
+const uint32_t kIndexFileVersion = 1;
+
+template<typename T>
+void WriteValues(ofstream &file, const T *values, size_t number) {
+  file.write(reinterpret_cast<const char *>(values), sizeof(T) * number);
+}
+
+template<typename T>
+bool ReadValues(ifstream &file, T *values, size_t number) {
+  file.read(reinterpret_cast<char *>(values), sizeof(T) * number);
+  return file.good();
+}
+
+// whether number values of size bytes each fit in the rest of a file
+bool FitsInFile(uint64_t number, uint64_t size, uint64_t &rest) {
+  if (size != 0 && number > rest / size) {
+    return false;
+  }
+  rest -= number * size;
+  return true;
+}
+
+uint32_t NearestCentroid(const float *row, const vector<float> &centroids,
+                         uint32_t list_number, uint32_t stride) {
+  uint32_t nearest = 0;
+  float best_score = -2.0f;
+  for (uint32_t list = 0; list < list_number; ++list) {
+    float score = ascend::utils::DotProduct(row, &centroids[list * stride],
+                                            stride);
+    if (score > best_score) {
+      best_score = score;
+      nearest = list;
+    }
+  }
+  return nearest;
+}
+}
+
+namespace ascend {
+namespace utils {
+FaceIvfIndex::FaceIvfIndex(uint32_t dim, uint32_t list_number,
+                           uint32_t probe_number, uint32_t train_factor,
+                           bool auto_train)
+    : dim_(dim),
+      stride_(FeatureStride(dim)),
+      list_number_(max(list_number, 1u)),
+      probe_number_(max(probe_number, 1u)),
+      train_factor_(max(train_factor, 1u)),
+      auto_train_(auto_train),
+      trained_size_(0),
+      lists_(1) {
+}
+
+uint32_t FaceIvfIndex::NearestList(const float *row) const {
+  return NearestCentroid(row, centroids_, list_number_, stride_);
+}
+
+void FaceIvfIndex::AppendRow(uint32_t list, uint32_t id, const float *row) {
+  InvertedList &inverted_list = lists_[list];
+  locations_[id] = make_pair(list, inverted_list.ids.size());
+  inverted_list.ids.push_back(id);
+  inverted_list.rows.insert(inverted_list.rows.end(), row, row + stride_);
+}
+
+bool FaceIvfIndex::Add(uint32_t id, const float *feature) {
+  vector<float> row(stride_);
+  if (!NormalizeFeature(feature, dim_, stride_, row.data())) {
+    return false;
+  }
+
+  Remove(id);
+  AppendRow(trained() ? NearestList(row.data()) : 0, id, row.data());
+  if (auto_train_ && NeedsTraining()) {
+    Train();
+  }
+  return true;
+}
+
+bool FaceIvfIndex::Remove(uint32_t id) {
+  unordered_map<uint32_t, pair<uint32_t, size_t>>::iterator iter =
+      locations_.find(id);
+  if (iter == locations_.end()) {
+    return false;
+  }
+
+  // move the last row of the list into the hole
+  InvertedList &inverted_list = lists_[iter->second.first];
+  size_t row = iter->second.second;
+  size_t last_row = inverted_list.ids.size() - 1;
+  locations_.erase(iter);
+  if (row != last_row) {
+    copy(inverted_list.rows.begin() + last_row * stride_,
+         inverted_list.rows.begin() + (last_row + 1) * stride_,
+         inverted_list.rows.begin() + row * stride_);
+    inverted_list.ids[row] = inverted_list.ids[last_row];
+    locations_[inverted_list.ids[row]].second = row;
+  }
+  inverted_list.ids.pop_back();
+  inverted_list.rows.resize(last_row * stride_);
+  return true;
+}
+
+void FaceIvfIndex::Clear() {
+  centroids_.clear();
+  trained_size_ = 0;
+  lists_.assign(1, InvertedList());
+  locations_.clear();
+}
+
+bool FaceIvfIndex::NeedsTraining() const {
+  if (list_number_ <= 1
+      || Size() < static_cast<size_t>(list_number_) * train_factor_) {
+    return false;
+  }
+  return !trained() || Size() >= trained_size_ * kRetrainGrowth;
+}
+
+bool FaceIvfIndex::Train() {
+  FaceIvfTrainer trainer(*this);
+  return trainer.Run() && trainer.Apply(*this);
+}
+
+void FaceIvfIndex::Search(const float *query, uint32_t top_k,
+                          float threshold,
+                          vector<FaceGalleryResult> &results) const {
+  results.clear();
+  vector<float> normalized_query(stride_);
+  if (top_k == 0 || locations_.empty()
+      || !NormalizeFeature(query, dim_, stride_, normalized_query.data())) {
+    return;
+  }
+
+  // lists to scan, the ones with the nearest centroids when trained
+  vector<uint32_t> probe_lists;
+  if (!trained()) {
+    probe_lists.push_back(0);
+  } else {
+    vector<pair<float, uint32_t>> centroid_scores(list_number_);
+    for (uint32_t list = 0; list < list_number_; ++list) {
+      centroid_scores[list] = make_pair(
+          DotProduct(normalized_query.data(), &centroids_[list * stride_],
+                     stride_),
+          list);
+    }
+    uint32_t probe_number = min(probe_number_, list_number_);
+    partial_sort(centroid_scores.begin(),
+                 centroid_scores.begin() + probe_number,
+                 centroid_scores.end(),
+                 greater<pair<float, uint32_t>>());
+    for (uint32_t index = 0; index < probe_number; ++index) {
+      probe_lists.push_back(centroid_scores[index].second);
+    }
+  }
+
+  for (uint32_t list : probe_lists) {
+    const InvertedList &inverted_list = lists_[list];
+    const float *row = inverted_list.rows.data();
+    for (size_t index = 0; index < inverted_list.ids.size();
+        ++index, row += stride_) {
+      float score = DotProduct(normalized_query.data(), row, stride_);
+      if (score >= threshold) {
+        PushTopK({inverted_list.ids[index], score}, top_k, results);
+      }
+    }
+  }
+  SortTopK(top_k, results);
+}
+
+bool FaceIvfIndex::Save(const string &path) const {
+  ofstream file(path, ios::binary | ios::trunc);
+  if (!file) {
+    return false;
+  }
+
+  // rows are written without padding, so the file does not depend on the
+  // simd block size
+  uint32_t header[] = { kIndexFileMagic, kIndexFileVersion, dim_,
+      list_number_, probe_number_, train_factor_,
+      static_cast<uint32_t>(trained()),
+      static_cast<uint32_t>(lists_.size()) };
+  WriteValues(file, header, sizeof(header) / sizeof(header[0]));
+  if (trained()) {
+    for (uint32_t list = 0; list < list_number_; ++list) {
+      WriteValues(file, &centroids_[list * stride_], dim_);
+    }
+  }
+  for (const InvertedList &inverted_list : lists_) {
+    uint64_t row_number = inverted_list.ids.size();
+    WriteValues(file, &row_number, 1);
+    WriteValues(file, inverted_list.ids.data(), row_number);
+    for (size_t row = 0; row < row_number; ++row) {
+      WriteValues(file, &inverted_list.rows[row * stride_], dim_);
+    }
+  }
+  file.close();
+  return file.good();
+}
+
+bool FaceIvfIndex::Load(const string &path) {
+  ifstream file(path, ios::binary | ios::ate);
+  if (!file) {
+    return false;
+  }
+  // every count read from the file is checked against the bytes left, so
+  // a truncated or corrupted file never makes a huge allocation
+  uint64_t rest = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+  uint32_t header[8] = { 0 };
+  const uint64_t row_size = sizeof(float) * static_cast<uint64_t>(dim_);
+  if (!FitsInFile(1, sizeof(header), rest)
+      || !ReadValues(file, header, sizeof(header) / sizeof(header[0]))
+      || header[0] != kIndexFileMagic || header[1] != kIndexFileVersion
+      || header[2] != dim_ || header[3] == 0) {
+    return false;
+  }
+  bool trained = header[6] != 0;
+  uint32_t list_count = header[7];
+  if (list_count != (trained ? header[3] : 1)
+      || (trained && !FitsInFile(header[3], row_size, rest))
+      || !FitsInFile(list_count, sizeof(uint64_t), rest)) {
+    return false;
+  }
+
+  FaceIvfIndex index(dim_, header[3], probe_number_, header[5], auto_train_);
+  vector<float> row(stride_, 0.0f);
+  if (trained) {
+    index.centroids_.assign(static_cast<size_t>(header[3]) * stride_, 0.0f);
+    for (uint32_t list = 0; list < header[3]; ++list) {
+      if (!ReadValues(file, &index.centroids_[list * stride_], dim_)) {
+        return false;
+      }
+    }
+  }
+  index.lists_.assign(list_count, InvertedList());
+  for (uint32_t list = 0; list < list_count; ++list) {
+    uint64_t row_number = 0;
+    if (!ReadValues(file, &row_number, 1)
+        || !FitsInFile(row_number, sizeof(uint32_t) + row_size, rest)) {
+      return false;
+    }
+    vector<uint32_t> ids(row_number);
+    if (!ReadValues(file, ids.data(), row_number)) {
+      return false;
+    }
+    for (uint32_t id : ids) {
+      if (!ReadValues(file, row.data(), dim_)) {
+        return false;
+      }
+      index.AppendRow(list, id, row.data());
+    }
+  }
+  if (trained) {
+    index.trained_size_ = index.Size();
+  }
+
+  *this = move(index);
+  return true;
+}
+
+FaceIvfTrainer::FaceIvfTrainer(const FaceIvfIndex &index)
+    : dim_(index.dim_),
+      stride_(index.stride_),
+      list_number_(index.list_number_) {
+  vector<const float *> rows;
+  rows.reserve(index.Size());
+  for (const FaceIvfIndex::InvertedList &inverted_list : index.lists_) {
+    for (size_t row = 0; row < inverted_list.ids.size(); ++row) {
+      rows.push_back(&inverted_list.rows[row * stride_]);
+    }
+  }
+
+  // only the sampled rows are copied, so that the index can be changed
+  // again while Run works on them
+  mt19937 generator(kTrainSeed);
+  shuffle(rows.begin(), rows.end(), generator);
+  rows.resize(min(rows.size(), static_cast<size_t>(list_number_)
+                                   * kMaxTrainFacesPerList));
+  samples_.reserve(rows.size() * stride_);
+  for (const float *row : rows) {
+    samples_.insert(samples_.end(), row, row + stride_);
+  }
+}
+
+bool FaceIvfTrainer::Run() {
+  size_t sample_number = samples_.size() / stride_;
+  if (list_number_ <= 1 || sample_number < list_number_) {
+    return false;
+  }
+
+  // spherical k-means: centroids are normalized means of their faces,
+  // the first ones are random faces
+  centroids_.assign(samples_.begin(),
+                    samples_.begin() + list_number_ * stride_);
+  vector<float> sums(centroids_.size());
+  vector<size_t> counts(list_number_);
+  mt19937 generator(kTrainSeed);
+  uniform_int_distribution<size_t> random_sample(0, sample_number - 1);
+  for (uint32_t iteration = 0; iteration < kTrainIterations; ++iteration) {
+    fill(sums.begin(), sums.end(), 0.0f);
+    fill(counts.begin(), counts.end(), 0);
+    for (size_t sample = 0; sample < sample_number; ++sample) {
+      const float *row = &samples_[sample * stride_];
+      uint32_t list = NearestCentroid(row, centroids_, list_number_,
+                                      stride_);
+      float *sum = &sums[list * stride_];
+      for (uint32_t i = 0; i < dim_; ++i) {
+        sum[i] += row[i];
+      }
+      ++counts[list];
+    }
+    for (uint32_t list = 0; list < list_number_; ++list) {
+      float *centroid = &centroids_[list * stride_];
+      // an empty list restarts from a random face
+      if (counts[list] == 0 || !NormalizeFeature(&sums[list * stride_], dim_,
+                                                 stride_, centroid)) {
+        size_t sample = random_sample(generator);
+        copy(samples_.begin() + sample * stride_,
+             samples_.begin() + (sample + 1) * stride_, centroid);
+      }
+    }
+  }
+  return true;
+}
+
+bool FaceIvfTrainer::Apply(FaceIvfIndex &index) const {
+  if (centroids_.empty() || index.dim_ != dim_
+      || index.list_number_ != list_number_) {
+    return false;
+  }
+
+  // the faces of the index may have changed since sampling, all of its
+  // current rows are moved to the lists of the new centroids
+  vector<FaceIvfIndex::InvertedList> old_lists(list_number_);
+  old_lists.swap(index.lists_);
+  index.locations_.clear();
+  index.centroids_ = centroids_;
+  for (FaceIvfIndex::InvertedList &inverted_list : old_lists) {
+    for (size_t row = 0; row < inverted_list.ids.size(); ++row) {
+      const float *values = &inverted_list.rows[row * stride_];
+      index.AppendRow(index.NearestList(values), inverted_list.ids[row],
+                      values);
+    }
+    vector<float>().swap(inverted_list.rows);
+  }
+  index.trained_size_ = index.Size();
+  return true;
+}
+}
+}
+
+void *FaceIvfIndexCreate(uint32_t dim, uint32_t list_number,
+                         uint32_t probe_number) {
+  if (dim == 0) {
+    return nullptr;
+  }
+  return new (std::nothrow) ascend::utils::FaceIvfIndex(
+      dim, list_number, probe_number, ascend::utils::kIvfTrainFactor, false);
+}
+
+void FaceIvfIndexDestroy(void *index) {
+  delete static_cast<ascend::utils::FaceIvfIndex *>(index);
+}
+
+int FaceIvfIndexAdd(void *index, uint32_t id, const float *feature) {
+  if (index == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceIvfIndex *>(index)->Add(id, feature)
+      ? 0 : -1;
+}
+
+int FaceIvfIndexRemove(void *index, uint32_t id) {
+  if (index == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceIvfIndex *>(index)->Remove(id)
+      ? 0 : -1;
+}
+
+void FaceIvfIndexClear(void *index) {
+  if (index != nullptr) {
+    static_cast<ascend::utils::FaceIvfIndex *>(index)->Clear();
+  }
+}
+
+uint32_t FaceIvfIndexSize(const void *index) {
+  if (index == nullptr) {
+    return 0;
+  }
+  return static_cast<const ascend::utils::FaceIvfIndex *>(index)->Size();
+}
+
+uint32_t FaceIvfIndexSearch(const void *index, const float *query,
+                            uint32_t top_k, float threshold, uint32_t *ids,
+                            float *scores) {
+  if (index == nullptr || ids == nullptr || scores == nullptr) {
+    return 0;
+  }
+  std::vector<ascend::utils::FaceGalleryResult> results;
+  static_cast<const ascend::utils::FaceIvfIndex *>(index)->Search(
+      query, top_k, threshold, results);
+  for (size_t i = 0; i < results.size(); ++i) {
+    ids[i] = results[i].id;
+    scores[i] = results[i].score;
+  }
+  return results.size();
+}
+
+int FaceIvfIndexSave(const void *index, const char *path) {
+  if (index == nullptr || path == nullptr) {
+    return -1;
+  }
+  return static_cast<const ascend::utils::FaceIvfIndex *>(index)->Save(path)
+      ? 0 : -1;
+}
+
+int FaceIvfIndexLoad(void *index, const char *path) {
+  if (index == nullptr || path == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceIvfIndex *>(index)->Load(path)
+      ? 0 : -1;
+}
+
+int FaceIvfIndexNeedsTraining(const void *index) {
+  if (index == nullptr) {
+    return 0;
+  }
+  return static_cast<const ascend::utils::FaceIvfIndex *>(index)
+      ->NeedsTraining() ? 1 : 0;
+}
+
+void *FaceIvfTrainerCreate(const void *index) {
+  if (index == nullptr) {
+    return nullptr;
+  }
+  return new (std::nothrow) ascend::utils::FaceIvfTrainer(
+      *static_cast<const ascend::utils::FaceIvfIndex *>(index));
+}
+
+void FaceIvfTrainerDestroy(void *trainer) {
+  delete static_cast<ascend::utils::FaceIvfTrainer *>(trainer);
+}
+
+int FaceIvfTrainerRun(void *trainer) {
+  if (trainer == nullptr) {
+    return -1;
+  }
+  return static_cast<ascend::utils::FaceIvfTrainer *>(trainer)->Run()
+      ? 0 : -1;
+}
+
+int FaceIvfTrainerApply(const void *trainer, void *index) {
+  if (trainer == nullptr || index == nullptr) {
+    return -1;
+  }
+  return static_cast<const ascend::utils::FaceIvfTrainer *>(trainer)->Apply(
+      *static_cast<ascend::utils::FaceIvfIndex *>(index)) ? 0 : -1;
+}
@@ -0,0 +1,156 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ascenddk/ascend_face_gallery/feature_codec.h"
+
+namespace {
+// largest int8 code
+const float kInt8MaxCode = 127.0f;
+
+// half: exponent bias and masks
+const uint32_t kFloatExponentMask = 0x7f800000;
+const uint32_t kFloatAbsMask = 0x7fffffff;
+const uint32_t kHalfSignShift = 16;
+const uint32_t kHalfInfinity = 0x7c00;
+const uint32_t kHalfQuietNan = 0x7e00;
+// 65520 and above round to half infinity
+const uint32_t kHalfOverflow = 0x477ff000;
+// below 2^-14 a half is subnormal
+const uint32_t kHalfMinNormal = 0x38800000;
+// 2^24, a subnormal half counts units of 2^-24
+const float kHalfSubnormalScale = 16777216.0f;
+// float and half exponent biases differ by 112
+const uint32_t kExponentRebias = 112u << 23;
+const uint32_t kMantissaShift = 13;
+}
+
+namespace ascend {
+namespace utils {
+size_t FeatureElementSize(FeatureEncoding encoding) {
+  switch (encoding) {
+    case kFeatureFp16:
+      return sizeof(uint16_t);
+    case kFeatureInt8:
+      return sizeof(int8_t);
+    default:
+      return sizeof(float);
+  }
+}
+
+uint16_t FloatToHalf(float value) {
+  uint32_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> kHalfSignShift) & 0x8000;
+  uint32_t abs_bits = bits & kFloatAbsMask;
+  if (abs_bits > kFloatExponentMask) {
+    return sign | kHalfQuietNan;
+  }
+  if (abs_bits >= kHalfOverflow) {
+    return sign | kHalfInfinity;
+  }
+  if (abs_bits < kHalfMinNormal) {
+    // rounds to nearest even, 2^-14 itself becomes the smallest normal
+    float abs_value = 0.0f;
+    memcpy(&abs_value, &abs_bits, sizeof(abs_value));
+    return sign | static_cast<uint32_t>(
+        nearbyintf(abs_value * kHalfSubnormalScale));
+  }
+
+  // round to nearest even on the 13 dropped mantissa bits, a carry moves
+  // into the exponent as it should
+  uint32_t odd = (abs_bits >> kMantissaShift) & 1;
+  abs_bits = abs_bits - kExponentRebias + 0xfff + odd;
+  return sign | (abs_bits >> kMantissaShift);
+}
+
+float HalfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << kHalfSignShift;
+  uint32_t exponent = (half >> 10) & 0x1f;
+  uint32_t mantissa = half & 0x3ff;
+  uint32_t bits = 0;
+  if (exponent == 0) {
+    float value = mantissa / kHalfSubnormalScale;
+    memcpy(&bits, &value, sizeof(bits));
+    bits |= sign;
+  } else if (exponent == 0x1f) {
+    bits = sign | kFloatExponentMask | (mantissa << kMantissaShift);
+  } else {
+    bits = sign | (((exponent << 23) + kExponentRebias)
+        | (mantissa << kMantissaShift));
+  }
+  float value = 0.0f;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void EncodeFp16(const float *feature, uint32_t dim, uint16_t *codes) {
+  for (uint32_t i = 0; i < dim; ++i) {
+    codes[i] = FloatToHalf(feature[i]);
+  }
+}
+
+void DecodeFp16(const uint16_t *codes, uint32_t dim, float *feature) {
+  for (uint32_t i = 0; i < dim; ++i) {
+    feature[i] = HalfToFloat(codes[i]);
+  }
+}
+
+float EncodeInt8(const float *feature, uint32_t dim, int8_t *codes) {
+  float max_abs = 0.0f;
+  for (uint32_t i = 0; i < dim; ++i) {
+    max_abs = std::max(max_abs, std::fabs(feature[i]));
+  }
+  if (!(max_abs > 0.0f) || !std::isfinite(max_abs)) {
+    memset(codes, 0, dim);
+    return 0.0f;
+  }
+
+  float scale = max_abs / kInt8MaxCode;
+  float inverse_scale = kInt8MaxCode / max_abs;
+  for (uint32_t i = 0; i < dim; ++i) {
+    codes[i] = static_cast<int8_t>(nearbyintf(feature[i] * inverse_scale));
+  }
+  return scale;
+}
+
+void DecodeInt8(const int8_t *codes, uint32_t dim, float scale,
+                float *feature) {
+  for (uint32_t i = 0; i < dim; ++i) {
+    feature[i] = codes[i] * scale;
+  }
+}
+}
+}
@@ -0,0 +1,238 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ascenddk/ascend_face_gallery/feature_codec.h"
+#include "feature_math.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace {
+// order of a min heap on score, the worst kept result is on top
+bool HigherScore(const ascend::utils::FaceGalleryResult &lhs,
+                 const ascend::utils::FaceGalleryResult &rhs) {
+  return lhs.score > rhs.score;
+}
+}
+
+namespace ascend {
+namespace utils {
+float DotProduct(const float *lhs, const float *rhs, uint32_t length) {
+#if defined(__AVX2__) && defined(__FMA__)
+  __m256 sum0 = _mm256_setzero_ps();
+  __m256 sum1 = _mm256_setzero_ps();
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i),
+                           sum0);
+    sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(lhs + i + 8),
+                           _mm256_loadu_ps(rhs + i + 8), sum1);
+  }
+  __m256 sum = _mm256_add_ps(sum0, sum1);
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum),
+                           _mm256_extractf128_ps(sum, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_movehdup_ps(half));
+  return _mm_cvtss_f32(half);
+#elif defined(__ARM_NEON)
+  float32x4_t sum0 = vdupq_n_f32(0.0f);
+  float32x4_t sum1 = vdupq_n_f32(0.0f);
+  float32x4_t sum2 = vdupq_n_f32(0.0f);
+  float32x4_t sum3 = vdupq_n_f32(0.0f);
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    sum0 = vmlaq_f32(sum0, vld1q_f32(lhs + i), vld1q_f32(rhs + i));
+    sum1 = vmlaq_f32(sum1, vld1q_f32(lhs + i + 4), vld1q_f32(rhs + i + 4));
+    sum2 = vmlaq_f32(sum2, vld1q_f32(lhs + i + 8), vld1q_f32(rhs + i + 8));
+    sum3 = vmlaq_f32(sum3, vld1q_f32(lhs + i + 12), vld1q_f32(rhs + i + 12));
+  }
+  float32x4_t sum = vaddq_f32(vaddq_f32(sum0, sum1), vaddq_f32(sum2, sum3));
+  float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(pair, pair), 0);
+#else
+  // independent partial sums, so the compiler can vectorize the loop
+  float sum[kBlockFloats] = { 0.0f };
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    for (uint32_t j = 0; j < kBlockFloats; ++j) {
+      sum[j] += lhs[i + j] * rhs[i + j];
+    }
+  }
+  float total = 0.0f;
+  for (uint32_t j = 0; j < kBlockFloats; ++j) {
+    total += sum[j];
+  }
+  return total;
+#endif
+}
+
+float DotProductFp16(const float *lhs, const uint16_t *rhs, uint32_t length) {
+#if defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+  __m256 sum0 = _mm256_setzero_ps();
+  __m256 sum1 = _mm256_setzero_ps();
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    __m256i halves = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(rhs + i));
+    sum0 = _mm256_fmadd_ps(
+        _mm256_loadu_ps(lhs + i),
+        _mm256_cvtph_ps(_mm256_castsi256_si128(halves)), sum0);
+    sum1 = _mm256_fmadd_ps(
+        _mm256_loadu_ps(lhs + i + 8),
+        _mm256_cvtph_ps(_mm256_extracti128_si256(halves, 1)), sum1);
+  }
+  __m256 sum = _mm256_add_ps(sum0, sum1);
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum),
+                           _mm256_extractf128_ps(sum, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_movehdup_ps(half));
+  return _mm_cvtss_f32(half);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  float32x4_t sum0 = vdupq_n_f32(0.0f);
+  float32x4_t sum1 = vdupq_n_f32(0.0f);
+  float32x4_t sum2 = vdupq_n_f32(0.0f);
+  float32x4_t sum3 = vdupq_n_f32(0.0f);
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    uint16x8_t low = vld1q_u16(rhs + i);
+    uint16x8_t high = vld1q_u16(rhs + i + 8);
+    sum0 = vfmaq_f32(sum0, vld1q_f32(lhs + i),
+                     vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(low))));
+    sum1 = vfmaq_f32(sum1, vld1q_f32(lhs + i + 4),
+                     vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(low))));
+    sum2 = vfmaq_f32(sum2, vld1q_f32(lhs + i + 8),
+                     vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(high))));
+    sum3 = vfmaq_f32(sum3, vld1q_f32(lhs + i + 12),
+                     vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(high))));
+  }
+  float32x4_t sum = vaddq_f32(vaddq_f32(sum0, sum1), vaddq_f32(sum2, sum3));
+  return vaddvq_f32(sum);
+#else
+  float sum[kBlockFloats] = { 0.0f };
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    for (uint32_t j = 0; j < kBlockFloats; ++j) {
+      sum[j] += lhs[i + j] * HalfToFloat(rhs[i + j]);
+    }
+  }
+  float total = 0.0f;
+  for (uint32_t j = 0; j < kBlockFloats; ++j) {
+    total += sum[j];
+  }
+  return total;
+#endif
+}
+
+int32_t DotProductInt8(const int8_t *lhs, const int8_t *rhs, uint32_t length) {
+#if defined(__AVX2__) && defined(__FMA__)
+  // widen to int16 and multiply add pairs, codes are within +-127
+  __m256i sum = _mm256_setzero_si256();
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    __m256i left = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i)));
+    __m256i right = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i)));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(left, right));
+  }
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                               _mm256_extracti128_si256(sum, 1));
+  half = _mm_add_epi32(half, _mm_unpackhi_epi64(half, half));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 1));
+  return _mm_cvtsi128_si32(half);
+#elif defined(__ARM_NEON)
+  int32x4_t sum = vdupq_n_s32(0);
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    int8x16_t left = vld1q_s8(lhs + i);
+    int8x16_t right = vld1q_s8(rhs + i);
+    sum = vpadalq_s16(sum, vmull_s8(vget_low_s8(left), vget_low_s8(right)));
+    sum = vpadalq_s16(sum,
+                      vmull_s8(vget_high_s8(left), vget_high_s8(right)));
+  }
+  int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+  return vget_lane_s32(vpadd_s32(pair, pair), 0);
+#else
+  int32_t sum[kBlockFloats] = { 0 };
+  for (uint32_t i = 0; i < length; i += kBlockFloats) {
+    for (uint32_t j = 0; j < kBlockFloats; ++j) {
+      sum[j] += static_cast<int32_t>(lhs[i + j]) * rhs[i + j];
+    }
+  }
+  int32_t total = 0;
+  for (uint32_t j = 0; j < kBlockFloats; ++j) {
+    total += sum[j];
+  }
+  return total;
+#endif
+}
+
+bool NormalizeFeature(const float *feature, uint32_t dim, uint32_t stride,
+                      float *row) {
+  if (feature == nullptr) {
+    return false;
+  }
+  double square_sum = 0.0;
+  for (uint32_t i = 0; i < dim; ++i) {
+    square_sum += static_cast<double>(feature[i]) * feature[i];
+  }
+  if (!(square_sum > 0.0)) {
+    return false;
+  }
+  float scale = static_cast<float>(1.0 / sqrt(square_sum));
+  for (uint32_t i = 0; i < dim; ++i) {
+    row[i] = feature[i] * scale;
+  }
+  fill(row + dim, row + stride, 0.0f);
+  return true;
+}
+
+void PushTopK(const FaceGalleryResult &result, uint32_t top_k,
+              vector<FaceGalleryResult> &heap) {
+  if (heap.size() < top_k) {
+    heap.push_back(result);
+    push_heap(heap.begin(), heap.end(), HigherScore);
+  } else if (result.score > heap.front().score) {
+    pop_heap(heap.begin(), heap.end(), HigherScore);
+    heap.back() = result;
+    push_heap(heap.begin(), heap.end(), HigherScore);
+  }
+}
+
+void SortTopK(uint32_t top_k, vector<FaceGalleryResult> &results) {
+  sort(results.begin(), results.end(), HigherScore);
+  if (results.size() > top_k) {
+    results.resize(top_k);
+  }
+}
+}
+}
@@ -0,0 +1,114 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_MATH_H_
+#define ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_MATH_H_
+
+#include <cstdint>
+#include <vector>
+#include "ascenddk/ascend_face_gallery/face_gallery.h"
+
+namespace ascend {
+namespace utils {
+
+// floats of one kernel iteration, rows are padded to a multiple of it
+const uint32_t kBlockFloats = 16;
+
+/**
+ * @brief row length of a feature, dim rounded up to whole kernel blocks
+ * @param [in] uint32_t dim: length of feature vector
+ * @return  row length in floats
+ */
+inline uint32_t FeatureStride(uint32_t dim) {
+  return (dim + kBlockFloats - 1) / kBlockFloats * kBlockFloats;
+}
+
+/**
+ * @brief dot product of two rows (AVX2, NEON or scalar)
+ * @param [in] const float *lhs: first row
+ * @param [in] const float *rhs: second row
+ * @param [in] uint32_t length: row length, a multiple of kBlockFloats
+ * @return  dot product
+ */
+float DotProduct(const float *lhs, const float *rhs, uint32_t length);
+
+/**
+ * @brief dot product of a float row and a half row (F16C, NEON or scalar)
+ * @param [in] const float *lhs: float row
+ * @param [in] const uint16_t *rhs: IEEE half row
+ * @param [in] uint32_t length: row length, a multiple of kBlockFloats
+ * @return  dot product
+ */
+float DotProductFp16(const float *lhs, const uint16_t *rhs, uint32_t length);
+
+/**
+ * @brief dot product of two int8 rows (AVX2, NEON or scalar)
+ * @param [in] const int8_t *lhs: first row
+ * @param [in] const int8_t *rhs: second row
+ * @param [in] uint32_t length: row length, a multiple of kBlockFloats and
+ *             at most 65536, so the sum can not overflow
+ * @return  dot product of the codes
+ */
+int32_t DotProductInt8(const int8_t *lhs, const int8_t *rhs, uint32_t length);
+
+/**
+ * @brief normalize a feature into a zero padded row
+ * @param [in] const float *feature: feature vector of dim floats
+ * @param [in] uint32_t dim: length of feature vector
+ * @param [in] uint32_t stride: row length
+ * @param [out] float *row: normalized row
+ * @return  true: success; false: feature is null or a zero vector
+ */
+bool NormalizeFeature(const float *feature, uint32_t dim, uint32_t stride,
+                      float *row);
+
+/**
+ * @brief keep a result in a top k min heap
+ * @param [in] const FaceGalleryResult &result: scored face
+ * @param [in] uint32_t top_k: heap size
+ * @param [out] std::vector<FaceGalleryResult> &heap: min heap of results
+ */
+void PushTopK(const FaceGalleryResult &result, uint32_t top_k,
+              std::vector<FaceGalleryResult> &heap);
+
+/**
+ * @brief sort results the highest score first and keep the top k
+ * @param [in] uint32_t top_k: max number of results
+ * @param [out] std::vector<FaceGalleryResult> &results: results
+ */
+void SortTopK(uint32_t top_k, std::vector<FaceGalleryResult> &results);
+
+}
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_GALLERY_FEATURE_MATH_H_ */
@@ -0,0 +1,154 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "opencv2/opencv.hpp"
+#include "ascenddk/ascend_face_preprocess/face_preprocess.h"
+
+using namespace std;
+
+namespace {
+// input of the model of face_recognition
+const uint32_t kDefaultWidth = 96;
+const uint32_t kDefaultHeight = 112;
+const uint32_t kDefaultFaceNumber = 10000;
+const uint32_t kChannel = 3;
+const uint32_t kTransformSize = 6;
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief the chain of face_recognition: copy into a Mat, cvtColor,
+ *        warpAffine, flip twice, cvtColor both and copy them
+ */
+void OpenCvChain(const uint8_t *nv12, uint32_t width, uint32_t height,
+                 const double *matrix, uint8_t *aligned, uint8_t *flipped) {
+  cv::Mat src(height * 3 / 2, width, CV_8UC1);
+  memcpy(src.data, nv12, width * height * 3 / 2);
+  cv::Mat bgr;
+  cv::cvtColor(src, bgr, CV_YUV2BGR_NV12);
+  cv::Mat transform(2, 3, CV_64F, const_cast<double *>(matrix));
+  cv::Mat aligned_img;
+  cv::warpAffine(bgr, aligned_img, transform, cv::Size(width, height));
+  cv::Mat h_flip;
+  cv::flip(aligned_img, h_flip, 1);
+  cv::Mat hv_flip;
+  cv::flip(h_flip, hv_flip, -1);
+  cv::cvtColor(aligned_img, aligned_img, cv::COLOR_BGR2RGB);
+  cv::cvtColor(hv_flip, hv_flip, cv::COLOR_BGR2RGB);
+  memcpy(aligned, aligned_img.data, width * height * kChannel);
+  memcpy(flipped, hv_flip.data, width * height * kChannel);
+}
+}
+
+/**
+ * usage: face_align_benchmark [width] [height] [face_number]
+ * prints the time of one face through the OpenCV chain and the fused
+ * kernel, and the max difference of their images
+ */
+int main(int argc, char *argv[]) {
+  uint32_t width = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultWidth;
+  uint32_t height =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultHeight;
+  uint32_t face_number =
+      argc > 3 ? strtoul(argv[3], nullptr, 10) : kDefaultFaceNumber;
+  if (width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0
+      || face_number == 0) {
+    printf("width and height must be even and positive, face_number "
+           "positive\n");
+    return -1;
+  }
+
+  // random faces, rotated, scaled and moved a little like real landmarks
+  mt19937 generator(0);
+  uniform_int_distribution<int> pixel(0, 255);
+  uniform_real_distribution<double> angle(-0.5, 0.5);
+  uniform_real_distribution<double> scale(0.8, 1.25);
+  uniform_real_distribution<double> shift(-10.0, 10.0);
+  uint32_t image_size = width * height * 3 / 2;
+  uint32_t rgb_size = width * height * kChannel;
+  vector<uint8_t> faces(image_size * face_number);
+  for (uint8_t &value : faces) {
+    value = pixel(generator);
+  }
+  vector<double> matrices(kTransformSize * face_number);
+  for (uint32_t face = 0; face < face_number; ++face) {
+    double rotation = angle(generator);
+    double zoom = scale(generator);
+    double *matrix = matrices.data() + kTransformSize * face;
+    matrix[0] = zoom * cos(rotation);
+    matrix[1] = -zoom * sin(rotation);
+    matrix[2] = shift(generator);
+    matrix[3] = zoom * sin(rotation);
+    matrix[4] = zoom * cos(rotation);
+    matrix[5] = shift(generator);
+  }
+
+  vector<uint8_t> expected(rgb_size * 2);
+  vector<uint8_t> images(rgb_size * 2);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t face = 0; face < face_number; ++face) {
+    OpenCvChain(faces.data() + face * image_size, width, height,
+                matrices.data() + kTransformSize * face, expected.data(),
+                expected.data() + rgb_size);
+  }
+  double chain_us = ElapsedMs(start) * 1000.0 / face_number;
+
+  start = chrono::steady_clock::now();
+  for (uint32_t face = 0; face < face_number; ++face) {
+    ascend::utils::WarpAffineNv12ToRgb(
+        faces.data() + face * image_size, width, height, width,
+        matrices.data() + kTransformSize * face, width, height,
+        images.data(), images.data() + rgb_size);
+  }
+  double fused_us = ElapsedMs(start) * 1000.0 / face_number;
+
+  // both ran the last face last
+  int max_error = 0;
+  for (uint32_t i = 0; i < rgb_size * 2; ++i) {
+    max_error = max(max_error, abs(expected[i] - images[i]));
+  }
+  printf("%ux%u, %u faces: opencv chain %.2f us/face, fused %.2f us/face "
+         "(%.1fx), max difference %d\n", width, height, face_number,
+         chain_us, fused_us, chain_us / fused_us, max_error);
+  return 0;
+}
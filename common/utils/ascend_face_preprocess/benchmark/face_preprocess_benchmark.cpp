@@ -0,0 +1,157 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "opencv2/opencv.hpp"
+#include "ascenddk/ascend_face_preprocess/face_preprocess.h"
+
+using namespace std;
+
+namespace {
+// input of the landmark model of face_feature_mask
+const uint32_t kDefaultWidth = 40;
+const uint32_t kDefaultHeight = 40;
+const uint32_t kDefaultFaceNumber = 10000;
+const uint32_t kChannel = 3;
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief the chain of face_feature_mask: copy into a Mat, cvtColor,
+ *        convertTo, subtract mean, divide std, split and copy the planes
+ */
+void OpenCvChain(const uint8_t *nv12, uint32_t width, uint32_t height,
+                 const cv::Mat &mean, const cv::Mat &std_dev, float *tensor) {
+  cv::Mat src(height * 3 / 2, width, CV_8UC1);
+  memcpy(src.data, nv12, width * height * 3 / 2);
+  cv::Mat bgr;
+  cv::cvtColor(src, bgr, CV_YUV2BGR_NV12);
+  cv::Mat normalized;
+  bgr.convertTo(normalized, CV_32FC3);
+  normalized = normalized - mean;
+  normalized = normalized / std_dev;
+
+  vector<cv::Mat> planes;
+  cv::split(normalized, planes);
+  for (const cv::Mat &plane : planes) {
+    memcpy(tensor, plane.ptr<float>(0), width * height * sizeof(float));
+    tensor += width * height;
+  }
+}
+}
+
+/**
+ * usage: face_preprocess_benchmark [width] [height] [face_number]
+ * prints the time of one face through the OpenCV chain and the fused
+ * kernel, and the max difference of their tensors
+ */
+int main(int argc, char *argv[]) {
+  uint32_t width = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultWidth;
+  uint32_t height =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultHeight;
+  uint32_t face_number =
+      argc > 3 ? strtoul(argv[3], nullptr, 10) : kDefaultFaceNumber;
+  if (width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0
+      || face_number == 0) {
+    printf("width and height must be even and positive, face_number "
+           "positive\n");
+    return -1;
+  }
+
+  // random faces, means and stds in the HWC layout of the train data
+  mt19937 generator(0);
+  uniform_int_distribution<int> pixel(0, 255);
+  uniform_real_distribution<float> mean_value(0.0f, 255.0f);
+  uniform_real_distribution<float> std_value(1.0f, 100.0f);
+  uint32_t image_size = width * height * 3 / 2;
+  uint32_t tensor_size = width * height * kChannel;
+  vector<uint8_t> faces(image_size * face_number);
+  for (uint8_t &value : faces) {
+    value = pixel(generator);
+  }
+  cv::Mat mean(height, width, CV_32FC3);
+  cv::Mat std_dev(height, width, CV_32FC3);
+  for (uint32_t i = 0; i < tensor_size; ++i) {
+    mean.ptr<float>(0)[i] = mean_value(generator);
+    std_dev.ptr<float>(0)[i] = std_value(generator);
+  }
+
+  // the fused kernel reads planar means and reciprocal stds
+  vector<float> planar_mean(tensor_size);
+  vector<float> planar_scale(tensor_size);
+  for (uint32_t i = 0; i < width * height; ++i) {
+    for (uint32_t channel = 0; channel < kChannel; ++channel) {
+      planar_mean[channel * width * height + i] =
+          mean.ptr<float>(0)[i * kChannel + channel];
+      planar_scale[channel * width * height + i] =
+          1.0f / std_dev.ptr<float>(0)[i * kChannel + channel];
+    }
+  }
+
+  vector<float> expected(tensor_size);
+  vector<float> tensor(tensor_size);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t face = 0; face < face_number; ++face) {
+    OpenCvChain(faces.data() + face * image_size, width, height, mean,
+                std_dev, expected.data());
+  }
+  double chain_us = ElapsedMs(start) * 1000.0 / face_number;
+
+  start = chrono::steady_clock::now();
+  for (uint32_t face = 0; face < face_number; ++face) {
+    ascend::utils::Nv12ToNormalizedBgrPlanes(
+        faces.data() + face * image_size, width, height, width,
+        planar_mean.data(), planar_scale.data(), tensor.data());
+  }
+  double fused_us = ElapsedMs(start) * 1000.0 / face_number;
+
+  // both ran the last face last
+  float max_error = 0.0f;
+  for (uint32_t i = 0; i < tensor_size; ++i) {
+    max_error = max(max_error, fabs(expected[i] - tensor[i]));
+  }
+  printf("%ux%u, %u faces: opencv chain %.2f us/face, fused %.2f us/face "
+         "(%.1fx), max difference %.6f\n", width, height, face_number,
+         chain_us, fused_us, chain_us / fused_us, max_error);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_PREPROCESS_FACE_PREPROCESS_H_
+#define ASCENDDK_ASCEND_FACE_PREPROCESS_FACE_PREPROCESS_H_
+
+#include <cstdint>
+
+namespace ascend {
+namespace utils {
+
+/**
+ * @brief convert a NV12 image to BGR, normalize it and write it as planes B,
+ *        G, R of a float tensor in one pass (AVX2, NEON or scalar), pixels
+ *        are the same as cv::cvtColor with CV_YUV2BGR_NV12
+ * @param [in] const uint8_t *nv12: height luma rows, then height / 2 rows of
+ *             interleaved U and V
+ * @param [in] uint32_t width: image width, even
+ * @param [in] uint32_t height: image height, even
+ * @param [in] uint32_t stride: bytes of a row, at least width
+ * @param [in] const float *mean: mean of each tensor element, 3 planes of
+ *             width * height floats
+ * @param [in] const float *scale: reciprocal std of each tensor element,
+ *             same layout as mean
+ * @param [out] float *tensor: 3 planes of width * height floats,
+ *              (pixel - mean) * scale
+ * @return  true: success; false: invalid argument
+ */
+bool Nv12ToNormalizedBgrPlanes(const uint8_t *nv12, uint32_t width,
+                               uint32_t height, uint32_t stride,
+                               const float *mean, const float *scale,
+                               float *tensor);
+
+/**
+ * @brief warp a NV12 image with an affine matrix and write it as interleaved
+ *        RGB, together with its top-to-bottom mirror, the source is sampled
+ *        in NV12 without a converted copy and each output pixel is written
+ *        once, pixels are the same as cv::cvtColor with CV_YUV2BGR_NV12, the
+ *        fixed point cv::warpAffine of OpenCV 3 and 4 with INTER_LINEAR and a
+ *        black border, and cv::COLOR_BGR2RGB
+ * @param [in] const uint8_t *nv12: height luma rows, then height / 2 rows of
+ *             interleaved U and V
+ * @param [in] uint32_t width: image width, even
+ * @param [in] uint32_t height: image height, even
+ * @param [in] uint32_t stride: bytes of a row, at least width
+ * @param [in] const double *matrix: 2x3 row major matrix from the source to
+ *             the destination, as passed to cv::warpAffine
+ * @param [in] uint32_t dst_width: width of the warped image
+ * @param [in] uint32_t dst_height: height of the warped image
+ * @param [out] uint8_t *aligned: dst_width * dst_height * 3 bytes of RGB
+ * @param [out] uint8_t *flipped: aligned with its rows reversed, nullptr to
+ *              skip it
+ * @return  true: success; false: invalid argument
+ */
+bool WarpAffineNv12ToRgb(const uint8_t *nv12, uint32_t width, uint32_t height,
+                         uint32_t stride, const double *matrix,
+                         uint32_t dst_width, uint32_t dst_height,
+                         uint8_t *aligned, uint8_t *flipped);
+
+}
+}
+
+#endif /* ASCENDDK_ASCEND_FACE_PREPROCESS_FACE_PREPROCESS_H_ */
@@ -0,0 +1,387 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "ascenddk/ascend_face_preprocess/face_preprocess.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace {
+// ITU-R BT.601 fixed point coefficients of OpenCV NV12 to BGR
+const int32_t kShift = 20;
+const int32_t kHalf = 1 << (kShift - 1);
+const int32_t kCoefY = 1220542;
+const int32_t kCoefUB = 2116026;
+const int32_t kCoefUG = -409993;
+const int32_t kCoefVG = -852492;
+const int32_t kCoefVR = 1673527;
+const int32_t kLumaOffset = 16;
+const int32_t kChromaOffset = 128;
+const int32_t kMaxPixel = 255;
+
+// pixels of one SIMD iteration
+const uint32_t kBlockPixels = 8;
+
+// B, G and R
+const uint32_t kChannel = 3;
+
+// fixed point of cv::warpAffine: source coordinates have kInterBits
+// fraction bits, the matrix kAbBits
+const int32_t kInterBits = 5;
+const int32_t kInterScale = 1 << kInterBits;
+const int32_t kAbBits = 10;
+const int32_t kAbScale = 1 << kAbBits;
+const int32_t kRoundDelta = kAbScale / kInterScale / 2;
+
+// the 4 bilinear weights of a pixel sum to 1 << kWeightBits
+const int32_t kWeightBits = 2 * kInterBits;
+const int32_t kWeightHalf = 1 << (kWeightBits - 1);
+
+// column of no converted neighbours
+const int32_t kNoColumn = -2;
+
+/**
+ * @brief convert one pixel
+ * @param [in] int32_t y: luma
+ * @param [in] int32_t u: U minus chroma offset
+ * @param [in] int32_t v: V minus chroma offset
+ * @param [out] int32_t *bgr: B, G and R
+ */
+inline void ConvertPixel(int32_t y, int32_t u, int32_t v, int32_t *bgr) {
+  int32_t luma = max(0, y - kLumaOffset) * kCoefY + kHalf;
+  bgr[0] = min(max((luma + kCoefUB * u) >> kShift, 0), kMaxPixel);
+  bgr[1] = min(max((luma + kCoefVG * v + kCoefUG * u) >> kShift, 0),
+               kMaxPixel);
+  bgr[2] = min(max((luma + kCoefVR * v) >> kShift, 0), kMaxPixel);
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief convert 8 pixels
+ * @param [in] const uint8_t *y_row: 8 luma
+ * @param [in] const uint8_t *uv_row: 4 pairs of U and V
+ * @param [out] __m256i *bgr: B, G and R of the 8 pixels
+ */
+inline void ConvertBlock(const uint8_t *y_row, const uint8_t *uv_row,
+                         __m256i *bgr) {
+  const __m256i u_index = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+  const __m256i v_index = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max_pixel = _mm256_set1_epi32(kMaxPixel);
+  __m256i y = _mm256_cvtepu8_epi32(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i *>(y_row)));
+  __m256i uv = _mm256_sub_epi32(
+      _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(uv_row))),
+      _mm256_set1_epi32(kChromaOffset));
+  __m256i u = _mm256_permutevar8x32_epi32(uv, u_index);
+  __m256i v = _mm256_permutevar8x32_epi32(uv, v_index);
+  __m256i luma = _mm256_add_epi32(
+      _mm256_mullo_epi32(
+          _mm256_max_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(kLumaOffset)),
+                           zero),
+          _mm256_set1_epi32(kCoefY)),
+      _mm256_set1_epi32(kHalf));
+  bgr[0] = _mm256_add_epi32(luma,
+                            _mm256_mullo_epi32(u, _mm256_set1_epi32(kCoefUB)));
+  bgr[1] = _mm256_add_epi32(
+      _mm256_add_epi32(luma,
+                       _mm256_mullo_epi32(v, _mm256_set1_epi32(kCoefVG))),
+      _mm256_mullo_epi32(u, _mm256_set1_epi32(kCoefUG)));
+  bgr[2] = _mm256_add_epi32(luma,
+                            _mm256_mullo_epi32(v, _mm256_set1_epi32(kCoefVR)));
+  for (uint32_t channel = 0; channel < kChannel; ++channel) {
+    bgr[channel] = _mm256_min_epi32(
+        _mm256_max_epi32(_mm256_srai_epi32(bgr[channel], kShift), zero),
+        max_pixel);
+  }
+}
+#elif defined(__ARM_NEON)
+/**
+ * @brief convert 4 pixels of 32 bit luma (offset removed) and chroma
+ */
+inline void ConvertQuad(int32x4_t y, int32x4_t u, int32x4_t v,
+                        int32x4_t *bgr) {
+  int32x4_t luma = vaddq_s32(vmulq_n_s32(y, kCoefY), vdupq_n_s32(kHalf));
+  bgr[0] = vaddq_s32(luma, vmulq_n_s32(u, kCoefUB));
+  bgr[1] = vaddq_s32(vaddq_s32(luma, vmulq_n_s32(v, kCoefVG)),
+                     vmulq_n_s32(u, kCoefUG));
+  bgr[2] = vaddq_s32(luma, vmulq_n_s32(v, kCoefVR));
+  for (uint32_t channel = 0; channel < kChannel; ++channel) {
+    bgr[channel] = vminq_s32(
+        vmaxq_s32(vshrq_n_s32(bgr[channel], kShift), vdupq_n_s32(0)),
+        vdupq_n_s32(kMaxPixel));
+  }
+}
+
+/**
+ * @brief convert 8 pixels
+ * @param [in] const uint8_t *y_row: 8 luma
+ * @param [in] const uint8_t *uv_row: 4 pairs of U and V
+ * @param [out] int32x4_t *bgr: B, G and R of pixels 0 to 3, then of pixels
+ *              4 to 7
+ */
+inline void ConvertBlock(const uint8_t *y_row, const uint8_t *uv_row,
+                         int32x4_t *bgr) {
+  int16x8_t y = vmaxq_s16(
+      vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y_row))),
+                vdupq_n_s16(kLumaOffset)),
+      vdupq_n_s16(0));
+  // U0 V0 U1 V1 .. to U0 U0 U1 U1 .. and V0 V0 V1 V1 ..
+  uint8x8_t uv = vld1_u8(uv_row);
+  uint8x8x2_t planar = vuzp_u8(uv, uv);
+  int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(
+      vzip_u8(planar.val[0], planar.val[0]).val[0])),
+                          vdupq_n_s16(kChromaOffset));
+  int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(
+      vzip_u8(planar.val[1], planar.val[1]).val[0])),
+                          vdupq_n_s16(kChromaOffset));
+  ConvertQuad(vmovl_s16(vget_low_s16(y)), vmovl_s16(vget_low_s16(u)),
+              vmovl_s16(vget_low_s16(v)), bgr);
+  ConvertQuad(vmovl_s16(vget_high_s16(y)), vmovl_s16(vget_high_s16(u)),
+              vmovl_s16(vget_high_s16(v)), bgr + kChannel);
+}
+
+/**
+ * @brief normalize 4 channel values and store them
+ */
+inline void StoreNormalized(int32x4_t value, const float *mean,
+                            const float *scale, float *tensor) {
+  float32x4_t pixel = vcvtq_f32_s32(value);
+  vst1q_f32(tensor, vmulq_f32(vsubq_f32(pixel, vld1q_f32(mean)),
+                              vld1q_f32(scale)));
+}
+#endif
+
+/**
+ * @brief convert one NV12 pixel, the same as a pixel of cv::cvtColor
+ * @param [in] const uint8_t *nv12: luma plane
+ * @param [in] const uint8_t *uv_plane: chroma plane
+ * @param [in] uint32_t stride: bytes of a row
+ * @param [in] int32_t x: column of the pixel
+ * @param [in] int32_t y: row of the pixel
+ * @param [out] int32_t *rgb: R, G and B
+ */
+inline void ConvertNv12Pixel(const uint8_t *nv12, const uint8_t *uv_plane,
+                             uint32_t stride, int32_t x, int32_t y,
+                             int32_t *rgb) {
+  const uint8_t *uv = uv_plane + stride * (y >> 1) + (x & ~1);
+  int32_t bgr[kChannel];
+  ConvertPixel(nv12[stride * y + x], uv[0] - kChromaOffset,
+               uv[1] - kChromaOffset, bgr);
+  rgb[0] = bgr[2];
+  rgb[1] = bgr[1];
+  rgb[2] = bgr[0];
+}
+}
+
+namespace ascend {
+namespace utils {
+bool Nv12ToNormalizedBgrPlanes(const uint8_t *nv12, uint32_t width,
+                               uint32_t height, uint32_t stride,
+                               const float *mean, const float *scale,
+                               float *tensor) {
+  if (nv12 == nullptr || mean == nullptr || scale == nullptr
+      || tensor == nullptr || width == 0 || height == 0 || width % 2 != 0
+      || height % 2 != 0 || stride < width) {
+    return false;
+  }
+
+  uint32_t plane = width * height;
+  const uint8_t *uv_plane = nv12 + stride * height;
+  for (uint32_t row = 0; row < height; ++row) {
+    const uint8_t *y_row = nv12 + stride * row;
+    const uint8_t *uv_row = uv_plane + stride * (row / 2);
+    uint32_t index = width * row;
+    uint32_t col = 0;
+#if defined(__AVX2__)
+    for (; col + kBlockPixels <= width; col += kBlockPixels) {
+      __m256i bgr[kChannel];
+      ConvertBlock(y_row + col, uv_row + col, bgr);
+      for (uint32_t channel = 0; channel < kChannel; ++channel) {
+        uint32_t offset = index + col + plane * channel;
+        __m256 pixel = _mm256_sub_ps(_mm256_cvtepi32_ps(bgr[channel]),
+                                     _mm256_loadu_ps(mean + offset));
+        _mm256_storeu_ps(tensor + offset,
+                         _mm256_mul_ps(pixel, _mm256_loadu_ps(scale + offset)));
+      }
+    }
+#elif defined(__ARM_NEON)
+    for (; col + kBlockPixels <= width; col += kBlockPixels) {
+      int32x4_t bgr[kChannel * 2];
+      ConvertBlock(y_row + col, uv_row + col, bgr);
+      for (uint32_t quad = 0; quad < 2; ++quad) {
+        for (uint32_t channel = 0; channel < kChannel; ++channel) {
+          uint32_t offset = index + col + quad * 4 + plane * channel;
+          StoreNormalized(bgr[quad * kChannel + channel], mean + offset,
+                          scale + offset, tensor + offset);
+        }
+      }
+    }
+#endif
+    for (; col < width; ++col) {
+      uint32_t uv_col = col & ~1u;
+      int32_t bgr[kChannel];
+      ConvertPixel(y_row[col], uv_row[uv_col] - kChromaOffset,
+                   uv_row[uv_col + 1] - kChromaOffset, bgr);
+      for (uint32_t channel = 0; channel < kChannel; ++channel) {
+        uint32_t offset = index + col + plane * channel;
+        tensor[offset] = (static_cast<float>(bgr[channel]) - mean[offset])
+            * scale[offset];
+      }
+    }
+  }
+  return true;
+}
+
+bool WarpAffineNv12ToRgb(const uint8_t *nv12, uint32_t width, uint32_t height,
+                         uint32_t stride, const double *matrix,
+                         uint32_t dst_width, uint32_t dst_height,
+                         uint8_t *aligned, uint8_t *flipped) {
+  if (nv12 == nullptr || matrix == nullptr || aligned == nullptr
+      || width == 0 || height == 0 || width % 2 != 0 || height % 2 != 0
+      || stride < width || dst_width == 0 || dst_height == 0) {
+    return false;
+  }
+
+  // the neighbours of each sample are converted from NV12 where they are
+  // read, converted the same way as cv::cvtColor converts them, so no
+  // converted copy of the source is made
+  const uint8_t *uv_plane = nv12 + stride * height;
+
+  // cv::warpAffine samples the source through the inverse matrix
+  double det = matrix[0] * matrix[4] - matrix[1] * matrix[3];
+  det = det != 0.0 ? 1.0 / det : 0.0;
+  double a11 = matrix[4] * det;
+  double a12 = -matrix[1] * det;
+  double a21 = -matrix[3] * det;
+  double a22 = matrix[0] * det;
+  double b1 = -a11 * matrix[2] - a12 * matrix[5];
+  double b2 = -a21 * matrix[2] - a22 * matrix[5];
+
+  // fixed point offsets of each column, the same for all rows
+  vector<int32_t> col_x(dst_width);
+  vector<int32_t> col_y(dst_width);
+  for (uint32_t col = 0; col < dst_width; ++col) {
+    col_x[col] = lrint(a11 * col * kAbScale);
+    col_y[col] = lrint(a21 * col * kAbScale);
+  }
+
+  int32_t max_x = static_cast<int32_t>(width) - 1;
+  int32_t max_y = static_cast<int32_t>(height) - 1;
+  uint32_t row_size = dst_width * kChannel;
+  for (uint32_t row = 0; row < dst_height; ++row) {
+    int32_t row_x = lrint((a12 * row + b1) * kAbScale) + kRoundDelta;
+    int32_t row_y = lrint((a22 * row + b2) * kAbScale) + kRoundDelta;
+    uint8_t *dst = aligned + row_size * row;
+
+    // converted neighbours [left, right][top, bottom] of the last sample
+    int32_t neighbours[2][2][kChannel];
+    int32_t cached_x = kNoColumn;
+    int32_t cached_y = kNoColumn;
+    for (uint32_t col = 0; col < dst_width; ++col, dst += kChannel) {
+      int32_t x = (row_x + col_x[col]) >> (kAbBits - kInterBits);
+      int32_t y = (row_y + col_y[col]) >> (kAbBits - kInterBits);
+      int32_t fraction_x = x & (kInterScale - 1);
+      int32_t fraction_y = y & (kInterScale - 1);
+      x >>= kInterBits;
+      y >>= kInterBits;
+      int32_t weights[4] = {
+          (kInterScale - fraction_x) * (kInterScale - fraction_y),
+          fraction_x * (kInterScale - fraction_y),
+          (kInterScale - fraction_x) * fraction_y, fraction_x * fraction_y };
+
+      // neighbours outside the source are black and add nothing
+      int32_t value[kChannel] = { kWeightHalf, kWeightHalf, kWeightHalf };
+      if (x < 0 || y < 0 || x >= max_x || y >= max_y) {
+        for (int32_t i = 0; i < 4; ++i) {
+          int32_t sample_x = x + (i & 1);
+          int32_t sample_y = y + (i >> 1);
+          if (sample_x < 0 || sample_y < 0 || sample_x > max_x
+              || sample_y > max_y) {
+            continue;
+          }
+          int32_t rgb[kChannel];
+          ConvertNv12Pixel(nv12, uv_plane, stride, sample_x, sample_y, rgb);
+          for (uint32_t channel = 0; channel < kChannel; ++channel) {
+            value[channel] += weights[i] * rgb[channel];
+          }
+        }
+        cached_x = kNoColumn;
+      } else {
+        // neighbours are read left to right along the row, so the right
+        // column of a sample is mostly the left column of the next one
+        if (y != cached_y || x != cached_x) {
+          if (y == cached_y && x == cached_x + 1) {
+            memcpy(neighbours[0], neighbours[1], sizeof(neighbours[0]));
+          } else {
+            ConvertNv12Pixel(nv12, uv_plane, stride, x, y, neighbours[0][0]);
+            ConvertNv12Pixel(nv12, uv_plane, stride, x, y + 1,
+                             neighbours[0][1]);
+          }
+          ConvertNv12Pixel(nv12, uv_plane, stride, x + 1, y, neighbours[1][0]);
+          ConvertNv12Pixel(nv12, uv_plane, stride, x + 1, y + 1,
+                           neighbours[1][1]);
+          cached_x = x;
+          cached_y = y;
+        }
+        for (uint32_t channel = 0; channel < kChannel; ++channel) {
+          value[channel] += weights[0] * neighbours[0][0][channel]
+              + weights[1] * neighbours[1][0][channel]
+              + weights[2] * neighbours[0][1][channel]
+              + weights[3] * neighbours[1][1][channel];
+        }
+      }
+      for (uint32_t channel = 0; channel < kChannel; ++channel) {
+        dst[channel] = static_cast<uint8_t>(value[channel] >> kWeightBits);
+      }
+    }
+
+    // the mirror only reverses the rows
+    if (flipped != nullptr) {
+      memcpy(flipped + row_size * (dst_height - 1 - row),
+             aligned + row_size * row, row_size);
+    }
+  }
+  return true;
+}
+}
+}
@@ -0,0 +1,141 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_FACE_TRACKER_FACE_TRACKER_H_
+#define ASCENDDK_ASCEND_FACE_TRACKER_FACE_TRACKER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ascend {
+namespace utils {
+
+// a face of a camera frame linked by the tracker
+struct TrackedFace {
+  // box of the face, set by the caller
+  float lt_x;
+  float lt_y;
+  float rb_x;
+  float rb_y;
+
+  // id of the track the face is linked to, set by Track
+  int32_t track_id;
+
+  // true if feature is the fresh feature vector of the track, set by Track
+  bool feature_cached;
+  std::vector<float> feature;
+};
+
+/**
+ * links the faces of consecutive camera frames into tracks by box overlap,
+ * so that the feature vector of a track is computed once and reused until
+ * its refresh interval. The engine linking the faces and the engine
+ * computing the feature vectors share the instance of this library, so it
+ * is defined in one translation unit instead of each engine library.
+ */
+class FaceTracker {
+ public:
+  /**
+   * @brief get the instance shared by all engines of the process
+   */
+  static FaceTracker& GetInstance();
+
+  /**
+   * @brief set tracking parameters
+   * @param [in] float iou_threshold: min overlap of a face and the last box
+   *             of its track
+   * @param [in] uint32_t refresh_interval: frames a feature vector is
+   *             reused before it is computed again
+   * @param [in] uint32_t max_lost_frames: frames a track is kept without
+   *             faces
+   */
+  void SetParams(float iou_threshold, uint32_t refresh_interval,
+                 uint32_t max_lost_frames);
+
+  /**
+   * @brief link the faces of a camera frame to tracks, a face of a track
+   *        with a fresh feature vector gets it and is marked feature_cached
+   * @param [in|out] std::vector<TrackedFace> &faces: faces of the frame
+   */
+  void Track(std::vector<TrackedFace> &faces);
+
+  /**
+   * @brief keep the feature vector computed for a track
+   * @param [in] int32_t track_id: track id of the face
+   * @param [in] const std::vector<float> &feature: feature vector of the
+   *             face
+   */
+  void UpdateFeature(int32_t track_id, const std::vector<float> &feature);
+
+ private:
+  FaceTracker();
+
+  struct FaceTrack {
+    int32_t id;
+    float lt_x;  // box of the last linked face
+    float lt_y;
+    float rb_x;
+    float rb_y;
+    uint32_t lost;  // frames since the last linked face
+    uint32_t age;  // frames since the feature vector was requested
+    std::vector<float> feature;  // empty until computed
+  };
+
+  struct TrackPair {
+    float iou;
+    uint32_t face;
+    uint32_t track;
+  };
+
+  /**
+   * @brief intersection over union of a face and the last box of a track
+   */
+  static float Iou(const TrackedFace &face, const FaceTrack &track);
+
+  std::mutex mutex_;
+  std::vector<FaceTrack> tracks_;
+
+  // candidate pairs of the last frame, kept to reuse the buffer
+  std::vector<TrackPair> pairs_;
+
+  int32_t next_id_;
+  float iou_threshold_;
+  uint32_t refresh_interval_;
+  uint32_t max_lost_frames_;
+};
+
+}  // namespace utils
+}  // namespace ascend
+
+#endif /* ASCENDDK_ASCEND_FACE_TRACKER_FACE_TRACKER_H_ */
@@ -0,0 +1,158 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include "ascenddk/ascend_face_tracker/face_tracker.h"
+
+using namespace std;
+
+namespace {
+// default tracking parameters
+const float kDefaultIouThreshold = 0.3;
+const uint32_t kDefaultRefreshInterval = 10;
+const uint32_t kDefaultMaxLostFrames = 3;
+}
+
+namespace ascend {
+namespace utils {
+FaceTracker& FaceTracker::GetInstance() {
+  static FaceTracker instance;
+  return instance;
+}
+
+FaceTracker::FaceTracker()
+    : next_id_(0),
+      iou_threshold_(kDefaultIouThreshold),
+      refresh_interval_(kDefaultRefreshInterval),
+      max_lost_frames_(kDefaultMaxLostFrames) {
+}
+
+void FaceTracker::SetParams(float iou_threshold, uint32_t refresh_interval,
+                            uint32_t max_lost_frames) {
+  lock_guard<mutex> lock(mutex_);
+  iou_threshold_ = iou_threshold;
+  refresh_interval_ = refresh_interval;
+  max_lost_frames_ = max_lost_frames;
+}
+
+void FaceTracker::Track(vector<TrackedFace> &faces) {
+  lock_guard<mutex> lock(mutex_);
+
+  // candidate pairs by overlap, greedily linked from the largest
+  pairs_.clear();
+  for (uint32_t i = 0; i < faces.size(); i++) {
+    for (uint32_t j = 0; j < tracks_.size(); j++) {
+      float iou = Iou(faces[i], tracks_[j]);
+      if (iou >= iou_threshold_) {
+        pairs_.push_back({iou, i, j});
+      }
+    }
+  }
+  sort(pairs_.begin(), pairs_.end(),
+       [](const TrackPair &a, const TrackPair &b) {
+         return a.iou > b.iou;
+       });
+
+  vector<int32_t> track_of_face(faces.size(), -1);
+  vector<bool> track_seen(tracks_.size(), false);
+  for (const TrackPair &pair : pairs_) {
+    if (track_of_face[pair.face] >= 0 || track_seen[pair.track]) {
+      continue;
+    }
+    track_of_face[pair.face] = pair.track;
+    track_seen[pair.track] = true;
+  }
+
+  for (uint32_t i = 0; i < tracks_.size(); i++) {
+    tracks_[i].lost = track_seen[i] ? 0 : tracks_[i].lost + 1;
+  }
+
+  for (uint32_t i = 0; i < faces.size(); i++) {
+    TrackedFace &face = faces[i];
+    if (track_of_face[i] < 0) {
+      FaceTrack new_track = { next_id_++, 0, 0, 0, 0, 0, 0,
+                              vector<float>() };
+      tracks_.push_back(new_track);
+      track_of_face[i] = tracks_.size() - 1;
+    }
+
+    FaceTrack &track = tracks_[track_of_face[i]];
+    track.lt_x = face.lt_x;
+    track.lt_y = face.lt_y;
+    track.rb_x = face.rb_x;
+    track.rb_y = face.rb_y;
+    face.track_id = track.id;
+    face.feature_cached = false;
+
+    // no feature yet, or due for refresh: the engines compute it
+    if (track.feature.empty() || ++track.age >= refresh_interval_) {
+      track.age = 0;
+      continue;
+    }
+    face.feature = track.feature;
+    face.feature_cached = true;
+  }
+
+  tracks_.erase(remove_if(tracks_.begin(), tracks_.end(),
+                          [this](const FaceTrack &track) {
+                            return track.lost > max_lost_frames_;
+                          }),
+                tracks_.end());
+}
+
+void FaceTracker::UpdateFeature(int32_t track_id,
+                                const vector<float> &feature) {
+  lock_guard<mutex> lock(mutex_);
+  for (FaceTrack &track : tracks_) {
+    if (track.id == track_id) {
+      track.feature = feature;
+      return;
+    }
+  }
+}
+
+float FaceTracker::Iou(const TrackedFace &face, const FaceTrack &track) {
+  float lt_x = max(face.lt_x, track.lt_x);
+  float lt_y = max(face.lt_y, track.lt_y);
+  float rb_x = min(face.rb_x, track.rb_x);
+  float rb_y = min(face.rb_y, track.rb_y);
+  if (rb_x <= lt_x || rb_y <= lt_y) {
+    return 0;
+  }
+  float inter = (rb_x - lt_x) * (rb_y - lt_y);
+  float area_face = (face.rb_x - face.lt_x) * (face.rb_y - face.lt_y);
+  float area_track = (track.rb_x - track.lt_x) * (track.rb_y - track.lt_y);
+  return inter / (area_face + area_track - inter);
+}
+}
+}
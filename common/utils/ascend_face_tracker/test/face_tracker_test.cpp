@@ -0,0 +1,115 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "ascenddk/ascend_face_tracker/face_tracker.h"
+
+using namespace std;
+using ascend::utils::FaceTracker;
+using ascend::utils::TrackedFace;
+
+namespace {
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+TrackedFace Face(float x, float y) {
+  TrackedFace face = { x, y, x + 100, y + 100, -1, false, vector<float>() };
+  return face;
+}
+
+void TestSharedInstance() {
+  Check(&FaceTracker::GetInstance() == &FaceTracker::GetInstance(),
+        "one instance");
+}
+
+void TestFeatureReused() {
+  FaceTracker &tracker = FaceTracker::GetInstance();
+  tracker.SetParams(0.3, 3, 1);
+
+  // first frame: a new track without feature
+  vector<TrackedFace> faces = { Face(0, 0) };
+  tracker.Track(faces);
+  int32_t track_id = faces[0].track_id;
+  Check(track_id >= 0, "face tracked");
+  Check(!faces[0].feature_cached, "no feature on a new track");
+  tracker.UpdateFeature(track_id, vector<float>(4, 1.0f));
+
+  // the moved face keeps its track and gets the feature until refresh
+  for (int frame = 1; frame < 3; ++frame) {
+    faces = { Face(frame * 10, 0) };
+    tracker.Track(faces);
+    Check(faces[0].track_id == track_id, "moved face keeps its track");
+    Check(faces[0].feature_cached && faces[0].feature.size() == 4,
+          "feature reused");
+  }
+  faces = { Face(30, 0) };
+  tracker.Track(faces);
+  Check(!faces[0].feature_cached, "feature refreshed after interval");
+}
+
+void TestTrackLost() {
+  FaceTracker &tracker = FaceTracker::GetInstance();
+  tracker.SetParams(0.3, 10, 1);
+  vector<TrackedFace> faces = { Face(1000, 1000) };
+  tracker.Track(faces);
+  int32_t track_id = faces[0].track_id;
+
+  // a far face starts a new track, the old one is dropped after 1 frame
+  vector<TrackedFace> far_faces = { Face(0, 1000) };
+  tracker.Track(far_faces);
+  Check(far_faces[0].track_id != track_id, "far face gets a new track");
+  tracker.Track(far_faces);
+  tracker.Track(faces);
+  Check(faces[0].track_id != track_id, "lost track dropped");
+}
+}
+
+/**
+ * usage: face_tracker_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestSharedInstance();
+  TestFeatureReused();
+  TestTrackLost();
+  printf("face_tracker_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
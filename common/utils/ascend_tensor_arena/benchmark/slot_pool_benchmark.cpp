@@ -0,0 +1,124 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "ascenddk/ascend_tensor_arena/slot_pool.h"
+
+using namespace std;
+using ascend::utils::AllocateArenaBuffer;
+using ascend::utils::SlotPool;
+
+namespace {
+// input of a batch of 10 images of the car classifiers, 224x224 bgr
+const uint32_t kDefaultBufferSize = 10 * 224 * 224 * 3;
+const uint32_t kDefaultBatchNumber = 10000;
+const size_t kAlignment = 64;
+
+struct BenchmarkSlot {
+  shared_ptr<uint8_t> buffer;
+};
+
+double ElapsedMs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// the pre-process touches every page of the input buffer
+uint32_t Touch(uint8_t *buffer, uint32_t size) {
+  const uint32_t kPageSize = 4096;
+  uint32_t sum = 0;
+  for (uint32_t offset = 0; offset < size; offset += kPageSize) {
+    buffer[offset] = static_cast<uint8_t>(offset / kPageSize + 1);
+    sum += buffer[offset];
+  }
+  return sum;
+}
+}
+
+/**
+ * usage: slot_pool_benchmark [buffer_size] [batch_number]
+ * prints the time of one batch with a new input buffer per batch and with
+ * buffers reused from a double buffered slot pool
+ */
+int main(int argc, char *argv[]) {
+  uint32_t buffer_size =
+      argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultBufferSize;
+  uint32_t batch_number =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultBatchNumber;
+  if (buffer_size == 0 || batch_number == 0) {
+    printf("buffer_size and batch_number must be positive\n");
+    return -1;
+  }
+
+  uint32_t sum = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t batch = 0; batch < batch_number; ++batch) {
+    shared_ptr<uint8_t> buffer(new uint8_t[buffer_size],
+                               default_delete<uint8_t[]>());
+    sum += Touch(buffer.get(), buffer_size);
+  }
+  double new_us = ElapsedMs(start) * 1000.0 / batch_number;
+
+  SlotPool<BenchmarkSlot> pool;
+  bool ret = pool.Init(2, 2, [buffer_size]() {
+    unique_ptr<BenchmarkSlot> slot(new BenchmarkSlot());
+    slot->buffer = AllocateArenaBuffer(buffer_size, kAlignment);
+    return slot;
+  }, [](const BenchmarkSlot &slot) {return slot.buffer.use_count() == 1;});
+  if (!ret) {
+    printf("slot pool init failed\n");
+    return -1;
+  }
+
+  // the result of the previous batch is still held by the next engine
+  shared_ptr<uint8_t> previous;
+  start = chrono::steady_clock::now();
+  for (uint32_t batch = 0; batch < batch_number; ++batch) {
+    BenchmarkSlot *slot = pool.Next();
+    if (slot == nullptr) {
+      printf("no free slot at batch %u\n", batch);
+      return -1;
+    }
+    sum += Touch(slot->buffer.get(), buffer_size);
+    previous = slot->buffer;
+  }
+  double pool_us = ElapsedMs(start) * 1000.0 / batch_number;
+
+  printf("%u bytes, %u batches: new buffer %.2f us/batch, slot pool %.2f "
+         "us/batch (%.1fx), %zu slots (checksum %u)\n", buffer_size,
+         batch_number, new_us, pool_us, new_us / pool_us, pool.size(), sum);
+  return 0;
+}
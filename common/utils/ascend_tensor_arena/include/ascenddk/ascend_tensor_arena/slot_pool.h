@@ -0,0 +1,172 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_TENSOR_ARENA_SLOT_POOL_H_
+#define ASCENDDK_ASCEND_TENSOR_ARENA_SLOT_POOL_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ascend {
+namespace utils {
+
+/**
+ * @brief allocate a zero filled buffer
+ * @param [in] size_t size: buffer size in bytes
+ * @param [in] size_t alignment: alignment in bytes, a power of two multiple
+ *             of sizeof(void*), 0 for the default alignment of new
+ * @return  buffer, nullptr if allocation failed
+ */
+inline std::shared_ptr<uint8_t> AllocateArenaBuffer(size_t size,
+                                                    size_t alignment) {
+  std::shared_ptr<uint8_t> buffer;
+  if (alignment == 0) {
+    buffer.reset(new (std::nothrow) uint8_t[size](),
+                 std::default_delete<uint8_t[]>());
+    return buffer;
+  }
+
+  void *memory = nullptr;
+  if (posix_memalign(&memory, alignment, size) != 0) {
+    return buffer;
+  }
+  memset(memory, 0, size);
+  buffer.reset(static_cast<uint8_t *>(memory), free);
+  return buffer;
+}
+
+/**
+ * a bounded set of reusable slots, used in turn. A slot which is still in use
+ * is skipped, and a new slot is only created when all slots are in use, up to
+ * max_slot_number slots. Slots are never moved, so a returned slot stays
+ * valid while the pool is alive.
+ */
+template<typename Slot>
+class SlotPool {
+ public:
+  // creates a slot, returns nullptr if allocation failed
+  typedef std::function<std::unique_ptr<Slot>()> SlotCreator;
+
+  // returns true if the slot can be reused
+  typedef std::function<bool(const Slot &)> SlotChecker;
+
+  SlotPool()
+      : max_slot_number_(0),
+        next_slot_(0) {
+  }
+
+  /**
+   * @brief create the first slots
+   * @param [in] uint32_t slot_number: number of preallocated slots
+   * @param [in] uint32_t max_slot_number: upper bound of the number of
+   *             slots, not less than slot_number
+   * @param [in] SlotCreator creator: creates a slot
+   * @param [in] SlotChecker is_free: checks if a slot can be reused
+   * @return  true: success; false: invalid slot number or creation failed
+   */
+  bool Init(uint32_t slot_number, uint32_t max_slot_number,
+            SlotCreator creator, SlotChecker is_free) {
+    slots_.clear();
+    next_slot_ = 0;
+    if (slot_number == 0 || max_slot_number < slot_number) {
+      return false;
+    }
+
+    max_slot_number_ = max_slot_number;
+    creator_ = creator;
+    is_free_ = is_free;
+    slots_.reserve(max_slot_number_);
+    for (uint32_t index = 0; index < slot_number; ++index) {
+      if (!AddSlot()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief get the next free slot
+   * @return  slot, nullptr if every slot is in use and max_slot_number is
+   *          reached, or a new slot is needed but creation failed
+   */
+  Slot *Next() {
+    for (size_t count = 0; count < slots_.size(); ++count) {
+      Slot *slot = slots_[next_slot_].get();
+      next_slot_ = (next_slot_ + 1) % slots_.size();
+      if (is_free_(*slot)) {
+        return slot;
+      }
+    }
+
+    // every slot is still held by a consumer
+    if (slots_.size() >= max_slot_number_ || !AddSlot()) {
+      return nullptr;
+    }
+    next_slot_ = 0;
+    return slots_.back().get();
+  }
+
+  /**
+   * @brief number of created slots
+   */
+  size_t size() const {
+    return slots_.size();
+  }
+
+ private:
+  bool AddSlot() {
+    std::unique_ptr<Slot> slot = creator_();
+    if (slot == nullptr) {
+      return false;
+    }
+    slots_.push_back(std::move(slot));
+    return true;
+  }
+
+  std::vector<std::unique_ptr<Slot>> slots_;
+  SlotCreator creator_;
+  SlotChecker is_free_;
+  uint32_t max_slot_number_;
+  size_t next_slot_;
+};
+
+}  // namespace utils
+}  // namespace ascend
+
+#endif /* ASCENDDK_ASCEND_TENSOR_ARENA_SLOT_POOL_H_ */
@@ -0,0 +1,129 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef ASCENDDK_ASCEND_TENSOR_ARENA_TENSOR_ARENA_H_
+#define ASCENDDK_ASCEND_TENSOR_ARENA_TENSOR_ARENA_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "hiaiengine/ai_model_manager.h"
+#include "hiaiengine/ai_tensor.h"
+#include "hiaiengine/ai_types.h"
+#include "ascenddk/ascend_tensor_arena/slot_pool.h"
+
+namespace ascend {
+namespace utils {
+
+// input and output tensors of one inference, allocated once
+struct TensorArenaSlot {
+  // input buffer, owned by the slot and zero filled when allocated
+  std::shared_ptr<uint8_t> input_buffer;
+  uint32_t input_size;
+  std::shared_ptr<hiai::AINeuralNetworkBuffer> input_tensor;
+  std::vector<std::shared_ptr<hiai::IAITensor>> input_tensors;
+
+  // output buffers, owned by the slot and wrapped by output_tensors
+  std::vector<std::shared_ptr<uint8_t>> output_buffers;
+  std::vector<uint32_t> output_sizes;
+  std::vector<std::shared_ptr<hiai::IAITensor>> output_tensors;
+};
+
+/**
+ * preallocated input and output tensors of a model, sized from the model io
+ * dims at engine init. Slots are used in turn (double buffered by default);
+ * a slot whose output buffer is still referenced outside the arena, e.g. sent
+ * to the next engine, is skipped, and a new slot is only allocated when all
+ * slots are still in use, up to max_slot_number slots.
+ */
+class TensorArena {
+ public:
+  // default upper bound of the number of slots
+  static const uint32_t kMaxSlotNumber = 8;
+
+  TensorArena();
+
+  /**
+   * @brief allocate slots for a model
+   * @param [in] model_manager: model manager which has loaded the model
+   * @param [in] model_name: model name set in the model description
+   * @param [in] slot_number: number of preallocated slots
+   * @param [in] max_slot_number: upper bound of the number of slots, not
+   *             less than slot_number
+   * @param [in] input_alignment: alignment of input buffers in bytes, e.g.
+   *             for the SIMD stores of a pre-process, 0 for the default
+   * @return true: success; false: invalid slot number, get model dims or
+   *         allocation failed
+   */
+  bool Init(const std::shared_ptr<hiai::AIModelManager>& model_manager,
+            const std::string& model_name, uint32_t slot_number = 2,
+            uint32_t max_slot_number = kMaxSlotNumber,
+            size_t input_alignment = 0);
+
+  /**
+   * @brief get the next free slot, its output tensors can be passed to
+   *        AIModelManager::Process directly
+   * @return slot, nullptr if every slot is in use and max_slot_number is
+   *         reached, or a new slot is needed but allocation failed
+   */
+  TensorArenaSlot* NextSlot();
+
+  /**
+   * @brief size of the model input buffer
+   */
+  uint32_t input_size() const {
+    return input_size_;
+  }
+
+  /**
+   * @brief number of allocated slots
+   */
+  size_t slot_number() const {
+    return slots_.size();
+  }
+
+ private:
+  std::unique_ptr<TensorArenaSlot> CreateSlot() const;
+
+  static bool IsFree(const TensorArenaSlot& slot);
+
+  uint32_t input_size_;
+  std::vector<uint32_t> output_sizes_;
+  size_t input_alignment_;
+  SlotPool<TensorArenaSlot> slots_;
+};
+
+}  // namespace utils
+}  // namespace ascend
+
+#endif /* ASCENDDK_ASCEND_TENSOR_ARENA_TENSOR_ARENA_H_ */
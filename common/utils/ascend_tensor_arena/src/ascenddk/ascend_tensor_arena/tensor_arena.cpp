@@ -0,0 +1,122 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "ascenddk/ascend_tensor_arena/tensor_arena.h"
+
+#include <new>
+
+using namespace std;
+
+namespace ascend {
+namespace utils {
+
+TensorArena::TensorArena()
+    : input_size_(0),
+      input_alignment_(0) {
+}
+
+bool TensorArena::Init(const shared_ptr<hiai::AIModelManager>& model_manager,
+                       const string& model_name, uint32_t slot_number,
+                       uint32_t max_slot_number, size_t input_alignment) {
+  vector<hiai::TensorDimension> input_dims;
+  vector<hiai::TensorDimension> output_dims;
+  hiai::AIStatus ret = model_manager->GetModelIOTensorDim(model_name,
+                                                          input_dims,
+                                                          output_dims);
+  if (ret != hiai::SUCCESS || input_dims.empty() || output_dims.empty()) {
+    return false;
+  }
+
+  input_size_ = input_dims[0].size;
+  input_alignment_ = input_alignment;
+  output_sizes_.clear();
+  for (const hiai::TensorDimension& dim : output_dims) {
+    output_sizes_.push_back(dim.size);
+  }
+
+  return slots_.Init(slot_number, max_slot_number,
+                     [this]() {return CreateSlot();}, IsFree);
+}
+
+TensorArenaSlot* TensorArena::NextSlot() {
+  return slots_.Next();
+}
+
+unique_ptr<TensorArenaSlot> TensorArena::CreateSlot() const {
+  unique_ptr<TensorArenaSlot> slot(new (nothrow) TensorArenaSlot());
+  if (slot == nullptr) {
+    return nullptr;
+  }
+
+  slot->input_size = input_size_;
+  slot->input_buffer = AllocateArenaBuffer(input_size_, input_alignment_);
+  if (slot->input_buffer == nullptr) {
+    return nullptr;
+  }
+  slot->input_tensor = make_shared<hiai::AINeuralNetworkBuffer>();
+  slot->input_tensor->SetBuffer(slot->input_buffer.get(), input_size_, false);
+  slot->input_tensors.push_back(
+      static_pointer_cast<hiai::IAITensor>(slot->input_tensor));
+
+  hiai::AITensorDescription description =
+      hiai::AINeuralNetworkBuffer::GetDescription();
+  for (uint32_t size : output_sizes_) {
+    shared_ptr<uint8_t> buffer = AllocateArenaBuffer(size, 0);
+    if (buffer == nullptr) {
+      return nullptr;
+    }
+    shared_ptr<hiai::IAITensor> tensor =
+        hiai::AITensorFactory::GetInstance()->CreateTensor(description,
+                                                           buffer.get(),
+                                                           size);
+    if (tensor == nullptr) {
+      return nullptr;
+    }
+    slot->output_buffers.push_back(buffer);
+    slot->output_sizes.push_back(size);
+    slot->output_tensors.push_back(tensor);
+  }
+  return slot;
+}
+
+bool TensorArena::IsFree(const TensorArenaSlot& slot) {
+  for (const shared_ptr<uint8_t>& buffer : slot.output_buffers) {
+    if (buffer.use_count() > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace utils
+}  // namespace ascend
@@ -0,0 +1,151 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "ascenddk/ascend_tensor_arena/slot_pool.h"
+
+using namespace std;
+using ascend::utils::AllocateArenaBuffer;
+using ascend::utils::SlotPool;
+
+namespace {
+const uint32_t kBufferSize = 1000;
+const size_t kAlignment = 64;
+
+// a slot like TensorArenaSlot: busy while its buffer is held outside
+struct TestSlot {
+  shared_ptr<uint8_t> buffer;
+};
+
+unique_ptr<TestSlot> CreateSlot() {
+  unique_ptr<TestSlot> slot(new TestSlot());
+  slot->buffer = AllocateArenaBuffer(kBufferSize, kAlignment);
+  return slot;
+}
+
+bool IsFree(const TestSlot &slot) {
+  return slot.buffer.use_count() == 1;
+}
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+void TestAllocateArenaBuffer() {
+  shared_ptr<uint8_t> aligned = AllocateArenaBuffer(kBufferSize, kAlignment);
+  Check(aligned != nullptr, "aligned buffer allocated");
+  Check(reinterpret_cast<uintptr_t>(aligned.get()) % kAlignment == 0,
+        "buffer aligned");
+  shared_ptr<uint8_t> plain = AllocateArenaBuffer(kBufferSize, 0);
+  Check(plain != nullptr, "default buffer allocated");
+  bool zero = true;
+  for (uint32_t i = 0; i < kBufferSize; ++i) {
+    zero = zero && aligned.get()[i] == 0 && plain.get()[i] == 0;
+  }
+  Check(zero, "buffers zero filled");
+}
+
+void TestInvalidSlotNumber() {
+  SlotPool<TestSlot> pool;
+  Check(!pool.Init(0, 4, CreateSlot, IsFree), "zero slots rejected");
+  Check(!pool.Init(3, 2, CreateSlot, IsFree), "max below slots rejected");
+}
+
+void TestRoundRobin() {
+  SlotPool<TestSlot> pool;
+  Check(pool.Init(2, 4, CreateSlot, IsFree), "init");
+  TestSlot *first = pool.Next();
+  TestSlot *second = pool.Next();
+  Check(first != nullptr && second != nullptr && first != second,
+        "slots used in turn");
+  Check(pool.Next() == first, "free slot reused");
+  Check(pool.size() == 2, "no slot added while slots are free");
+}
+
+void TestBusySlotSkipped() {
+  SlotPool<TestSlot> pool;
+  Check(pool.Init(2, 4, CreateSlot, IsFree), "init");
+  TestSlot *first = pool.Next();
+  shared_ptr<uint8_t> held = first->buffer;
+  TestSlot *second = pool.Next();
+  Check(pool.Next() == second, "busy slot skipped");
+  held.reset();
+  Check(pool.Next() == first, "released slot reused");
+}
+
+void TestGrowthIsBounded() {
+  SlotPool<TestSlot> pool;
+  Check(pool.Init(2, 3, CreateSlot, IsFree), "init");
+  vector<shared_ptr<uint8_t>> held;
+  vector<TestSlot *> slots;
+  for (int i = 0; i < 3; ++i) {
+    TestSlot *slot = pool.Next();
+    Check(slot != nullptr, "slot up to max_slot_number");
+    if (slot == nullptr) {
+      return;
+    }
+    slots.push_back(slot);
+    held.push_back(slot->buffer);
+  }
+  Check(pool.size() == 3, "one slot added");
+  Check(pool.Next() == nullptr, "no slot beyond max_slot_number");
+  Check(pool.size() == 3, "no slot added beyond max_slot_number");
+
+  // slots handed out before the growth are still the same slots
+  Check(slots[0]->buffer == held[0] && slots[1]->buffer == held[1],
+        "slot pointers stable across growth");
+  held[1].reset();
+  Check(pool.Next() == slots[1], "released slot reused at the cap");
+}
+}
+
+/**
+ * usage: slot_pool_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestAllocateArenaBuffer();
+  TestInvalidSlotNumber();
+  TestRoundRobin();
+  TestBusySlotSkipped();
+  TestGrowthIsBounded();
+  printf("slot_pool_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
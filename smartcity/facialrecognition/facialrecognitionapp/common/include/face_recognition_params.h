@@ -163,6 +163,12 @@ struct FaceImage {
   FaceRectangle rectangle;  // face rectangle
   FaceFeature feature_mask;  // face feature mask
   std::vector<float> feature_vector;  // face feature vector
+  bool matched = false;  // matched on device, feature_vector is dropped
+  std::string match_name = "";  // name of matched registered face
+  float match_score = 0;  // similarity of matched registered face
+  int32_t track_id = -1;  // id of face track, -1 when not tracked
+  bool feature_cached = false;  // feature_vector reused from the track
+  bool quality_skipped = false;  // failed quality check, no feature_vector
 };
 
 /**
@@ -171,7 +177,9 @@ struct FaceImage {
  */
 template<class Archive>
 void serialize(Archive& ar, FaceImage& data) {
-  ar(data.image, data.rectangle, data.feature_mask, data.feature_vector);
+  ar(data.image, data.rectangle, data.feature_mask, data.feature_vector,
+     data.matched, data.match_name, data.match_score, data.track_id,
+     data.feature_cached, data.quality_skipped);
 }
 
 /**
@@ -37,7 +37,7 @@ namespace protobuf_facial_5frecognition_5fmessage_2eproto {
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[7];
+  static const ::google::protobuf::internal::ParseTable schema[8];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -57,6 +57,8 @@ void InitDefaultsFaceResultImpl();
 void InitDefaultsFaceResult();
 void InitDefaultsFrameInfoImpl();
 void InitDefaultsFrameInfo();
+void InitDefaultsGallerySyncImpl();
+void InitDefaultsGallerySync();
 inline void InitDefaults() {
   InitDefaultsCommonResponse();
   InitDefaultsRegisterApp();
@@ -65,6 +67,7 @@ inline void InitDefaults() {
   InitDefaultsFaceInfo();
   InitDefaultsFaceResult();
   InitDefaultsFrameInfo();
+  InitDefaultsGallerySync();
 }
 }  // namespace protobuf_facial_5frecognition_5fmessage_2eproto
 namespace ascend {
@@ -88,6 +91,9 @@ extern FaceResultDefaultTypeInternal _FaceResult_default_instance_;
 class FrameInfo;
 class FrameInfoDefaultTypeInternal;
 extern FrameInfoDefaultTypeInternal _FrameInfo_default_instance_;
+class GallerySync;
+class GallerySyncDefaultTypeInternal;
+extern GallerySyncDefaultTypeInternal _GallerySync_default_instance_;
 class RegisterApp;
 class RegisterAppDefaultTypeInternal;
 extern RegisterAppDefaultTypeInternal _RegisterApp_default_instance_;
@@ -122,6 +128,28 @@ inline bool ErrorCode_Parse(
   return ::google::protobuf::internal::ParseNamedEnum<ErrorCode>(
     ErrorCode_descriptor(), name, value);
 }
+enum FeatureEncoding {
+  kFeatureFloat32 = 0,
+  kFeatureFp16 = 1,
+  kFeatureInt8 = 2,
+  FeatureEncoding_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
+  FeatureEncoding_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
+};
+bool FeatureEncoding_IsValid(int value);
+const FeatureEncoding FeatureEncoding_MIN = kFeatureFloat32;
+const FeatureEncoding FeatureEncoding_MAX = kFeatureInt8;
+const int FeatureEncoding_ARRAYSIZE = FeatureEncoding_MAX + 1;
+
+const ::google::protobuf::EnumDescriptor* FeatureEncoding_descriptor();
+inline const ::std::string& FeatureEncoding_Name(FeatureEncoding value) {
+  return ::google::protobuf::internal::NameOfEnum(
+    FeatureEncoding_descriptor(), value);
+}
+inline bool FeatureEncoding_Parse(
+    const ::std::string& name, FeatureEncoding* value) {
+  return ::google::protobuf::internal::ParseNamedEnum<FeatureEncoding>(
+    FeatureEncoding_descriptor(), name, value);
+}
 // ===================================================================
 
 class CommonResponse : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.facial_recognition.CommonResponse) */ {
@@ -574,6 +602,34 @@ class FaceFeature : public ::google::protobuf::Message /* @@protoc_insertion_poi
   ::google::protobuf::RepeatedField< float >*
       mutable_vector();
 
+  // bytes packed_vector = 5;
+  void clear_packed_vector();
+  static const int kPackedVectorFieldNumber = 5;
+  const ::std::string& packed_vector() const;
+  void set_packed_vector(const ::std::string& value);
+  #if LANG_CXX11
+  void set_packed_vector(::std::string&& value);
+  #endif
+  void set_packed_vector(const char* value);
+  void set_packed_vector(const void* value, size_t size);
+  ::std::string* mutable_packed_vector();
+  ::std::string* release_packed_vector();
+  void set_allocated_packed_vector(::std::string* packed_vector);
+
+  // string name = 6;
+  void clear_name();
+  static const int kNameFieldNumber = 6;
+  const ::std::string& name() const;
+  void set_name(const ::std::string& value);
+  #if LANG_CXX11
+  void set_name(::std::string&& value);
+  #endif
+  void set_name(const char* value);
+  void set_name(const char* value, size_t size);
+  ::std::string* mutable_name();
+  ::std::string* release_name();
+  void set_allocated_name(::std::string* name);
+
   // .ascend.presenter.facial_recognition.Box box = 1;
   bool has_box() const;
   void clear_box();
@@ -583,13 +639,36 @@ class FaceFeature : public ::google::protobuf::Message /* @@protoc_insertion_poi
   ::ascend::presenter::facial_recognition::Box* mutable_box();
   void set_allocated_box(::ascend::presenter::facial_recognition::Box* box);
 
+  // .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+  void clear_encoding();
+  static const int kEncodingFieldNumber = 3;
+  ::ascend::presenter::facial_recognition::FeatureEncoding encoding() const;
+  void set_encoding(::ascend::presenter::facial_recognition::FeatureEncoding value);
+
+  // float scale = 4;
+  void clear_scale();
+  static const int kScaleFieldNumber = 4;
+  float scale() const;
+  void set_scale(float value);
+
+  // float score = 7;
+  void clear_score();
+  static const int kScoreFieldNumber = 7;
+  float score() const;
+  void set_score(float value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.facial_recognition.FaceFeature)
  private:
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::RepeatedField< float > vector_;
   mutable int _vector_cached_byte_size_;
+  ::google::protobuf::internal::ArenaStringPtr packed_vector_;
+  ::google::protobuf::internal::ArenaStringPtr name_;
   ::ascend::presenter::facial_recognition::Box* box_;
+  int encoding_;
+  float scale_;
+  float score_;
   mutable int _cached_size_;
   friend struct ::protobuf_facial_5frecognition_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsFaceFeatureImpl();
@@ -966,6 +1045,125 @@ class FrameInfo : public ::google::protobuf::Message /* @@protoc_insertion_point
   friend struct ::protobuf_facial_5frecognition_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsFrameInfoImpl();
 };
+// -------------------------------------------------------------------
+
+class GallerySync : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.facial_recognition.GallerySync) */ {
+ public:
+  GallerySync();
+  virtual ~GallerySync();
+
+  GallerySync(const GallerySync& from);
+
+  inline GallerySync& operator=(const GallerySync& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  GallerySync(GallerySync&& from) noexcept
+    : GallerySync() {
+    *this = ::std::move(from);
+  }
+
+  inline GallerySync& operator=(GallerySync&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const GallerySync& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const GallerySync* internal_default_instance() {
+    return reinterpret_cast<const GallerySync*>(
+               &_GallerySync_default_instance_);
+  }
+  static PROTOBUF_CONSTEXPR int const kIndexInFileMessages =
+    7;
+
+  void Swap(GallerySync* other);
+  friend void swap(GallerySync& a, GallerySync& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline GallerySync* New() const PROTOBUF_FINAL { return New(NULL); }
+
+  GallerySync* New(::google::protobuf::Arena* arena) const PROTOBUF_FINAL;
+  void CopyFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void MergeFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void CopyFrom(const GallerySync& from);
+  void MergeFrom(const GallerySync& from);
+  void Clear() PROTOBUF_FINAL;
+  bool IsInitialized() const PROTOBUF_FINAL;
+
+  size_t ByteSizeLong() const PROTOBUF_FINAL;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) PROTOBUF_FINAL;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const PROTOBUF_FINAL;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const PROTOBUF_FINAL;
+  int GetCachedSize() const PROTOBUF_FINAL { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const PROTOBUF_FINAL;
+  void InternalSwap(GallerySync* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const PROTOBUF_FINAL;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+  int face_size() const;
+  void clear_face();
+  static const int kFaceFieldNumber = 2;
+  const ::ascend::presenter::facial_recognition::FaceFeature& face(int index) const;
+  ::ascend::presenter::facial_recognition::FaceFeature* mutable_face(int index);
+  ::ascend::presenter::facial_recognition::FaceFeature* add_face();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::facial_recognition::FaceFeature >*
+      mutable_face();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::facial_recognition::FaceFeature >&
+      face() const;
+
+  // bool reset = 1;
+  void clear_reset();
+  static const int kResetFieldNumber = 1;
+  bool reset() const;
+  void set_reset(bool value);
+
+  // float threshold = 3;
+  void clear_threshold();
+  static const int kThresholdFieldNumber = 3;
+  float threshold() const;
+  void set_threshold(float value);
+
+  // @@protoc_insertion_point(class_scope:ascend.presenter.facial_recognition.GallerySync)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::facial_recognition::FaceFeature > face_;
+  bool reset_;
+  float threshold_;
+  mutable int _cached_size_;
+  friend struct ::protobuf_facial_5frecognition_5fmessage_2eproto::TableStruct;
+  friend void ::protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsGallerySyncImpl();
+};
 // ===================================================================
 
 
@@ -1298,6 +1496,154 @@ FaceFeature::mutable_vector() {
   return &vector_;
 }
 
+// .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+inline void FaceFeature::clear_encoding() {
+  encoding_ = 0;
+}
+inline ::ascend::presenter::facial_recognition::FeatureEncoding FaceFeature::encoding() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.FaceFeature.encoding)
+  return static_cast< ::ascend::presenter::facial_recognition::FeatureEncoding >(encoding_);
+}
+inline void FaceFeature::set_encoding(::ascend::presenter::facial_recognition::FeatureEncoding value) {
+  
+  encoding_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.FaceFeature.encoding)
+}
+
+// float scale = 4;
+inline void FaceFeature::clear_scale() {
+  scale_ = 0;
+}
+inline float FaceFeature::scale() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.FaceFeature.scale)
+  return scale_;
+}
+inline void FaceFeature::set_scale(float value) {
+  
+  scale_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.FaceFeature.scale)
+}
+
+// bytes packed_vector = 5;
+inline void FaceFeature::clear_packed_vector() {
+  packed_vector_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& FaceFeature::packed_vector() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+  return packed_vector_.GetNoArena();
+}
+inline void FaceFeature::set_packed_vector(const ::std::string& value) {
+  
+  packed_vector_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+}
+#if LANG_CXX11
+inline void FaceFeature::set_packed_vector(::std::string&& value) {
+  
+  packed_vector_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+}
+#endif
+inline void FaceFeature::set_packed_vector(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  packed_vector_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+}
+inline void FaceFeature::set_packed_vector(const void* value, size_t size) {
+  
+  packed_vector_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+}
+inline ::std::string* FaceFeature::mutable_packed_vector() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+  return packed_vector_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* FaceFeature::release_packed_vector() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+  
+  return packed_vector_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void FaceFeature::set_allocated_packed_vector(::std::string* packed_vector) {
+  if (packed_vector != NULL) {
+    
+  } else {
+    
+  }
+  packed_vector_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), packed_vector);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.facial_recognition.FaceFeature.packed_vector)
+}
+
+// string name = 6;
+inline void FaceFeature::clear_name() {
+  name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& FaceFeature::name() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.FaceFeature.name)
+  return name_.GetNoArena();
+}
+inline void FaceFeature::set_name(const ::std::string& value) {
+  
+  name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.FaceFeature.name)
+}
+#if LANG_CXX11
+inline void FaceFeature::set_name(::std::string&& value) {
+  
+  name_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.facial_recognition.FaceFeature.name)
+}
+#endif
+inline void FaceFeature::set_name(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.facial_recognition.FaceFeature.name)
+}
+inline void FaceFeature::set_name(const char* value, size_t size) {
+  
+  name_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.facial_recognition.FaceFeature.name)
+}
+inline ::std::string* FaceFeature::mutable_name() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.facial_recognition.FaceFeature.name)
+  return name_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* FaceFeature::release_name() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.facial_recognition.FaceFeature.name)
+  
+  return name_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void FaceFeature::set_allocated_name(::std::string* name) {
+  if (name != NULL) {
+    
+  } else {
+    
+  }
+  name_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), name);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.facial_recognition.FaceFeature.name)
+}
+
+// float score = 7;
+inline void FaceFeature::clear_score() {
+  score_ = 0;
+}
+inline float FaceFeature::score() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.FaceFeature.score)
+  return score_;
+}
+inline void FaceFeature::set_score(float value) {
+  
+  score_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.FaceFeature.score)
+}
+
 // -------------------------------------------------------------------
 
 // FaceInfo
@@ -1632,6 +1978,68 @@ FrameInfo::feature() const {
   return feature_;
 }
 
+// -------------------------------------------------------------------
+
+// GallerySync
+
+// bool reset = 1;
+inline void GallerySync::clear_reset() {
+  reset_ = false;
+}
+inline bool GallerySync::reset() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.GallerySync.reset)
+  return reset_;
+}
+inline void GallerySync::set_reset(bool value) {
+  
+  reset_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.GallerySync.reset)
+}
+
+// repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+inline int GallerySync::face_size() const {
+  return face_.size();
+}
+inline void GallerySync::clear_face() {
+  face_.Clear();
+}
+inline const ::ascend::presenter::facial_recognition::FaceFeature& GallerySync::face(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.GallerySync.face)
+  return face_.Get(index);
+}
+inline ::ascend::presenter::facial_recognition::FaceFeature* GallerySync::mutable_face(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.facial_recognition.GallerySync.face)
+  return face_.Mutable(index);
+}
+inline ::ascend::presenter::facial_recognition::FaceFeature* GallerySync::add_face() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.facial_recognition.GallerySync.face)
+  return face_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::facial_recognition::FaceFeature >*
+GallerySync::mutable_face() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.facial_recognition.GallerySync.face)
+  return &face_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::facial_recognition::FaceFeature >&
+GallerySync::face() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.facial_recognition.GallerySync.face)
+  return face_;
+}
+
+// float threshold = 3;
+inline void GallerySync::clear_threshold() {
+  threshold_ = 0;
+}
+inline float GallerySync::threshold() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.facial_recognition.GallerySync.threshold)
+  return threshold_;
+}
+inline void GallerySync::set_threshold(float value) {
+  
+  threshold_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.facial_recognition.GallerySync.threshold)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -1647,6 +2055,8 @@ FrameInfo::feature() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -1662,6 +2072,11 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::ascend::presenter::facial_recognition::ErrorCode>() {
   return ::ascend::presenter::facial_recognition::ErrorCode_descriptor();
 }
+template <> struct is_proto_enum< ::ascend::presenter::facial_recognition::FeatureEncoding> : ::google::protobuf::internal::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::ascend::presenter::facial_recognition::FeatureEncoding>() {
+  return ::ascend::presenter::facial_recognition::FeatureEncoding_descriptor();
+}
 
 }  // namespace protobuf
 }  // namespace google
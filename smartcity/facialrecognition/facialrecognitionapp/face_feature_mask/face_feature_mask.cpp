@@ -36,6 +36,10 @@
 #include "hiaiengine/log.h"
 #include "hiaiengine/data_type_reg.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
+#include "ascenddk/ascend_face_preprocess/face_preprocess.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <memory>
 #include <fstream>
 #include <sstream>
@@ -46,7 +50,6 @@ using namespace ascend::utils;
 using hiai::Engine;
 using namespace std;
 using namespace hiai;
-using namespace cv;
 
 namespace {
 // The image's width need to be resized
@@ -65,6 +68,19 @@ const int32_t kEachResultTensorNum = 10;
 const float kNormalizedCenterData = 0.5;
 
 const int32_t kSendDataIntervalMiss = 20;
+
+// The model name for the model description and the tensor arena
+const string kModelName = "face_feature_mask";
+
+// One batch is in flight at a time, its result is copied out right away
+const uint32_t kTensorArenaSlots = 1;
+
+// The fused pre-process stores whole SIMD vectors, align the batch to a cache
+// line
+const size_t kInputAlignment = 64;
+
+// Batches between two latency reports
+const int32_t kLatencyReportBatches = 100;
 }
 
 /**
@@ -96,6 +112,7 @@ bool FaceFeatureMaskProcess::InitAiModel(const AIConfig &config) {
 
   vector<AIModelDescription> model_desc_vec;
   AIModelDescription model_desc;
+  model_desc.set_name(kModelName);
 
   // Get the model information from the file graph.config
   for (int index = 0; index < config.items_size(); ++index) {
@@ -120,27 +137,42 @@ bool FaceFeatureMaskProcess::InitAiModel(const AIConfig &config) {
                     "AI model init failed!");
     return false;
   }
-  return true;
-}
 
-bool FaceFeatureMaskProcess::InitNormlizedData() {
-  // Load the mean data
-  Mat train_mean_value(kResizedImgWidth, kResizedImgHeight, CV_32FC3, (void *)kTrainMean);
-  train_mean_ = train_mean_value;
-  if (train_mean_.empty()) {
+  // The batch tensors are reused by every inference
+  if (!tensor_arena_.Init(ai_model_manager_, kModelName, kTensorArenaSlots,
+                          kTensorArenaSlots, kInputAlignment)) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                    "Load mean failed!");
+                    "Tensor arena init failed!");
     return false;
   }
-
-  // Load the STD data
-  Mat train_std_value(kResizedImgWidth, kResizedImgHeight, CV_32FC3, (void *)kTrainStd);
-  train_std_ = train_std_value;
-  if (train_std_.empty()) {
+  uint32_t batch_bytes = batch_size_ * kResizedImgWidth * kResizedImgHeight * kRgbChannel * sizeof(float);
+  if (batch_size_ <= 0 || tensor_arena_.input_size() != batch_bytes) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                    "Load std failed!");
+                    "Batch size %d does not match the model input %u!",
+                    batch_size_, tensor_arena_.input_size());
     return false;
   }
+  return true;
+}
+
+bool FaceFeatureMaskProcess::InitNormlizedData() {
+  // The train data is BGR interleaved, the model input is B, G, R planes
+  int32_t plane_size = kResizedImgWidth * kResizedImgHeight;
+  mean_planes_.resize(plane_size * kRgbChannel);
+  scale_planes_.resize(plane_size * kRgbChannel);
+  for (int32_t i = 0; i < plane_size; ++i) {
+    for (int32_t channel = 0; channel < kRgbChannel; ++channel) {
+      float std_value = kTrainStd[i * kRgbChannel + channel];
+      if (std_value == 0) {
+        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                        "Load std failed!");
+        return false;
+      }
+      mean_planes_[channel * plane_size + i] =
+        kTrainMean[i * kRgbChannel + channel];
+      scale_planes_[channel * plane_size + i] = 1.0f / std_value;
+    }
+  }
   HIAI_ENGINE_LOG("Load mean and std success!");
   return true;
 }
@@ -251,135 +283,57 @@ bool FaceFeatureMaskProcess::Resize(const vector<FaceImage> &face_imgs,
   return true;
 }
 
-bool FaceFeatureMaskProcess::ImageYUV2BGR (
-  const vector<ImageData<u_int8_t>> &resized_image,
-  vector<Mat> &bgr_image) {
-  for (vector<ImageData<u_int8_t>>::const_iterator resized_img_iter = resized_image.begin();
-       resized_img_iter != resized_image.end(); ++resized_img_iter) {
-
-    int img_height = resized_img_iter->height;
-    int img_width = resized_img_iter->width;
-    Mat src(img_height * kNv12SizeMolecule / kNv12SizeDenominator,
-            img_width, CV_8UC1);
-
-    int copy_size = img_width * img_height * kNv12SizeMolecule
-                    / kNv12SizeDenominator;
-    int destination_size = src.cols * src.rows * src.elemSize();
-    int ret = memcpy_s(src.data, destination_size, resized_img_iter->data.get(),
-                       copy_size);
-    CHECK_MEM_OPERATOR_RESULTS(ret);
-
-    Mat dst_temp;
-    cvtColor(src, dst_temp, CV_YUV2BGR_NV12);
-    Mat dst;
-    dst_temp.convertTo(dst, CV_32FC3);
-    bgr_image.push_back(dst);
-  }
-  return true;
-}
-
-bool FaceFeatureMaskProcess::NormalizeData (
-  vector<Mat> &normalized_image) {
-  // The flag to record
-  bool failuar_flag = true;
-  for (vector<Mat>::iterator iter = normalized_image.begin();
-       iter != normalized_image.end(); ++iter) {
-
-    // Sub the mean and divide the std
-    *iter = *iter  - train_mean_;
-    *iter = *iter  / train_std_;
-
-    // Record that whether all the data is empty
-    if (failuar_flag && !(*iter).empty()) {
-      failuar_flag = false;
-    }
-  }
-
-  // If all the data is empty, return false
-  if (failuar_flag) {
-    HIAI_ENGINE_LOG("All the data normalize failed");
-    return false;
-  }
-  return true;
-}
-
-bool FaceFeatureMaskProcess::Inference(vector<Mat> &normalized_image,
-                                       vector<FaceImage> &face_imgs) {
+bool FaceFeatureMaskProcess::Inference(
+  const vector<ImageData<u_int8_t>> &resized_imgs,
+  vector<FaceImage> &face_imgs) {
   // Define the ai model's data
   AIContext ai_context;
 
-  int normalized_image_size = normalized_image.size();
-  int normalized_image_mod = normalized_image_size % batch_size_;
-
-  // calcuate the iter number
-  // calcuate the value by batch
-  int iter_num = normalized_image_mod == 0 ?
-                 (normalized_image_size / batch_size_) : (normalized_image_size / batch_size_ + 1);
+  int resized_image_size = resized_imgs.size();
 
   // Invoke interface to do the inference
-  for (int i = 0; i < iter_num; i++) {
-    HIAI_ENGINE_LOG("Batch data's number is %d!", i);
-    int start_index = batch_size_ * i;
-    int end_index = start_index + batch_size_;
-
-    // Last group data, need to fulfill the extra data
-    // fulfill with last Mat in the vector
-    if (i == iter_num - 1 && normalized_image_mod != 0) {
-      int fulfill_number = batch_size_ - normalized_image_mod;
-      EnrichDataByLastMat(normalized_image, fulfill_number);
-      end_index = i * batch_size_ + normalized_image_mod;
-    }
+  for (int start_index = 0; start_index < resized_image_size; start_index += batch_size_) {
+    HIAI_ENGINE_LOG("Batch data's number is %d!", start_index / batch_size_);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
 
-    float *tensor_buffer = new(std::nothrow) float[batch_size_ * kResizedImgWidth * kResizedImgHeight * kRgbChannel];
-    if (tensor_buffer == nullptr) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "New the tensor buffer error.");
-      return false;
-    }
-    int last_size = CopyDataToBuffer(normalized_image, start_index, tensor_buffer);
+    // Last group data fills its faces and zeros the rest, the model still
+    // runs the full batch and the results past end_index are not read
+    int end_index = min(start_index + batch_size_, resized_image_size);
 
-    if (last_size == -1) {
+    TensorArenaSlot *slot = tensor_arena_.NextSlot();
+    if (slot == nullptr) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "Get the tensor arena slot error.");
       return false;
     }
-
-    vector<shared_ptr<IAITensor>> input_data_vec;
-    shared_ptr<AINeuralNetworkBuffer> neural_buffer = shared_ptr <
-        AINeuralNetworkBuffer > (new(std::nothrow) AINeuralNetworkBuffer());
-    shared_ptr<IAITensor> input_data = static_pointer_cast <
-                                       IAITensor > (neural_buffer);
-    neural_buffer->SetBuffer((void *)tensor_buffer,  last_size * sizeof(float));
-    input_data_vec.push_back(input_data);
-
-    vector<shared_ptr<IAITensor>> output_data_vec;
-    AIStatus ret = ai_model_manager_->CreateOutputTensor(input_data_vec, output_data_vec);
-    if (ret != SUCCESS) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "Fail to create output tensor");
-      delete [] tensor_buffer;
+    float *tensor_buffer = reinterpret_cast<float *>(slot->input_buffer.get());
+    if (!CopyDataToBuffer(resized_imgs, start_index, end_index, tensor_buffer)) {
       return false;
     }
+    chrono::steady_clock::time_point prepared = chrono::steady_clock::now();
 
-    ret = ai_model_manager_->Process(ai_context, input_data_vec, output_data_vec, 0);
+    AIStatus ret = ai_model_manager_->Process(ai_context, slot->input_tensors, slot->output_tensors, 0);
 
     if (ret != SUCCESS) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
                       "Fail to process the data in FWK");
-      delete [] tensor_buffer;
       return false;
     }
+    chrono::steady_clock::time_point processed = chrono::steady_clock::now();
 
     HIAI_ENGINE_LOG("Inference successed!");
 
     // Get the inference result.
     shared_ptr<AISimpleTensor> result_tensor = static_pointer_cast <
-        AISimpleTensor > (output_data_vec[0]);
+        AISimpleTensor > (slot->output_tensors[0]);
     if (!ArrangeFaceMarkInfo(result_tensor, start_index, end_index, face_imgs)) {
-      delete [] tensor_buffer;
       return false;
     }
-    input_data_vec.clear();
-    output_data_vec.clear();
-    delete [] tensor_buffer;
+
+    chrono::duration<float, milli> prepare_time = prepared - start;
+    chrono::duration<float, milli> process_time = processed - prepared;
+    RecordBatchLatency(end_index - start_index, prepare_time.count(),
+                       process_time.count());
   }
   return true;
 }
@@ -448,45 +402,56 @@ void FaceFeatureMaskProcess::EnrichFacePosition(int *face_position,
   face_feature->right_mouth.y = face_position[FaceFeaturePos::kRightMouthY];
 }
 
-void FaceFeatureMaskProcess::EnrichDataByLastMat(vector<Mat> &normalized_image,
-    int number) {
-  Mat last_mat = normalized_image[normalized_image.size() - 1];
-  for (int i = 0; i < number; i++) {
-    normalized_image.push_back(last_mat);
-  }
-}
-
-int FaceFeatureMaskProcess::CopyDataToBuffer(vector<Mat> &normalized_image,
-    int start_index, float *tensor_buffer) {
-
-  int last_size = 0;
-  for (int i = start_index; i < start_index + batch_size_; i++) {
+bool FaceFeatureMaskProcess::CopyDataToBuffer(
+  const vector<ImageData<u_int8_t>> &resized_imgs, int start_index,
+  int end_index, float *tensor_buffer) {
 
-    // Split the normalized data by opencv
-    vector<Mat> temp_splited_image;
-    split(normalized_image[i], temp_splited_image);
+  int image_floats = kResizedImgWidth * kResizedImgHeight * kRgbChannel;
+  for (int i = start_index; i < end_index; i++) {
+    const ImageData<u_int8_t> &resized_img = resized_imgs[i];
 
-    // Copy data to buffer
-    for (vector<Mat>::iterator
-         splited_data_iter = temp_splited_image.begin();
-         splited_data_iter != temp_splited_image.end(); ++splited_data_iter) {
+    // Convert, normalize and copy to planes in one pass
+    if (!Nv12ToNormalizedBgrPlanes(resized_img.data.get(), resized_img.width,
+                                   resized_img.height, resized_img.width,
+                                   mean_planes_.data(), scale_planes_.data(),
+                                   tensor_buffer + (i - start_index) * image_floats)) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "Convert the resized image failed in the feature mask's CopyDataToBuffer");
+      return false;
+    }
+  }
 
-      // Change data type to float
-      (*splited_data_iter).convertTo(*splited_data_iter, CV_32FC3);
-      int splited_data_length = (*splited_data_iter).rows * (*splited_data_iter).cols;
-      int each_size = splited_data_length * sizeof(float);
-      int ret = memcpy_s(tensor_buffer + last_size, each_size, (*splited_data_iter).ptr<float>(0), each_size);
-      if (ret != EOK) {
-        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                        "memory operation failed in the feature mask's CopyDataToBuffer, error=%d", ret);
-        return 0;
-      }
+  // The slot keeps the faces of its previous batch, which must not be
+  // inferred again with a partial batch
+  int valid_number = end_index - start_index;
+  if (valid_number < batch_size_) {
+    memset(tensor_buffer + valid_number * image_floats, 0,
+           (batch_size_ - valid_number) * image_floats * sizeof(float));
+  }
+  return true;
+}
 
-      // Calcuate the memory's end position
-      last_size += splited_data_length;
-    }
+void FaceFeatureMaskProcess::RecordBatchLatency(int face_count,
+    float prepare_ms, float process_ms) {
+  HIAI_ENGINE_LOG("Batch of %d/%d faces: prepare %.3fms, process %.3fms",
+                  face_count, batch_size_, prepare_ms, process_ms);
+
+  batch_latency_.batches++;
+  batch_latency_.faces += face_count;
+  batch_latency_.prepare_ms += prepare_ms;
+  batch_latency_.process_ms += process_ms;
+  batch_latency_.max_ms = max(batch_latency_.max_ms, prepare_ms + process_ms);
+  if (batch_latency_.batches < kLatencyReportBatches) {
+    return;
   }
-  return last_size;
+
+  // Occupancy shows how much of the batches the partial batches waste
+  HIAI_ENGINE_LOG(
+    "Last %d batches: prepare %.3fms, process %.3fms, max %.3fms, occupancy %.1f%%",
+    batch_latency_.batches, batch_latency_.prepare_ms / batch_latency_.batches,
+    batch_latency_.process_ms / batch_latency_.batches, batch_latency_.max_ms,
+    100.0f * batch_latency_.faces / (batch_latency_.batches * batch_size_));
+  batch_latency_ = BatchLatency();
 }
 
 bool FaceFeatureMaskProcess::IsDataHandleWrong(shared_ptr<FaceRecognitionInfo> &face_detail_info) {
@@ -497,6 +462,25 @@ bool FaceFeatureMaskProcess::IsDataHandleWrong(shared_ptr<FaceRecognitionInfo> &
   return true;
 }
 
+void FaceFeatureMaskProcess::SplitCachedFaces(vector<FaceImage> &face_imgs,
+    vector<FaceImage> &cached_imgs) {
+  vector<FaceImage>::iterator first_cached = stable_partition(
+      face_imgs.begin(), face_imgs.end(),
+      [](const FaceImage &face_img) {
+        return !face_img.feature_cached && !face_img.quality_skipped;
+      });
+  cached_imgs.assign(make_move_iterator(first_cached),
+                     make_move_iterator(face_imgs.end()));
+  face_imgs.erase(first_cached, face_imgs.end());
+}
+
+void FaceFeatureMaskProcess::MergeCachedFaces(vector<FaceImage> &cached_imgs,
+    vector<FaceImage> &face_imgs) {
+  face_imgs.insert(face_imgs.end(), make_move_iterator(cached_imgs.begin()),
+                   make_move_iterator(cached_imgs.end()));
+  cached_imgs.clear();
+}
+
 HIAI_StatusT FaceFeatureMaskProcess::SendFailed(const string error_log,
     shared_ptr<FaceRecognitionInfo> &face_recognition_info) {
 
@@ -555,39 +539,31 @@ HIAI_IMPL_ENGINE_PROCESS("face_feature_mask", FaceFeatureMaskProcess, INPUT_SIZE
     return HIAI_ERROR;
   }
 
+  // Faces of a track with a fresh feature vector and faces failing the
+  // quality check skip crop and inference
+  vector<FaceImage> cached_imgs;
+  SplitCachedFaces(face_recognition_info->face_imgs, cached_imgs);
   if (face_recognition_info->face_imgs.size() == 0) {
     HIAI_ENGINE_LOG("No face image need to be handled.");
+    MergeCachedFaces(cached_imgs, face_recognition_info->face_imgs);
     return SendSuccess(face_recognition_info);
   }
 
-  if (!Crop(face_recognition_info, face_recognition_info->org_img, face_recognition_info->face_imgs)) {
-    return SendFailed("Crop all the data failed, all the data failed",
-                      face_recognition_info);
-  }
-
+  // Cached and skipped faces are merged back whether the inference
+  // succeeds or not, so they do not vanish from the frame
+  string error_log;
   vector<ImageData<u_int8_t>> resized_imgs;
-  if (!Resize(face_recognition_info->face_imgs, resized_imgs)) {
-    return SendFailed("Resize all the data failed, all the data failed",
-                      face_recognition_info);
-  }
-
-  vector<Mat> bgr_imgs;
-  if (!ImageYUV2BGR(resized_imgs, bgr_imgs)) {
-    return SendFailed("Convert all the data failed, all the data failed",
-                      face_recognition_info);
-  }
-
-  if (!NormalizeData(bgr_imgs)) {
-    return SendFailed("Normalize all the data failed, all the data failed",
-                      face_recognition_info);
+  if (!Crop(face_recognition_info, face_recognition_info->org_img, face_recognition_info->face_imgs)) {
+    error_log = "Crop all the data failed, all the data failed";
+  } else if (!Resize(face_recognition_info->face_imgs, resized_imgs)) {
+    error_log = "Resize all the data failed, all the data failed";
+  } else if (!Inference(resized_imgs, face_recognition_info->face_imgs)) {
+    error_log = "Inference the data failed";
   }
 
-  // Inference the data
-  bool inference_flag = Inference(bgr_imgs, face_recognition_info->face_imgs);
-  if (!inference_flag) {
-    return SendFailed("Inference the data failed",
-                      face_recognition_info);
+  MergeCachedFaces(cached_imgs, face_recognition_info->face_imgs);
+  if (!error_log.empty()) {
+    return SendFailed(error_log, face_recognition_info);
   }
-
   return SendSuccess(face_recognition_info);
 }
\ No newline at end of file
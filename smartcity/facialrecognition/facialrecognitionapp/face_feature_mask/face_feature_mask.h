@@ -41,6 +41,7 @@
 #include "hiaiengine/data_type_reg.h"
 #include "hiaiengine/ai_tensor.h"
 #include "face_recognition_params.h"
+#include "ascenddk/ascend_tensor_arena/tensor_arena.h"
 #include <iostream>
 #include <string>
 #include <dirent.h>
@@ -48,9 +49,6 @@
 #include <unistd.h>
 #include <vector>
 #include <stdint.h>
-#include "opencv2/opencv.hpp"
-#include "opencv2/imgproc.hpp"
-#include "opencv2/core/types_c.h"
 
 #define INPUT_SIZE 2
 #define OUTPUT_SIZE 1
@@ -61,7 +59,7 @@ class FaceFeatureMaskProcess : public hiai::Engine {
 
   // Contrust function for FaceFeatureMaskProcess
   FaceFeatureMaskProcess() :
-    input_que_(INPUT_SIZE),batch_size_(4) {}
+    input_que_(INPUT_SIZE),batch_size_(4), batch_latency_() {}
   HIAI_StatusT Init(const hiai::AIConfig& config, const std::vector<hiai::AIModelDescription>& model_desc);
 
   /**
@@ -80,11 +78,26 @@ class FaceFeatureMaskProcess : public hiai::Engine {
   // AI module manager
   std::shared_ptr<hiai::AIModelManager> ai_model_manager_;
 
-  // Mean value after trained
-  cv::Mat train_mean_;
+  // Mean value after trained, B, G, R planes of the model input
+  std::vector<float> mean_planes_;
 
-  // Std value after trained
-  cv::Mat train_std_;
+  // Reciprocal of std value after trained, same layout as mean_planes_
+  std::vector<float> scale_planes_;
+
+  // Input and output tensors of a batch, allocated once in InitAiModel
+  ascend::utils::TensorArena tensor_arena_;
+
+  /*
+   * Latency of the batches since the last report
+   */
+  struct BatchLatency {
+    int32_t batches;
+    int32_t faces;
+    float prepare_ms;
+    float process_ms;
+    float max_ms;
+  };
+  BatchLatency batch_latency_;
 
   /*
    * Define the face feature position
@@ -139,43 +152,15 @@ class FaceFeatureMaskProcess : public hiai::Engine {
   bool Resize(const std::vector<FaceImage> &face_imgs,
               std::vector<hiai::ImageData<u_int8_t>> &resized_image);
 
-  /*
-   * @brief: Transform the image from resized YUV image to BGR image
-   *   Invoke the opencv's interface to transf
-   * @param [in]: resized_image The resized YUV image
-   * @param [in]: bgr_image BGE images after transf
-   * @return: Whether init success
-   */
-  bool ImageYUV2BGR(const std::vector<hiai::ImageData<u_int8_t>> &resized_image,
-                    std::vector<cv::Mat> &bgr_image);
-
-  /*
-   * @brief: Transform the image from (0,255) to little number
-   *   Invoke the opencv's interface to do the normalization,
-   *   sub mean and divide std.
-   * @param [in]: normalized_image The BGR image data,between(0,255)
-   * @param [in]: normalized_image The data after normalization
-   * @return: Whether init success
-   */
-  bool NormalizeData (std::vector<cv::Mat> &normalized_image);
-
   /*
    * @brief: Inference the data by the FWK's Process interface
-   * @param [in]: normalized_image The data after normalization
+   * @param [in]: resized_imgs The resized NV12 images
    * @param [in]: face_imgs->feature_mask The inference result
    * @return: Whether init success
    */
-  bool Inference(std::vector<cv::Mat> &normalized_image,
+  bool Inference(const std::vector<hiai::ImageData<u_int8_t>> &resized_imgs,
                  std::vector<FaceImage> &face_imgs);
 
-  /*
-   * @brief: Copy the data from Mat to Memory Buffer
-   * @param [in]: normalized_image The original data after normalized
-   * @param [in]: number How many Mat need to be fulfilled
-   */
-  void EnrichDataByLastMat(std::vector<cv::Mat> &normalized_image,
-                           int number);
-
   /*
    * @brief: Enrich the face's position by inference result
    * @param [in]: face_position Face position array
@@ -185,14 +170,27 @@ class FaceFeatureMaskProcess : public hiai::Engine {
                           FaceFeature* face_feature);
 
   /*
-   * @brief: Copy the data from Mat to Memory Buffer
-   * @param [in]: normalized_image The data after normalized
-   * @param [in]: start_index start index in the splited_image data.
+   * @brief: Convert the resized NV12 images to BGR, normalize them (sub mean
+   *   and divide std) and write them to the buffer as planes in one pass,
+   *   rows of a partial batch past end_index are zero filled
+   * @param [in]: resized_imgs The resized NV12 images
+   * @param [in]: start_index start index in the resized images
+   * @param [in]: end_index end index (excluded) in the resized images
    * @param [in]: tensor_buffer The buffer for the inference
-   * @return: Handle result
+   * @return: Whether convert success
+   */
+  bool CopyDataToBuffer(
+    const std::vector<hiai::ImageData<u_int8_t>> &resized_imgs,
+    int start_index, int end_index, float* tensor_buffer);
+
+  /*
+   * @brief: Log the latency of a batch, and the average and max latency
+   *   every kLatencyReportBatches batches
+   * @param [in]: face_count Faces in the batch
+   * @param [in]: prepare_ms Time to convert the faces into the tensor
+   * @param [in]: process_ms Time of the model inference
    */
-  int CopyDataToBuffer(std::vector<cv::Mat> &normalized_image,
-                       int start_index, float* tensor_buffer);
+  void RecordBatchLatency(int face_count, float prepare_ms, float process_ms);
 
   /*
    * @brief: Arrange the inference result from result_tensor to face_imgs->feature_mask
@@ -215,6 +213,24 @@ class FaceFeatureMaskProcess : public hiai::Engine {
    */
   bool IsDataHandleWrong(std::shared_ptr<FaceRecognitionInfo> &face_detail_info);
 
+  /*
+   * @brief: Move the faces reusing the feature vector of their track and
+   *   the faces skipped by face quality out of face_imgs, they need no
+   *   landmarks
+   * param [in]: face_imgs: all the faces of the frame
+   * param [out]: cached_imgs: faces with cached feature vector or skipped
+   */
+  void SplitCachedFaces(std::vector<FaceImage> &face_imgs,
+                        std::vector<FaceImage> &cached_imgs);
+
+  /*
+   * @brief: Move the faces set aside by SplitCachedFaces back
+   * param [in]: cached_imgs: faces with cached feature vector or skipped
+   * param [out]: face_imgs: all the faces of the frame
+   */
+  void MergeCachedFaces(std::vector<FaceImage> &cached_imgs,
+                        std::vector<FaceImage> &face_imgs);
+
   /*
    * @brief: Handle failed when some step has the error
    * param [in]: error_log Error log info
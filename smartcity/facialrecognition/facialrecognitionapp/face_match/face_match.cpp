@@ -0,0 +1,133 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "face_match.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "hiaiengine/log.h"
+#include "ascenddk/ascend_face_gallery/face_gallery_replica.h"
+
+using namespace std;
+using ascend::utils::FaceGalleryReplica;
+using ascend::utils::kUnknownFaceName;
+
+namespace {
+// output port (engine port begin with 0)
+const uint32_t kSendDataPort = 0;
+
+// image source from camera
+const uint32_t kCameraSrc = 0;
+
+// image source from register
+const uint32_t kRegisterSrc = 1;
+
+// sleep interval when queue full (unit:microseconds)
+const __useconds_t kSleepInterval = 200000;
+}
+
+// register custom data type
+HIAI_REGISTER_DATA_TYPE("FaceRecognitionInfo", FaceRecognitionInfo);
+HIAI_REGISTER_DATA_TYPE("FaceRectangle", FaceRectangle);
+HIAI_REGISTER_DATA_TYPE("FaceImage", FaceImage);
+
+HIAI_StatusT FaceMatch::Init(
+    const hiai::AIConfig& config,
+    const vector<hiai::AIModelDescription>& model_desc) {
+  // the gallery and the threshold are synced by presenter server
+  return HIAI_OK;
+}
+
+void FaceMatch::MatchFaces(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  // registered faces need their feature vectors, failed frames are skipped
+  if (image_handle->frame.image_source != kCameraSrc
+      || image_handle->err_info.err_code != AppErrorCode::kNone) {
+    return;
+  }
+
+  // until presenter server syncs the gallery, faces are matched by it
+  FaceGalleryReplica &replica = FaceGalleryReplica::GetInstance();
+  for (FaceImage &face_img : image_handle->face_imgs) {
+    // faces failing the quality check have no feature vector, they are
+    // shown as unknown faces
+    if (face_img.quality_skipped) {
+      face_img.matched = true;
+      face_img.match_name = kUnknownFaceName;
+      face_img.match_score = 0;
+      continue;
+    }
+    if (!replica.Match(face_img.feature_vector, face_img.match_name,
+                       face_img.match_score)) {
+      continue;
+    }
+    face_img.matched = true;
+    vector<float>().swap(face_img.feature_vector);
+  }
+}
+
+void FaceMatch::SendResult(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  HIAI_StatusT hiai_ret;
+  // when register face, can not discard when queue full
+  do {
+    hiai_ret = SendData(kSendDataPort, "FaceRecognitionInfo",
+                        static_pointer_cast<void>(image_handle));
+    // when queue full, sleep
+    if (hiai_ret == HIAI_QUEUE_FULL) {
+      HIAI_ENGINE_LOG("queue full, sleep 200ms");
+      usleep(kSleepInterval);
+    }
+  } while (hiai_ret == HIAI_QUEUE_FULL
+      && image_handle->frame.image_source == kRegisterSrc);
+
+  // send failed
+  if (hiai_ret != HIAI_OK) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "call SendData failed, err_code=%d", hiai_ret);
+  }
+}
+
+HIAI_IMPL_ENGINE_PROCESS("face_match", FaceMatch, INPUT_SIZE) {
+  // deal arg0 (engine only have one input)
+  if (arg0 != nullptr) {
+    shared_ptr<FaceRecognitionInfo> image_handle = static_pointer_cast<
+        FaceRecognitionInfo>(arg0);
+    MatchFaces(image_handle);
+    SendResult(image_handle);
+  }
+  return HIAI_OK;
+}
@@ -0,0 +1,87 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef FACE_MATCH_ENGINE_H_
+#define FACE_MATCH_ENGINE_H_
+
+#include <memory>
+#include <vector>
+
+#include "hiaiengine/engine.h"
+#include "hiaiengine/data_type_reg.h"
+
+#include "face_recognition_params.h"
+
+#define INPUT_SIZE 1
+#define OUTPUT_SIZE 1
+
+/**
+ * @brief: match camera faces with the gallery synced from presenter server,
+ *         so that identities are sent instead of feature vectors
+ */
+class FaceMatch : public hiai::Engine {
+public:
+  /**
+   * @brief: face match engine initialize
+   * @param [in]: engine's parameters which configured in graph.config
+   * @param [in]: model description
+   * @return: HIAI_StatusT
+   */
+  HIAI_StatusT Init(const hiai::AIConfig& config,
+                    const std::vector<hiai::AIModelDescription>& model_desc);
+
+  /**
+   * @brief: engine processor which override HIAI engine
+   *         match every face, and then send data to post process
+   * @param [in]: input size
+   * @param [in]: output size
+   */
+HIAI_DEFINE_PROCESS(INPUT_SIZE, OUTPUT_SIZE)
+  ;
+
+private:
+  /**
+   * @brief: match faces of a camera frame, the feature vector of a matched
+   *         face is dropped
+   * param [out]: image_handle: engine transform data
+   */
+  void MatchFaces(const std::shared_ptr<FaceRecognitionInfo> &image_handle);
+
+  /**
+   * @brief: send result
+   * param [in]: image_handle: engine transform data
+   */
+  void SendResult(const std::shared_ptr<FaceRecognitionInfo> &image_handle);
+};
+
+#endif /* FACE_MATCH_ENGINE_H_ */
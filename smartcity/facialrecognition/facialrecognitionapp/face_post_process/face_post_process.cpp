@@ -43,6 +43,7 @@
 #include "hiaiengine/log.h"
 #include "hiaiengine/data_type_reg.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
+#include "ascenddk/ascend_face_gallery/feature_codec.h"
 
 using namespace std;
 using namespace ascend::presenter;
@@ -58,15 +59,74 @@ HIAI_REGISTER_DATA_TYPE("FaceImage", FaceImage);
 namespace {
 // level for call DVPP
 const int32_t kDvppToJpegLevel = 100;
+
+// config name of feature encoding, values: float32, fp16, int8
+const string kFeatureEncodingParamKey = "feature_encoding";
+const string kFeatureEncodingFloat32 = "float32";
+const string kFeatureEncodingFp16 = "fp16";
+const string kFeatureEncodingInt8 = "int8";
 }
 
 HIAI_StatusT FacePostProcess::Init(
     const hiai::AIConfig &config,
     const std::vector<hiai::AIModelDescription> &model_desc) {
-  // need do nothing
+  // feature vectors are sent as float32 unless configured
+  feature_encoding_ = facial_recognition::kFeatureFloat32;
+  for (int index = 0; index < config.items_size(); index++) {
+    const ::hiai::AIConfigItem& item = config.items(index);
+    if (item.name() != kFeatureEncodingParamKey) {
+      continue;
+    }
+
+    if (item.value() == kFeatureEncodingFloat32) {
+      feature_encoding_ = facial_recognition::kFeatureFloat32;
+    } else if (item.value() == kFeatureEncodingFp16) {
+      feature_encoding_ = facial_recognition::kFeatureFp16;
+    } else if (item.value() == kFeatureEncodingInt8) {
+      feature_encoding_ = facial_recognition::kFeatureInt8;
+    } else {
+      HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                      "feature_encoding = %s which configured is invalid.",
+                      item.value().c_str());
+      return HIAI_ERROR;
+    }
+  }
+  HIAI_ENGINE_LOG("feature_encoding = %d", feature_encoding_);
   return HIAI_OK;
 }
 
+void FacePostProcess::SetFeatureVector(
+    const vector<float> &feature_vector,
+    facial_recognition::FaceFeature *feature) {
+  uint32_t dim = feature_vector.size();
+  switch (feature_encoding_) {
+    case facial_recognition::kFeatureFp16: {
+      // 2 bytes per element, little endian as the device
+      string packed_vector(dim * sizeof(uint16_t), '\0');
+      EncodeFp16(feature_vector.data(), dim,
+                 reinterpret_cast<uint16_t*>(&packed_vector[0]));
+      feature->set_encoding(facial_recognition::kFeatureFp16);
+      feature->set_packed_vector(move(packed_vector));
+      break;
+    }
+    case facial_recognition::kFeatureInt8: {
+      // 1 byte per element, element = code * scale
+      string packed_vector(dim, '\0');
+      float scale = EncodeInt8(feature_vector.data(), dim,
+                               reinterpret_cast<int8_t*>(&packed_vector[0]));
+      feature->set_encoding(facial_recognition::kFeatureInt8);
+      feature->set_scale(scale);
+      feature->set_packed_vector(move(packed_vector));
+      break;
+    }
+    default:
+      for (int j = 0; j < feature_vector.size(); j++) {
+        feature->add_vector(feature_vector[j]);
+      }
+      break;
+  }
+}
+
 HIAI_StatusT FacePostProcess::CheckSendMessageRes(
     const PresenterErrorCode &error_code) {
   if (error_code == PresenterErrorCode::kNone) {
@@ -138,9 +198,12 @@ HIAI_StatusT FacePostProcess::SendFeature(
 
     HIAI_ENGINE_LOG("position is (%d,%d),(%d,%d)",face_imgs[i].rectangle.lt.x,face_imgs[i].rectangle.lt.y,face_imgs[i].rectangle.rb.x,face_imgs[i].rectangle.rb.y);
 
-    // vector
-    for (int j = 0; j < face_imgs[i].feature_vector.size(); j++) {
-      feature->add_vector(face_imgs[i].feature_vector[j]);
+    // identity when matched on device, otherwise vector
+    if (face_imgs[i].matched) {
+      feature->set_name(face_imgs[i].match_name);
+      feature->set_score(face_imgs[i].match_score);
+    } else {
+      SetFeatureVector(face_imgs[i].feature_vector, feature);
     }
   }
 
@@ -160,10 +223,10 @@ HIAI_StatusT FacePostProcess::ReplyFeature(
     return HIAI_ERROR;
   }
 
-  // generate FaceResult
+  // generate FaceResult, server does not respond to it. The channel is read
+  // by face_register only, so the result is sent without reading a response
   facial_recognition::FaceResult result;
   result.set_id(info->frame.face_id);
-  unique_ptr<Message> resp;
 
   // 1. front engine dealing failed, send error message
   if (info->err_info.err_code != AppErrorCode::kNone) {
@@ -175,7 +238,7 @@ HIAI_StatusT FacePostProcess::ReplyFeature(
     result.mutable_response()->set_message(info->err_info.err_msg);
 
     // send
-    PresenterErrorCode error_code = channel->SendMessage(result, resp);
+    PresenterErrorCode error_code = channel->SendMessage(result);
     return CheckSendMessageRes(error_code);
   }
 
@@ -194,12 +257,10 @@ HIAI_StatusT FacePostProcess::ReplyFeature(
     face_feature->mutable_box()->set_rb_y(face_imgs[i].rectangle.rb.y);
 
     // vector
-    for (int j = 0; j < face_imgs[i].feature_vector.size(); j++) {
-      face_feature->add_vector(face_imgs[i].feature_vector[j]);
-    }
+    SetFeatureVector(face_imgs[i].feature_vector, face_feature);
   }
 
-  PresenterErrorCode error_code = channel->SendMessage(result, resp);
+  PresenterErrorCode error_code = channel->SendMessage(result);
   return CheckSendMessageRes(error_code);
 }
 
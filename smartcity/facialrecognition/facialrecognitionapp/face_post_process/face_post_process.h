@@ -42,6 +42,7 @@
 #include "hiaiengine/engine.h"
 #include "hiaiengine/multitype_queue.h"
 #include "presenter_channels.h"
+#include "facial_recognition_message.pb.h"
 
 #define INPUT_SIZE 1
 #define OUTPUT_SIZE 1
@@ -89,6 +90,17 @@ private:
    */
   HIAI_StatusT ReplyFeature(const std::shared_ptr<FaceRecognitionInfo> &info);
 
+  /**
+   * @brief: set feature vector of a face in the configured encoding
+   * @param [in]: feature vector
+   * @param [out]: face feature message
+   */
+  void SetFeatureVector(
+      const std::vector<float> &feature_vector,
+      ascend::presenter::facial_recognition::FaceFeature *feature);
+
+  // encoding of feature vectors sent to presenter server
+  ascend::presenter::facial_recognition::FeatureEncoding feature_encoding_;
 };
 
 #endif
@@ -57,6 +57,11 @@ class FrameInfoDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<FrameInfo>
       _instance;
 } _FrameInfo_default_instance_;
+class GallerySyncDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<GallerySync>
+      _instance;
+} _GallerySync_default_instance_;
 }  // namespace facial_recognition
 }  // namespace presenter
 }  // namespace ascend
@@ -212,8 +217,30 @@ void InitDefaultsFrameInfo() {
   ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsFrameInfoImpl);
 }
 
-::google::protobuf::Metadata file_level_metadata[7];
-const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[1];
+void InitDefaultsGallerySyncImpl() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+#ifdef GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  ::google::protobuf::internal::InitProtobufDefaultsForceUnique();
+#else
+  ::google::protobuf::internal::InitProtobufDefaults();
+#endif  // GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsFaceFeature();
+  {
+    void* ptr = &::ascend::presenter::facial_recognition::_GallerySync_default_instance_;
+    new (ptr) ::ascend::presenter::facial_recognition::GallerySync();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::ascend::presenter::facial_recognition::GallerySync::InitAsDefaultInstance();
+}
+
+void InitDefaultsGallerySync() {
+  static GOOGLE_PROTOBUF_DECLARE_ONCE(once);
+  ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsGallerySyncImpl);
+}
+
+::google::protobuf::Metadata file_level_metadata[8];
+const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[2];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   ~0u,  // no _has_bits_
@@ -246,6 +273,11 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, box_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, vector_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, encoding_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, scale_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, packed_vector_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, name_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceFeature, score_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FaceInfo, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -268,15 +300,24 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   ~0u,  // no _weak_field_map_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FrameInfo, image_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::FrameInfo, feature_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::GallerySync, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::GallerySync, reset_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::GallerySync, face_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::facial_recognition::GallerySync, threshold_),
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::ascend::presenter::facial_recognition::CommonResponse)},
   { 7, -1, sizeof(::ascend::presenter::facial_recognition::RegisterApp)},
   { 14, -1, sizeof(::ascend::presenter::facial_recognition::Box)},
   { 23, -1, sizeof(::ascend::presenter::facial_recognition::FaceFeature)},
-  { 30, -1, sizeof(::ascend::presenter::facial_recognition::FaceInfo)},
-  { 37, -1, sizeof(::ascend::presenter::facial_recognition::FaceResult)},
-  { 45, -1, sizeof(::ascend::presenter::facial_recognition::FrameInfo)},
+  { 35, -1, sizeof(::ascend::presenter::facial_recognition::FaceInfo)},
+  { 42, -1, sizeof(::ascend::presenter::facial_recognition::FaceResult)},
+  { 50, -1, sizeof(::ascend::presenter::facial_recognition::FrameInfo)},
+  { 57, -1, sizeof(::ascend::presenter::facial_recognition::GallerySync)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
@@ -287,6 +328,7 @@ static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::facial_recognition::_FaceInfo_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::facial_recognition::_FaceResult_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::facial_recognition::_FrameInfo_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::facial_recognition::_GallerySync_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -305,7 +347,7 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 7);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 8);
 }
 
 void AddDescriptorsImpl() {
@@ -317,23 +359,32 @@ void AddDescriptorsImpl() {
       "r.facial_recognition.ErrorCode\022\017\n\007messag"
       "e\030\002 \001(\t\"\'\n\013RegisterApp\022\n\n\002id\030\001 \001(\t\022\014\n\004ty"
       "pe\030\002 \001(\t\"=\n\003Box\022\014\n\004lt_x\030\001 \001(\r\022\014\n\004lt_y\030\002 "
-      "\001(\r\022\014\n\004rb_x\030\003 \001(\r\022\014\n\004rb_y\030\004 \001(\r\"T\n\013FaceF"
-      "eature\0225\n\003box\030\001 \001(\0132(.ascend.presenter.f"
-      "acial_recognition.Box\022\016\n\006vector\030\002 \003(\002\"%\n"
-      "\010FaceInfo\022\n\n\002id\030\001 \001(\t\022\r\n\005image\030\002 \001(\014\"\242\001\n"
-      "\nFaceResult\022\n\n\002id\030\001 \001(\t\022E\n\010response\030\002 \001("
-      "\01323.ascend.presenter.facial_recognition."
-      "CommonResponse\022A\n\007feature\030\003 \003(\01320.ascend"
-      ".presenter.facial_recognition.FaceFeatur"
-      "e\"]\n\tFrameInfo\022\r\n\005image\030\001 \001(\014\022A\n\007feature"
-      "\030\002 \003(\01320.ascend.presenter.facial_recogni"
-      "tion.FaceFeature*\177\n\tErrorCode\022\016\n\nkErrorN"
-      "one\020\000\022\032\n\026kErrorAppRegisterExist\020\001\022\031\n\025kEr"
-      "rorAppRegisterType\020\002\022\032\n\026kErrorAppRegiste"
-      "rLimit\020\003\022\017\n\013kErrorOther\020\005b\006proto3"
+      "\001(\r\022\014\n\004rb_x\030\003 \001(\r\022\014\n\004rb_y\030\004 \001(\r\"\337\001\n\013Face"
+      "Feature\0225\n\003box\030\001 \001(\0132(.ascend.presenter."
+      "facial_recognition.Box\022\016\n\006vector\030\002 \003(\002\022F"
+      "\n\010encoding\030\003 \001(\01624.ascend.presenter.faci"
+      "al_recognition.FeatureEncoding\022\r\n\005scale\030"
+      "\004 \001(\002\022\025\n\rpacked_vector\030\005 \001(\014\022\014\n\004name\030\006 \001"
+      "(\t\022\r\n\005score\030\007 \001(\002\"%\n\010FaceInfo\022\n\n\002id\030\001 \001("
+      "\t\022\r\n\005image\030\002 \001(\014\"\242\001\n\nFaceResult\022\n\n\002id\030\001 "
+      "\001(\t\022E\n\010response\030\002 \001(\01323.ascend.presenter"
+      ".facial_recognition.CommonResponse\022A\n\007fe"
+      "ature\030\003 \003(\01320.ascend.presenter.facial_re"
+      "cognition.FaceFeature\"]\n\tFrameInfo\022\r\n\005im"
+      "age\030\001 \001(\014\022A\n\007feature\030\002 \003(\01320.ascend.pres"
+      "enter.facial_recognition.FaceFeature\"o\n\013"
+      "GallerySync\022\r\n\005reset\030\001 \001(\010\022>\n\004face\030\002 \003(\013"
+      "20.ascend.presenter.facial_recognition.F"
+      "aceFeature\022\021\n\tthreshold\030\003 \001(\002*\177\n\tErrorCo"
+      "de\022\016\n\nkErrorNone\020\000\022\032\n\026kErrorAppRegisterE"
+      "xist\020\001\022\031\n\025kErrorAppRegisterType\020\002\022\032\n\026kEr"
+      "rorAppRegisterLimit\020\003\022\017\n\013kErrorOther\020\005*J"
+      "\n\017FeatureEncoding\022\023\n\017kFeatureFloat32\020\000\022\020"
+      "\n\014kFeatureFp16\020\001\022\020\n\014kFeatureInt8\020\002b\006prot"
+      "o3"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 793);
+      descriptor, 1122);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "facial_recognition_message.proto", &protobuf_RegisterTypes);
 }
@@ -369,6 +420,21 @@ bool ErrorCode_IsValid(int value) {
   }
 }
 
+const ::google::protobuf::EnumDescriptor* FeatureEncoding_descriptor() {
+  protobuf_facial_5frecognition_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return protobuf_facial_5frecognition_5fmessage_2eproto::file_level_enum_descriptors[1];
+}
+bool FeatureEncoding_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+      return true;
+    default:
+      return false;
+  }
+}
+
 
 // ===================================================================
 
@@ -1341,6 +1407,11 @@ void FaceFeature::InitAsDefaultInstance() {
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
 const int FaceFeature::kBoxFieldNumber;
 const int FaceFeature::kVectorFieldNumber;
+const int FaceFeature::kEncodingFieldNumber;
+const int FaceFeature::kScaleFieldNumber;
+const int FaceFeature::kPackedVectorFieldNumber;
+const int FaceFeature::kNameFieldNumber;
+const int FaceFeature::kScoreFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 FaceFeature::FaceFeature()
@@ -1357,16 +1428,31 @@ FaceFeature::FaceFeature(const FaceFeature& from)
       vector_(from.vector_),
       _cached_size_(0) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
+  packed_vector_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.packed_vector().size() > 0) {
+    packed_vector_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.packed_vector_);
+  }
+  name_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.name().size() > 0) {
+    name_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.name_);
+  }
   if (from.has_box()) {
     box_ = new ::ascend::presenter::facial_recognition::Box(*from.box_);
   } else {
     box_ = NULL;
   }
+  ::memcpy(&encoding_, &from.encoding_,
+    static_cast<size_t>(reinterpret_cast<char*>(&score_) -
+    reinterpret_cast<char*>(&encoding_)) + sizeof(score_));
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.facial_recognition.FaceFeature)
 }
 
 void FaceFeature::SharedCtor() {
-  box_ = NULL;
+  packed_vector_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  name_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ::memset(&box_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&score_) -
+      reinterpret_cast<char*>(&box_)) + sizeof(score_));
   _cached_size_ = 0;
 }
 
@@ -1376,6 +1462,8 @@ FaceFeature::~FaceFeature() {
 }
 
 void FaceFeature::SharedDtor() {
+  packed_vector_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  name_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   if (this != internal_default_instance()) delete box_;
 }
 
@@ -1409,10 +1497,15 @@ void FaceFeature::Clear() {
   (void) cached_has_bits;
 
   vector_.Clear();
+  packed_vector_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   if (GetArenaNoVirtual() == NULL && box_ != NULL) {
     delete box_;
   }
   box_ = NULL;
+  ::memset(&encoding_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&score_) -
+      reinterpret_cast<char*>(&encoding_)) + sizeof(score_));
   _internal_metadata_.Clear();
 }
 
@@ -1457,6 +1550,77 @@ bool FaceFeature::MergePartialFromCodedStream(
         break;
       }
 
+      // .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(24u /* 24 & 0xFF */)) {
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_encoding(static_cast< ::ascend::presenter::facial_recognition::FeatureEncoding >(value));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // float scale = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(37u /* 37 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &scale_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes packed_vector = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(42u /* 42 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_packed_vector()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // string name = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(50u /* 50 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
+                input, this->mutable_name()));
+          DO_(::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+            this->name().data(), static_cast<int>(this->name().length()),
+            ::google::protobuf::internal::WireFormatLite::PARSE,
+            "ascend.presenter.facial_recognition.FaceFeature.name"));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // float score = 7;
+      case 7: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(61u /* 61 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &score_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -1498,6 +1662,38 @@ void FaceFeature::SerializeWithCachedSizes(
       this->vector().data(), this->vector_size(), output);
   }
 
+  // .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+  if (this->encoding() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      3, this->encoding(), output);
+  }
+
+  // float scale = 4;
+  if (this->scale() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(4, this->scale(), output);
+  }
+
+  // bytes packed_vector = 5;
+  if (this->packed_vector().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      5, this->packed_vector(), output);
+  }
+
+  // string name = 6;
+  if (this->name().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+      this->name().data(), static_cast<int>(this->name().length()),
+      ::google::protobuf::internal::WireFormatLite::SERIALIZE,
+      "ascend.presenter.facial_recognition.FaceFeature.name");
+    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
+      6, this->name(), output);
+  }
+
+  // float score = 7;
+  if (this->score() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(7, this->score(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -1532,6 +1728,40 @@ void FaceFeature::SerializeWithCachedSizes(
       WriteFloatNoTagToArray(this->vector_, target);
   }
 
+  // .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+  if (this->encoding() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      3, this->encoding(), target);
+  }
+
+  // float scale = 4;
+  if (this->scale() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(4, this->scale(), target);
+  }
+
+  // bytes packed_vector = 5;
+  if (this->packed_vector().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        5, this->packed_vector(), target);
+  }
+
+  // string name = 6;
+  if (this->name().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::VerifyUtf8String(
+      this->name().data(), static_cast<int>(this->name().length()),
+      ::google::protobuf::internal::WireFormatLite::SERIALIZE,
+      "ascend.presenter.facial_recognition.FaceFeature.name");
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
+        6, this->name(), target);
+  }
+
+  // float score = 7;
+  if (this->score() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(7, this->score(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -1565,6 +1795,20 @@ size_t FaceFeature::ByteSizeLong() const {
     total_size += data_size;
   }
 
+  // bytes packed_vector = 5;
+  if (this->packed_vector().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->packed_vector());
+  }
+
+  // string name = 6;
+  if (this->name().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::StringSize(
+        this->name());
+  }
+
   // .ascend.presenter.facial_recognition.Box box = 1;
   if (this->has_box()) {
     total_size += 1 +
@@ -1572,6 +1816,22 @@ size_t FaceFeature::ByteSizeLong() const {
         *this->box_);
   }
 
+  // .ascend.presenter.facial_recognition.FeatureEncoding encoding = 3;
+  if (this->encoding() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->encoding());
+  }
+
+  // float scale = 4;
+  if (this->scale() != 0) {
+    total_size += 1 + 4;
+  }
+
+  // float score = 7;
+  if (this->score() != 0) {
+    total_size += 1 + 4;
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -1602,9 +1862,26 @@ void FaceFeature::MergeFrom(const FaceFeature& from) {
   (void) cached_has_bits;
 
   vector_.MergeFrom(from.vector_);
+  if (from.packed_vector().size() > 0) {
+
+    packed_vector_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.packed_vector_);
+  }
+  if (from.name().size() > 0) {
+
+    name_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.name_);
+  }
   if (from.has_box()) {
     mutable_box()->::ascend::presenter::facial_recognition::Box::MergeFrom(from.box());
   }
+  if (from.encoding() != 0) {
+    set_encoding(from.encoding());
+  }
+  if (from.scale() != 0) {
+    set_scale(from.scale());
+  }
+  if (from.score() != 0) {
+    set_score(from.score());
+  }
 }
 
 void FaceFeature::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1632,7 +1909,12 @@ void FaceFeature::Swap(FaceFeature* other) {
 void FaceFeature::InternalSwap(FaceFeature* other) {
   using std::swap;
   vector_.InternalSwap(&other->vector_);
+  packed_vector_.Swap(&other->packed_vector_);
+  name_.Swap(&other->name_);
   swap(box_, other->box_);
+  swap(encoding_, other->encoding_);
+  swap(scale_, other->scale_);
+  swap(score_, other->score_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -2578,6 +2860,324 @@ void FrameInfo::InternalSwap(FrameInfo* other) {
 }
 
 
+// ===================================================================
+
+void GallerySync::InitAsDefaultInstance() {
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int GallerySync::kResetFieldNumber;
+const int GallerySync::kFaceFieldNumber;
+const int GallerySync::kThresholdFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+GallerySync::GallerySync()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  if (GOOGLE_PREDICT_TRUE(this != internal_default_instance())) {
+    ::protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsGallerySync();
+  }
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:ascend.presenter.facial_recognition.GallerySync)
+}
+GallerySync::GallerySync(const GallerySync& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      face_(from.face_),
+      _cached_size_(0) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::memcpy(&reset_, &from.reset_,
+    static_cast<size_t>(reinterpret_cast<char*>(&threshold_) -
+    reinterpret_cast<char*>(&reset_)) + sizeof(threshold_));
+  // @@protoc_insertion_point(copy_constructor:ascend.presenter.facial_recognition.GallerySync)
+}
+
+void GallerySync::SharedCtor() {
+  ::memset(&reset_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&threshold_) -
+      reinterpret_cast<char*>(&reset_)) + sizeof(threshold_));
+  _cached_size_ = 0;
+}
+
+GallerySync::~GallerySync() {
+  // @@protoc_insertion_point(destructor:ascend.presenter.facial_recognition.GallerySync)
+  SharedDtor();
+}
+
+void GallerySync::SharedDtor() {
+}
+
+void GallerySync::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* GallerySync::descriptor() {
+  ::protobuf_facial_5frecognition_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_facial_5frecognition_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const GallerySync& GallerySync::default_instance() {
+  ::protobuf_facial_5frecognition_5fmessage_2eproto::InitDefaultsGallerySync();
+  return *internal_default_instance();
+}
+
+GallerySync* GallerySync::New(::google::protobuf::Arena* arena) const {
+  GallerySync* n = new GallerySync;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void GallerySync::Clear() {
+// @@protoc_insertion_point(message_clear_start:ascend.presenter.facial_recognition.GallerySync)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  face_.Clear();
+  ::memset(&reset_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&threshold_) -
+      reinterpret_cast<char*>(&reset_)) + sizeof(threshold_));
+  _internal_metadata_.Clear();
+}
+
+bool GallerySync::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:ascend.presenter.facial_recognition.GallerySync)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // bool reset = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(8u /* 8 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &reset_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(18u /* 18 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_face()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // float threshold = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(29u /* 29 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
+                 input, &threshold_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:ascend.presenter.facial_recognition.GallerySync)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:ascend.presenter.facial_recognition.GallerySync)
+  return false;
+#undef DO_
+}
+
+void GallerySync::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:ascend.presenter.facial_recognition.GallerySync)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // bool reset = 1;
+  if (this->reset() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(1, this->reset(), output);
+  }
+
+  // repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->face_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      2, this->face(static_cast<int>(i)), output);
+  }
+
+  // float threshold = 3;
+  if (this->threshold() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteFloat(3, this->threshold(), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:ascend.presenter.facial_recognition.GallerySync)
+}
+
+::google::protobuf::uint8* GallerySync::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:ascend.presenter.facial_recognition.GallerySync)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // bool reset = 1;
+  if (this->reset() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(1, this->reset(), target);
+  }
+
+  // repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->face_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        2, this->face(static_cast<int>(i)), deterministic, target);
+  }
+
+  // float threshold = 3;
+  if (this->threshold() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(3, this->threshold(), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ascend.presenter.facial_recognition.GallerySync)
+  return target;
+}
+
+size_t GallerySync::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ascend.presenter.facial_recognition.GallerySync)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .ascend.presenter.facial_recognition.FaceFeature face = 2;
+  {
+    unsigned int count = static_cast<unsigned int>(this->face_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->face(static_cast<int>(i)));
+    }
+  }
+
+  // bool reset = 1;
+  if (this->reset() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // float threshold = 3;
+  if (this->threshold() != 0) {
+    total_size += 1 + 4;
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = cached_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void GallerySync::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:ascend.presenter.facial_recognition.GallerySync)
+  GOOGLE_DCHECK_NE(&from, this);
+  const GallerySync* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const GallerySync>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:ascend.presenter.facial_recognition.GallerySync)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:ascend.presenter.facial_recognition.GallerySync)
+    MergeFrom(*source);
+  }
+}
+
+void GallerySync::MergeFrom(const GallerySync& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:ascend.presenter.facial_recognition.GallerySync)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  face_.MergeFrom(from.face_);
+  if (from.reset() != 0) {
+    set_reset(from.reset());
+  }
+  if (from.threshold() != 0) {
+    set_threshold(from.threshold());
+  }
+}
+
+void GallerySync::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:ascend.presenter.facial_recognition.GallerySync)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void GallerySync::CopyFrom(const GallerySync& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ascend.presenter.facial_recognition.GallerySync)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GallerySync::IsInitialized() const {
+  return true;
+}
+
+void GallerySync::Swap(GallerySync* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void GallerySync::InternalSwap(GallerySync* other) {
+  using std::swap;
+  face_.InternalSwap(&other->face_);
+  swap(reset_, other->reset_);
+  swap(threshold_, other->threshold_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata GallerySync::GetMetadata() const {
+  protobuf_facial_5frecognition_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_facial_5frecognition_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace facial_recognition
 }  // namespace presenter
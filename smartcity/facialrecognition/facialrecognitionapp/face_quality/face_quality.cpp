@@ -0,0 +1,199 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "face_quality.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "hiaiengine/log.h"
+#include "opencv2/opencv.hpp"
+
+using namespace std;
+
+namespace {
+// output port (engine port begin with 0)
+const uint32_t kSendDataPort = 0;
+
+// image source from camera
+const uint32_t kCameraSrc = 0;
+
+// image source from register
+const uint32_t kRegisterSrc = 1;
+
+// sleep interval when queue full (unit:microseconds)
+const __useconds_t kSleepInterval = 200000;
+
+// parameter keys in graph.config
+const string kMinFaceSizeParamKey = "min_face_size";
+const string kMinSharpnessParamKey = "min_sharpness";
+
+// default parameters
+const uint32_t kDefaultMinFaceSize = 40;
+const double kDefaultMinSharpness = 50.0;
+}
+
+// register custom data type
+HIAI_REGISTER_DATA_TYPE("FaceRecognitionInfo", FaceRecognitionInfo);
+HIAI_REGISTER_DATA_TYPE("FaceRectangle", FaceRectangle);
+HIAI_REGISTER_DATA_TYPE("FaceImage", FaceImage);
+
+HIAI_StatusT FaceQuality::Init(
+    const hiai::AIConfig& config,
+    const vector<hiai::AIModelDescription>& model_desc) {
+  min_face_size_ = kDefaultMinFaceSize;
+  min_sharpness_ = kDefaultMinSharpness;
+  for (int index = 0; index < config.items_size(); index++) {
+    const ::hiai::AIConfigItem& item = config.items(index);
+    stringstream ss(item.value());
+    if (item.name() == kMinFaceSizeParamKey) {
+      ss >> min_face_size_;
+    } else if (item.name() == kMinSharpnessParamKey) {
+      ss >> min_sharpness_;
+    }
+    // else: noting need to do
+  }
+
+  if (min_sharpness_ < 0) {
+    HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                    "min_sharpness invalid, please check your configuration.");
+    return HIAI_ERROR;
+  }
+  return HIAI_OK;
+}
+
+double FaceQuality::Sharpness(const hiai::ImageData<u_int8_t> &org_img,
+                              const FaceRectangle &rectangle) {
+  // luma plane is the first height rows of NV12, rows may be aligned
+  uint32_t stride =
+      (org_img.width_step != 0) ? org_img.width_step : org_img.width;
+  cv::Mat luma(org_img.height, stride, CV_8UC1, org_img.data.get());
+
+  int32_t lt_x = max(0, static_cast<int32_t>(rectangle.lt.x));
+  int32_t lt_y = max(0, static_cast<int32_t>(rectangle.lt.y));
+  int32_t rb_x = min(static_cast<int32_t>(org_img.width),
+                     static_cast<int32_t>(rectangle.rb.x));
+  int32_t rb_y = min(static_cast<int32_t>(org_img.height),
+                     static_cast<int32_t>(rectangle.rb.y));
+  if (rb_x - lt_x < 3 || rb_y - lt_y < 3) {
+    return 0;
+  }
+
+  cv::Mat laplacian;
+  cv::Laplacian(luma(cv::Rect(lt_x, lt_y, rb_x - lt_x, rb_y - lt_y)),
+                laplacian, CV_16S);
+  cv::Scalar mean;
+  cv::Scalar stddev;
+  cv::meanStdDev(laplacian, mean, stddev);
+  return stddev[0] * stddev[0];
+}
+
+bool FaceQuality::IsQualified(const hiai::ImageData<u_int8_t> &org_img,
+                              const FaceImage &face_img) {
+  // 1. size, boxes of the detection may be empty or inverted
+  const FaceRectangle &rectangle = face_img.rectangle;
+  int32_t width = static_cast<int32_t>(rectangle.rb.x)
+      - static_cast<int32_t>(rectangle.lt.x);
+  int32_t height = static_cast<int32_t>(rectangle.rb.y)
+      - static_cast<int32_t>(rectangle.lt.y);
+  if (width <= 0 || height <= 0
+      || static_cast<uint32_t>(min(width, height)) < min_face_size_) {
+    HIAI_ENGINE_LOG("face %dx%d is too small, skip it", width, height);
+    return false;
+  }
+
+  // 2. sharpness, computed last as it reads the pixels
+  if (min_sharpness_ > 0) {
+    double sharpness = Sharpness(org_img, rectangle);
+    if (sharpness < min_sharpness_) {
+      HIAI_ENGINE_LOG("face sharpness %f is too low, skip it", sharpness);
+      return false;
+    }
+  }
+  return true;
+}
+
+void FaceQuality::MarkFaces(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  // registered faces are chosen by user, failed frames are skipped
+  if (image_handle->frame.image_source != kCameraSrc
+      || image_handle->err_info.err_code != AppErrorCode::kNone) {
+    return;
+  }
+
+  // faces reusing the feature vector of their track were checked before,
+  // skipped faces stay in the result and are shown as unknown
+  for (FaceImage &face_img : image_handle->face_imgs) {
+    if (!face_img.feature_cached
+        && !IsQualified(image_handle->org_img, face_img)) {
+      face_img.quality_skipped = true;
+    }
+  }
+}
+
+void FaceQuality::SendResult(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  HIAI_StatusT hiai_ret;
+  // when register face, can not discard when queue full
+  do {
+    hiai_ret = SendData(kSendDataPort, "FaceRecognitionInfo",
+                        static_pointer_cast<void>(image_handle));
+    // when queue full, sleep
+    if (hiai_ret == HIAI_QUEUE_FULL) {
+      HIAI_ENGINE_LOG("queue full, sleep 200ms");
+      usleep(kSleepInterval);
+    }
+  } while (hiai_ret == HIAI_QUEUE_FULL
+      && image_handle->frame.image_source == kRegisterSrc);
+
+  // send failed
+  if (hiai_ret != HIAI_OK) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "call SendData failed, err_code=%d", hiai_ret);
+  }
+}
+
+HIAI_IMPL_ENGINE_PROCESS("face_quality", FaceQuality, INPUT_SIZE) {
+  // deal arg0 (engine only have one input)
+  if (arg0 != nullptr) {
+    shared_ptr<FaceRecognitionInfo> image_handle = static_pointer_cast<
+        FaceRecognitionInfo>(arg0);
+    MarkFaces(image_handle);
+    SendResult(image_handle);
+  }
+  return HIAI_OK;
+}
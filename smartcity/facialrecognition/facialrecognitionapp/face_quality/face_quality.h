@@ -0,0 +1,112 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef FACE_QUALITY_ENGINE_H_
+#define FACE_QUALITY_ENGINE_H_
+
+#include <memory>
+#include <vector>
+
+#include "hiaiengine/engine.h"
+#include "hiaiengine/data_type_reg.h"
+
+#include "face_recognition_params.h"
+
+#define INPUT_SIZE 1
+#define OUTPUT_SIZE 1
+
+/**
+ * @brief: mark tiny and blurry camera faces before the landmarks and feature
+ *         vector inference, they give poor feature vectors
+ */
+class FaceQuality : public hiai::Engine {
+public:
+  /**
+   * @brief: face quality engine initialize
+   * @param [in]: engine's parameters which configured in graph.config
+   * @param [in]: model description
+   * @return: HIAI_StatusT
+   */
+  HIAI_StatusT Init(const hiai::AIConfig& config,
+                    const std::vector<hiai::AIModelDescription>& model_desc);
+
+  /**
+   * @brief: engine processor which override HIAI engine
+   *         check every face, and then send data to face feature mask
+   * @param [in]: input size
+   * @param [in]: output size
+   */
+HIAI_DEFINE_PROCESS(INPUT_SIZE, OUTPUT_SIZE)
+  ;
+
+private:
+  /**
+   * @brief: mark the faces of a camera frame failing any threshold as
+   *         quality_skipped, they keep their box but get no feature vector
+   * param [out]: image_handle: engine transform data
+   */
+  void MarkFaces(const std::shared_ptr<FaceRecognitionInfo> &image_handle);
+
+  /**
+   * @brief: check size and sharpness of a face, they need no landmarks
+   * param [in]: org_img: original NV12 image
+   * param [in]: face_img: face box
+   * @return: true: good enough for feature vector; false: skip it
+   */
+  bool IsQualified(const hiai::ImageData<u_int8_t> &org_img,
+                   const FaceImage &face_img);
+
+  /**
+   * @brief: variance of the Laplacian of the face box on the luma plane,
+   *         low for blurry faces
+   * param [in]: org_img: original NV12 image
+   * param [in]: rectangle: face box
+   * @return: sharpness
+   */
+  double Sharpness(const hiai::ImageData<u_int8_t> &org_img,
+                   const FaceRectangle &rectangle);
+
+  /**
+   * @brief: send result
+   * param [in]: image_handle: engine transform data
+   */
+  void SendResult(const std::shared_ptr<FaceRecognitionInfo> &image_handle);
+
+  // min width and height of a face box (pixel), 0 disables the check
+  uint32_t min_face_size_;
+
+  // min sharpness of a face, 0 disables the check
+  double min_sharpness_;
+};
+
+#endif /* FACE_QUALITY_ENGINE_H_ */
@@ -33,12 +33,16 @@
 
 #include "face_recognition.h"
 
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <sstream>
+#include <string>
 
 #include "hiaiengine/log.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
+#include "ascenddk/ascend_face_preprocess/face_preprocess.h"
+#include "ascenddk/ascend_face_tracker/face_tracker.h"
 
 using hiai::Engine;
 using hiai::ImageData;
@@ -54,11 +58,19 @@ const uint32_t kSendDataPort = 0;
 const float kResizeWidth = 96.0;
 const float kResizeHeight = 112.0;
 
+// image source from camera
+const uint32_t kCameraSrc = 0;
+
 // image source from register
 const uint32_t kRegisterSrc = 1;
 
-// The memory size of the BGR image is 3 times that of width*height.
-const int32_t kBgrBufferMultiple = 3;
+// max horizontal offset of nose from the middle of the eyes, relative to the
+// eye distance, 0 disables the check
+const string kMaxYawRatioParamKey = "max_yaw_ratio";
+const float kDefaultMaxYawRatio = 0.5;
+
+// The memory size of the RGB image is 3 times that of width*height.
+const int32_t kRgbBufferMultiple = 3;
 
 // destination points for aligned face
 const float kLeftEyeX = 30.2946;
@@ -76,12 +88,6 @@ const float kRightMouthCornerY = 92.2041;
 const int32_t kEstimateRows = 2;
 const int32_t kEstimateCols = 3;
 
-// flip face
-// Horizontally flip for OpenCV
-const int32_t kHorizontallyFlip = 1;
-// Vertically and Horizontally flip for OpenCV
-const int32_t kVerticallyAndHorizontallyFlip = -1;
-
 // inference batch
 const int32_t kBatchSize = 4;
 // every batch has one aligned face and one flip face, total 2
@@ -102,6 +108,7 @@ HIAI_REGISTER_DATA_TYPE("FaceImage", FaceImage);
 
 FaceRecognition::FaceRecognition() {
   ai_model_manager_ = nullptr;
+  max_yaw_ratio_ = kDefaultMaxYawRatio;
 }
 
 HIAI_StatusT FaceRecognition::Init(
@@ -123,10 +130,19 @@ HIAI_StatusT FaceRecognition::Init(
     if (item.name() == kModelPathParamKey) {
       const char* model_path = item.value().data();
       fg_model_desc.set_path(model_path);
+    } else if (item.name() == kMaxYawRatioParamKey) {
+      stringstream ss(item.value());
+      ss >> max_yaw_ratio_;
     }
     // else: noting need to do
   }
 
+  if (max_yaw_ratio_ < 0) {
+    HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                    "max_yaw_ratio invalid, please check your configuration.");
+    return HIAI_ERROR;
+  }
+
   // initialize model manager
   vector<hiai::AIModelDescription> model_desc_vec;
   model_desc_vec.push_back(fg_model_desc);
@@ -194,34 +210,6 @@ bool FaceRecognition::ResizeImg(const FaceImage &face_img,
   return true;
 }
 
-bool FaceRecognition::Nv12ToBgr(const ImageData<u_int8_t> &src_image,
-                                Mat &dst) {
-  // transforming smart pointer data into Mat type data
-  // for calling OpenCV interface
-  Mat src(src_image.height * kNv12SizeMolecule / kNv12SizeDenominator,
-          src_image.width, CV_8UC1);
-
-  // number of characters to copy, the size of yuv image is 1.5 times
-  // than width * height;
-  int copy_size = src_image.width * src_image.height * kNv12SizeMolecule
-      / kNv12SizeDenominator;
-
-  // size of the destination buffer
-  int destination_size = src.cols * src.rows * src.elemSize();
-
-  // copy the input image data into the Mat matrix for image conversion.
-  int ret = memcpy_s(src.data, destination_size, src_image.data.get(),
-                     copy_size);
-  // check memory_s result
-  CHECK_MEM_OPERATOR_RESULTS(ret);
-
-  // call OpenCV interface to convert image from yuv420sp_nv12 to bgr
-  // OpenCV interface have no return value
-  cvtColor(src, dst, CV_YUV2BGR_NV12);
-
-  return true;
-}
-
 bool FaceRecognition::checkTransfromMat(const Mat &mat) {
   // openCV warpAffine method, need transformation matrix should match
   // 1. type need CV_32F or CV_64F
@@ -240,14 +228,7 @@ bool FaceRecognition::checkTransfromMat(const Mat &mat) {
 bool FaceRecognition::AlignedAndFlipFace(
     const FaceImage &face_img, const ImageData<u_int8_t> &resized_image,
     int32_t index, vector<AlignedFace> &aligned_imgs) {
-  // Step1: convert NV12 to BGR
-  Mat bgr_img;
-  if (!Nv12ToBgr(resized_image, bgr_img)) {
-    // failed, no need to do anything
-    return false;
-  }
-
-  // Step2: aligned face
+  // Step1: aligned face
   // arrange destination points
   vector<cv::Point2f> dst_points;
   dst_points.emplace_back(cv::Point2f(kLeftEyeX, kLeftEyeY));
@@ -321,35 +302,55 @@ bool FaceRecognition::AlignedAndFlipFace(
     return false;
   }
 
-  cv::Size img_size(kResizeWidth, kResizeHeight);
-  Mat aligned_img;
-  warpAffine(bgr_img, aligned_img, point_estimate, img_size);
-
-  // Step3: flip image (call OpenCV)
-  // first Horizontally flip
-  Mat h_flip;
-  flip(aligned_img, h_flip, kHorizontallyFlip);
-  // then Vertically and Horizontally flip
-  Mat hv_flip;
-  flip(h_flip, hv_flip, kVerticallyAndHorizontallyFlip);
-
-  // Step4: change to RGB (because AIPP need this format)
-  cvtColor(aligned_img, aligned_img, cv::COLOR_BGR2RGB);
-  cvtColor(hv_flip, hv_flip, cv::COLOR_BGR2RGB);
-
-  // Step5: set back to aligned images
+  // Step2: set back to aligned images, warp, flip and change to RGB
+  // (because AIPP need this format) are done in the batch buffer
   AlignedFace result;
   result.face_index = index;
-  result.aligned_face = aligned_img;
-  result.aligned_flip_face = hv_flip;
+  result.resized_image = resized_image;
+  Mat transform(kEstimateRows, kEstimateCols, CV_64F, result.transform);
+  point_estimate.convertTo(transform, CV_64F);
   aligned_imgs.emplace_back(result);
   return true;
 }
 
+bool FaceRecognition::IsFrontal(const FaceFeature &mask) {
+  // nose of a frontal face is between the eyes
+  float eye_distance = hypot(mask.right_eye.x - mask.left_eye.x,
+                             mask.right_eye.y - mask.left_eye.y);
+  float eye_middle_x = (mask.left_eye.x + mask.right_eye.x) / 2.0;
+  return eye_distance > 0
+      && fabs(mask.nose.x - eye_middle_x) <= max_yaw_ratio_ * eye_distance;
+}
+
+void FaceRecognition::SkipProfileFaces(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  // registered faces are chosen by user
+  if (max_yaw_ratio_ <= 0
+      || image_handle->frame.image_source != kCameraSrc) {
+    return;
+  }
+
+  // profile faces stay in the result without feature vector, as the faces
+  // skipped by face quality
+  for (FaceImage &face_img : image_handle->face_imgs) {
+    if (!face_img.feature_cached && !face_img.quality_skipped
+        && face_img.feature_mask.flag && !IsFrontal(face_img.feature_mask)) {
+      HIAI_ENGINE_LOG("face is not frontal, skip it");
+      face_img.quality_skipped = true;
+    }
+  }
+}
+
 void FaceRecognition::PreProcess(const vector<FaceImage> &face_imgs,
                                  vector<AlignedFace> &aligned_imgs) {
   // loop each cropped face image
   for (int32_t index = 0; index < face_imgs.size(); ++index) {
+    // feature vector reused from the face track or face skipped by the
+    // quality check, no landmarks either
+    if (face_imgs[index].feature_cached || face_imgs[index].quality_skipped) {
+      continue;
+    }
+
     // check flag, if false need not to do anything
     if (!face_imgs[index].feature_mask.flag) {
       HIAI_ENGINE_LOG("flag is false, skip it");
@@ -383,22 +384,31 @@ bool FaceRecognition::PrepareBuffer(int32_t batch_begin,
   for (int i = 0; i < kBatchSize; ++i) {
     // real image
     if (batch_begin + i < aligned_imgs.size()) {
-      AlignedFace face_img = aligned_imgs[batch_begin + i];
-      // copy aligned face image
-      errno_t ret = memcpy_s(batch_buffer.get() + last_size,
-                             buffer_size - last_size,
-                             face_img.aligned_face.ptr<uint8_t>(),
-                             each_img_size);
-      // check memcpy_s result
-      CHECK_MEM_OPERATOR_RESULTS(ret);
-      last_size += each_img_size;
-
-      // copy aligned flip face image
-      ret = memcpy_s(batch_buffer.get() + last_size, buffer_size - last_size,
-                     face_img.aligned_flip_face.ptr<uint8_t>(), each_img_size);
-      // check memcpy_s result
-      CHECK_MEM_OPERATOR_RESULTS(ret);
-      last_size += each_img_size;
+      const AlignedFace &face_img = aligned_imgs[batch_begin + i];
+      if (buffer_size - last_size < each_img_size * kBatchImgCount) {
+        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                        "batch buffer is too small, buffer_size=%u",
+                        buffer_size);
+        return false;
+      }
+
+      // warp aligned face image and its flip image (the two OpenCV flips,
+      // horizontally then vertically and horizontally, only reverse rows)
+      uint8_t *aligned_face = batch_buffer.get() + last_size;
+      uint8_t *aligned_flip_face = aligned_face + each_img_size;
+      if (!WarpAffineNv12ToRgb(face_img.resized_image.data.get(),
+                               face_img.resized_image.width,
+                               face_img.resized_image.height,
+                               face_img.resized_image.width,
+                               face_img.transform, kResizeWidth,
+                               kResizeHeight, aligned_face,
+                               aligned_flip_face)) {
+        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                        "warp face failed, face index=%d",
+                        face_img.face_index);
+        return false;
+      }
+      last_size += each_img_size * kBatchImgCount;
     } else {  // image size less than batch size
       // need set all data to 0
       errno_t ret = memset_s(batch_buffer.get() + last_size,
@@ -467,8 +477,8 @@ bool FaceRecognition::ArrangeResult(
 void FaceRecognition::InferenceFeatureVector(
     const vector<AlignedFace> &aligned_imgs, vector<FaceImage> &face_imgs) {
   // initialize buffer
-  uint32_t each_img_size = aligned_imgs[0].aligned_face.total()
-      * aligned_imgs[0].aligned_face.channels();
+  uint32_t each_img_size = static_cast<uint32_t>(kResizeWidth)
+      * static_cast<uint32_t>(kResizeHeight) * kRgbBufferMultiple;
   uint32_t buffer_size = each_img_size * kBatchImgCount * kBatchSize;
   shared_ptr<uint8_t> batch_buffer = shared_ptr<uint8_t>(
       new uint8_t[buffer_size], default_delete<uint8_t[]>());
@@ -567,6 +577,9 @@ HIAI_StatusT FaceRecognition::Recognition(
     return HIAI_ERROR;
   }
 
+  // pose needs the landmarks, it is checked here rather than in face quality
+  SkipProfileFaces(image_handle);
+
   // pre-process
   vector<AlignedFace> aligned_imgs;
   PreProcess(image_handle->face_imgs, aligned_imgs);
@@ -581,6 +594,15 @@ HIAI_StatusT FaceRecognition::Recognition(
   // inference and set results
   InferenceFeatureVector(aligned_imgs, image_handle->face_imgs);
 
+  // keep new feature vectors for the following frames of their tracks
+  FaceTracker &tracker = FaceTracker::GetInstance();
+  for (const FaceImage &face_img : image_handle->face_imgs) {
+    if (face_img.track_id >= 0 && !face_img.feature_cached
+        && !face_img.feature_vector.empty()) {
+      tracker.UpdateFeature(face_img.track_id, face_img.feature_vector);
+    }
+  }
+
   // send result
   SendResult(image_handle);
   return HIAI_OK;
@@ -52,14 +52,17 @@
 
 #define AI_MODEL_PROCESS_TIMEOUT 0
 
-// aligned face data
+// warpAffine matrix has 2 rows and 3 cols
+#define TRANSFORM_SIZE 6
+
+// aligned face data, warped straight into the batch buffer
 struct AlignedFace {
 // face index (using for set result)
   int32_t face_index;
-// aligned face
-  cv::Mat aligned_face;
-// flip face according to aligned face
-  cv::Mat aligned_flip_face;
+// resized face (NV12, no padding)
+  hiai::ImageData<u_int8_t> resized_image;
+// warpAffine matrix from the resized face to the aligned face
+  double transform[TRANSFORM_SIZE];
 };
 
 /**
@@ -99,10 +102,29 @@ private:
 // cache AI model parameters
   std::shared_ptr<hiai::AIModelManager> ai_model_manager_;
 
+// max horizontal offset of nose from the middle of the eyes, relative to the
+// eye distance, 0 disables the pose check
+  float max_yaw_ratio_;
+
+  /**
+   * @brief: check pose of a face by its landmarks
+   * param [in]: mask: face landmarks
+   * @return: true: frontal enough for feature vector; false: skip it
+   */
+  bool IsFrontal(const FaceFeature &mask);
+
+  /**
+   * @brief: mark the camera faces which are not frontal as quality_skipped,
+   *         they keep their box but get no feature vector
+   * param [out]: image_handle: engine transform data
+   */
+  void SkipProfileFaces(
+      const std::shared_ptr<FaceRecognitionInfo> &image_handle);
+
   /**
    * @brief: pre-process
    * param [in]: face_imgs: face images
-   * param [out]: aligned_imgs: aligned output images (RGB)
+   * param [out]: aligned_imgs: resized faces and their transformations
    */
   void PreProcess(const std::vector<FaceImage> &face_imgs,
                   std::vector<AlignedFace> &aligned_imgs);
@@ -115,16 +137,6 @@ private:
   bool ResizeImg(const FaceImage &face_img,
                  hiai::ImageData<u_int8_t> &resized_image);
 
-  /**
-   * @brief Image format conversion, call OpenCV interface to transform
-   *        the image, from YUV420SP_NV12 to BGR
-   * @param [in] src_image: source image
-   * @param [out] dst: image after conversion, Mat type
-   * @return true: yuv420spnv12 convert to BGR success
-   *         false: yuv420spnv12 convert to BGR failed
-   */
-  bool Nv12ToBgr(const hiai::ImageData<u_int8_t> &src_image, cv::Mat &dst);
-
   /**
    * @brief check transformation matrix for openCV wapAffine
    * @param [in] mat: transformation matrix
@@ -134,11 +146,12 @@ private:
   bool checkTransfromMat(const cv::Mat &mat);
 
   /**
-   * @brief: aligned and flip face
+   * @brief: estimate the transformation which aligns the face, the aligned
+   *         and flip images are warped later in PrepareBuffer
    * param [in]: face_img: cropped face image
    * param [in]: resized_image: call ez_dvpp output image
    * param [in]: index: image index
-   * param [out]: aligned_imgs: result image
+   * param [out]: aligned_imgs: resized face and its transformation
    * @return: true: success; false: failed
    */
   bool AlignedAndFlipFace(const FaceImage &face_img,
@@ -153,7 +166,8 @@ private:
    * param [out]: batch_buffer: batch buffer
    * param [in]: buffer_size: batch buffer total size
    * param [in]: each_img_size: each face image size
-   * param [in]: aligned_imgs: aligned face and flip images
+   * param [in]: aligned_imgs: resized faces and their transformations,
+   *             each one is warped into an aligned and a flip image
    * @return: true: success; false: failed
    */
   bool PrepareBuffer(int32_t batch_begin,
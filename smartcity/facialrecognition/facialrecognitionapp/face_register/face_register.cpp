@@ -42,6 +42,8 @@
 #include "hiaiengine/log.h"
 #include "hiaiengine/data_type_reg.h"
 #include "face_recognition_params.h"
+#include "ascenddk/ascend_face_gallery/face_gallery_replica.h"
+#include "ascenddk/ascend_face_gallery/feature_codec.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
 
 using hiai::Engine;
@@ -49,6 +51,61 @@ using namespace hiai;
 using namespace std;
 using namespace ascend::presenter;
 using namespace ascend::presenter::facial_recognition;
+using ascend::utils::FaceGalleryReplica;
+using ascend::utils::FaceGalleryUpdate;
+using ascend::utils::kReplicaFeatureDim;
+
+namespace {
+/**
+ * @brief decode the feature vector of a face in any encoding
+ * @param [in] face: face of a gallery sync message
+ * @param [out] feature: feature vector, empty if the face has no vector or
+ *                       its length is invalid
+ */
+void DecodeFeature(const FaceFeature& face, vector<float>& feature) {
+  const string& packed = face.packed_vector();
+  feature.clear();
+  switch (face.encoding()) {
+    case kFeatureFp16:
+      if (packed.size() == kReplicaFeatureDim * sizeof(uint16_t)) {
+        feature.resize(kReplicaFeatureDim);
+        ascend::utils::DecodeFp16(
+            reinterpret_cast<const uint16_t*>(packed.data()),
+            kReplicaFeatureDim, feature.data());
+      }
+      break;
+    case kFeatureInt8:
+      if (packed.size() == kReplicaFeatureDim) {
+        feature.resize(kReplicaFeatureDim);
+        ascend::utils::DecodeInt8(
+            reinterpret_cast<const int8_t*>(packed.data()),
+            kReplicaFeatureDim, face.scale(), feature.data());
+      }
+      break;
+    default:
+      if (static_cast<uint32_t>(face.vector_size()) == kReplicaFeatureDim) {
+        feature.assign(face.vector().begin(), face.vector().end());
+      }
+      break;
+  }
+}
+
+/**
+ * @brief apply a gallery sync message of presenter server to the replica
+ *        shared with face_match engine
+ * @param [in] sync: reset replaces all faces, a face without vector is
+ *                   removed, the others are added or replaced
+ */
+void ApplyGallerySync(const GallerySync& sync) {
+  vector<FaceGalleryUpdate> faces(sync.face_size());
+  for (int i = 0; i < sync.face_size(); i++) {
+    faces[i].name = sync.face(i).name();
+    DecodeFeature(sync.face(i), faces[i].feature);
+  }
+  FaceGalleryReplica::GetInstance().Apply(sync.reset(), sync.threshold(),
+                                          faces);
+}
+}
 
 bool FaceRegister::IsInvalidIp(const string &ip) {
   regex re(kIpRegularExpression);
@@ -148,14 +205,29 @@ bool FaceRegister::DoRegisterProcess() {
 
   HIAI_StatusT hiai_ret = HIAI_OK;
   while (1) {
+    // this loop is the only reader of the register channel, messages pushed
+    // by server are dispatched by type. face_post_process only sends on it.
     // construct registered request Message and read message
     unique_ptr < google::protobuf::Message > response_rec;
     PresenterErrorCode agent_ret = agent_channel->ReceiveMessage(response_rec);
     if (agent_ret == PresenterErrorCode::kNone) {
-      FaceInfo* face_register_req = (FaceInfo*) (response_rec.get());
+      // registered faces of presenter server, used by face_match engine
+      GallerySync* gallery_sync =
+          dynamic_cast<GallerySync*>(response_rec.get());
+      if (gallery_sync != nullptr) {
+        HIAI_ENGINE_LOG("gallery sync: reset = %d, face number = %d",
+                        gallery_sync->reset(), gallery_sync->face_size());
+        ApplyGallerySync(*gallery_sync);
+        continue;
+      }
+
+      FaceInfo* face_register_req =
+          dynamic_cast<FaceInfo*>(response_rec.get());
       if (face_register_req == nullptr) {
         HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                        "[DoRegisterProcess]face_register_req is nullptr");
+                        "[DoRegisterProcess]unexpected message %s, ignored",
+                        response_rec == nullptr ? "null"
+                            : response_rec->GetTypeName().c_str());
         continue;
       }
 
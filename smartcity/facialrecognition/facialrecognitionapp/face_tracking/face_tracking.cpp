@@ -0,0 +1,169 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include "face_tracking.h"
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "hiaiengine/log.h"
+#include "ascenddk/ascend_face_tracker/face_tracker.h"
+
+using namespace std;
+using ascend::utils::FaceTracker;
+using ascend::utils::TrackedFace;
+
+namespace {
+// output port (engine port begin with 0)
+const uint32_t kSendDataPort = 0;
+
+// image source from camera
+const uint32_t kCameraSrc = 0;
+
+// image source from register
+const uint32_t kRegisterSrc = 1;
+
+// sleep interval when queue full (unit:microseconds)
+const __useconds_t kSleepInterval = 200000;
+
+// parameter keys in graph.config
+const string kIouThresholdParamKey = "iou_threshold";
+const string kRefreshIntervalParamKey = "refresh_interval";
+const string kMaxLostFramesParamKey = "max_lost_frames";
+
+// default parameters
+const float kDefaultIouThreshold = 0.3;
+const uint32_t kDefaultRefreshInterval = 10;
+const uint32_t kDefaultMaxLostFrames = 3;
+}
+
+// register custom data type
+HIAI_REGISTER_DATA_TYPE("FaceRecognitionInfo", FaceRecognitionInfo);
+HIAI_REGISTER_DATA_TYPE("FaceRectangle", FaceRectangle);
+HIAI_REGISTER_DATA_TYPE("FaceImage", FaceImage);
+
+HIAI_StatusT FaceTracking::Init(
+    const hiai::AIConfig& config,
+    const vector<hiai::AIModelDescription>& model_desc) {
+  float iou_threshold = kDefaultIouThreshold;
+  uint32_t refresh_interval = kDefaultRefreshInterval;
+  uint32_t max_lost_frames = kDefaultMaxLostFrames;
+  for (int index = 0; index < config.items_size(); index++) {
+    const ::hiai::AIConfigItem& item = config.items(index);
+    stringstream ss(item.value());
+    if (item.name() == kIouThresholdParamKey) {
+      ss >> iou_threshold;
+    } else if (item.name() == kRefreshIntervalParamKey) {
+      ss >> refresh_interval;
+    } else if (item.name() == kMaxLostFramesParamKey) {
+      ss >> max_lost_frames;
+    }
+    // else: noting need to do
+  }
+
+  if (iou_threshold <= 0 || iou_threshold > 1 || refresh_interval == 0) {
+    HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                    "iou_threshold or refresh_interval invalid, "
+                    "please check your configuration.");
+    return HIAI_ERROR;
+  }
+
+  FaceTracker::GetInstance().SetParams(iou_threshold, refresh_interval,
+                                       max_lost_frames);
+  return HIAI_OK;
+}
+
+void FaceTracking::TrackFaces(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  // registered faces always need feature vectors, failed frames are skipped
+  if (image_handle->frame.image_source != kCameraSrc
+      || image_handle->err_info.err_code != AppErrorCode::kNone) {
+    return;
+  }
+
+  vector<FaceImage> &face_imgs = image_handle->face_imgs;
+  vector<TrackedFace> faces(face_imgs.size());
+  for (uint32_t i = 0; i < face_imgs.size(); i++) {
+    const FaceRectangle &box = face_imgs[i].rectangle;
+    faces[i].lt_x = static_cast<float>(box.lt.x);
+    faces[i].lt_y = static_cast<float>(box.lt.y);
+    faces[i].rb_x = static_cast<float>(box.rb.x);
+    faces[i].rb_y = static_cast<float>(box.rb.y);
+  }
+  FaceTracker::GetInstance().Track(faces);
+
+  // a face of a track with a fresh feature vector skips the inference
+  for (uint32_t i = 0; i < face_imgs.size(); i++) {
+    face_imgs[i].track_id = faces[i].track_id;
+    face_imgs[i].feature_cached = faces[i].feature_cached;
+    if (faces[i].feature_cached) {
+      face_imgs[i].feature_vector.swap(faces[i].feature);
+    }
+  }
+}
+
+void FaceTracking::SendResult(
+    const shared_ptr<FaceRecognitionInfo> &image_handle) {
+  HIAI_StatusT hiai_ret;
+  // when register face, can not discard when queue full
+  do {
+    hiai_ret = SendData(kSendDataPort, "FaceRecognitionInfo",
+                        static_pointer_cast<void>(image_handle));
+    // when queue full, sleep
+    if (hiai_ret == HIAI_QUEUE_FULL) {
+      HIAI_ENGINE_LOG("queue full, sleep 200ms");
+      usleep(kSleepInterval);
+    }
+  } while (hiai_ret == HIAI_QUEUE_FULL
+      && image_handle->frame.image_source == kRegisterSrc);
+
+  // send failed
+  if (hiai_ret != HIAI_OK) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "call SendData failed, err_code=%d", hiai_ret);
+  }
+}
+
+HIAI_IMPL_ENGINE_PROCESS("face_tracking", FaceTracking, INPUT_SIZE) {
+  // deal arg0 (engine only have one input)
+  if (arg0 != nullptr) {
+    shared_ptr<FaceRecognitionInfo> image_handle = static_pointer_cast<
+        FaceRecognitionInfo>(arg0);
+    TrackFaces(image_handle);
+    SendResult(image_handle);
+  }
+  return HIAI_OK;
+}
@@ -54,12 +54,49 @@ const int kWaitTime = 20000;
 const int kDestImageWidth = 224;
 // the image height for model.
 const int kDestImageHeight = 224;
+// the model name used to query the model tensor dims
+const string kModelName = "car_color";
 // the name of model_path in the config file
 const string kModelPathItemName = "model_path";
 // the name of passcode in the config file
 const string kPasscodeItemName = "passcode";
 // the name of batch_size in the config file
 const string kBatchSizeItemName = "batch_size";
+// the names of attribute cache params in the config file
+const string kCacheCapacityItemName = "cache_capacity";
+const string kCacheIouThresholdItemName = "cache_iou_threshold";
+const string kCacheRefreshConfidenceItemName = "cache_refresh_confidence";
+const string kCacheMaxAgeItemName = "cache_max_age";
+// the name of batch deadline in the config file
+const string kBatchDeadlineItemName = "batch_deadline_ms";
+
+// dvpp params to resize a whole object image to the model resolution
+ascend::utils::DvppCropOrResizePara ModelResizeParam(
+    const hiai::ImageData<u_int8_t>& img) {
+  ascend::utils::DvppCropOrResizePara dvpp_resize_param;
+
+  /**
+   * when use dvpp_process only for resize function:
+   *
+   * 1.DVPP limits horz_max and vert_max should be Odd number,
+   * if it is even number, subtract 1, otherwise Equal to origin width
+   * or height.
+   *
+   * 2.horz_min and vert_min should be set to zero.
+   */
+  dvpp_resize_param.horz_max = img.width % 2 == 0 ? img.width - 1 : img.width;
+  dvpp_resize_param.horz_min = 0;
+  dvpp_resize_param.vert_max =
+      img.height % 2 == 0 ? img.height - 1 : img.height;
+  dvpp_resize_param.vert_min = 0;
+  dvpp_resize_param.is_input_align = true;
+  dvpp_resize_param.is_output_align = true;
+  dvpp_resize_param.src_resolution.width = img.width;
+  dvpp_resize_param.src_resolution.height = img.height;
+  dvpp_resize_param.dest_resolution.width = kDestImageWidth;
+  dvpp_resize_param.dest_resolution.height = kDestImageHeight;
+  return dvpp_resize_param;
+}
 }
 
 HIAI_REGISTER_DATA_TYPE("BatchCarInfoT", BatchCarInfoT);
@@ -79,9 +116,16 @@ HIAI_StatusT CarColorInferenceEngine::Init(
 
   std::vector<hiai::AIModelDescription> model_desc_vec;
   hiai::AIModelDescription model_description;
+  model_description.set_name(kModelName);
+  size_t cache_capacity = CACHE_CAPACITY;
+  float cache_iou_threshold = CACHE_IOU_THRESHOLD;
+  float cache_refresh_confidence = CACHE_REFRESH_CONFIDENCE;
+  uint32_t cache_max_age = CACHE_MAX_AGE;
+  uint32_t batch_deadline_ms = BATCH_DEADLINE_MS;
 
   for (int index = 0; index < config.items_size(); ++index) {
     const ::hiai::AIConfigItem& item = config.items(index);
+    bool valid = true;
     if (item.name() == kModelPathItemName) {
       const char* model_path = item.value().data();
       model_description.set_path(model_path);
@@ -90,10 +134,31 @@ HIAI_StatusT CarColorInferenceEngine::Init(
       const char* passcode = item.value().data();
       model_description.set_key(passcode);
     } else if (item.name() == kBatchSizeItemName) {
-      std::stringstream ss(item.value());
-      ss >> batch_size_;
+      valid = StringToNumber(item.value(), batch_size_) && batch_size_ > 0;
+    } else if (item.name() == kCacheCapacityItemName) {
+      valid = StringToNumber(item.value(), cache_capacity);
+    } else if (item.name() == kCacheIouThresholdItemName) {
+      valid = StringToNumber(item.value(), cache_iou_threshold)
+          && cache_iou_threshold > 0.0f && cache_iou_threshold <= 1.0f;
+    } else if (item.name() == kCacheRefreshConfidenceItemName) {
+      valid = StringToNumber(item.value(), cache_refresh_confidence)
+          && cache_refresh_confidence >= 0.0f
+          && cache_refresh_confidence <= 1.0f;
+    } else if (item.name() == kCacheMaxAgeItemName) {
+      valid = StringToNumber(item.value(), cache_max_age);
+    } else if (item.name() == kBatchDeadlineItemName) {
+      valid = StringToNumber(item.value(), batch_deadline_ms);
+    }
+    if (!valid) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "[CarColorInferenceEngine] %s value %s is invalid!",
+                      item.name().c_str(), item.value().c_str());
+      return HIAI_ERROR;
     }
   }
+  batcher_.SetParams(batch_size_, batch_deadline_ms);
+  attribute_cache_.SetParams(cache_capacity, cache_iou_threshold,
+                             cache_refresh_confidence, cache_max_age);
 
   model_desc_vec.push_back(model_description);
   ret = ai_model_manager_->Init(config, model_desc_vec);
@@ -101,6 +166,26 @@ HIAI_StatusT CarColorInferenceEngine::Init(
     return HIAI_ERROR;
   }
 
+  // input and output tensors are reused by every batch
+  if (!tensor_arena_.Init(ai_model_manager_, kModelName)) {
+    HIAI_ENGINE_LOG("[CarColorInferenceEngine] init tensor arena failed!");
+    return HIAI_ERROR;
+  }
+
+  // objects are resized straight into the model input, one after another
+  hiai::ImageData<u_int8_t> model_image;
+  model_image.width = kDestImageWidth;
+  model_image.height = kDestImageHeight;
+  ascend::utils::DvppProcess dvpp_process(ModelResizeParam(model_image));
+  uint32_t batch_buffer_size = dvpp_process.GetCropOrResizeOutputSize()
+      * batch_size_;
+  if (batch_buffer_size != tensor_arena_.input_size()) {
+    HIAI_ENGINE_LOG(
+        "[CarColorInferenceEngine] batch buffer size %u is not model input %u!",
+        batch_buffer_size, tensor_arena_.input_size());
+    return HIAI_ERROR;
+  }
+
   HIAI_ENGINE_LOG("[CarColorInferenceEngine] end init!");
   return HIAI_OK;
 }
@@ -127,98 +212,56 @@ HIAI_StatusT CarColorInferenceEngine::SendResultData(
   return HIAI_OK;
 }
 
-void CarColorInferenceEngine::BatchImageResize(
-    std::shared_ptr<BatchCroppedImageParaT>& batch_image_input,
-    std::shared_ptr<BatchCroppedImageParaT>& batch_image_output) {
-  batch_image_output->video_image_info = batch_image_input->video_image_info;
-  // resize for each image
-  for (std::vector<ObjectImageParaT>::iterator iter = batch_image_input
-      ->obj_imgs.begin(); iter != batch_image_input->obj_imgs.end(); ++iter) {
-    ascend::utils::DvppCropOrResizePara dvpp_resize_param;
-
-    /**
-     * when use dvpp_process only for resize function:
-     *
-     * 1.DVPP limits horz_max and vert_max should be Odd number,
-     * if it is even number, subtract 1, otherwise Equal to origin width
-     * or height.
-     *
-     * 2.horz_min and vert_min should be set to zero.
-     */
-    dvpp_resize_param.horz_max =
-        iter->img.width % 2 == 0 ? iter->img.width - 1 : iter->img.width;
-    dvpp_resize_param.horz_min = 0;
-    dvpp_resize_param.vert_max =
-        iter->img.height % 2 == 0 ? iter->img.height - 1 : iter->img.height;
-    dvpp_resize_param.vert_min = 0;
-    dvpp_resize_param.is_input_align = true;
-    dvpp_resize_param.is_output_align = true;
-    dvpp_resize_param.src_resolution.width = iter->img.width;
-    dvpp_resize_param.src_resolution.height = iter->img.height;
-    dvpp_resize_param.dest_resolution.width = kDestImageWidth;
-    dvpp_resize_param.dest_resolution.height = kDestImageHeight;
-
-    ascend::utils::DvppProcess dvpp_process(dvpp_resize_param);
-
-    char* image_buffer = (char*) (iter->img.data.get());
-    ascend::utils::DvppOutput dvpp_out;
-    int ret = dvpp_process.DvppOperationProc(image_buffer, iter->img.size,
-                                             &dvpp_out);
+bool CarColorInferenceEngine::ResizeBatchIntoBuffer(
+    const std::vector<PendingObjectT>& batch, uint8_t* buffer,
+    uint32_t buffer_size, std::vector<PendingObjectT>& ready_objects) {
+  uint32_t image_size = buffer_size / batch_size_;
+  for (std::vector<PendingObjectT>::const_iterator iter = batch.begin();
+      iter != batch.end(); ++iter) {
+    const hiai::ImageData<u_int8_t>& img = iter->obj_img.img;
+    uint8_t* image_buffer = buffer + ready_objects.size() * image_size;
+
+    // object_detection_post resizes car images to the model resolution
+    // once for both car classifiers, such images are copied as they are
+    if (img.width == kDestImageWidth && img.height == kDestImageHeight
+        && img.size == image_size) {
+      errno_t err = memcpy_s(image_buffer, image_size, img.data.get(),
+                             image_size);
+      if (err != EOK) {
+        HIAI_ENGINE_LOG(
+            "[CarColorInferenceEngine] ERROR, copy image buffer failed");
+        return false;
+      }
+      ready_objects.push_back(*iter);
+      continue;
+    }
+
+    // dvpp writes the resized image to its place in the batch, so neither
+    // a buffer per object nor a copy into the batch is needed
+    ascend::utils::DvppProcess dvpp_process(ModelResizeParam(img));
+    int ret = dvpp_process.DvppCropOrResizeProc(
+        reinterpret_cast<char*>(img.data.get()), img.size, image_size,
+        image_buffer);
     if (ret != ascend::utils::kDvppOperationOk) {
       HIAI_ENGINE_LOG(
           "[CarColorInferenceEngine] resize image failed with code %d !", ret);
       continue;
     }
-
-    std::shared_ptr<ObjectImageParaT> obj_image = std::make_shared<
-        ObjectImageParaT>();
-
-    obj_image->object_info.object_id = iter->object_info.object_id;
-    obj_image->object_info.score = iter->object_info.score;
-    obj_image->img.width = kDestImageWidth;
-    obj_image->img.height = kDestImageHeight;
-    obj_image->img.channel = iter->img.channel;
-    obj_image->img.depth = iter->img.depth;
-    obj_image->img.size = dvpp_out.size;
-    obj_image->img.data.reset(dvpp_out.buffer,
-                              std::default_delete<uint8_t[]>());
-    batch_image_output->obj_imgs.push_back(*obj_image);
+    ready_objects.push_back(*iter);
   }
-}
 
-bool CarColorInferenceEngine::ConstructBatchBuffer(
-    int batch_index,
-    const std::shared_ptr<BatchCroppedImageParaT>& image_handle,
-    uint8_t* temp) {
-  bool is_successed = true;
-  int image_number = image_handle->obj_imgs.size();
-  int image_size = image_handle->obj_imgs[0].img.size * sizeof(uint8_t);
-
-  //the loop for each image
-  for (int j = 0; j < batch_size_; j++) {
-    if (batch_index + j < image_number) {
-      errno_t err = memcpy_s(
-          temp + j * image_size, image_size,
-          image_handle->obj_imgs[batch_index + j].img.data.get(), image_size);
-      if (err != EOK) {
-        HIAI_ENGINE_LOG(
-            "[CarTypeInferenceEngine] ERROR, copy image buffer failed");
-        is_successed = false;
-        break;
-      }
-    } else {
-      errno_t err = memset_s(temp + j * image_size, image_size,
-                             static_cast<char>(0), image_size);
-      if (err != EOK) {
-        HIAI_ENGINE_LOG(
-            "[CarTypeInferenceEngine] batch padding for image data failed");
-        is_successed = false;
-        break;
-      }
+  // batch padding for image data
+  uint32_t used_size = ready_objects.size() * image_size;
+  if (used_size < buffer_size) {
+    errno_t err = memset_s(buffer + used_size, buffer_size - used_size,
+                           static_cast<char>(0), buffer_size - used_size);
+    if (err != EOK) {
+      HIAI_ENGINE_LOG(
+          "[CarColorInferenceEngine] batch padding for image data failed");
+      return false;
     }
   }
-
-  return is_successed;
+  return true;
 }
 
 bool CarColorInferenceEngine::ConstructInferenceResult(
@@ -270,107 +313,161 @@ bool CarColorInferenceEngine::ConstructInferenceResult(
   return true;
 }
 
+HIAI_StatusT CarColorInferenceEngine::InferenceReadyBatches(bool flush) {
+  HIAI_StatusT hiai_ret = HIAI_OK;
+  uint64_t batch_count = batcher_.batch_count();
+  std::vector<PendingObjectT> batch;
+  while (batcher_.Pop(flush, batch)) {
+    if (BatchInferenceProcess(batch) != HIAI_OK) {
+      hiai_ret = HIAI_ERROR;
+    }
+  }
+
+  if (batcher_.batch_count() != batch_count) {
+    HIAI_ENGINE_LOG(
+        "[CarColorInferenceEngine] batches: %llu, fill ratio: %.2f, "
+        "deadline misses: %llu",
+        static_cast<unsigned long long>(batcher_.batch_count()),
+        batcher_.FillRatio(),
+        static_cast<unsigned long long>(batcher_.deadline_misses()));
+  }
+  return hiai_ret;
+}
+
 HIAI_StatusT CarColorInferenceEngine::BatchInferenceProcess(
-    const std::shared_ptr<BatchCroppedImageParaT>& image_handle,
-    std::shared_ptr<BatchCarInfoT> tran_data) {
+    const std::vector<PendingObjectT>& batch) {
   HIAI_ENGINE_LOG("[CarColorInferenceEngine] start process!");
 
   hiai::AIStatus ret = hiai::SUCCESS;
-  HIAI_StatusT hiai_ret = HIAI_OK;
-  int image_number = image_handle->obj_imgs.size();
-  int image_size = image_handle->obj_imgs[0].img.size * sizeof(uint8_t);
-  int batch_buffer_size = image_size * batch_size_;
-
-  // the loop for each batch ,maybe image_number greater than batch_size_
-  for (int i = 0; i < image_number; i += batch_size_) {
 
-    std::vector<std::shared_ptr<hiai::IAITensor> > input_data_vec;
-    std::vector<std::shared_ptr<hiai::IAITensor> > output_data_vec;
-    //1.prepare input buffer for each batch
-    if (tran_data == nullptr) {
-      tran_data = std::make_shared<BatchCarInfoT>();
-    }
-
-    // apply buffer for each batch
-    uint8_t* temp = new uint8_t[batch_buffer_size];
-    // Origin image information is transmitted to next Engine directly
-    tran_data->video_image_info = image_handle->video_image_info;
-    bool is_successed = true;
+  //1.resize the objects into the input buffer of a preallocated slot
+  ascend::utils::TensorArenaSlot* slot = tensor_arena_.NextSlot();
+  if (slot == nullptr) {
+    HIAI_ENGINE_LOG("[CarColorInferenceEngine] no tensor arena slot!");
+    return HIAI_ERROR;
+  }
+  std::vector<PendingObjectT> ready_objects;
+  bool is_successed = ResizeBatchIntoBuffer(batch, slot->input_buffer.get(),
+                                            slot->input_size, ready_objects);
+  if (!is_successed) {
+    HIAI_ENGINE_LOG(
+        "[CarColorInferenceEngine] batch input buffer construct failed!");
+    return HIAI_ERROR;
+  }
+  if (ready_objects.empty()) {
+    HIAI_ENGINE_LOG("[CarColorInferenceEngine] no object resized in batch");
+    return HIAI_ERROR;
+  }
 
-    is_successed = ConstructBatchBuffer(i, image_handle, temp);
-    if (!is_successed) {
-      HIAI_ENGINE_LOG(
-          "[CarColorInferenceEngine] batch input buffer construct failed!");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
+  // the objects of one batch may belong to different frames
+  std::shared_ptr<BatchCroppedImageParaT> image_handle = std::make_shared<
+      BatchCroppedImageParaT>();
+  for (std::vector<PendingObjectT>::const_iterator iter =
+      ready_objects.begin(); iter != ready_objects.end(); ++iter) {
+    image_handle->obj_imgs.push_back(iter->obj_img);
+  }
+  std::shared_ptr<BatchCarInfoT> batch_result =
+      std::make_shared<BatchCarInfoT>();
+
+  // 2.Call Process, Predict
+  hiai::AIContext ai_context;
+  HIAI_ENGINE_LOG(
+      "[CarColorInferenceEngine] ai_model_manager_->Process start!");
+  ret = ai_model_manager_->Process(ai_context, slot->input_tensors,
+                                   slot->output_tensors, 0);
+  if (ret != hiai::SUCCESS) {
+    HIAI_ENGINE_LOG(
+        "[CarColorInferenceEngine] ai_model_manager Process failed");
+    return HIAI_ERROR;
+  }
 
-    std::shared_ptr<hiai::AINeuralNetworkBuffer> neural_buffer =
-        std::shared_ptr<hiai::AINeuralNetworkBuffer>(
-            new hiai::AINeuralNetworkBuffer());
-    neural_buffer->SetBuffer((void*) (temp), batch_buffer_size);
-    std::shared_ptr<hiai::IAITensor> input_data = std::static_pointer_cast<
-        hiai::IAITensor>(neural_buffer);
-    input_data_vec.push_back(input_data);
-
-    // 2.Call Process, Predict
-    ret = ai_model_manager_->CreateOutputTensor(input_data_vec,
-                                                output_data_vec);
-    if (ret != hiai::SUCCESS) {
-      HIAI_ENGINE_LOG("[CarColorInferenceEngine] CreateOutputTensor failed");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
-    hiai::AIContext ai_context;
+  //3.get the result of each object in the batch
+  is_successed = ConstructInferenceResult(slot->output_tensors, 0,
+                                          image_handle,
+                                          batch_result);
+  if (!is_successed
+      || batch_result->car_infos.size() != ready_objects.size()) {
     HIAI_ENGINE_LOG(
-        "[CarColorInferenceEngine] ai_model_manager_->Process start!");
-    ret = ai_model_manager_->Process(ai_context, input_data_vec,
-                                     output_data_vec, 0);
-    if (ret != hiai::SUCCESS) {
-      HIAI_ENGINE_LOG(
-          "[CarColorInferenceEngine] ai_model_manager Process failed");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
-    delete[] temp;
-    input_data_vec.clear();
+        "[CarColorInferenceEngine] batch copy output buffer failed!");
+    return HIAI_ERROR;
+  }
 
-    //3.set the tran_data with the result of this batch
+  //4. send the results back to their frames
+  ScatterResults(ready_objects, batch_result);
 
-    is_successed = ConstructInferenceResult(output_data_vec, i, image_handle,
-                                            tran_data);
+  HIAI_ENGINE_LOG("[CarColorInferenceEngine] end process!");
+  return HIAI_OK;
+}
 
-    if (!is_successed) {
-      HIAI_ENGINE_LOG(
-          "[CarColorInferenceEngine] batch copy output buffer failed!");
-      return HIAI_ERROR;
+void CarColorInferenceEngine::ScatterResults(
+    const std::vector<PendingObjectT>& batch,
+    const std::shared_ptr<BatchCarInfoT>& batch_result) {
+  std::shared_ptr<BatchCarInfoT> tran_data = nullptr;
+  for (size_t index = 0; index < batch.size(); ++index) {
+    const VideoImageInfoT& video_image_info = batch[index].video_image_info;
+    const CarInfoT& car_info = batch_result->car_infos[index];
+    attribute_cache_.Store(video_image_info, batch[index].obj_img.object_info,
+                           car_info, car_info.confidence);
+
+    // objects of one frame are adjacent in the batch, send when frame changes
+    if (tran_data != nullptr
+        && (tran_data->video_image_info.channel_id
+            != video_image_info.channel_id
+            || tran_data->video_image_info.frame_id
+                != video_image_info.frame_id)) {
+      if (SendResultData(tran_data) != HIAI_OK) {
+        HIAI_ENGINE_LOG("[CarColorInferenceEngine] SendData failed!");
+      }
+      tran_data = nullptr;
     }
-    //4. send the result
-    hiai_ret = SendResultData(tran_data);
-    if (hiai_ret != HIAI_OK) {
-      HIAI_ENGINE_LOG(
-          "[CarColorInferenceEngine] SendData failed! error code: %d",
-          hiai_ret);
+    if (tran_data == nullptr) {
+      tran_data = std::make_shared<BatchCarInfoT>();
+      tran_data->video_image_info = video_image_info;
     }
+    tran_data->car_infos.push_back(car_info);
+  }
 
-    //5. release sources
-    tran_data = nullptr;
+  if (tran_data != nullptr && SendResultData(tran_data) != HIAI_OK) {
+    HIAI_ENGINE_LOG("[CarColorInferenceEngine] SendData failed!");
   }
+}
 
-  HIAI_ENGINE_LOG("[CarColorInferenceEngine] end process!");
-  return HIAI_OK;
+void CarColorInferenceEngine::FilterCachedObjects(
+    std::shared_ptr<BatchCroppedImageParaT>& image_input,
+    const std::shared_ptr<BatchCarInfoT>& cached_data) {
+  cached_data->video_image_info = image_input->video_image_info;
+  std::vector<ObjectImageParaT> uncached_imgs;
+  for (std::vector<ObjectImageParaT>::iterator iter = image_input->obj_imgs
+      .begin(); iter != image_input->obj_imgs.end(); ++iter) {
+    CarInfoT car_info;
+    if (!iter->refresh_attributes
+        && attribute_cache_.Lookup(image_input->video_image_info,
+                                   iter->object_info, car_info)) {
+      car_info.object_id = iter->object_info.object_id;
+      cached_data->car_infos.push_back(car_info);
+    } else {
+      uncached_imgs.push_back(*iter);
+    }
+  }
+  image_input->obj_imgs.swap(uncached_imgs);
+
+  if (++cache_frames_ % CACHE_REPORT_FRAMES != 0) {
+    return;
+  }
+  HIAI_ENGINE_LOG(
+      "[CarColorInferenceEngine] attribute cache hits: %llu, misses: %llu, "
+      "hit rate: %.2f",
+      static_cast<unsigned long long>(attribute_cache_.hits()),
+      static_cast<unsigned long long>(attribute_cache_.misses()),
+      attribute_cache_.HitRate());
 }
 
 HIAI_IMPL_ENGINE_PROCESS("car_color_inference", CarColorInferenceEngine,
                          INPUT_SIZE) {
-  HIAI_StatusT hiai_ret = HIAI_OK;
   std::shared_ptr<BatchCarInfoT> tran_data = std::make_shared<BatchCarInfoT>();
   std::shared_ptr<BatchCroppedImageParaT> image_input = std::make_shared<
       BatchCroppedImageParaT>();
 
-  std::shared_ptr<BatchCroppedImageParaT> image_handle = std::make_shared<
-      BatchCroppedImageParaT>();
-
   if (arg0 == nullptr) {
     HIAI_ENGINE_LOG("[CarColorInferenceEngine] input data is null!");
     return HIAI_ERROR;
@@ -389,16 +486,32 @@ HIAI_IMPL_ENGINE_PROCESS("car_color_inference", CarColorInferenceEngine,
 
   // add is_finished for showing this data in dataset are all sended.
   if (image_input->video_image_info.is_finished == true) {
+    // pending objects are inferred before the finished data goes downstream
+    if (InferenceReadyBatches(true) != HIAI_OK) {
+      HIAI_ENGINE_LOG("[CarColorInferenceEngine] flush pending objects failed");
+    }
+    attribute_cache_.EraseChannel(image_input->video_image_info.channel_id);
     tran_data->video_image_info = image_input->video_image_info;
     return SendResultData(tran_data);
   }
 
-  // resize input image;
-  BatchImageResize(image_input, image_handle);
-  if (image_handle->obj_imgs.empty() == true) {
-    HIAI_ENGINE_LOG("[CarColorInferenceEngine] image_input resize failed");
-    return HIAI_ERROR;
+  // reuse cached attributes, only objects which miss the cache are inferred
+  std::shared_ptr<BatchCarInfoT> cached_data =
+      std::make_shared<BatchCarInfoT>();
+  FilterCachedObjects(image_input, cached_data);
+  if (!cached_data->car_infos.empty()
+      && SendResultData(cached_data) != HIAI_OK) {
+    HIAI_ENGINE_LOG("[CarColorInferenceEngine] send cached result failed!");
   }
+
+  // queue input images for cross frame batching, they are resized when the
+  // batch is built. an input without object works as a clock so expired
+  // objects are still inferred
+  for (std::vector<ObjectImageParaT>::iterator iter = image_input->obj_imgs
+      .begin(); iter != image_input->obj_imgs.end(); ++iter) {
+    batcher_.Push(image_input->video_image_info, *iter);
+  }
+
   // inference and send inference result;
-  return BatchInferenceProcess(image_handle, tran_data);
+  return InferenceReadyBatches(false);
 }
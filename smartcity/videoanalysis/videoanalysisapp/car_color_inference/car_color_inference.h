@@ -42,20 +42,39 @@
 #include "hiaiengine/data_type_reg.h"
 #include "hiaiengine/ai_tensor.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
+#include "ascenddk/ascend_tensor_arena/tensor_arena.h"
 
 #include "video_analysis_params.h"
+#include "attribute_cache.h"
+#include "dynamic_batcher.h"
 
 #define INPUT_SIZE 2
 #define OUTPUT_SIZE 1
 #define BATCH_SIZE 10
 
+// default params of attribute cache
+#define CACHE_CAPACITY 256
+#define CACHE_IOU_THRESHOLD 0.5f
+#define CACHE_REFRESH_CONFIDENCE 0.6f
+#define CACHE_MAX_AGE 25
+
+// frames between two reports of the attribute cache hit rate
+#define CACHE_REPORT_FRAMES 100
+
+// default max waiting time of an object for a full batch, in milliseconds
+#define BATCH_DEADLINE_MS 50
+
 class CarColorInferenceEngine : public hiai::Engine {
  public:
   /**
    * @brief constructor
    */
   CarColorInferenceEngine()
-      : input_que_(INPUT_SIZE - 1) {
+      : input_que_(INPUT_SIZE - 1),
+        attribute_cache_(CACHE_CAPACITY, CACHE_IOU_THRESHOLD,
+                         CACHE_REFRESH_CONFIDENCE, CACHE_MAX_AGE),
+        cache_frames_(0),
+        batcher_(BATCH_SIZE, BATCH_DEADLINE_MS) {
     batch_size_ = BATCH_SIZE;
   }
   /**
@@ -79,40 +98,62 @@ class CarColorInferenceEngine : public hiai::Engine {
   hiai::MultiTypeQueue input_que_;
   // Define a AIModelManager type smart pointer.
   std::shared_ptr<hiai::AIModelManager> ai_model_manager_;
+  // last inference result of each object.
+  AttributeCache<CarInfoT> attribute_cache_;
+  // frames looked up in the attribute cache, for the hit rate report.
+  uint64_t cache_frames_;
+  // accumulates objects of different frames into model batches.
+  DynamicBatcher batcher_;
+  // model input and output tensors, allocated at init.
+  ascend::utils::TensorArena tensor_arena_;
   /**
-   * @brief call ez_dvpp interface for resizing image.
-   * @param [in] batch_image_input:  batch image from previous engine.
-   * @param [out] batch_image_output: batch image for processing.
+   * @brief move objects whose attribute is cached and not due a refresh out
+   *        of the input batch.
+   * @param [in] image_input: batch image from previous engine, objects which
+   *             hit the cache are removed.
+   * @param [out] cached_data: cached results of the removed objects.
    */
-  void BatchImageResize(
-      std::shared_ptr<BatchCroppedImageParaT>& batch_image_input,
-      std::shared_ptr<BatchCroppedImageParaT>& batch_image_output);
+  void FilterCachedObjects(
+      std::shared_ptr<BatchCroppedImageParaT>& image_input,
+      const std::shared_ptr<BatchCarInfoT>& cached_data);
   /**
    * @brief  send result data to next engine.
    * @param [in] tran_data: the data will be sent to next engine.
    * @return  success --> HIAI_OK ; fail --> HIAI_ERROR
    */
   HIAI_StatusT SendResultData(const std::shared_ptr<BatchCarInfoT>& tran_data);
+  /**
+   * @brief  inference all batches which are ready in the batcher
+   * @param [in] flush:  inference pending objects even if batch is not full.
+   * @return  success --> HIAI_OK ; fail --> HIAI_ERROR
+   */
+  HIAI_StatusT InferenceReadyBatches(bool flush);
   /**
    * @brief  batch inference
-   * @param [in] image_handle: batch image for processing.
-   * @param [in] tran_data:  the data will be sent to next engine.
+   * @param [in] batch: objects of one batch, may belong to different frames.
    * @return  success --> HIAI_OK ; fail --> HIAI_ERROR
    */
-  HIAI_StatusT BatchInferenceProcess(
-      const std::shared_ptr<BatchCroppedImageParaT>& image_handle,
-      std::shared_ptr<BatchCarInfoT> tran_data);
+  HIAI_StatusT BatchInferenceProcess(const std::vector<PendingObjectT>& batch);
   /**
-   * @brief  construct batch buffer as a input for process
-   * @param [in] batch_index:  batch index of input image;
-   * @param [in] image_handle:  batch image for processing.
-   * @param [in] temp:  apply memory for image origin data.
+   * @brief  send results of a batch back to the frames of the objects
+   * @param [in] batch: objects of one batch.
+   * @param [in] batch_result: inference result of each object of the batch.
+   */
+  void ScatterResults(const std::vector<PendingObjectT>& batch,
+                      const std::shared_ptr<BatchCarInfoT>& batch_result);
+  /**
+   * @brief  resize the objects of a batch with dvpp straight into the model
+   *         input buffer, one image after another, and pad the rest with 0
+   * @param [in] batch:  objects of one batch.
+   * @param [out] buffer:  model input buffer.
+   * @param [in] buffer_size:  size of model input buffer.
+   * @param [out] ready_objects:  objects written to the buffer, in order,
+   *              objects which failed to resize are left out.
    * @return  success --> true ; fail --> fail
    */
-  bool ConstructBatchBuffer(
-      int batch_index,
-      const std::shared_ptr<BatchCroppedImageParaT>& image_handle,
-      uint8_t* temp);
+  bool ResizeBatchIntoBuffer(const std::vector<PendingObjectT>& batch,
+                             uint8_t* buffer, uint32_t buffer_size,
+                             std::vector<PendingObjectT>& ready_objects);
   /**
    * @brief  analyze inference result
    * @param [in] output_data_vec:  inference output from model
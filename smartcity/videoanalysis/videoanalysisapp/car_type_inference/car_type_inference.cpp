@@ -113,12 +113,21 @@ const int kWaitTime = 20000;
 const int kDestImageWidth = 224;
 // the image height for model.
 const int kDestImageHeight = 224;
+// the model name used to query the model tensor dims
+const string kModelName = "car_type";
 // the name of model_path in the config file
 const string kModelPathItemName = "model_path";
 // the name of passcode in the config file
 const string kPasscodeItemName = "passcode";
 // the name of batch_size in the config file
 const string kBatchSizeItemName = "batch_size";
+// the names of attribute cache params in the config file
+const string kCacheCapacityItemName = "cache_capacity";
+const string kCacheIouThresholdItemName = "cache_iou_threshold";
+const string kCacheRefreshConfidenceItemName = "cache_refresh_confidence";
+const string kCacheMaxAgeItemName = "cache_max_age";
+// the name of batch deadline in the config file
+const string kBatchDeadlineItemName = "batch_deadline_ms";
 }
 
 HIAI_REGISTER_DATA_TYPE("BatchCarInfoT", BatchCarInfoT);
@@ -138,10 +147,17 @@ HIAI_StatusT CarTypeInferenceEngine::Init(
 
   std::vector<hiai::AIModelDescription> model_desc_vec;
   hiai::AIModelDescription model_description;
+  model_description.set_name(kModelName);
+  size_t cache_capacity = CACHE_CAPACITY;
+  float cache_iou_threshold = CACHE_IOU_THRESHOLD;
+  float cache_refresh_confidence = CACHE_REFRESH_CONFIDENCE;
+  uint32_t cache_max_age = CACHE_MAX_AGE;
+  uint32_t batch_deadline_ms = BATCH_DEADLINE_MS;
 
   for (int index = 0; index < config.items_size(); ++index) {
 
     const ::hiai::AIConfigItem& item = config.items(index);
+    bool valid = true;
 
     if (item.name() == kModelPathItemName) {
       const char* model_path = item.value().data();
@@ -151,10 +167,31 @@ HIAI_StatusT CarTypeInferenceEngine::Init(
       const char* passcode = item.value().data();
       model_description.set_key(passcode);
     } else if (item.name() == kBatchSizeItemName) {
-      std::stringstream ss(item.value());
-      ss >> batch_size_;
+      valid = StringToNumber(item.value(), batch_size_) && batch_size_ > 0;
+    } else if (item.name() == kCacheCapacityItemName) {
+      valid = StringToNumber(item.value(), cache_capacity);
+    } else if (item.name() == kCacheIouThresholdItemName) {
+      valid = StringToNumber(item.value(), cache_iou_threshold)
+          && cache_iou_threshold > 0.0f && cache_iou_threshold <= 1.0f;
+    } else if (item.name() == kCacheRefreshConfidenceItemName) {
+      valid = StringToNumber(item.value(), cache_refresh_confidence)
+          && cache_refresh_confidence >= 0.0f
+          && cache_refresh_confidence <= 1.0f;
+    } else if (item.name() == kCacheMaxAgeItemName) {
+      valid = StringToNumber(item.value(), cache_max_age);
+    } else if (item.name() == kBatchDeadlineItemName) {
+      valid = StringToNumber(item.value(), batch_deadline_ms);
+    }
+    if (!valid) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "[CarTypeInferenceEngine] %s value %s is invalid!",
+                      item.name().c_str(), item.value().c_str());
+      return HIAI_ERROR;
     }
   }
+  batcher_.SetParams(batch_size_, batch_deadline_ms);
+  attribute_cache_.SetParams(cache_capacity, cache_iou_threshold,
+                             cache_refresh_confidence, cache_max_age);
 
   model_desc_vec.push_back(model_description);
   ret = ai_model_manager_->Init(config, model_desc_vec);
@@ -162,6 +199,12 @@ HIAI_StatusT CarTypeInferenceEngine::Init(
     return HIAI_ERROR;
   }
 
+  // input and output tensors are reused by every batch
+  if (!tensor_arena_.Init(ai_model_manager_, kModelName)) {
+    HIAI_ENGINE_LOG("[CarTypeInferenceEngine] init tensor arena failed!");
+    return HIAI_ERROR;
+  }
+
   HIAI_ENGINE_LOG("[CarTypeInferenceEngine] end init!");
   return HIAI_OK;
 }
@@ -195,6 +238,13 @@ void CarTypeInferenceEngine::BatchImageResize(
   // resize for each image
   for (std::vector<ObjectImageParaT>::iterator iter = batch_image_input
       ->obj_imgs.begin(); iter != batch_image_input->obj_imgs.end(); ++iter) {
+    // object_detection_post resizes car images to the model resolution
+    // once for both car classifiers, such images are used as they are
+    if (iter->img.width == kDestImageWidth
+        && iter->img.height == kDestImageHeight) {
+      batch_image_output->obj_imgs.push_back(*iter);
+      continue;
+    }
 
     ascend::utils::DvppCropOrResizePara dvpp_resize_param;
 
@@ -235,8 +285,7 @@ void CarTypeInferenceEngine::BatchImageResize(
     std::shared_ptr<ObjectImageParaT> obj_image = std::make_shared<
         ObjectImageParaT>();
 
-    obj_image->object_info.object_id = iter->object_info.object_id;
-    obj_image->object_info.score = iter->object_info.score;
+    obj_image->object_info = iter->object_info;
     obj_image->img.width = kDestImageWidth;
     obj_image->img.height = kDestImageHeight;
     obj_image->img.channel = iter->img.channel;
@@ -333,98 +382,159 @@ bool CarTypeInferenceEngine::ConstructInferenceResult(
   return true;
 }
 
+HIAI_StatusT CarTypeInferenceEngine::InferenceReadyBatches(bool flush) {
+  HIAI_StatusT hiai_ret = HIAI_OK;
+  uint64_t batch_count = batcher_.batch_count();
+  std::vector<PendingObjectT> batch;
+  while (batcher_.Pop(flush, batch)) {
+    if (BatchInferenceProcess(batch) != HIAI_OK) {
+      hiai_ret = HIAI_ERROR;
+    }
+  }
+
+  if (batcher_.batch_count() != batch_count) {
+    HIAI_ENGINE_LOG(
+        "[CarTypeInferenceEngine] batches: %llu, fill ratio: %.2f, "
+        "deadline misses: %llu",
+        static_cast<unsigned long long>(batcher_.batch_count()),
+        batcher_.FillRatio(),
+        static_cast<unsigned long long>(batcher_.deadline_misses()));
+  }
+  return hiai_ret;
+}
+
 HIAI_StatusT CarTypeInferenceEngine::BatchInferenceProcess(
-    const std::shared_ptr<BatchCroppedImageParaT>& image_handle,
-    std::shared_ptr<BatchCarInfoT> tran_data) {
+    const std::vector<PendingObjectT>& batch) {
   HIAI_ENGINE_LOG("[CarTypeInferenceEngine] start process!");
 
+  // the objects of one batch may belong to different frames
+  std::shared_ptr<BatchCroppedImageParaT> image_handle = std::make_shared<
+      BatchCroppedImageParaT>();
+  for (std::vector<PendingObjectT>::const_iterator iter = batch.begin();
+      iter != batch.end(); ++iter) {
+    image_handle->obj_imgs.push_back(iter->obj_img);
+  }
+  std::shared_ptr<BatchCarInfoT> batch_result =
+      std::make_shared<BatchCarInfoT>();
+
   hiai::AIStatus ret = hiai::SUCCESS;
-  HIAI_StatusT hiai_ret = HIAI_OK;
-  int image_number = image_handle->obj_imgs.size();
   int image_size = image_handle->obj_imgs[0].img.size * sizeof(uint8_t);
   int batch_buffer_size = image_size * batch_size_;
 
-  // the loop for each batch ,maybe image_number greater than batch_size_
-  for (int i = 0; i < image_number; i += batch_size_) {
+  //1.prepare input buffer for the batch in a preallocated slot
+  ascend::utils::TensorArenaSlot* slot = tensor_arena_.NextSlot();
+  if (slot == nullptr) {
+    HIAI_ENGINE_LOG("[CarTypeInferenceEngine] no tensor arena slot!");
+    return HIAI_ERROR;
+  }
+  if (static_cast<uint32_t>(batch_buffer_size) != slot->input_size) {
+    HIAI_ENGINE_LOG(
+        "[CarTypeInferenceEngine] batch buffer size %d is not model input %u!",
+        batch_buffer_size, slot->input_size);
+    return HIAI_ERROR;
+  }
+  bool is_successed = ConstructBatchBuffer(0, image_handle,
+                                           slot->input_buffer.get());
+  if (!is_successed) {
+    HIAI_ENGINE_LOG(
+        "[CarTypeInferenceEngine] batch input buffer construct failed!");
+    return HIAI_ERROR;
+  }
 
-    std::vector<std::shared_ptr<hiai::IAITensor> > input_data_vec;
-    std::vector<std::shared_ptr<hiai::IAITensor> > output_data_vec;
-    //1.prepare input buffer for each batch
-    if (tran_data == nullptr) {
-      tran_data = std::make_shared<BatchCarInfoT>();
-    }
-    //  apply buffer for each batch
-    uint8_t* temp = new uint8_t[batch_buffer_size];
-    // Origin image information is transmitted to next Engine directly
-    tran_data->video_image_info = image_handle->video_image_info;
-    bool is_successed = true;
-
-    is_successed = ConstructBatchBuffer(i, image_handle, temp);
-    if (!is_successed) {
-      HIAI_ENGINE_LOG(
-          "[CarTypeInferenceEngine] batch input buffer construct failed!");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
+  // 2.Call Process, Predict
+  hiai::AIContext ai_context;
+  HIAI_ENGINE_LOG(
+      "[CarTypeInferenceEngine] ai_model_manager_->Process start!");
+  ret = ai_model_manager_->Process(ai_context, slot->input_tensors,
+                                   slot->output_tensors, 0);
+  if (ret != hiai::SUCCESS) {
+    HIAI_ENGINE_LOG(
+        "[CarTypeInferenceEngine] ai_model_manager Process failed");
+    return HIAI_ERROR;
+  }
 
-    std::shared_ptr<hiai::AINeuralNetworkBuffer> neural_buffer =
-        std::shared_ptr<hiai::AINeuralNetworkBuffer>(
-            new hiai::AINeuralNetworkBuffer());
-    neural_buffer->SetBuffer((void*) (temp), batch_buffer_size);
-    std::shared_ptr<hiai::IAITensor> input_data = std::static_pointer_cast<
-        hiai::IAITensor>(neural_buffer);
-    input_data_vec.push_back(input_data);
-
-    // 2.Call Process, Predict
-    ret = ai_model_manager_->CreateOutputTensor(input_data_vec,
-                                                output_data_vec);
-    if (ret != hiai::SUCCESS) {
-      HIAI_ENGINE_LOG("[CarTypeInferenceEngine] CreateOutputTensor failed");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
-    hiai::AIContext ai_context;
+  //3.get the result of each object in the batch
+  is_successed = ConstructInferenceResult(slot->output_tensors, 0,
+                                          image_handle,
+                                          batch_result);
+  if (!is_successed || batch_result->car_infos.size() != batch.size()) {
     HIAI_ENGINE_LOG(
-        "[CarTypeInferenceEngine] ai_model_manager_->Process start!");
-    ret = ai_model_manager_->Process(ai_context, input_data_vec,
-                                     output_data_vec, 0);
-    if (ret != hiai::SUCCESS) {
-      HIAI_ENGINE_LOG(
-          "[CarTypeInferenceEngine] ai_model_manager Process failed");
-      delete[] temp;
-      return HIAI_ERROR;
-    }
-    delete[] temp;
-    input_data_vec.clear();
+        "[CarTypeInferenceEngine] batch copy output buffer failed!");
+    return HIAI_ERROR;
+  }
 
-    //3.set the tran_data with the result of this batch
+  //4. send the results back to their frames
+  ScatterResults(batch, batch_result);
 
-    is_successed = ConstructInferenceResult(output_data_vec, i, image_handle,
-                                            tran_data);
+  HIAI_ENGINE_LOG("[CarTypeInferenceEngine] end process!");
+  return HIAI_OK;
+}
 
-    if (!is_successed) {
-      HIAI_ENGINE_LOG(
-          "[CarTypeInferenceEngine] batch copy output buffer failed!");
-      return HIAI_ERROR;
+void CarTypeInferenceEngine::ScatterResults(
+    const std::vector<PendingObjectT>& batch,
+    const std::shared_ptr<BatchCarInfoT>& batch_result) {
+  std::shared_ptr<BatchCarInfoT> tran_data = nullptr;
+  for (size_t index = 0; index < batch.size(); ++index) {
+    const VideoImageInfoT& video_image_info = batch[index].video_image_info;
+    const CarInfoT& car_info = batch_result->car_infos[index];
+    attribute_cache_.Store(video_image_info, batch[index].obj_img.object_info,
+                           car_info, car_info.confidence);
+
+    // objects of one frame are adjacent in the batch, send when frame changes
+    if (tran_data != nullptr
+        && (tran_data->video_image_info.channel_id
+            != video_image_info.channel_id
+            || tran_data->video_image_info.frame_id
+                != video_image_info.frame_id)) {
+      if (SendResultData(tran_data) != HIAI_OK) {
+        HIAI_ENGINE_LOG("[CarTypeInferenceEngine] SendData failed!");
+      }
+      tran_data = nullptr;
     }
-    //4. send the result
-    hiai_ret = SendResultData(tran_data);
-    if (hiai_ret != HIAI_OK) {
-      HIAI_ENGINE_LOG(
-          "[CarTypeInferenceEngine] SendData failed! error code: %d", hiai_ret);
+    if (tran_data == nullptr) {
+      tran_data = std::make_shared<BatchCarInfoT>();
+      tran_data->video_image_info = video_image_info;
     }
+    tran_data->car_infos.push_back(car_info);
+  }
 
-    //5. release sources
-    tran_data = nullptr;
+  if (tran_data != nullptr && SendResultData(tran_data) != HIAI_OK) {
+    HIAI_ENGINE_LOG("[CarTypeInferenceEngine] SendData failed!");
   }
-  HIAI_ENGINE_LOG("[CarTypeInferenceEngine] end process!");
+}
 
-  return HIAI_OK;
+void CarTypeInferenceEngine::FilterCachedObjects(
+    std::shared_ptr<BatchCroppedImageParaT>& image_input,
+    const std::shared_ptr<BatchCarInfoT>& cached_data) {
+  cached_data->video_image_info = image_input->video_image_info;
+  std::vector<ObjectImageParaT> uncached_imgs;
+  for (std::vector<ObjectImageParaT>::iterator iter = image_input->obj_imgs
+      .begin(); iter != image_input->obj_imgs.end(); ++iter) {
+    CarInfoT car_info;
+    if (!iter->refresh_attributes
+        && attribute_cache_.Lookup(image_input->video_image_info,
+                                   iter->object_info, car_info)) {
+      car_info.object_id = iter->object_info.object_id;
+      cached_data->car_infos.push_back(car_info);
+    } else {
+      uncached_imgs.push_back(*iter);
+    }
+  }
+  image_input->obj_imgs.swap(uncached_imgs);
+
+  if (++cache_frames_ % CACHE_REPORT_FRAMES != 0) {
+    return;
+  }
+  HIAI_ENGINE_LOG(
+      "[CarTypeInferenceEngine] attribute cache hits: %llu, misses: %llu, "
+      "hit rate: %.2f",
+      static_cast<unsigned long long>(attribute_cache_.hits()),
+      static_cast<unsigned long long>(attribute_cache_.misses()),
+      attribute_cache_.HitRate());
 }
 
 HIAI_IMPL_ENGINE_PROCESS("car_type_inference", CarTypeInferenceEngine,
                          INPUT_SIZE) {
-  HIAI_StatusT hiai_ret = HIAI_OK;
   std::shared_ptr<BatchCarInfoT> tran_data = std::make_shared<BatchCarInfoT>();
   std::shared_ptr<BatchCroppedImageParaT> image_input = std::make_shared<
       BatchCroppedImageParaT>();
@@ -449,16 +559,37 @@ HIAI_IMPL_ENGINE_PROCESS("car_type_inference", CarTypeInferenceEngine,
 
   // add is_finished for showing this data in dataset are all sended.
   if (image_input->video_image_info.is_finished == true) {
+    // pending objects are inferred before the finished data goes downstream
+    if (InferenceReadyBatches(true) != HIAI_OK) {
+      HIAI_ENGINE_LOG("[CarTypeInferenceEngine] flush pending objects failed");
+    }
+    attribute_cache_.EraseChannel(image_input->video_image_info.channel_id);
     tran_data->video_image_info = image_input->video_image_info;
     return SendResultData(tran_data);
   }
 
-  // resize input image;
-  BatchImageResize(image_input, image_handle);
-  if (image_handle->obj_imgs.empty() == true) {
-    HIAI_ENGINE_LOG("[CarColorInferenceEngine] image_input resize failed");
-    return HIAI_ERROR;
+  // reuse cached attributes, only objects which miss the cache are inferred
+  std::shared_ptr<BatchCarInfoT> cached_data =
+      std::make_shared<BatchCarInfoT>();
+  FilterCachedObjects(image_input, cached_data);
+  if (!cached_data->car_infos.empty()
+      && SendResultData(cached_data) != HIAI_OK) {
+    HIAI_ENGINE_LOG("[CarTypeInferenceEngine] send cached result failed!");
   }
+
+  // resize input image and queue them for cross frame batching, an input
+  // without object works as a clock so expired objects are still inferred
+  if (!image_input->obj_imgs.empty()) {
+    BatchImageResize(image_input, image_handle);
+    if (image_handle->obj_imgs.empty() == true) {
+      HIAI_ENGINE_LOG("[CarTypeInferenceEngine] image_input resize failed");
+    }
+    for (std::vector<ObjectImageParaT>::iterator iter = image_handle->obj_imgs
+        .begin(); iter != image_handle->obj_imgs.end(); ++iter) {
+      batcher_.Push(image_handle->video_image_info, *iter);
+    }
+  }
+
   // inference and send inference result;
-  return BatchInferenceProcess(image_handle, tran_data);
+  return InferenceReadyBatches(false);
 }
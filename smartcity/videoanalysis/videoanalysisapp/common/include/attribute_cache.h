@@ -0,0 +1,246 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef COMMON_INCLUDE_ATTRIBUTE_CACHE_H
+#define COMMON_INCLUDE_ATTRIBUTE_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include "video_analysis_params.h"
+
+/**
+ * bounded LRU cache of the last attribute inference result of each object.
+ * Entries are keyed by (channel id, object id); if the object id is unknown,
+ * the object is associated by IoU with the recent boxes of the same label in
+ * the same channel, so a re-numbered object still hits its old entry.
+ * An entry is treated as a miss (and refreshed by the caller) when its
+ * confidence is lower than refresh_confidence or it is older than max_age
+ * frames.
+ */
+template<typename ResultT>
+class AttributeCache {
+ public:
+  /**
+   * @brief constructor
+   * @param [in] capacity: max number of cached objects
+   * @param [in] iou_threshold: min IoU to associate an unknown object id
+   * @param [in] refresh_confidence: results below it are inferred again
+   * @param [in] max_age: frames after which a result is inferred again
+   */
+  AttributeCache(size_t capacity, float iou_threshold,
+                 float refresh_confidence, uint32_t max_age)
+      : capacity_(capacity),
+        iou_threshold_(iou_threshold),
+        refresh_confidence_(refresh_confidence),
+        max_age_(max_age),
+        hits_(0),
+        misses_(0) {
+  }
+
+  /**
+   * @brief set cache params, existing entries are kept
+   * @param [in] capacity: max number of cached objects
+   * @param [in] iou_threshold: min IoU to associate an unknown object id
+   * @param [in] refresh_confidence: results below it are inferred again
+   * @param [in] max_age: frames after which a result is inferred again
+   */
+  void SetParams(size_t capacity, float iou_threshold,
+                 float refresh_confidence, uint32_t max_age) {
+    capacity_ = capacity;
+    iou_threshold_ = iou_threshold;
+    refresh_confidence_ = refresh_confidence;
+    max_age_ = max_age;
+    Shrink();
+  }
+
+  /**
+   * @brief look up the cached result of an object
+   * @param [in] image_info: frame which the object belongs to
+   * @param [in] object: object info with id, label and bounding box
+   * @param [out] result: cached result, only valid when hit
+   * @return true: hit and result can be reused; false: need inference
+   */
+  bool Lookup(const VideoImageInfoT& image_info, const ObjectInfoT& object,
+              ResultT& result) {
+    EntryIter entry = Find(image_info.channel_id, object);
+    if (entry == entries_.end()
+        || entry->confidence < refresh_confidence_
+        || image_info.frame_id - entry->frame_id > max_age_) {
+      ++misses_;
+      return false;
+    }
+
+    // follow the object, the next lookup is associated with the latest box
+    Rekey(entry, object.object_id);
+    entry->bbox = object.bbox;
+    entries_.splice(entries_.begin(), entries_, entry);
+    result = entry->result;
+    ++hits_;
+    return true;
+  }
+
+  /**
+   * @brief store the inference result of an object
+   * @param [in] image_info: frame which the object belongs to
+   * @param [in] object: object info with id, label and bounding box
+   * @param [in] result: inference result
+   * @param [in] confidence: confidence of the inference result
+   */
+  void Store(const VideoImageInfoT& image_info, const ObjectInfoT& object,
+             const ResultT& result, float confidence) {
+    EntryIter entry = Find(image_info.channel_id, object);
+    if (entry == entries_.end()) {
+      entries_.push_front(Entry());
+      entry = entries_.begin();
+      entry->channel_id = image_info.channel_id;
+      entry->object_id = object.object_id;
+      index_[Key(entry->channel_id, entry->object_id)] = entry;
+    } else {
+      Rekey(entry, object.object_id);
+      entries_.splice(entries_.begin(), entries_, entry);
+    }
+
+    entry->label = object.label;
+    entry->bbox = object.bbox;
+    entry->frame_id = image_info.frame_id;
+    entry->result = result;
+    entry->confidence = confidence;
+    Shrink();
+  }
+
+  /**
+   * @brief remove all entries of a channel, used when the video is finished
+   * @param [in] channel_id: video channel id
+   */
+  void EraseChannel(const std::string& channel_id) {
+    for (EntryIter iter = entries_.begin(); iter != entries_.end();) {
+      if (iter->channel_id == channel_id) {
+        index_.erase(Key(iter->channel_id, iter->object_id));
+        iter = entries_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  /**
+   * @brief number of lookups which reused a cached result
+   */
+  uint64_t hits() const {
+    return hits_;
+  }
+
+  /**
+   * @brief number of lookups which need inference
+   */
+  uint64_t misses() const {
+    return misses_;
+  }
+
+  /**
+   * @brief ratio of hits in all lookups
+   */
+  float HitRate() const {
+    uint64_t total = hits_ + misses_;
+    return total == 0 ? 0.0f : static_cast<float>(hits_) / total;
+  }
+
+ private:
+  struct Entry {
+    std::string channel_id;
+    uint32_t object_id;
+    uint32_t label;
+    BoundingBox bbox;
+    uint32_t frame_id;  // frame of the last inference
+    ResultT result;
+    float confidence;
+  };
+
+  typedef std::pair<std::string, uint32_t> Key;
+  typedef typename std::list<Entry>::iterator EntryIter;
+
+  // find entry by object id first, then by IoU in the same channel and label
+  EntryIter Find(const std::string& channel_id, const ObjectInfoT& object) {
+    typename std::map<Key, EntryIter>::iterator found = index_.find(
+        Key(channel_id, object.object_id));
+    if (found != index_.end()) {
+      return found->second;
+    }
+
+    EntryIter best = entries_.end();
+    float best_iou = iou_threshold_;
+    for (EntryIter iter = entries_.begin(); iter != entries_.end(); ++iter) {
+      if (iter->channel_id != channel_id || iter->label != object.label) {
+        continue;
+      }
+      float iou = BoundingBoxIoU(iter->bbox, object.bbox);
+      if (iou >= best_iou) {
+        best_iou = iou;
+        best = iter;
+      }
+    }
+    return best;
+  }
+
+  void Rekey(EntryIter entry, uint32_t object_id) {
+    if (entry->object_id == object_id) {
+      return;
+    }
+    index_.erase(Key(entry->channel_id, entry->object_id));
+    entry->object_id = object_id;
+    index_[Key(entry->channel_id, entry->object_id)] = entry;
+  }
+
+  // evict least recently used entries
+  void Shrink() {
+    while (entries_.size() > capacity_) {
+      index_.erase(Key(entries_.back().channel_id, entries_.back().object_id));
+      entries_.pop_back();
+    }
+  }
+
+  size_t capacity_;
+  float iou_threshold_;
+  float refresh_confidence_;
+  uint32_t max_age_;
+  uint64_t hits_;
+  uint64_t misses_;
+  // most recently used entry is at front
+  std::list<Entry> entries_;
+  std::map<Key, EntryIter> index_;
+};
+
+#endif /* COMMON_INCLUDE_ATTRIBUTE_CACHE_H */
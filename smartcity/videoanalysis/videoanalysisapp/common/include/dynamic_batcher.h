@@ -0,0 +1,161 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef COMMON_INCLUDE_DYNAMIC_BATCHER_H
+#define COMMON_INCLUDE_DYNAMIC_BATCHER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "video_analysis_params.h"
+
+// one object waiting to be inferred, with the frame it belongs to
+struct PendingObjectT {
+  VideoImageInfoT video_image_info;
+  ObjectImageParaT obj_img;
+  std::chrono::steady_clock::time_point arrival;
+};
+
+/**
+ * accumulates objects of different frames and channels into model batches.
+ * A batch is released when it is full or when the oldest object has waited
+ * longer than the deadline, so a frame with a single object no longer runs a
+ * whole zero padded batch on its own.
+ */
+class DynamicBatcher {
+ public:
+  /**
+   * @brief constructor
+   * @param [in] batch_size: model batch size
+   * @param [in] deadline_ms: max time an object waits for a full batch
+   */
+  DynamicBatcher(size_t batch_size, uint32_t deadline_ms)
+      : batch_size_(batch_size),
+        deadline_(deadline_ms),
+        batch_count_(0),
+        object_count_(0),
+        deadline_misses_(0) {
+  }
+
+  /**
+   * @brief set batcher params
+   * @param [in] batch_size: model batch size
+   * @param [in] deadline_ms: max time an object waits for a full batch
+   */
+  void SetParams(size_t batch_size, uint32_t deadline_ms) {
+    batch_size_ = batch_size;
+    deadline_ = std::chrono::milliseconds(deadline_ms);
+  }
+
+  /**
+   * @brief add an object to the pending queue
+   * @param [in] video_image_info: frame which the object belongs to
+   * @param [in] obj_img: resized object image
+   */
+  void Push(const VideoImageInfoT& video_image_info,
+            const ObjectImageParaT& obj_img) {
+    pending_.push_back(PendingObjectT { video_image_info, obj_img,
+        std::chrono::steady_clock::now() });
+  }
+
+  /**
+   * @brief pop a batch if it is ready
+   * @param [in] flush: pop even if the batch is neither full nor expired
+   * @param [out] batch: objects of the batch, in arrival order
+   * @return true: a batch is popped; false: nothing is ready
+   */
+  bool Pop(bool flush, std::vector<PendingObjectT>& batch) {
+    batch.clear();
+    if (pending_.empty()) {
+      return false;
+    }
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    bool expired = now - pending_.front().arrival >= deadline_;
+    if (pending_.size() < batch_size_ && !expired && !flush) {
+      return false;
+    }
+
+    while (!pending_.empty() && batch.size() < batch_size_) {
+      if (now - pending_.front().arrival > deadline_) {
+        ++deadline_misses_;
+      }
+      batch.push_back(pending_.front());
+      pending_.pop_front();
+    }
+    ++batch_count_;
+    object_count_ += batch.size();
+    return true;
+  }
+
+  /**
+   * @brief whether there is any pending object
+   */
+  bool Empty() const {
+    return pending_.empty();
+  }
+
+  /**
+   * @brief number of popped batches
+   */
+  uint64_t batch_count() const {
+    return batch_count_;
+  }
+
+  /**
+   * @brief number of objects which waited longer than the deadline
+   */
+  uint64_t deadline_misses() const {
+    return deadline_misses_;
+  }
+
+  /**
+   * @brief ratio of used slots in all popped batches
+   */
+  float FillRatio() const {
+    return batch_count_ == 0 ?
+        0.0f : static_cast<float>(object_count_) / (batch_count_ * batch_size_);
+  }
+
+ private:
+  size_t batch_size_;
+  std::chrono::milliseconds deadline_;
+  uint64_t batch_count_;
+  uint64_t object_count_;
+  uint64_t deadline_misses_;
+  std::deque<PendingObjectT> pending_;
+};
+
+#endif /* COMMON_INCLUDE_DYNAMIC_BATCHER_H */
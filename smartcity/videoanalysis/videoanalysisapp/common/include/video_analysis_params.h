@@ -34,6 +34,9 @@
 #ifndef COMMON_INCLUDE_VIDEO_ANALYSIS_PARAMS_H
 #define COMMON_INCLUDE_VIDEO_ANALYSIS_PARAMS_H
 
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include "hiaiengine/data_type.h"
 #include "hiaiengine/data_type_reg.h"
 
@@ -46,7 +49,7 @@ struct VideoImageInfoT {
   std::string channel_name;
   bool is_finished;
 
-  VideoImageInfoT& operator=(VideoImageInfoT& value) {
+  VideoImageInfoT& operator=(const VideoImageInfoT& value) {
     channel_id = value.channel_id;
     frame_id = value.frame_id;
     channel_name = value.channel_name;
@@ -70,34 +73,145 @@ void serialize(Archive& ar, VideoImageParaT& data) {
   ar(data.video_image_info, data.img);
 }
 
+struct BoundingBox {
+  uint32_t lt_x;
+  uint32_t lt_y;
+  uint32_t rb_x;
+  uint32_t rb_y;
+};
+
+template <class Archive>
+void serialize(Archive& ar, BoundingBox& data) {
+  ar(data.lt_x, data.lt_y, data.rb_x, data.rb_y);
+}
+
+/**
+ * @brief : calculate intersection over union of two bounding boxes.
+ * @param [in] lhs: bounding box.
+ * @param [in] rhs: bounding box.
+ * @return IoU between 0.0 and 1.0.
+ */
+inline float BoundingBoxIoU(const BoundingBox& lhs, const BoundingBox& rhs) {
+  uint32_t inter_lt_x = lhs.lt_x > rhs.lt_x ? lhs.lt_x : rhs.lt_x;
+  uint32_t inter_lt_y = lhs.lt_y > rhs.lt_y ? lhs.lt_y : rhs.lt_y;
+  uint32_t inter_rb_x = lhs.rb_x < rhs.rb_x ? lhs.rb_x : rhs.rb_x;
+  uint32_t inter_rb_y = lhs.rb_y < rhs.rb_y ? lhs.rb_y : rhs.rb_y;
+  if (inter_rb_x <= inter_lt_x || inter_rb_y <= inter_lt_y) {
+    return 0.0f;
+  }
+
+  float inter_area = static_cast<float>(inter_rb_x - inter_lt_x)
+      * (inter_rb_y - inter_lt_y);
+  float lhs_area = static_cast<float>(lhs.rb_x - lhs.lt_x)
+      * (lhs.rb_y - lhs.lt_y);
+  float rhs_area = static_cast<float>(rhs.rb_x - rhs.lt_x)
+      * (rhs.rb_y - rhs.lt_y);
+  return inter_area / (lhs_area + rhs_area - inter_area);
+}
+
+// class of an object, kept in the high bits of its object id
+enum ObjectClass {
+  kObjectClassUnknown = 0,
+  kObjectClassCar = 1,
+  kObjectClassBus = 2,
+  kObjectClassPerson = 3,
+};
+
+// object id is the object class in the high 8 bits and the index of the
+// object in its channel in the low 24 bits
+const uint32_t kObjectIndexBits = 24;
+const uint32_t kObjectIndexMask = (1u << kObjectIndexBits) - 1;
+
+/**
+ * @brief : build object id from object class and index.
+ * @param [in] object_class: class of the object.
+ * @param [in] index: index of the object, only the low 24 bits are kept.
+ * @return object id.
+ */
+inline uint32_t MakeObjectId(ObjectClass object_class, uint32_t index) {
+  return (static_cast<uint32_t>(object_class) << kObjectIndexBits)
+      | (index & kObjectIndexMask);
+}
+
+/**
+ * @brief : get object class from object id.
+ * @param [in] object_id: object id.
+ * @return object class.
+ */
+inline ObjectClass GetObjectClass(uint32_t object_id) {
+  return static_cast<ObjectClass>(object_id >> kObjectIndexBits);
+}
+
+/**
+ * @brief : get object index from object id.
+ * @param [in] object_id: object id.
+ * @return object index.
+ */
+inline uint32_t GetObjectIndex(uint32_t object_id) {
+  return object_id & kObjectIndexMask;
+}
+
+/**
+ * @brief : convert an engine config value to a number.
+ * @param [in] input: config value.
+ * @param [out] value: number, unchanged if input is invalid.
+ * @return false if input is not a valid number, or negative for an
+ *         unsigned type which the stream would silently wrap around.
+ */
+template <typename T>
+bool StringToNumber(const std::string& input, T& value) {
+  if (std::is_unsigned<T>::value && input.find('-') != std::string::npos) {
+    return false;
+  }
+  std::istringstream iss(input);
+  T tmp;
+  iss >> std::noskipws >> tmp;
+  if (!(iss.eof() && !iss.fail())) {
+    return false;
+  }
+  value = tmp;
+  return true;
+}
+
 struct ObjectInfoT {
-  std::string object_id;
+  uint32_t object_id;  // see MakeObjectId
   float score;
+  uint32_t label;  // detection label of the object
+  BoundingBox bbox;  // object coordinate in the original frame
 };
 
 template <class Archive>
 void serialize(Archive& ar, ObjectInfoT& data) {
-  ar(data.object_id, data.score);
+  ar(data.object_id, data.score, data.label, data.bbox);
 }
 
 struct ObjectImageParaT {
   ObjectInfoT object_info;
   hiai::ImageData<u_int8_t> img;
+  // false if the tracker of object_detection_post does not ask for a new
+  // inference, the classifiers then re-emit the cached attributes
+  bool refresh_attributes = true;
 };
 
 template <class Archive>
 void serialize(Archive& ar, ObjectImageParaT& data) {
-  ar(data.object_info, data.img);
+  ar(data.object_info, data.img, data.refresh_attributes);
 }
 
 struct VideoDetectionImageParaT {
   VideoImageParaT image;
   std::vector<ObjectImageParaT> obj_imgs;
+  // number of objects sent to car type, car color and pedestrian inference,
+  // used to judge whether all results of the frame have arrived
+  uint32_t car_type_number;
+  uint32_t car_color_number;
+  uint32_t pedestrian_number;
 };
 
 template <class Archive>
 void serialize(Archive& ar, VideoDetectionImageParaT& data) {
-  ar(data.image, data.obj_imgs);
+  ar(data.image, data.obj_imgs, data.car_type_number, data.car_color_number,
+     data.pedestrian_number);
 }
 
 struct BatchCroppedImageParaT {
@@ -116,7 +230,7 @@ enum CarInferenceType {
 };
 
 struct CarInfoT {
-  std::string object_id;
+  uint32_t object_id;
   uint32_t label;
   CarInferenceType attribute_name;  // attribute name:cartype or carcolor
   std::string inference_result;
@@ -168,17 +282,63 @@ void serialize(Archive& ar, DetectionEngineTransT& data) {
   ar(data.status, data.msg, data.output_datas, data.video_image);
 }
 
+// pedestrian attributes, the first ones follow the output order of the
+// model, the last ones are the opposites of the binary hair and gender
+// outputs. names are resolved by video_analysis_post only.
+enum PedestrianAttribute {
+  kPedAttrAge16To30 = 0,
+  kPedAttrAge31To45,
+  kPedAttrAge46To60,
+  kPedAttrAgeAbove61,
+  kPedAttrBackpack,
+  kPedAttrCarryingOther,
+  kPedAttrCasualLower,
+  kPedAttrCasualUpper,
+  kPedAttrFormalLower,
+  kPedAttrFormalUpper,
+  kPedAttrHat,
+  kPedAttrJacket,
+  kPedAttrJeans,
+  kPedAttrLeatherShoes,
+  kPedAttrLogo,
+  kPedAttrLongHair,
+  kPedAttrMale,
+  kPedAttrMessengerBag,
+  kPedAttrMuffler,
+  kPedAttrNoAccessory,
+  kPedAttrNoCarrying,
+  kPedAttrPlaid,
+  kPedAttrPlasticBags,
+  kPedAttrSandals,
+  kPedAttrShoes,
+  kPedAttrShorts,
+  kPedAttrShortSleeve,
+  kPedAttrSkirt,
+  kPedAttrSneaker,
+  kPedAttrStripes,
+  kPedAttrSunglasses,
+  kPedAttrTrousers,
+  kPedAttrTshirt,
+  kPedAttrUpperOther,
+  kPedAttrVNeck,
+  kPedAttrModelNumber,  // number of model outputs
+  kPedAttrShortHair = kPedAttrModelNumber,
+  kPedAttrFemale,
+  kPedAttrNumber
+};
+
 struct PedestrianInfoT {
-  std::string object_id;
+  uint32_t object_id;
   std::string
       attribute_name;  // property name:cartype or carcolor or pedestrian
-  std::map<string, float>
-      pedestrian_attribute_map;  // string:label_name,float:confidence
+  // confidence of each attribute indexed by PedestrianAttribute, size is
+  // kPedAttrNumber, 0 means the attribute is not reported
+  std::vector<float> attributes;
 };
 
 template <class Archive>
 void serialize(Archive& ar, PedestrianInfoT& data) {
-  ar(data.object_id, data.attribute_name, data.pedestrian_attribute_map);
+  ar(data.object_id, data.attribute_name, data.attributes);
 }
 
 struct BatchPedestrianInfoT {
@@ -40,9 +40,9 @@
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
 
 using ascend::utils::DvppCropOrResizePara;
-using ascend::utils::DvppOutput;
 using ascend::utils::DvppProcess;
 using ascend::utils::DvppVpcImageType;
+using ascend::utils::TensorArenaSlot;
 using hiai::ImageData;
 using hiai::IMAGEFORMAT;
 using namespace std;
@@ -59,6 +59,16 @@ const int kDvppProcSuccess = 0;     // call dvpp success return.
 const int kSleepMicroSecs = 20000;  // waiting time after queue is full.
 
 const string kModelPath = "model_path";
+const string kTensorSlotNumber = "tensor_slot_number";
+
+// frames whose output tensors can be in flight at the same time: one being
+// inferred here, one in the queue of object_detection_post (queueSize 1)
+// and one being post processed. a full arena means the post engine is
+// behind, so the engine waits for a slot instead of dropping the frame.
+const uint32_t kDefaultTensorSlotNumber = 3;
+
+// model name used to query the model tensor dims.
+const string kModelName = "object_detection";
 }  // namespace
 
 HIAI_REGISTER_DATA_TYPE("VideoImageInfoT", VideoImageInfoT);
@@ -77,13 +87,23 @@ HIAI_StatusT ObjectDetectionInferenceEngine::Init(
 
   vector<hiai::AIModelDescription> od_model_descs;
   hiai::AIModelDescription model_description;
+  model_description.set_name(kModelName);
 
-  // load model path.
+  // load model path and arena size.
+  uint32_t tensor_slot_number = kDefaultTensorSlotNumber;
   for (int index = 0; index < config.items_size(); ++index) {
     const ::hiai::AIConfigItem& item = config.items(index);
     if (item.name() == kModelPath) {
       const char* model_path = item.value().data();
       model_description.set_path(model_path);
+    } else if (item.name() == kTensorSlotNumber) {
+      if (!StringToNumber(item.value(), tensor_slot_number)
+          || tensor_slot_number == 0) {
+        HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                        "[ODInferenceEngine] %s value %s is invalid!",
+                        item.name().c_str(), item.value().c_str());
+        return HIAI_ERROR;
+      }
     }
   }
   od_model_descs.push_back(model_description);
@@ -96,12 +116,21 @@ HIAI_StatusT ObjectDetectionInferenceEngine::Init(
     return HIAI_ERROR;
   }
 
+  // input and output tensors are reused by every frame, all slots are
+  // allocated here and the arena does not grow at run time.
+  if (!tensor_arena_.Init(ai_model_manager_, kModelName, tensor_slot_number,
+                          tensor_slot_number)) {
+    HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                    "[ODInferenceEngine] failed to initialize tensor arena!");
+    return HIAI_ERROR;
+  }
+
   HIAI_ENGINE_LOG(HIAI_DEBUG_INFO, "[ODInferenceEngine] engine initialized!");
   return HIAI_OK;
 }
 
 HIAI_StatusT ObjectDetectionInferenceEngine::ImagePreProcess(
-    const ImageData<u_int8_t>& src_img, ImageData<u_int8_t>& resized_img) {
+    const ImageData<u_int8_t>& src_img, TensorArenaSlot& slot) {
   if (src_img.format != IMAGEFORMAT::YUV420SP) {
     // input image must be yuv420sp nv12.
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
@@ -127,9 +156,19 @@ HIAI_StatusT ObjectDetectionInferenceEngine::ImagePreProcess(
 
   DvppProcess dvpp_process(dvpp_resize_param);
 
-  DvppOutput dvpp_out;
-  int ret = dvpp_process.DvppOperationProc(
-      reinterpret_cast<char*>(src_img.data.get()), src_img.size, &dvpp_out);
+  // the resized image must fit in the model input buffer.
+  int output_size = dvpp_process.GetCropOrResizeOutputSize();
+  if (output_size <= 0 || output_size > static_cast<int>(slot.input_size)) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "[ODInferenceEngine] resize output size %d does not fit "
+                    "input buffer size %u!", output_size, slot.input_size);
+    return HIAI_ERROR;
+  }
+
+  // resize into the model input buffer directly.
+  int ret = dvpp_process.DvppCropOrResizeProc(
+      reinterpret_cast<const char*>(src_img.data.get()), src_img.size,
+      output_size, slot.input_buffer.get());
 
   if (ret != kDvppProcSuccess) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
@@ -138,65 +177,31 @@ HIAI_StatusT ObjectDetectionInferenceEngine::ImagePreProcess(
     return HIAI_ERROR;
   }
 
-  // dvpp_out->pbuf
-  resized_img.data.reset(dvpp_out.buffer, default_delete<uint8_t[]>());
-  resized_img.size = dvpp_out.size;
-
   return HIAI_OK;
 }
 
 HIAI_StatusT ObjectDetectionInferenceEngine::PerformInference(
     shared_ptr<DetectionEngineTransT>& detection_trans,
-    ImageData<u_int8_t>& input_img) {
-  // init neural buffer.
-  shared_ptr<hiai::AINeuralNetworkBuffer> neural_buffer =
-      shared_ptr<hiai::AINeuralNetworkBuffer>(
-          new hiai::AINeuralNetworkBuffer(),
-          default_delete<hiai::AINeuralNetworkBuffer>());
-
-  neural_buffer->SetBuffer((void*)input_img.data.get(), input_img.size);
-
-  shared_ptr<hiai::IAITensor> input_tensor =
-      static_pointer_cast<hiai::IAITensor>(neural_buffer);
-
-  vector<shared_ptr<hiai::IAITensor>> input_tensors;
-  vector<shared_ptr<hiai::IAITensor>> output_tensors;
-  input_tensors.push_back(input_tensor);
-
+    TensorArenaSlot& slot) {
   HIAI_StatusT ret = hiai::SUCCESS;
-  ret = ai_model_manager_->CreateOutputTensor(input_tensors, output_tensors);
-  if (ret != hiai::SUCCESS) {
-    SendDetectionResult(detection_trans, false,
-                        "[ODInferenceEngine] output tensor created failed!");
-    return HIAI_ERROR;
-  }
   hiai::AIContext ai_context;
 
   // neural network inference.
-  ret =
-      ai_model_manager_->Process(ai_context, input_tensors, output_tensors, 0);
+  ret = ai_model_manager_->Process(ai_context, slot.input_tensors,
+                                   slot.output_tensors, 0);
   if (ret != hiai::SUCCESS) {
     SendDetectionResult(detection_trans, false,
                         "[ODInferenceEngine] image inference failed!");
     return HIAI_ERROR;
   }
 
-  // set trans_data
+  // set trans_data, the slot is not reused until the next engine releases
+  // the output buffers.
   detection_trans->status = true;
-  for (uint32_t index = 0; index < output_tensors.size(); ++index) {
-    shared_ptr<hiai::AINeuralNetworkBuffer> result_tensor =
-        static_pointer_cast<hiai::AINeuralNetworkBuffer>(output_tensors[index]);
+  for (uint32_t index = 0; index < slot.output_buffers.size(); ++index) {
     OutputT out;
-    out.size = result_tensor->GetSize();
-    out.data = std::shared_ptr<uint8_t>(new uint8_t[out.size],
-                                        std::default_delete<uint8_t[]>());
-    errno_t ret = memcpy_s(out.data.get(), out.size, result_tensor->GetBuffer(),
-                           out.size);
-    if (ret != EOK) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "[ODInferenceEngine] output tensor copy failure!");
-      continue;
-    }
+    out.size = slot.output_sizes[index];
+    out.data = slot.output_buffers[index];
     detection_trans->output_datas.push_back(out);
   }
   if (detection_trans->output_datas.empty()) {
@@ -262,10 +267,20 @@ HIAI_IMPL_ENGINE_PROCESS("object_detection", ObjectDetectionInferenceEngine,
     return SendDetectionResult(detection_trans);
   }
 
+  // every slot is held downstream, wait until the post engine releases one
+  TensorArenaSlot* slot = tensor_arena_.NextSlot();
+  if (slot == nullptr) {
+    HIAI_ENGINE_LOG(HIAI_DEBUG_INFO,
+                    "[ODInferenceEngine] wait for a tensor arena slot");
+  }
+  while (slot == nullptr) {
+    usleep(kSleepMicroSecs);
+    slot = tensor_arena_.NextSlot();
+  }
+
   // resize input image.
-  ImageData<u_int8_t> resized_img;
   HIAI_StatusT dvpp_ret =
-      ImagePreProcess(detection_trans->video_image.img, resized_img);
+      ImagePreProcess(detection_trans->video_image.img, *slot);
 
   if (dvpp_ret != HIAI_OK) {
     // if preprocess error,send input image to the next engine.
@@ -275,5 +290,5 @@ HIAI_IMPL_ENGINE_PROCESS("object_detection", ObjectDetectionInferenceEngine,
   }
 
   // inference
-  return PerformInference(detection_trans, resized_img);
+  return PerformInference(detection_trans, *slot);
 }
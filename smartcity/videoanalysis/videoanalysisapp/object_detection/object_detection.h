@@ -41,6 +41,7 @@
 #include "hiaiengine/data_type.h"
 #include "hiaiengine/data_type_reg.h"
 #include "hiaiengine/engine.h"
+#include "ascenddk/ascend_tensor_arena/tensor_arena.h"
 #include "video_analysis_params.h"
 
 #define INPUT_SIZE 2
@@ -67,21 +68,21 @@ class ObjectDetectionInferenceEngine : public hiai::Engine {
   /**
    * @brief : image preprocess function.
    * @param [in] src_img: input image data.
-   * @param [out] resized_img: resized image data.
+   * @param [out] slot: resized image is written to the slot input buffer.
    * @return HIAI_StatusT
    */
   HIAI_StatusT ImagePreProcess(const hiai::ImageData<u_int8_t>& src_img,
-                               hiai::ImageData<u_int8_t>& resized_img);
+                               ascend::utils::TensorArenaSlot& slot);
 
   /**
    * @brief : object detection function.
-   * @param [in] input_img: input image data.
    * @param [out] detection_trans: inference results tensor.
+   * @param [in] slot: input and output tensors of the inference.
    * @return HIAI_StatusT
    */
   HIAI_StatusT PerformInference(
       std::shared_ptr<DetectionEngineTransT>& detection_trans,
-      hiai::ImageData<u_int8_t>& input_img);
+      ascend::utils::TensorArenaSlot& slot);
 
   /**
    * @brief : send inference results to next engine.
@@ -96,6 +97,10 @@ class ObjectDetectionInferenceEngine : public hiai::Engine {
 
   // shared ptr to load ai model.
   std::shared_ptr<hiai::AIModelManager> ai_model_manager_;
+
+  // model input and output tensors allocated at init, output buffers are
+  // passed to the next engine without copy.
+  ascend::utils::TensorArena tensor_arena_;
 };
 
 #endif /* OBJECT_DETECTION_OBJECT_DETECTION_H_ */
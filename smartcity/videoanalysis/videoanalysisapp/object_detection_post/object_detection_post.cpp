@@ -32,8 +32,12 @@
  */
 #include "object_detection_post.h"
 #include <unistd.h>
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include "ascenddk/ascend_ezdvpp/dvpp_data_type.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
 using namespace std;
@@ -53,6 +57,42 @@ const uint32_t kSizePerResultset = 7;
 const float kMinConfidence = 0.0f;
 const float kMaxConfidence = 1.0f;
 
+// box filter config item names
+const string kNmsIouThreshold = "nms_iou_threshold";
+const string kMaxObjectsPerClass = "max_objects_per_class";
+
+// tracker config item names
+const string kTrackIouThreshold = "track_iou_threshold";
+const string kTrackMaxAge = "track_max_age";
+const string kAttributeRefreshInterval = "attribute_refresh_interval";
+
+// zone config item names, zone and counting line items are followed by the
+// channel id, such as zone_channel1
+const string kZoneCountOnly = "zone_count_only";
+const string kZonePrefix = "zone_";
+const string kCountLinePrefix = "count_line_";
+const string kTrue = "true";
+
+// crop config item names
+const string kCropThreadNumber = "crop_thread_number";
+const string kCarResizeWidth = "car_resize_width";
+const string kCarResizeHeight = "car_resize_height";
+
+// overload controller config item names
+const string kOverloadHighMs = "overload_high_ms";
+const string kOverloadLowMs = "overload_low_ms";
+const string kOverloadHoldFrames = "overload_hold_frames";
+const string kOverloadMaxLevel = "overload_max_level";
+const string kOverloadConfidenceStep = "overload_confidence_step";
+const string kOverloadObjectsPerClass = "overload_objects_per_class";
+
+// default overload controller params, high watermark 0 means disabled
+const uint32_t kDefaultOverloadHoldFrames = 25;
+const uint32_t kDefaultOverloadMaxLevel = 4;
+
+// overload metrics are logged every so many frames, 10s of a 25fps video
+const uint32_t kOverloadReportFrames = 250;
+
 // dvpp minimal crop size
 const uint32_t kMinCropPixel = 16;
 
@@ -75,10 +115,6 @@ const int kInferenceVectorSize = 2;
 const int kInferenceOutputNum = 1;
 const int kInferenceOutputBBox = 0;
 
-const string kPrefixCar = "car_";
-const string kPrefixBus = "bus_";
-const string kPrefixPerson = "person_";
-
 // function of dvpp returns success
 const int kDvppOperationOk = 0;
 
@@ -114,6 +150,15 @@ HIAI_StatusT ObjectDetectionPostProcess::Init(
     const vector<hiai::AIModelDescription>& model_desc) {
   HIAI_ENGINE_LOG(HIAI_DEBUG_INFO, "[ODPostProcess] start to initialize!");
 
+  uint32_t overload_high_ms = 0;
+  uint32_t overload_low_ms = 0;
+  uint32_t overload_hold_frames = kDefaultOverloadHoldFrames;
+  uint32_t overload_max_level = kDefaultOverloadMaxLevel;
+  map<string, uint32_t*> overload_params = {
+      { kOverloadHighMs, &overload_high_ms },
+      { kOverloadLowMs, &overload_low_ms },
+      { kOverloadHoldFrames, &overload_hold_frames },
+      { kOverloadMaxLevel, &overload_max_level } };
   for (int index = 0; index < config.items_size(); ++index) {
     const ::hiai::AIConfigItem& item = config.items(index);
     const string& name = item.name();
@@ -125,11 +170,117 @@ HIAI_StatusT ObjectDetectionPostProcess::Init(
                         value.c_str());
         return HIAI_ERROR;
       }
+    } else if (overload_params.count(name) > 0) {
+      if (!StringToNumber(value, *overload_params[name])) {
+        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                        "[ODPostProcess] %s value %s is invalid!",
+                        name.c_str(), value.c_str());
+        return HIAI_ERROR;
+      }
+    } else if (!InitPostParam(name, value)) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "[ODPostProcess] %s value %s is invalid!", name.c_str(),
+                      value.c_str());
+      return HIAI_ERROR;
     }
   }
+
+  // positions of lost tracks are kept as long as the tracker keeps them
+  for (auto& zone_filter : zone_filters_) {
+    zone_filter.second.SetMaxAge(track_max_age_);
+  }
+
+  overload_.SetParams(overload_high_ms, overload_low_ms, overload_hold_frames,
+                      overload_max_level);
+
+  // more threads than cores only add context switches, 0 means unknown
+  uint32_t core_number = thread::hardware_concurrency();
+  if (core_number > 0 && crop_thread_number_ > core_number) {
+    HIAI_ENGINE_LOG(HIAI_DEBUG_INFO,
+                    "[ODPostProcess] crop_thread_number %u is limited to %u"
+                    " cores", crop_thread_number_, core_number);
+    crop_thread_number_ = core_number;
+  }
+
+  // the engine thread crops as well, so one thread less is started
+  if (crop_thread_number_ > 1) {
+    crop_pool_.reset(new TaskPool(crop_thread_number_ - 1));
+  }
   return HIAI_OK;
 }
 
+bool ObjectDetectionPostProcess::InitPostParam(const string& name,
+                                               const string& value) {
+  if (name == kNmsIouThreshold) {
+    float nms_threshold = 0.0f;
+    if (!StringToNumber(value, nms_threshold) || nms_threshold <= 0.0f
+        || nms_threshold > 1.0f) {
+      return false;
+    }
+    nms_iou_threshold_ = nms_threshold;
+  } else if (name == kMaxObjectsPerClass) {
+    return StringToNumber(value, max_objects_per_class_);
+  } else if (name == kTrackIouThreshold) {
+    float iou_threshold = 0.0f;
+    if (!StringToNumber(value, iou_threshold) || iou_threshold <= 0.0f
+        || iou_threshold > 1.0f) {
+      return false;
+    }
+    track_iou_threshold_ = iou_threshold;
+  } else if (name == kTrackMaxAge) {
+    return StringToNumber(value, track_max_age_);
+  } else if (name == kAttributeRefreshInterval) {
+    return StringToNumber(value, attribute_refresh_interval_);
+  } else if (name == kOverloadConfidenceStep) {
+    float step = 0.0f;
+    if (!StringToNumber(value, step) || step < 0.0f || step > 1.0f) {
+      return false;
+    }
+    overload_confidence_step_ = step;
+  } else if (name == kOverloadObjectsPerClass) {
+    return StringToNumber(value, overload_objects_per_class_);
+  } else if (name == kCropThreadNumber) {
+    // parsed as signed, an unsigned stream wraps "-1" around silently
+    int32_t thread_number = 0;
+    if (!StringToNumber(value, thread_number) || thread_number <= 0) {
+      return false;
+    }
+    crop_thread_number_ = static_cast<uint32_t>(thread_number);
+  } else if (name == kCarResizeWidth) {
+    return StringToNumber(value, car_resize_width_);
+  } else if (name == kCarResizeHeight) {
+    return StringToNumber(value, car_resize_height_);
+  } else if (name == kZoneCountOnly) {
+    zone_count_only_ = (value == kTrue);
+  } else if (name.compare(0, kZonePrefix.size(), kZonePrefix) == 0) {
+    return zone_filters_[name.substr(kZonePrefix.size())].SetZones(value);
+  } else if (name.compare(0, kCountLinePrefix.size(), kCountLinePrefix) == 0) {
+    return zone_filters_[name.substr(kCountLinePrefix.size())].SetLines(
+        value);
+  }
+  return true;
+}
+
+ObjectTracker& ObjectDetectionPostProcess::GetTracker(
+    const string& channel_id) {
+  unordered_map<string, ObjectTracker>::iterator iter = trackers_.find(
+      channel_id);
+  if (iter == trackers_.end()) {
+    iter = trackers_.emplace(
+        channel_id,
+        ObjectTracker(track_iou_threshold_, track_max_age_,
+                      attribute_refresh_interval_)).first;
+  }
+  return iter->second;
+}
+
+ZoneFilter* ObjectDetectionPostProcess::GetZoneFilter(
+    const string& channel_id) {
+  unordered_map<string, ZoneFilter>::iterator iter = zone_filters_.find(
+      channel_id);
+  return iter == zone_filters_.end() ? nullptr : &iter->second;
+}
+
 HIAI_StatusT ObjectDetectionPostProcess::CropObjectFromImage(
     const ImageData<u_int8_t>& src_img, ImageData<u_int8_t>& target_img,
     const BoundingBox& bbox) {
@@ -180,6 +331,45 @@ HIAI_StatusT ObjectDetectionPostProcess::CropObjectFromImage(
   return HIAI_OK;
 }
 
+HIAI_StatusT ObjectDetectionPostProcess::ResizeObjectFromImage(
+    const ImageData<u_int8_t>& src_img, ImageData<u_int8_t>& target_img,
+    const BoundingBox& bbox, uint32_t width, uint32_t height) {
+  DvppCropOrResizePara dvpp_resize_param;
+  dvpp_resize_param.src_resolution.height = src_img.height;
+  dvpp_resize_param.src_resolution.width = src_img.width;
+
+  // same odd and even limits as crop
+  dvpp_resize_param.horz_min = bbox.lt_x % 2 == 0 ? bbox.lt_x : bbox.lt_x + 1;
+  dvpp_resize_param.horz_max = bbox.rb_x % 2 == 0 ? bbox.rb_x - 1 : bbox.rb_x;
+  dvpp_resize_param.vert_min = bbox.lt_y % 2 == 0 ? bbox.lt_y : bbox.lt_y + 1;
+  dvpp_resize_param.vert_max = bbox.rb_y % 2 == 0 ? bbox.rb_y - 1 : bbox.rb_y;
+  dvpp_resize_param.dest_resolution.width = width;
+  dvpp_resize_param.dest_resolution.height = height;
+
+  // output is aligned like the resize output of the classifiers
+  dvpp_resize_param.is_input_align = true;
+  dvpp_resize_param.is_output_align = true;
+
+  DvppProcess dvpp_process(dvpp_resize_param);
+
+  DvppOutput dvpp_out;
+  int ret = dvpp_process.DvppOperationProc(
+      reinterpret_cast<char*>(src_img.data.get()), src_img.size, &dvpp_out);
+  if (ret != kDvppProcSuccess) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "[ODPostProcess] resize image failed with code %d !", ret);
+    return HIAI_ERROR;
+  }
+  target_img.channel = src_img.channel;
+  target_img.format = src_img.format;
+  target_img.data.reset(dvpp_out.buffer, default_delete<uint8_t[]>());
+  target_img.width = width;
+  target_img.height = height;
+  target_img.size = dvpp_out.size;
+
+  return HIAI_OK;
+}
+
 void ObjectDetectionPostProcess::FilterBoundingBox(
     float* bbox_buffer, int32_t bbox_buffer_size,
     shared_ptr<VideoDetectionImageParaT>& detection_image,
@@ -187,19 +377,26 @@ void ObjectDetectionPostProcess::FilterBoundingBox(
     vector<ObjectImageParaT>& car_color_imgs,
     vector<ObjectImageParaT>& person_imgs) {
   float* ptr = bbox_buffer;
-  int32_t num_car = 0;
-  int32_t num_bus = 0;
-  int32_t num_person = 0;
 
   uint32_t base_width = detection_image->image.img.width;
   uint32_t base_height = detection_image->image.img.height;
+  const string& channel_id = detection_image->image.video_image_info
+      .channel_id;
+  ZoneFilter* zone_filter = GetZoneFilter(channel_id);
+
+  // thresholds of current overload level
+  float confidence = overload_.Confidence(confidence_,
+                                          overload_confidence_step_);
+  uint32_t max_objects_per_class = overload_.ObjectsPerClass(
+      max_objects_per_class_, overload_objects_per_class_);
 
+  vector<FilteredObject> objects;
   for (int32_t k = 0; k < bbox_buffer_size; k += kSizePerResultset) {
     ptr = bbox_buffer + k;
     int32_t attr = static_cast<int32_t>(ptr[BBoxDataIndex::kAttribute]);
     float score = ptr[BBoxDataIndex::kScore];
 
-    if (score < confidence_ ||
+    if (score < confidence ||
         (attr != kLabelCar && attr != kLabelBus && attr != kLabelPerson)) {
       continue;
     }
@@ -217,36 +414,123 @@ void ObjectDetectionPostProcess::FilterBoundingBox(
     if (rb_x - lt_x < kMinCropPixel || rb_y - lt_x < kMinCropPixel) {
       continue;
     }
-    // crop image
-    ObjectImageParaT object_image;
     BoundingBox bbox = {lt_x, lt_y, rb_x, rb_y};
-    HIAI_StatusT crop_ret =
-        CropObjectFromImage(detection_image->image.img, object_image.img, bbox);
-    if (crop_ret != HIAI_OK) {
+
+    // objects out of the region of interest are not tracked or cropped
+    if (zone_filter != nullptr
+        && !zone_filter->Contains(bbox, base_width, base_height)) {
       continue;
     }
+    objects.push_back({attr, score, bbox});
+  }
+
+  // drop duplicated boxes before any crop or classifier work is spent on them
+  SuppressOverlappedObjects(objects, nms_iou_threshold_,
+                            max_objects_per_class);
+
+  vector<TrackDetection> detections;
+  for (const FilteredObject& object : objects) {
+    detections.push_back({static_cast<uint32_t>(object.attr), object.bbox});
+  }
+
+  // associate objects with tracks, so object id keeps the same across frames
+  // and attributes are only inferred for new tracks or on refresh interval.
+  // attributes of the other tracks are re-emitted from the classifier caches.
+  vector<TrackResult> track_results;
+  GetTracker(channel_id).Update(detections, track_results);
+
+  if (zone_filter != nullptr && zone_filter->HasLines()) {
+    vector<uint32_t> track_ids;
+    vector<BoundingBox> bboxes;
+    for (size_t i = 0; i < objects.size(); ++i) {
+      track_ids.push_back(track_results[i].track_id);
+      bboxes.push_back(objects[i].bbox);
+    }
+    if (zone_filter->CountCrossings(track_ids, bboxes) > 0) {
+      const vector<uint32_t>& counts = zone_filter->line_counts();
+      for (size_t line = 0; line < counts.size(); ++line) {
+        HIAI_ENGINE_LOG("[ODPostProcess] channel %s line %zu count %u",
+                        channel_id.c_str(), line, counts[line]);
+      }
+    }
+  }
 
-    object_image.object_info.score = score;
+  // counts are all what is wanted, skip crop and attribute inference
+  if (zone_count_only_) {
+    return;
+  }
+
+  // crop objects in parallel, every task writes its own slot only, so the
+  // results are collected in detection order. vehicles waiting for
+  // attribute inference are also resized to the model resolution, so car
+  // type and car color share one resized image instead of resizing the
+  // crop twice.
+  bool car_resize = car_resize_width_ > 0 && car_resize_height_ > 0;
+  vector<ObjectImageParaT> object_images(objects.size());
+  vector<ImageData<u_int8_t>> car_images(objects.size());
+  vector<HIAI_StatusT> crop_rets(objects.size(), HIAI_ERROR);
+  vector<HIAI_StatusT> resize_rets(objects.size(), HIAI_ERROR);
+  function<void(size_t)> crop_task = [&](size_t index) {
+    crop_rets[index] = CropObjectFromImage(detection_image->image.img,
+                                           object_images[index].img,
+                                           objects[index].bbox);
+    int32_t attr = objects[index].attr;
+    if (car_resize && track_results[index].need_inference
+        && (attr == kLabelCar || attr == kLabelBus)) {
+      resize_rets[index] = ResizeObjectFromImage(detection_image->image.img,
+                                                 car_images[index],
+                                                 objects[index].bbox,
+                                                 car_resize_width_,
+                                                 car_resize_height_);
+    }
+  };
+  if (crop_pool_ != nullptr) {
+    crop_pool_->Run(objects.size(), crop_task);
+  } else {
+    for (size_t i = 0; i < objects.size(); ++i) {
+      crop_task(i);
+    }
+  }
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (crop_rets[i] != HIAI_OK) {
+      continue;
+    }
+    ObjectImageParaT& object_image = object_images[i];
+    ObjectImageParaT car_image;
+
+    int32_t attr = objects[i].attr;
+    bool need_inference = track_results[i].need_inference;
+    object_image.object_info.score = objects[i].score;
+    object_image.object_info.label = attr;
+    object_image.object_info.bbox = objects[i].bbox;
+    uint32_t track_id = track_results[i].track_id;
+
+    // every tracked object goes to the classifiers on every frame, so each
+    // frame carries attributes of all its objects. For objects which are not
+    // due a refresh the classifiers re-emit the cached result of the track;
+    // the crop is still attached in case the cache has lost the entry.
+    object_image.refresh_attributes = need_inference;
+    car_image.refresh_attributes = need_inference;
+    car_image.object_info = object_image.object_info;
+    car_image.img = need_inference && resize_rets[i] == HIAI_OK
+        ? car_images[i] : object_image.img;
     if (attr == kLabelCar) {
-      ++num_car;
-      stringstream ss;
-      ss << kPrefixCar << num_car;
-      object_image.object_info.object_id = ss.str();
-      car_type_imgs.push_back(object_image);
-      car_color_imgs.push_back(object_image);
+      object_image.object_info.object_id = MakeObjectId(kObjectClassCar,
+                                                        track_id);
+      car_image.object_info.object_id = object_image.object_info.object_id;
+      car_type_imgs.push_back(car_image);
+      car_color_imgs.push_back(car_image);
 
     } else if (attr == kLabelBus) {
-      ++num_bus;
-      stringstream ss;
-      ss << kPrefixBus << num_bus;
-      object_image.object_info.object_id = ss.str();
-      car_color_imgs.push_back(object_image);
+      object_image.object_info.object_id = MakeObjectId(kObjectClassBus,
+                                                        track_id);
+      car_image.object_info.object_id = object_image.object_info.object_id;
+      car_color_imgs.push_back(car_image);
 
     } else if (attr == kLabelPerson) {
-      ++num_person;
-      stringstream ss;
-      ss << kPrefixPerson << num_person;
-      object_image.object_info.object_id = ss.str();
+      object_image.object_info.object_id = MakeObjectId(kObjectClassPerson,
+                                                        track_id);
       person_imgs.push_back(object_image);
     }
     detection_image->obj_imgs.push_back(object_image);
@@ -262,6 +546,13 @@ HIAI_StatusT ObjectDetectionPostProcess::HandleResults(
   // send finished datas to all output port.
   if (inference_result->video_image.video_image_info.is_finished) {
     HIAI_ENGINE_LOG(HIAI_DEBUG_INFO, "[ODPostProcess] input video finished");
+    const string& channel_id =
+        inference_result->video_image.video_image_info.channel_id;
+    trackers_.erase(channel_id);
+    ZoneFilter* zone_filter = GetZoneFilter(channel_id);
+    if (zone_filter != nullptr) {
+      zone_filter->Reset();
+    }
     SendResults(kPortPost, "VideoDetectionImageParaT",
                 static_pointer_cast<void>(detection_image));
 
@@ -308,6 +599,11 @@ HIAI_StatusT ObjectDetectionPostProcess::HandleResults(
   FilterBoundingBox(bbox_buffer, bbox_buffer_size, detection_image,
                     car_type_imgs, car_color_imgs, person_imgs);
 
+  // video_analysis_post waits for this number of results of the frame
+  detection_image->car_type_number = car_type_imgs.size();
+  detection_image->car_color_number = car_color_imgs.size();
+  detection_image->pedestrian_number = person_imgs.size();
+
   // send_data
   HIAI_StatusT send_ret = SendDetectImage(detection_image);
   if (send_ret != HIAI_OK) {
@@ -329,9 +625,8 @@ HIAI_StatusT ObjectDetectionPostProcess::HandleResults(
 void ObjectDetectionPostProcess::SendCroppedImages(
     uint32_t port_id, const vector<ObjectImageParaT>& cropped_images,
     VideoImageInfoT& video_image_info) {
-  if (cropped_images.empty()) {
-    return;
-  }
+  // an empty batch is sent as well, classifier engines use it as a clock to
+  // release objects which are waiting for a full batch.
   shared_ptr<BatchCroppedImageParaT> object_image =
       make_shared<BatchCroppedImageParaT>();
   object_image->video_image_info = video_image_info;
@@ -438,6 +733,31 @@ HIAI_StatusT ObjectDetectionPostProcess::SendDetectImage(
                      static_pointer_cast<void>(image_para));
 }
 
+void ObjectDetectionPostProcess::UpdateOverload(
+    const chrono::steady_clock::time_point& start) {
+  chrono::duration<float, milli> frame_time = chrono::steady_clock::now()
+      - start;
+  if (overload_.Update(frame_time.count())) {
+    HIAI_ENGINE_LOG(
+        "[ODPostProcess] overload level %u, frame time %.1f ms, "
+        "confidence %.2f, objects per class %u",
+        overload_.level(), overload_.average_ms(),
+        overload_.Confidence(confidence_, overload_confidence_step_),
+        overload_.ObjectsPerClass(max_objects_per_class_,
+                                  overload_objects_per_class_));
+  }
+
+  // level changes alone do not show how long the engine stays overloaded
+  OverloadMetrics metrics = overload_.Metrics();
+  if (metrics.frames % kOverloadReportFrames == 0) {
+    HIAI_ENGINE_LOG(
+        "[ODPostProcess] overload metrics: frames %u, overloaded frames %u, "
+        "level changes %u, level %u, frame time %.1f ms, peak %.1f ms",
+        metrics.frames, metrics.overloaded_frames, metrics.level_changes,
+        metrics.level, metrics.average_ms, metrics.peak_ms);
+  }
+}
+
 float ObjectDetectionPostProcess::CorrectCoordinate(float value) {
   float tmp = value < kLowerCoord ? kLowerCoord : value;
   return tmp > kUpperCoord ? kUpperCoord : tmp;
@@ -454,5 +774,9 @@ HIAI_IMPL_ENGINE_PROCESS("object_detection_post", ObjectDetectionPostProcess,
   shared_ptr<DetectionEngineTransT> detection_trans =
       static_pointer_cast<DetectionEngineTransT>(arg0);
 
-  return HandleResults(detection_trans);
+  // frame time includes the time blocked on full downstream queues
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  HIAI_StatusT ret = HandleResults(detection_trans);
+  UpdateOverload(start);
+  return ret;
 }
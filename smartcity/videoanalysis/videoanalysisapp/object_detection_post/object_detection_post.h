@@ -34,30 +34,44 @@
 #ifndef OBJECT_DETECTION_POST_OBJECT_DETECTION_POST_H_
 #define OBJECT_DETECTION_POST_OBJECT_DETECTION_POST_H_
 
+#include <chrono>
+#include <memory>
 #include <unordered_map>
 #include "hiaiengine/api.h"
 #include "hiaiengine/data_type.h"
 #include "hiaiengine/data_type_reg.h"
 #include "hiaiengine/engine.h"
 #include "hiaiengine/multitype_queue.h"
+#include "object_nms.h"
+#include "object_tracker.h"
+#include "overload_controller.h"
+#include "task_pool.h"
+#include "zone_filter.h"
 #include "video_analysis_params.h"
 
 #define INPUT_SIZE 1
 #define OUTPUT_SIZE 4
 
-struct BoundingBox {
-  uint32_t lt_x;
-  uint32_t lt_y;
-  uint32_t rb_x;
-  uint32_t rb_y;
-};
-
 class ObjectDetectionPostProcess : public hiai::Engine {
  public:
   /**
-   * @brief : constructor,init confidence_ with default value 0.9f.
+   * @brief : constructor,init confidence_ with default value 0.9f,
+   *          init box filter and tracker params with default value.
    */
-  ObjectDetectionPostProcess() : confidence_(0.9f) {}
+  ObjectDetectionPostProcess()
+      : confidence_(0.9f),
+        nms_iou_threshold_(0.45f),
+        max_objects_per_class_(20),
+        track_iou_threshold_(0.3f),
+        track_max_age_(5),
+        attribute_refresh_interval_(25),
+        zone_count_only_(false),
+        crop_thread_number_(4),
+        overload_confidence_step_(0.05f),
+        overload_objects_per_class_(8),
+        car_resize_width_(224),
+        car_resize_height_(224) {
+  }
   /**
    * @brief HIAI_DEFINE_PROCESS : default destructor.
    */
@@ -95,6 +109,20 @@ class ObjectDetectionPostProcess : public hiai::Engine {
   HIAI_StatusT CropObjectFromImage(const hiai::ImageData<u_int8_t>& src_img,
                                    hiai::ImageData<u_int8_t>& target_img,
                                    const BoundingBox& bbox);
+  /**
+   * @brief : crop object image from input image and resize it to the input
+   *          resolution of a classifier model in one dvpp call.
+   * @param [in] src_img: input image.
+   * @param [out] target_img: output object image.
+   * @param [in] bbox: bounding box coordinate.
+   * @param [in] width: width of output image.
+   * @param [in] height: height of output image.
+   * @return HIAI_StatusT
+   */
+  HIAI_StatusT ResizeObjectFromImage(const hiai::ImageData<u_int8_t>& src_img,
+                                     hiai::ImageData<u_int8_t>& target_img,
+                                     const BoundingBox& bbox, uint32_t width,
+                                     uint32_t height);
   /**
    * @brief : filter bounding box from inferece results.
    * @param [in] bbox_buffer: bbox results buffer.
@@ -145,6 +173,34 @@ class ObjectDetectionPostProcess : public hiai::Engine {
    */
   bool InitConfidence(const string& input);
 
+  /**
+   * @brief : init box filter and tracker params from engine config.
+   * @param [in] name: config item name.
+   * @param [in] value: config item value.
+   * @return true if item is valid or not such an item, otherwise false.
+   */
+  bool InitPostParam(const string& name, const string& value);
+
+  /**
+   * @brief : get the tracker of a video channel, create it if not exist.
+   * @param [in] channel_id: video channel id.
+   * @return tracker of the channel.
+   */
+  ObjectTracker& GetTracker(const string& channel_id);
+
+  /**
+   * @brief : get the zone filter of a video channel.
+   * @param [in] channel_id: video channel id.
+   * @return zone filter, nullptr if the channel has no zone or line.
+   */
+  ZoneFilter* GetZoneFilter(const string& channel_id);
+
+  /**
+   * @brief : feed the processing time of a frame to the overload controller.
+   * @param [in] start: time when the frame processing started.
+   */
+  void UpdateOverload(const std::chrono::steady_clock::time_point& start);
+
   /**
    * @brief : correct the coordinate value between 0.0f and 1.0f.
    * @param [in] input: coordinate value .
@@ -153,6 +209,52 @@ class ObjectDetectionPostProcess : public hiai::Engine {
   float CorrectCoordinate(float value);
 
   float confidence_;
+
+  // boxes of the same label overlapping more than it are suppressed
+  float nms_iou_threshold_;
+
+  // max objects kept for each label in one frame, 0 means no limit
+  uint32_t max_objects_per_class_;
+
+  // minimal IoU to associate a detection with a track
+  float track_iou_threshold_;
+
+  // frames a track survives without any associated detection
+  uint32_t track_max_age_;
+
+  // frames after which attributes of a tracked object are inferred again,
+  // 0 means attributes are inferred on every frame
+  uint32_t attribute_refresh_interval_;
+
+  // one tracker per video channel, key is channel id
+  std::unordered_map<std::string, ObjectTracker> trackers_;
+
+  // only count line crossings, objects are neither cropped nor classified
+  bool zone_count_only_;
+
+  // zones and counting lines of the channels which have them, key is
+  // channel id
+  std::unordered_map<std::string, ZoneFilter> zone_filters_;
+
+  // threads cropping objects of one frame, including the engine thread
+  uint32_t crop_thread_number_;
+
+  // workers helping the engine thread to crop, nullptr if single threaded
+  std::unique_ptr<TaskPool> crop_pool_;
+
+  // raises confidence and lowers objects per class when overloaded
+  OverloadController overload_;
+
+  // confidence increase per overload level
+  float overload_confidence_step_;
+
+  // objects kept per class at overload level 1, halved on each level
+  uint32_t overload_objects_per_class_;
+
+  // input resolution of car type and car color models, car images are
+  // resized once for both classifiers. 0 leaves resize to classifiers.
+  uint32_t car_resize_width_;
+  uint32_t car_resize_height_;
 };
 
 #endif /* OBJECT_DETECTION_POST_OBJECT_DETECTION_POST_H_ */
@@ -0,0 +1,89 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "object_nms.h"
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+void SuppressOverlappedObjects(vector<FilteredObject>& objects,
+                               float nms_threshold, uint32_t max_per_class) {
+  stable_sort(objects.begin(), objects.end(),
+              [](const FilteredObject& lhs, const FilteredObject& rhs) {
+                return lhs.score > rhs.score;
+              });
+
+  // structure of arrays, so the inner IoU loop is branch free and can be
+  // vectorized by the compiler
+  size_t count = objects.size();
+  vector<float> lt_x(count), lt_y(count), rb_x(count), rb_y(count);
+  vector<float> area(count);
+  vector<int32_t> label(count);
+  vector<uint8_t> suppressed(count, 0);
+  for (size_t i = 0; i < count; ++i) {
+    lt_x[i] = objects[i].bbox.lt_x;
+    lt_y[i] = objects[i].bbox.lt_y;
+    rb_x[i] = objects[i].bbox.rb_x;
+    rb_y[i] = objects[i].bbox.rb_y;
+    area[i] = (rb_x[i] - lt_x[i]) * (rb_y[i] - lt_y[i]);
+    label[i] = objects[i].attr;
+  }
+
+  map<int32_t, uint32_t> kept_per_class;
+  vector<FilteredObject> kept_objects;
+  for (size_t i = 0; i < count; ++i) {
+    if (suppressed[i]) {
+      continue;
+    }
+    uint32_t& kept_number = kept_per_class[label[i]];
+    if (max_per_class != 0 && kept_number >= max_per_class) {
+      continue;
+    }
+    ++kept_number;
+    kept_objects.push_back(objects[i]);
+
+    for (size_t j = i + 1; j < count; ++j) {
+      float inter_width = max(0.0f, min(rb_x[i], rb_x[j])
+          - max(lt_x[i], lt_x[j]));
+      float inter_height = max(0.0f, min(rb_y[i], rb_y[j])
+          - max(lt_y[i], lt_y[j]));
+      float inter_area = inter_width * inter_height;
+
+      // inter / union > threshold, written without division
+      uint8_t overlapped = inter_area
+          > nms_threshold * (area[i] + area[j] - inter_area);
+      suppressed[j] |= overlapped & (label[j] == label[i]);
+    }
+  }
+  objects.swap(kept_objects);
+}
@@ -0,0 +1,60 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef OBJECT_DETECTION_POST_OBJECT_NMS_H_
+#define OBJECT_DETECTION_POST_OBJECT_NMS_H_
+
+#include <cstdint>
+#include <vector>
+#include "video_analysis_params.h"
+
+// detected object which passed the filter, waiting for tracking and crop
+struct FilteredObject {
+  int32_t attr;
+  float score;
+  BoundingBox bbox;
+};
+
+/**
+ * @brief : class-aware non-maximum suppression. objects are sorted by score,
+ *          an object is dropped if it overlaps a kept object of the same
+ *          label by more than nms_threshold, and at most max_per_class
+ *          objects are kept for each label.
+ * @param [in|out] objects: detected objects, kept objects on return.
+ * @param [in] nms_threshold: max IoU of two kept objects of a label.
+ * @param [in] max_per_class: max objects of a label, 0 means no limit.
+ */
+void SuppressOverlappedObjects(std::vector<FilteredObject>& objects,
+                               float nms_threshold, uint32_t max_per_class);
+
+#endif /* OBJECT_DETECTION_POST_OBJECT_NMS_H_ */
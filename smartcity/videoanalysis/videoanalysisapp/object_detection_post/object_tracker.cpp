@@ -0,0 +1,202 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "object_tracker.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+// kalman filter noise parameters, in pixels
+const float kInitPosVariance = 10.0f;
+const float kInitVelVariance = 1000.0f;
+const float kProcessPosNoise = 1.0f;
+const float kProcessVelNoise = 0.01f;
+const float kMeasurementNoise = 4.0f;
+
+// predicted width and height of a track can not be smaller than one pixel
+const float kMinBoxSide = 1.0f;
+
+const float kHalf = 0.5f;
+
+// candidate pair of a track and a detection
+struct MatchCandidate {
+  float iou;
+  size_t track_index;
+  size_t detection_index;
+};
+}  // namespace
+
+void KalmanAxis::Init(float position) {
+  pos_ = position;
+  vel_ = 0.0f;
+  p00_ = kInitPosVariance;
+  p01_ = 0.0f;
+  p11_ = kInitVelVariance;
+}
+
+void KalmanAxis::Predict() {
+  // x = F * x, P = F * P * F' + Q with F = [[1, 1], [0, 1]]
+  pos_ += vel_;
+  p00_ += 2 * p01_ + p11_ + kProcessPosNoise;
+  p01_ += p11_;
+  p11_ += kProcessVelNoise;
+}
+
+void KalmanAxis::Correct(float position) {
+  // H = [1, 0], so the innovation covariance is a scalar
+  float innovation_cov = p00_ + kMeasurementNoise;
+  float gain_pos = p00_ / innovation_cov;
+  float gain_vel = p01_ / innovation_cov;
+  float residual = position - pos_;
+
+  pos_ += gain_pos * residual;
+  vel_ += gain_vel * residual;
+  p11_ -= gain_vel * p01_;
+  p00_ *= (1 - gain_pos);
+  p01_ *= (1 - gain_pos);
+}
+
+ObjectTracker::ObjectTracker(float iou_threshold, uint32_t max_age,
+                             uint32_t refresh_interval)
+    : iou_threshold_(iou_threshold),
+      max_age_(max_age),
+      refresh_interval_(refresh_interval),
+      next_id_(1) {
+}
+
+ObjectTracker::Track ObjectTracker::CreateTrack(
+    const TrackDetection& detection) {
+  const BoundingBox& bbox = detection.bbox;
+  Track track;
+  track.id = next_id_++;
+  track.label = detection.label;
+  track.misses = 0;
+  track.frames_since_inference = 0;
+  track.center_x.Init(kHalf * (bbox.lt_x + bbox.rb_x));
+  track.center_y.Init(kHalf * (bbox.lt_y + bbox.rb_y));
+  track.width.Init(bbox.rb_x - bbox.lt_x);
+  track.height.Init(bbox.rb_y - bbox.lt_y);
+  return track;
+}
+
+BoundingBox ObjectTracker::PredictedBox(const Track& track) const {
+  float half_width = kHalf * max(track.width.Position(), kMinBoxSide);
+  float half_height = kHalf * max(track.height.Position(), kMinBoxSide);
+  float lt_x = max(track.center_x.Position() - half_width, 0.0f);
+  float lt_y = max(track.center_y.Position() - half_height, 0.0f);
+  float rb_x = max(track.center_x.Position() + half_width, 0.0f);
+  float rb_y = max(track.center_y.Position() + half_height, 0.0f);
+
+  BoundingBox bbox = { static_cast<uint32_t>(lt_x), static_cast<uint32_t>(lt_y),
+      static_cast<uint32_t>(rb_x), static_cast<uint32_t>(rb_y) };
+  return bbox;
+}
+
+void ObjectTracker::Update(const vector<TrackDetection>& detections,
+                           vector<TrackResult>& results) {
+  // predict every track to current frame
+  for (Track& track : tracks_) {
+    track.center_x.Predict();
+    track.center_y.Predict();
+    track.width.Predict();
+    track.height.Predict();
+    ++track.misses;
+    ++track.frames_since_inference;
+  }
+
+  // collect all pairs of the same label which overlap enough
+  vector<MatchCandidate> candidates;
+  for (size_t i = 0; i < tracks_.size(); ++i) {
+    BoundingBox predicted = PredictedBox(tracks_[i]);
+    for (size_t j = 0; j < detections.size(); ++j) {
+      if (detections[j].label != tracks_[i].label) {
+        continue;
+      }
+      float iou = BoundingBoxIoU(predicted, detections[j].bbox);
+      if (iou >= iou_threshold_) {
+        candidates.push_back( { iou, i, j });
+      }
+    }
+  }
+
+  // greedy association, the pair with larger IoU is matched first
+  sort(candidates.begin(), candidates.end(),
+       [](const MatchCandidate& lhs, const MatchCandidate& rhs) {
+         return lhs.iou > rhs.iou;
+       });
+
+  vector<bool> track_matched(tracks_.size(), false);
+  vector<bool> detection_matched(detections.size(), false);
+  results.assign(detections.size(), TrackResult { 0, true });
+
+  for (const MatchCandidate& candidate : candidates) {
+    if (track_matched[candidate.track_index]
+        || detection_matched[candidate.detection_index]) {
+      continue;
+    }
+    track_matched[candidate.track_index] = true;
+    detection_matched[candidate.detection_index] = true;
+
+    Track& track = tracks_[candidate.track_index];
+    const BoundingBox& bbox = detections[candidate.detection_index].bbox;
+    track.center_x.Correct(kHalf * (bbox.lt_x + bbox.rb_x));
+    track.center_y.Correct(kHalf * (bbox.lt_y + bbox.rb_y));
+    track.width.Correct(bbox.rb_x - bbox.lt_x);
+    track.height.Correct(bbox.rb_y - bbox.lt_y);
+    track.misses = 0;
+
+    TrackResult& result = results[candidate.detection_index];
+    result.track_id = track.id;
+    result.need_inference = (refresh_interval_ == 0
+        || track.frames_since_inference >= refresh_interval_);
+    if (result.need_inference) {
+      track.frames_since_inference = 0;
+    }
+  }
+
+  // drop tracks which have not been seen for too long
+  tracks_.erase(remove_if(tracks_.begin(), tracks_.end(),
+                          [this](const Track& track) {
+                            return track.misses > max_age_;
+                          }),
+                tracks_.end());
+
+  // unmatched detections start new tracks
+  for (size_t j = 0; j < detections.size(); ++j) {
+    if (detection_matched[j]) {
+      continue;
+    }
+    tracks_.push_back(CreateTrack(detections[j]));
+    results[j].track_id = tracks_.back().id;
+  }
+}
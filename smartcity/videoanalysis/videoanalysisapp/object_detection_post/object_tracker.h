@@ -0,0 +1,154 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef OBJECT_DETECTION_POST_OBJECT_TRACKER_H_
+#define OBJECT_DETECTION_POST_OBJECT_TRACKER_H_
+
+#include <cstdint>
+#include <vector>
+#include "video_analysis_params.h"
+
+// one detected object of a frame which should be associated with a track
+struct TrackDetection {
+  uint32_t label;
+  BoundingBox bbox;
+};
+
+// association result of one detection
+struct TrackResult {
+  uint32_t track_id;
+  // true if attribute inference should run for this object in current frame
+  bool need_inference;
+};
+
+/**
+ * constant velocity kalman filter for one coordinate of the bounding box,
+ * the state is [position, velocity] and only position is measured.
+ */
+class KalmanAxis {
+ public:
+  /**
+   * @brief : init state with the first measurement.
+   * @param [in] position: measured position.
+   */
+  void Init(float position);
+
+  /**
+   * @brief : propagate the state one frame ahead.
+   */
+  void Predict();
+
+  /**
+   * @brief : correct the state with a new measurement.
+   * @param [in] position: measured position.
+   */
+  void Correct(float position);
+
+  /**
+   * @brief : get current position estimation.
+   * @return position.
+   */
+  float Position() const {
+    return pos_;
+  }
+
+ private:
+  float pos_;
+  float vel_;
+  // covariance matrix [[p00, p01], [p01, p11]]
+  float p00_;
+  float p01_;
+  float p11_;
+};
+
+/**
+ * SORT style multi-object tracker: kalman prediction of every track and
+ * greedy IoU association between predicted tracks and new detections of
+ * the same label. One tracker instance serves one video channel.
+ */
+class ObjectTracker {
+ public:
+  /**
+   * @brief : constructor.
+   * @param [in] iou_threshold: minimal IoU to associate a detection to track.
+   * @param [in] max_age: frames a track survives without any detection.
+   * @param [in] refresh_interval: frames after which the attributes of a
+   *             tracked object are inferred again, 0 means every frame.
+   */
+  ObjectTracker(float iou_threshold, uint32_t max_age,
+                uint32_t refresh_interval);
+
+  /**
+   * @brief : associate detections of a new frame with existing tracks.
+   * @param [in] detections: detections of current frame.
+   * @param [out] results: track result for each detection, same order.
+   */
+  void Update(const std::vector<TrackDetection>& detections,
+              std::vector<TrackResult>& results);
+
+ private:
+  struct Track {
+    uint32_t id;
+    uint32_t label;
+    // frames since last associated detection
+    uint32_t misses;
+    // frames since last attribute inference
+    uint32_t frames_since_inference;
+    KalmanAxis center_x;
+    KalmanAxis center_y;
+    KalmanAxis width;
+    KalmanAxis height;
+  };
+
+  /**
+   * @brief : create a track from an unmatched detection.
+   * @param [in] detection: detected object.
+   * @return new track.
+   */
+  Track CreateTrack(const TrackDetection& detection);
+
+  /**
+   * @brief : get predicted bounding box of a track.
+   * @param [in] track: track.
+   * @return bounding box.
+   */
+  BoundingBox PredictedBox(const Track& track) const;
+
+  float iou_threshold_;
+  uint32_t max_age_;
+  uint32_t refresh_interval_;
+  uint32_t next_id_;
+  std::vector<Track> tracks_;
+};
+
+#endif /* OBJECT_DETECTION_POST_OBJECT_TRACKER_H_ */
@@ -0,0 +1,131 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "overload_controller.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+// weight of the newest frame in the smoothed frame time
+const float kSmoothFactor = 0.2f;
+
+// confidence threshold never goes above it, so objects are still reported
+const float kMaxConfidence = 0.99f;
+
+// at least one object of each class is kept
+const uint32_t kMinObjectsPerClass = 1;
+
+// shift of a 32 bits value must be less than 32
+const uint32_t kMaxShift = 31;
+}  // namespace
+
+OverloadController::OverloadController()
+    : high_ms_(0),
+      low_ms_(0),
+      hold_frames_(0),
+      max_level_(0),
+      level_(0),
+      average_ms_(0.0f),
+      frames_since_change_(0),
+      peak_ms_(0.0f),
+      frames_(0),
+      overloaded_frames_(0),
+      level_changes_(0) {
+}
+
+void OverloadController::SetParams(uint32_t high_ms, uint32_t low_ms,
+                                   uint32_t hold_frames, uint32_t max_level) {
+  high_ms_ = high_ms;
+  low_ms_ = min(low_ms, high_ms);
+  hold_frames_ = hold_frames;
+  max_level_ = max_level;
+  level_ = min(level_, max_level_);
+}
+
+bool OverloadController::Update(float frame_ms) {
+  average_ms_ += kSmoothFactor * (frame_ms - average_ms_);
+  peak_ms_ = max(peak_ms_, frame_ms);
+  ++frames_;
+  if (level_ > 0) {
+    ++overloaded_frames_;
+  }
+  if (!Enabled()) {
+    return false;
+  }
+  ++frames_since_change_;
+  if (frames_since_change_ < hold_frames_) {
+    return false;
+  }
+
+  // between the watermarks the level is kept, so it does not flap
+  uint32_t old_level = level_;
+  if (average_ms_ > high_ms_ && level_ < max_level_) {
+    ++level_;
+  } else if (average_ms_ < low_ms_ && level_ > 0) {
+    --level_;
+  }
+  if (level_ == old_level) {
+    return false;
+  }
+  frames_since_change_ = 0;
+  ++level_changes_;
+  return true;
+}
+
+OverloadMetrics OverloadController::Metrics() const {
+  OverloadMetrics metrics;
+  metrics.level = level_;
+  metrics.average_ms = average_ms_;
+  metrics.peak_ms = peak_ms_;
+  metrics.frames = frames_;
+  metrics.overloaded_frames = overloaded_frames_;
+  metrics.level_changes = level_changes_;
+  return metrics;
+}
+
+float OverloadController::Confidence(float base, float step) const {
+  if (level_ == 0) {
+    return base;
+  }
+  return max(base, min(base + step * level_, kMaxConfidence));
+}
+
+uint32_t OverloadController::ObjectsPerClass(uint32_t base,
+                                             uint32_t overload_cap) const {
+  if (level_ == 0 || overload_cap == 0) {
+    return base;
+  }
+  uint32_t shift = min(level_ - 1, kMaxShift);
+  uint32_t cap = max(overload_cap >> shift, kMinObjectsPerClass);
+  return base == 0 ? cap : min(base, cap);
+}
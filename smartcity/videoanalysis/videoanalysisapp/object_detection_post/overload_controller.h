@@ -0,0 +1,145 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef OBJECT_DETECTION_POST_OVERLOAD_CONTROLLER_H_
+#define OBJECT_DETECTION_POST_OVERLOAD_CONTROLLER_H_
+
+#include <cstdint>
+
+/**
+ * metrics of the overload controller since it was created.
+ */
+struct OverloadMetrics {
+  uint32_t level;  // current load level
+  float average_ms;  // smoothed frame processing time
+  float peak_ms;  // longest frame processing time
+  uint32_t frames;  // frames fed to the controller
+  uint32_t overloaded_frames;  // frames processed above level 0
+  uint32_t level_changes;  // times the level is changed
+};
+
+/**
+ * sheds load when downstream engines can not keep up. the controller is fed
+ * with the time the engine spends on each frame, which includes the time
+ * blocked on full downstream queues. the smoothed time moves a load level up
+ * above the high watermark and down below the low watermark, and a level is
+ * held for some frames before it may change again. each level raises the
+ * confidence threshold and halves the objects kept per class.
+ */
+class OverloadController {
+ public:
+  OverloadController();
+
+  /**
+   * @brief : set controller params.
+   * @param [in] high_ms: level goes up above this frame time, 0 disables
+   *             the controller.
+   * @param [in] low_ms: level goes down below this frame time.
+   * @param [in] hold_frames: minimal frames between two level changes.
+   * @param [in] max_level: highest load level.
+   */
+  void SetParams(uint32_t high_ms, uint32_t low_ms, uint32_t hold_frames,
+                 uint32_t max_level);
+
+  /**
+   * @brief : whether the controller is enabled.
+   * @return true or false.
+   */
+  bool Enabled() const {
+    return high_ms_ > 0;
+  }
+
+  /**
+   * @brief : add the processing time of a frame and update the level.
+   * @param [in] frame_ms: processing time of the frame in milliseconds.
+   * @return true if the level is changed.
+   */
+  bool Update(float frame_ms);
+
+  /**
+   * @brief : get current load level, 0 means not overloaded.
+   * @return level.
+   */
+  uint32_t level() const {
+    return level_;
+  }
+
+  /**
+   * @brief : get smoothed frame processing time.
+   * @return milliseconds.
+   */
+  float average_ms() const {
+    return average_ms_;
+  }
+
+  /**
+   * @brief : get metrics, which are kept even if the controller is disabled.
+   * @return metrics.
+   */
+  OverloadMetrics Metrics() const;
+
+  /**
+   * @brief : get confidence threshold of current level.
+   * @param [in] base: configured confidence threshold.
+   * @param [in] step: threshold increase per level.
+   * @return threshold.
+   */
+  float Confidence(float base, float step) const;
+
+  /**
+   * @brief : get objects kept per class of current level.
+   * @param [in] base: configured objects per class, 0 means no limit.
+   * @param [in] overload_cap: objects per class at level 1, it is halved
+   *             on each further level.
+   * @return objects per class, 0 means no limit.
+   */
+  uint32_t ObjectsPerClass(uint32_t base, uint32_t overload_cap) const;
+
+ private:
+  uint32_t high_ms_;
+  uint32_t low_ms_;
+  uint32_t hold_frames_;
+  uint32_t max_level_;
+
+  uint32_t level_;
+  float average_ms_;
+  // frames since last level change
+  uint32_t frames_since_change_;
+
+  float peak_ms_;
+  uint32_t frames_;
+  uint32_t overloaded_frames_;
+  uint32_t level_changes_;
+};
+
+#endif /* OBJECT_DETECTION_POST_OVERLOAD_CONTROLLER_H_ */
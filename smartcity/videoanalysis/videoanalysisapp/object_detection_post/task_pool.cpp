@@ -0,0 +1,96 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "task_pool.h"
+
+using namespace std;
+
+TaskPool::TaskPool(uint32_t worker_number)
+    : task_(nullptr),
+      task_number_(0),
+      next_task_(0),
+      finished_tasks_(0),
+      stop_(false) {
+  for (uint32_t i = 0; i < worker_number; ++i) {
+    workers_.emplace_back(&TaskPool::WorkerLoop, this);
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_all();
+  for (thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void TaskPool::Run(size_t task_number,
+                   const function<void(size_t)>& task) {
+  unique_lock<mutex> lock(mutex_);
+  task_ = &task;
+  task_number_ = task_number;
+  next_task_ = 0;
+  finished_tasks_ = 0;
+  task_cond_.notify_all();
+
+  RunTasks(lock);
+  done_cond_.wait(lock, [this] { return finished_tasks_ == task_number_; });
+  task_ = nullptr;
+}
+
+void TaskPool::RunTasks(unique_lock<mutex>& lock) {
+  while (next_task_ < task_number_) {
+    size_t index = next_task_++;
+    const function<void(size_t)>* task = task_;
+    lock.unlock();
+    (*task)(index);
+    lock.lock();
+    if (++finished_tasks_ == task_number_) {
+      done_cond_.notify_all();
+    }
+  }
+}
+
+void TaskPool::WorkerLoop() {
+  unique_lock<mutex> lock(mutex_);
+  while (true) {
+    task_cond_.wait(lock,
+                    [this] { return stop_ || next_task_ < task_number_; });
+    if (stop_) {
+      return;
+    }
+    RunTasks(lock);
+  }
+}
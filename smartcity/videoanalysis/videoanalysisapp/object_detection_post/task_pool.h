@@ -0,0 +1,101 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef OBJECT_DETECTION_POST_TASK_POOL_H_
+#define OBJECT_DETECTION_POST_TASK_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * small fixed size worker pool which runs a group of independent tasks and
+ * returns when all of them are finished. the calling thread runs tasks as
+ * well, so a pool of n workers runs up to n + 1 tasks at the same time.
+ * Run must not be called from more than one thread at the same time.
+ */
+class TaskPool {
+ public:
+  /**
+   * @brief : constructor, start the worker threads.
+   * @param [in] worker_number: number of worker threads.
+   */
+  explicit TaskPool(uint32_t worker_number);
+
+  /**
+   * @brief : destructor, stop and join the worker threads.
+   */
+  ~TaskPool();
+
+  TaskPool(const TaskPool&) = delete;
+  TaskPool& operator=(const TaskPool&) = delete;
+
+  /**
+   * @brief : run task(0) ... task(task_number - 1) and wait for all of them.
+   * @param [in] task_number: number of tasks.
+   * @param [in] task: task function, called with the task index.
+   */
+  void Run(size_t task_number, const std::function<void(size_t)>& task);
+
+ private:
+  /**
+   * @brief : claim and run tasks until none is left. lock is held when the
+   *          method is called and returns.
+   * @param [in] lock: lock of mutex_.
+   */
+  void RunTasks(std::unique_lock<std::mutex>& lock);
+
+  /**
+   * @brief : worker thread main loop.
+   */
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  // notified when new tasks are ready or the pool is stopped
+  std::condition_variable task_cond_;
+  // notified when all tasks are finished
+  std::condition_variable done_cond_;
+
+  // all members below are guarded by mutex_
+  const std::function<void(size_t)>* task_;
+  size_t task_number_;
+  size_t next_task_;
+  size_t finished_tasks_;
+  bool stop_;
+};
+
+#endif /* OBJECT_DETECTION_POST_TASK_POOL_H_ */
@@ -0,0 +1,227 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "zone_filter.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+// side of a raster cell in pixels, boxes are tested with this precision
+const uint32_t kRasterCell = 8;
+
+const uint32_t kMinPolygonPoints = 3;
+const uint32_t kLinePoints = 2;
+
+const char kShapeSeparator = '|';
+const char kPointSeparator = ';';
+const char kCoordSeparator = ',';
+
+const float kHalf = 0.5f;
+
+// parse shapes like "x,y;x,y|x,y;x,y", return false if any point is invalid
+bool ParseShapes(const string& input, vector<vector<ZonePoint>>& shapes) {
+  istringstream shape_stream(input);
+  string shape;
+  while (getline(shape_stream, shape, kShapeSeparator)) {
+    vector<ZonePoint> points;
+    istringstream point_stream(shape);
+    string point;
+    while (getline(point_stream, point, kPointSeparator)) {
+      istringstream coord_stream(point);
+      ZonePoint zone_point;
+      char separator = 0;
+      coord_stream >> zone_point.x >> separator >> zone_point.y;
+      if (coord_stream.fail() || separator != kCoordSeparator
+          || !(coord_stream >> ws).eof() || zone_point.x < 0.0f
+          || zone_point.y < 0.0f) {
+        return false;
+      }
+      points.push_back(zone_point);
+    }
+    shapes.push_back(points);
+  }
+  return true;
+}
+
+// even-odd rule point in polygon test
+bool InPolygon(const vector<ZonePoint>& polygon, float x, float y) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const ZonePoint& a = polygon[i];
+    const ZonePoint& b = polygon[j];
+    if ((a.y > y) != (b.y > y)
+        && x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+// z component of (b - a) x (c - a)
+float Cross(const ZonePoint& a, const ZonePoint& b, const ZonePoint& c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// the movement from prev to cur crosses line a-b. a point lying on the line
+// is counted on the positive side, so touching the line and moving back
+// is not counted twice.
+bool Crossed(const ZonePoint& prev, const ZonePoint& cur, const ZonePoint& a,
+             const ZonePoint& b) {
+  bool prev_side = Cross(a, b, prev) >= 0.0f;
+  bool cur_side = Cross(a, b, cur) >= 0.0f;
+  if (prev_side == cur_side) {
+    return false;
+  }
+  return Cross(prev, cur, a) * Cross(prev, cur, b) <= 0.0f;
+}
+
+// bottom center of a box, where the object touches the ground
+ZonePoint Anchor(const BoundingBox& bbox) {
+  return {(bbox.lt_x + bbox.rb_x) * kHalf, static_cast<float>(bbox.rb_y)};
+}
+}  // namespace
+
+ZoneFilter::ZoneFilter()
+    : raster_width_(0),
+      raster_height_(0),
+      raster_cols_(0),
+      max_age_(0),
+      frame_count_(0) {
+}
+
+bool ZoneFilter::SetZones(const string& zones) {
+  vector<vector<ZonePoint>> polygons;
+  if (!ParseShapes(zones, polygons)) {
+    return false;
+  }
+  for (const vector<ZonePoint>& polygon : polygons) {
+    if (polygon.size() < kMinPolygonPoints) {
+      return false;
+    }
+  }
+  zones_.swap(polygons);
+  raster_width_ = 0;
+  raster_height_ = 0;
+  return true;
+}
+
+bool ZoneFilter::SetLines(const string& lines) {
+  vector<vector<ZonePoint>> shapes;
+  if (!ParseShapes(lines, shapes)) {
+    return false;
+  }
+  vector<pair<ZonePoint, ZonePoint>> counting_lines;
+  for (const vector<ZonePoint>& shape : shapes) {
+    if (shape.size() != kLinePoints) {
+      return false;
+    }
+    counting_lines.push_back(make_pair(shape[0], shape[1]));
+  }
+  lines_.swap(counting_lines);
+  line_counts_.assign(lines_.size(), 0);
+  return true;
+}
+
+void ZoneFilter::BuildRaster(uint32_t width, uint32_t height) {
+  raster_cols_ = (width + kRasterCell - 1) / kRasterCell;
+  uint32_t rows = (height + kRasterCell - 1) / kRasterCell;
+  raster_.assign(raster_cols_ * rows, 0);
+  for (uint32_t row = 0; row < rows; ++row) {
+    float y = (row + kHalf) * kRasterCell;
+    for (uint32_t col = 0; col < raster_cols_; ++col) {
+      float x = (col + kHalf) * kRasterCell;
+      for (const vector<ZonePoint>& polygon : zones_) {
+        if (InPolygon(polygon, x, y)) {
+          raster_[row * raster_cols_ + col] = 1;
+          break;
+        }
+      }
+    }
+  }
+  raster_width_ = width;
+  raster_height_ = height;
+}
+
+bool ZoneFilter::Contains(const BoundingBox& bbox, uint32_t width,
+                          uint32_t height) {
+  if (zones_.empty() || width == 0 || height == 0) {
+    return true;
+  }
+  if (width != raster_width_ || height != raster_height_) {
+    BuildRaster(width, height);
+  }
+  uint32_t x = min((bbox.lt_x + bbox.rb_x) / 2, width - 1);
+  uint32_t y = min(bbox.rb_y, height - 1);
+  return raster_[(y / kRasterCell) * raster_cols_ + x / kRasterCell] != 0;
+}
+
+uint32_t ZoneFilter::CountCrossings(const vector<uint32_t>& track_ids,
+                                    const vector<BoundingBox>& bboxes) {
+  ++frame_count_;
+  uint32_t crossings = 0;
+  for (size_t i = 0; i < track_ids.size() && i < bboxes.size(); ++i) {
+    ZonePoint cur = Anchor(bboxes[i]);
+    unordered_map<uint32_t, TrackPosition>::iterator iter = positions_.find(
+        track_ids[i]);
+    if (iter == positions_.end()) {
+      positions_[track_ids[i]] = {cur, frame_count_};
+      continue;
+    }
+    for (size_t line = 0; line < lines_.size(); ++line) {
+      if (Crossed(iter->second.point, cur, lines_[line].first,
+                  lines_[line].second)) {
+        ++line_counts_[line];
+        ++crossings;
+      }
+    }
+    iter->second = {cur, frame_count_};
+  }
+
+  // forget objects whose track has been dropped by the tracker
+  for (unordered_map<uint32_t, TrackPosition>::iterator iter =
+      positions_.begin(); iter != positions_.end();) {
+    if (frame_count_ - iter->second.frame > max_age_) {
+      iter = positions_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return crossings;
+}
+
+void ZoneFilter::Reset() {
+  positions_.clear();
+  line_counts_.assign(lines_.size(), 0);
+  frame_count_ = 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef OBJECT_DETECTION_POST_ZONE_FILTER_H_
+#define OBJECT_DETECTION_POST_ZONE_FILTER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "video_analysis_params.h"
+
+// a point in pixel coordinate of the original frame
+struct ZonePoint {
+  float x;
+  float y;
+};
+
+/**
+ * region of interest and counting lines of one video channel.
+ * polygons are rasterized into a coarse cell mask once per frame size, so
+ * testing a bounding box is a single lookup. counting lines are crossed by
+ * the anchor point (bottom center) of a tracked object between two frames.
+ */
+class ZoneFilter {
+ public:
+  ZoneFilter();
+
+  /**
+   * @brief : set region of interest polygons.
+   * @param [in] zones: polygons split by '|', each one is at least three
+   *             "x,y" points split by ';', in pixels of the original frame.
+   * @return true if zones are valid, otherwise false.
+   */
+  bool SetZones(const std::string& zones);
+
+  /**
+   * @brief : set counting lines.
+   * @param [in] lines: lines split by '|', each one is two "x,y" points
+   *             split by ';', in pixels of the original frame.
+   * @return true if lines are valid, otherwise false.
+   */
+  bool SetLines(const std::string& lines);
+
+  /**
+   * @brief : set frames a track position is kept without any update.
+   * @param [in] max_age: frames, same as the tracker max age.
+   */
+  void SetMaxAge(uint32_t max_age) {
+    max_age_ = max_age;
+  }
+
+  /**
+   * @brief : whether the channel has counting lines.
+   * @return true or false.
+   */
+  bool HasLines() const {
+    return !lines_.empty();
+  }
+
+  /**
+   * @brief : check if the anchor point of a bounding box is in any zone.
+   * @param [in] bbox: bounding box in pixels.
+   * @param [in] width: frame width.
+   * @param [in] height: frame height.
+   * @return true if the box is in a zone or no zone is set.
+   */
+  bool Contains(const BoundingBox& bbox, uint32_t width, uint32_t height);
+
+  /**
+   * @brief : update anchor points of tracked objects and count crossings.
+   * @param [in] track_ids: track id of each object in current frame.
+   * @param [in] bboxes: bounding box of each object, same order.
+   * @return number of line crossings in current frame.
+   */
+  uint32_t CountCrossings(const std::vector<uint32_t>& track_ids,
+                          const std::vector<BoundingBox>& bboxes);
+
+  /**
+   * @brief : get crossing count of every line since last reset.
+   * @return counts, same order as the lines.
+   */
+  const std::vector<uint32_t>& line_counts() const {
+    return line_counts_;
+  }
+
+  /**
+   * @brief : clear track positions and counts when the video is finished.
+   */
+  void Reset();
+
+ private:
+  struct TrackPosition {
+    ZonePoint point;
+    // frame number when the position was updated last time
+    uint64_t frame;
+  };
+
+  /**
+   * @brief : rasterize zones for a frame size.
+   * @param [in] width: frame width.
+   * @param [in] height: frame height.
+   */
+  void BuildRaster(uint32_t width, uint32_t height);
+
+  std::vector<std::vector<ZonePoint>> zones_;
+  std::vector<std::pair<ZonePoint, ZonePoint>> lines_;
+
+  // frame size the raster was built for, 0 means not built
+  uint32_t raster_width_;
+  uint32_t raster_height_;
+  uint32_t raster_cols_;
+  // one byte per cell, 1 if the cell center is in any zone
+  std::vector<uint8_t> raster_;
+
+  uint32_t max_age_;
+  uint64_t frame_count_;
+  std::unordered_map<uint32_t, TrackPosition> positions_;
+  std::vector<uint32_t> line_counts_;
+};
+
+#endif /* OBJECT_DETECTION_POST_ZONE_FILTER_H_ */
@@ -51,16 +51,10 @@ const int kDestImageWidth = 226; // the image width for model
 
 const int kDestImageHeight = 226; // the image height for model
 
-const int kPedestrianAttrNumber = 35; // pedestrian attributes number
-
-const int kAgeAttrNumber = 4; // age attributes number
-
-// pedestrian attributes confidence threshold value
+// binary attributes below it are reported as the opposite attribute
 const float kAttrConfidenceThreshold = 0.5;
 
-const int kHairAttrOrder = 15; // short or long hair attributes order
-
-const int kGenderAttrOrder = 16; // gender attributes order
+const string kModelName = "pedestrian_attr"; // model name string
 
 const string kModelPathItemName = "model_path"; // model path string
 
@@ -69,22 +63,18 @@ const string kPasscodeItemName = "passcode"; // passcode string
 // the name of batch_size in the config file
 const string kBatchSizeItemName = "batch_size";
 
-const string kAttrShortHair = "Short hair"; // the attribute: short hair
+// the names of attribute cache params in the config file
+const string kCacheCapacityItemName = "cache_capacity";
+const string kCacheIouThresholdItemName = "cache_iou_threshold";
+const string kCacheRefreshConfidenceItemName = "cache_refresh_confidence";
+const string kCacheMaxAgeItemName = "cache_max_age";
 
-const string kAttrLongHair = "Long hair"; // the attribute: long hair
+// the name of batch deadline in the config file
+const string kBatchDeadlineItemName = "batch_deadline_ms";
 
-const string kAttrFemale = "Female"; // the attribute: female
-
-const string kAttrMale = "Male"; // the attribute: male
-
-// pedestrian each attribute, total 35
-const string kPedestrianAttr[kPedestrianAttrNumber] = { "Age16-30", "Age31-45",
-    "Age46-60", "AgeAbove61", "Backpack", "CarryingOther", "Casual lower",
-    "Casual upper", "Formal lower", "Formal upper", "Hat", "Jacket", "Jeans",
-    "Leather Shoes", "Logo", "Long hair", "Male", "Messenger Bag", "Muffler",
-    "No accessory", "No carrying", "Plaid", "PlasticBags", "Sandals", "Shoes",
-    "Shorts", "Short Sleeve", "Skirt", "Sneaker", "Stripes", "Sunglasses",
-    "Trousers", "Tshirt", "UpperOther", "V-Neck" };
+// the names of attribute report params in the config file
+const string kAttributeThresholdItemName = "attribute_threshold";
+const string kAttributeTopKItemName = "attribute_top_k";
 
 const int kWaitTime = 10000; // wait 10 ms when send data to Cnext engine
 }
@@ -105,10 +95,17 @@ HIAI_StatusT PedestrianAttrInference::Init(
 
   std::vector<hiai::AIModelDescription> model_desc_vec;
   hiai::AIModelDescription model_description;
+  model_description.set_name(kModelName);
+  size_t cache_capacity = kDefaultCacheCapacity;
+  float cache_iou_threshold = kDefaultCacheIouThreshold;
+  float cache_refresh_confidence = kDefaultCacheRefreshConfidence;
+  uint32_t cache_max_age = kDefaultCacheMaxAge;
+  uint32_t batch_deadline = kDefaultBatchDeadline;
 
   // loop for each config items
   for (int index = 0; index < config.items_size(); ++index) {
     const ::hiai::AIConfigItem &item = config.items(index);
+    bool valid = true;
 
     if (item.name() == kModelPathItemName) { // get mode path
       const char* model_path = item.value().data();
@@ -117,10 +114,37 @@ HIAI_StatusT PedestrianAttrInference::Init(
       const char* passcode = item.value().data();
       model_description.set_key(passcode);
     } else if (item.name() == kBatchSizeItemName) { // get batch size
-      std::stringstream ss(item.value());
-      ss >> batch_size_;
+      valid = StringToNumber(item.value(), batch_size_) && batch_size_ > 0;
+    } else if (item.name() == kCacheCapacityItemName) { // get cache capacity
+      valid = StringToNumber(item.value(), cache_capacity);
+    } else if (item.name() == kCacheIouThresholdItemName) {
+      valid = StringToNumber(item.value(), cache_iou_threshold)
+          && cache_iou_threshold > 0.0f && cache_iou_threshold <= 1.0f;
+    } else if (item.name() == kCacheRefreshConfidenceItemName) {
+      valid = StringToNumber(item.value(), cache_refresh_confidence)
+          && cache_refresh_confidence >= 0.0f
+          && cache_refresh_confidence <= 1.0f;
+    } else if (item.name() == kCacheMaxAgeItemName) { // get cache max age
+      valid = StringToNumber(item.value(), cache_max_age);
+    } else if (item.name() == kBatchDeadlineItemName) { // get batch deadline
+      valid = StringToNumber(item.value(), batch_deadline);
+    } else if (item.name() == kAttributeThresholdItemName) {
+      valid = StringToNumber(item.value(), attribute_threshold_)
+          && attribute_threshold_ >= 0.0f && attribute_threshold_ <= 1.0f;
+    } else if (item.name() == kAttributeTopKItemName) {
+      valid = StringToNumber(item.value(), attribute_top_k_)
+          && attribute_top_k_ >= 0;
+    }
+    if (!valid) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "%s value %s is invalid!", item.name().c_str(),
+                      item.value().c_str());
+      return HIAI_ERROR;
     }
   }
+  batcher_.SetParams(batch_size_, batch_deadline);
+  attribute_cache_.SetParams(cache_capacity, cache_iou_threshold,
+                             cache_refresh_confidence, cache_max_age);
 
   model_desc_vec.push_back(model_description);
 
@@ -129,6 +153,13 @@ HIAI_StatusT PedestrianAttrInference::Init(
     return HIAI_ERROR;
   }
 
+  // input and output tensors are reused by every batch
+  if (!tensor_arena_.Init(ai_model_manager_, kModelName)) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "Fail to init tensor arena!");
+    return HIAI_ERROR;
+  }
+
   HIAI_ENGINE_LOG("End init!");
   return HIAI_OK;
 }
@@ -204,8 +235,7 @@ void PedestrianAttrInference::BatchImageResize(
       obj_image = std::make_shared<ObjectImageParaT>();
     }
 
-    obj_image->object_info.object_id = iter->object_info.object_id;
-    obj_image->object_info.score = iter->object_info.score;
+    obj_image->object_info = iter->object_info;
     obj_image->img.width = kDestImageWidth;
     obj_image->img.height = kDestImageHeight;
     obj_image->img.channel = iter->img.channel;
@@ -218,62 +248,54 @@ void PedestrianAttrInference::BatchImageResize(
   }
 }
 
-void PedestrianAttrInference::ExtractResults(int batch_result_index,
-                                             PedestrianInfoT &out_data,
-                                             float* &result) {
-  string age_str = ""; // initialize to empty string
-  float age_confidence = 0; // initialize to 0
-
-  // add age confidence to map
-  for (int i = 0; i < kAgeAttrNumber; i++) { // age has 4 values
-    float current_confidence = *(result
-        + batch_result_index * kPedestrianAttrNumber + i);
+void PedestrianAttrInference::ExtractResults(const float* confidences,
+                                             PedestrianInfoT &out_data) {
+  out_data.attributes.assign(kPedAttrNumber, 0.0f);
 
-    if (age_confidence < current_confidence) { // get the max confidence
-      age_str = kPedestrianAttr[i];
-      age_confidence = current_confidence;
+  // only the most confident age group is reported
+  int age = kPedAttrAge16To30;
+  for (int i = kPedAttrAge16To30 + 1; i <= kPedAttrAgeAbove61; i++) {
+    if (confidences[i] > confidences[age]) { // get the max confidence
+      age = i;
     }
   }
+  out_data.attributes[age] = confidences[age];
 
-  out_data.pedestrian_attribute_map.insert(
-      pair<string, float>(age_str, age_confidence));
-
-  // add hair confidence to map
-  float hair_confidence = *(result + batch_result_index * kPedestrianAttrNumber
-      + kHairAttrOrder);
+  // hair and gender are binary outputs, if the confidence is low the
+  // opposite attribute is reported with the remainder of 1.0
+  float hair_confidence = confidences[kPedAttrLongHair];
   if (hair_confidence < kAttrConfidenceThreshold) { // is short hair
-    // if gender is short hair, the confidence is the remainder of 1.0
-    out_data.pedestrian_attribute_map.insert(
-        pair<string, float>(kAttrShortHair, 1.0 - hair_confidence));
+    out_data.attributes[kPedAttrShortHair] = 1.0f - hair_confidence;
   } else { // is long hair
-    out_data.pedestrian_attribute_map.insert(
-        pair<string, float>(kAttrLongHair, hair_confidence));
+    out_data.attributes[kPedAttrLongHair] = hair_confidence;
   }
-
-  // add gender confidence to map
-  float gender_confidence = *(result
-      + batch_result_index * kPedestrianAttrNumber + kGenderAttrOrder);
+  float gender_confidence = confidences[kPedAttrMale];
   if (gender_confidence < kAttrConfidenceThreshold) { // is female
-    // if gender is female, the confidence is the remainder of 1.0
-    out_data.pedestrian_attribute_map.insert(
-        pair<string, float>(kAttrFemale, 1.0 - gender_confidence));
+    out_data.attributes[kPedAttrFemale] = 1.0f - gender_confidence;
   } else { // is male
-    out_data.pedestrian_attribute_map.insert(
-        pair<string, float>(kAttrMale, gender_confidence));
+    out_data.attributes[kPedAttrMale] = gender_confidence;
   }
 
-  // loop for each pedestrian attribute
-  for (int i = kAgeAttrNumber; i < kPedestrianAttrNumber; i++) {
-    float current_confidence = *(result
-        + batch_result_index * kPedestrianAttrNumber + i);
-
-    // check current confidence is valid
-    if (current_confidence > kAttrConfidenceThreshold && i != kHairAttrOrder
-        && i != kGenderAttrOrder) {
-      out_data.pedestrian_attribute_map.insert(
-          pair<string, float>(kPedestrianAttr[i], current_confidence));
+  // other attributes above the threshold, the most confident ones first
+  int candidates[kPedAttrModelNumber];
+  int candidate_number = 0;
+  for (int i = kPedAttrAgeAbove61 + 1; i < kPedAttrModelNumber; i++) {
+    if (confidences[i] > attribute_threshold_ && i != kPedAttrLongHair
+        && i != kPedAttrMale) {
+      candidates[candidate_number++] = i;
     }
   }
+  if (attribute_top_k_ > 0 && candidate_number > attribute_top_k_) {
+    std::partial_sort(candidates, candidates + attribute_top_k_,
+                      candidates + candidate_number,
+                      [confidences](int lhs, int rhs) {
+                        return confidences[lhs] > confidences[rhs];
+                      });
+    candidate_number = attribute_top_k_;
+  }
+  for (int i = 0; i < candidate_number; i++) {
+    out_data.attributes[candidates[i]] = confidences[candidates[i]];
+  }
 }
 
 bool PedestrianAttrInference::ConstructInferenceResult(
@@ -295,16 +317,16 @@ bool PedestrianAttrInference::ConstructInferenceResult(
 
     // analyze each batch result
     for (int batch_result_index = 0; batch_result_index < size;
-        batch_result_index += kPedestrianAttrNumber) {
-      if (batch_index + batch_result_index / kPedestrianAttrNumber
+        batch_result_index += kPedAttrModelNumber) {
+      if (batch_index + batch_result_index / kPedAttrModelNumber
           < image_number) { // check current data is valid image data
         PedestrianInfoT out_data;
         out_data.object_id = image_handle->obj_imgs[batch_index
-            + batch_result_index / kPedestrianAttrNumber].object_info.object_id;
+            + batch_result_index / kPedAttrModelNumber].object_info.object_id;
         out_data.attribute_name = "pedestrian";
 
         // extract appropriate results
-        ExtractResults(batch_result_index, out_data, result);
+        ExtractResults(result + batch_result_index, out_data);
 
         tran_data->pedestrian_info.push_back(out_data);
       }
@@ -351,92 +373,165 @@ bool PedestrianAttrInference::ConstructBatchBuffer(
   return is_successed;
 }
 
+HIAI_StatusT PedestrianAttrInference::InferenceReadyBatches(bool flush) {
+  HIAI_StatusT hiai_ret = HIAI_OK;
+  uint64_t batch_count = batcher_.batch_count();
+  std::vector<PendingObjectT> batch;
+
+  // loop for each ready batch
+  while (batcher_.Pop(flush, batch)) {
+    if (BatchInferenceProcess(batch) != HIAI_OK) {
+      hiai_ret = HIAI_ERROR;
+    }
+  }
+
+  if (batcher_.batch_count() != batch_count) { // some batch is inferred
+    HIAI_ENGINE_LOG(
+        "Batches: %llu, fill ratio: %.2f, deadline misses: %llu",
+        static_cast<unsigned long long>(batcher_.batch_count()),
+        batcher_.FillRatio(),
+        static_cast<unsigned long long>(batcher_.deadline_misses()));
+  }
+  return hiai_ret;
+}
+
 HIAI_StatusT PedestrianAttrInference::BatchInferenceProcess(
-    const std::shared_ptr<BatchCroppedImageParaT> &image_handle,
-    std::shared_ptr<BatchPedestrianInfoT> tran_data) {
+    const std::vector<PendingObjectT> &batch) {
   HIAI_ENGINE_LOG("Start process!");
 
-  int image_number = image_handle->obj_imgs.size();
+  // the objects of one batch may belong to different frames
+  std::shared_ptr<BatchCroppedImageParaT> image_handle = std::make_shared<
+      BatchCroppedImageParaT>();
+  for (std::vector<PendingObjectT>::const_iterator iter = batch.begin();
+      iter != batch.end(); ++iter) {
+    image_handle->obj_imgs.push_back(iter->obj_img);
+  }
+  std::shared_ptr<BatchPedestrianInfoT> batch_result = std::make_shared<
+      BatchPedestrianInfoT>();
+
   int image_size = image_handle->obj_imgs[0].img.size * sizeof(uint8_t);
   int batch_buffer_size = image_size * batch_size_;
 
-  // the loop for each batch ,maybe image_number greater than batch_size_
-  for (int i = 0; i < image_number; i += batch_size_) {
-    std::vector<std::shared_ptr<hiai::IAITensor>> input_data_vec;
-    std::vector<std::shared_ptr<hiai::IAITensor>> output_data_vec;
+  // get preallocated buffer for the batch
+  ascend::utils::TensorArenaSlot* slot = tensor_arena_.NextSlot();
+  if (slot == nullptr) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "Fail to get tensor arena slot!");
+    return HIAI_ERROR;
+  }
+  if (static_cast<uint32_t>(batch_buffer_size) != slot->input_size) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "Batch size %d does not match model input %u!",
+                    batch_buffer_size, slot->input_size);
+    return HIAI_ERROR;
+  }
+  if (!ConstructBatchBuffer(0, image_handle, slot->input_buffer.get())) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "Fail to construct input buffer!");
+    return HIAI_ERROR;
+  }
 
-    // prepare input buffer for each batch
-    if (tran_data == nullptr) {
-      tran_data = std::make_shared<BatchPedestrianInfoT>();
-    }
+  // Call Process, Predict
+  hiai::AIContext ai_context;
+  HIAI_ENGINE_LOG("Start ai_model_manager_->Process!");
+  hiai::AIStatus ret_process = ai_model_manager_->Process(ai_context,
+                                                          slot->input_tensors,
+                                                          slot->output_tensors,
+                                                          0);
+  if (ret_process != hiai::SUCCESS) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "ai_model_manager Process failed");
+    return HIAI_ERROR;
+  }
 
-    // apply buffer for each batch
-    uint8_t* batch_buffer = new uint8_t[batch_buffer_size];
-    // origin image information is transmitted to next Engine directly
-    tran_data->video_image_info = image_handle->video_image_info;
+  // get the result of each object in the batch
+  if (!ConstructInferenceResult(slot->output_tensors, 0, image_handle,
+                                batch_result)
+      || batch_result->pedestrian_info.size() != batch.size()) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "Fail to copy batch output buffer!");
+    return HIAI_ERROR;
+  }
 
-    if (!ConstructBatchBuffer(i, image_handle, batch_buffer)) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "Fail to construct input buffer!");
+  // send the results back to their frames
+  ScatterResults(batch, batch_result);
 
-      delete[] batch_buffer;
-      return HIAI_ERROR;
-    }
+  HIAI_ENGINE_LOG("End process!");
+  return HIAI_OK;
+}
 
-    std::shared_ptr<hiai::AINeuralNetworkBuffer> neural_buffer =
-        std::shared_ptr<hiai::AINeuralNetworkBuffer>(
-            new hiai::AINeuralNetworkBuffer());
-    neural_buffer->SetBuffer((void*) (batch_buffer), batch_buffer_size);
-    std::shared_ptr<hiai::IAITensor> input_data = std::static_pointer_cast<
-        hiai::IAITensor>(neural_buffer);
-    input_data_vec.push_back(input_data);
-
-    // Call Process, Predict
-    if (ai_model_manager_->CreateOutputTensor(input_data_vec, output_data_vec)
-        != hiai::SUCCESS) {
-      HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, HIAI_ENGINE_LOG(
-          "CreateOutputTensor failed");
-
-      delete[] batch_buffer;
-      return HIAI_ERROR;
+void PedestrianAttrInference::ScatterResults(
+    const std::vector<PendingObjectT> &batch,
+    const std::shared_ptr<BatchPedestrianInfoT> &batch_result) {
+  std::shared_ptr<BatchPedestrianInfoT> tran_data = nullptr;
+
+  // loop for each object of the batch
+  for (size_t index = 0; index < batch.size(); ++index) {
+    const VideoImageInfoT &video_image_info = batch[index].video_image_info;
+    const PedestrianInfoT &pedestrian_info =
+        batch_result->pedestrian_info[index];
+
+    // the least confident attribute decides the confidence of the result
+    float confidence = 1.0f;
+    for (float attribute_confidence : pedestrian_info.attributes) {
+      if (attribute_confidence > 0.0f) {
+        confidence = std::min(confidence, attribute_confidence);
+      }
     }
-
-    hiai::AIContext ai_context;
-    HIAI_ENGINE_LOG("Start ai_model_manager_->Process!");
-    hiai::AIStatus ret_process = ai_model_manager_->Process(ai_context,
-                                                            input_data_vec,
-                                                            output_data_vec, 0);
-    if (ret_process != hiai::SUCCESS) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "ai_model_manager Process failed");
-
-      delete[] batch_buffer;
-      return HIAI_ERROR;
+    attribute_cache_.Store(video_image_info, batch[index].obj_img.object_info,
+                           pedestrian_info, confidence);
+
+    // objects of one frame are adjacent in the batch, send when frame changes
+    if (tran_data != nullptr
+        && (tran_data->video_image_info.channel_id
+            != video_image_info.channel_id
+            || tran_data->video_image_info.frame_id
+                != video_image_info.frame_id)) {
+      if (SendResultData(tran_data) != HIAI_OK) { // check send data result
+        HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, "SendData failed!");
+      }
+      tran_data = nullptr;
     }
-
-    delete[] batch_buffer;
-
-    // set the tran_data with the result of this batch
-    if (!ConstructInferenceResult(output_data_vec, i, image_handle,
-                                  tran_data)) {
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "Fail to copy batch output buffer!");
-      return HIAI_ERROR;
+    if (tran_data == nullptr) { // first object of a frame
+      tran_data = std::make_shared<BatchPedestrianInfoT>();
+      tran_data->video_image_info = video_image_info;
     }
+    tran_data->pedestrian_info.push_back(pedestrian_info);
+  }
 
-    // send the result data
-    HIAI_StatusT ret_send_data = SendResultData(tran_data);
-    if (ret_send_data != HIAI_OK) { // check send data result
-      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                      "SendData failed! error code: %d", ret_send_data);
-    }
+  if (tran_data != nullptr && SendResultData(tran_data) != HIAI_OK) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, "SendData failed!");
+  }
+}
 
-    // release sources
-    tran_data = nullptr;
+void PedestrianAttrInference::FilterCachedObjects(
+    std::shared_ptr<BatchCroppedImageParaT> &image_input,
+    const std::shared_ptr<BatchPedestrianInfoT> &cached_data) {
+  cached_data->video_image_info = image_input->video_image_info;
+  std::vector<ObjectImageParaT> uncached_imgs;
+
+  // loop for each object, keep the objects which need inference
+  for (std::vector<ObjectImageParaT>::iterator iter = image_input->obj_imgs
+      .begin(); iter != image_input->obj_imgs.end(); ++iter) {
+    PedestrianInfoT pedestrian_info;
+    if (!iter->refresh_attributes
+        && attribute_cache_.Lookup(image_input->video_image_info,
+                                   iter->object_info, pedestrian_info)) {
+      pedestrian_info.object_id = iter->object_info.object_id;
+      cached_data->pedestrian_info.push_back(pedestrian_info);
+    } else {
+      uncached_imgs.push_back(*iter);
+    }
   }
+  image_input->obj_imgs.swap(uncached_imgs);
 
-  HIAI_ENGINE_LOG("End process!");
-  return HIAI_OK;
+  if (++cache_frames_ % kCacheReportFrames != 0) {
+    return;
+  }
+  HIAI_ENGINE_LOG("Attribute cache hits: %llu, misses: %llu, hit rate: %.2f",
+                  static_cast<unsigned long long>(attribute_cache_.hits()),
+                  static_cast<unsigned long long>(attribute_cache_.misses()),
+                  attribute_cache_.HitRate());
 }
 
 /**
@@ -472,18 +567,40 @@ HIAI_IMPL_ENGINE_PROCESS("pedestrian_attr_inference",
 
   // check current data is contains is_finished
   if (image_input->video_image_info.is_finished == true) {
+    // pending objects are inferred before the finished data goes downstream
+    if (InferenceReadyBatches(true) != HIAI_OK) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "Fail to flush pending objects!");
+    }
+    attribute_cache_.EraseChannel(image_input->video_image_info.channel_id);
     tran_data->video_image_info = image_input->video_image_info;
     return SendResultData(tran_data);
   }
 
-  // resize input image
-  BatchImageResize(image_input, image_handle);
-  if (image_handle->obj_imgs.empty() == true) { // check resize result
+  // reuse cached attributes, only objects which miss the cache are inferred
+  std::shared_ptr<BatchPedestrianInfoT> cached_data = std::make_shared<
+      BatchPedestrianInfoT>();
+  FilterCachedObjects(image_input, cached_data);
+  if (!cached_data->pedestrian_info.empty()
+      && SendResultData(cached_data) != HIAI_OK) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
-                    "Fail to resize input image!");
-    return HIAI_ERROR;
+                    "Fail to send cached result!");
+  }
+
+  // resize input image and queue them for cross frame batching, an input
+  // without object works as a clock so expired objects are still inferred
+  if (!image_input->obj_imgs.empty()) {
+    BatchImageResize(image_input, image_handle);
+    if (image_handle->obj_imgs.empty() == true) { // check resize result
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "Fail to resize input image!");
+    }
+    for (std::vector<ObjectImageParaT>::iterator iter = image_handle->obj_imgs
+        .begin(); iter != image_handle->obj_imgs.end(); ++iter) {
+      batcher_.Push(image_handle->video_image_info, *iter);
+    }
   }
 
   // inference and send inference result
-  return BatchInferenceProcess(image_handle, tran_data);
+  return InferenceReadyBatches(false);
 }
@@ -35,6 +35,8 @@
 #define PEDESTRIAN_ATTR_INFERENCE_H_
 
 #include "video_analysis_params.h"
+#include "attribute_cache.h"
+#include "dynamic_batcher.h"
 #include "hiaiengine/api.h"
 #include "hiaiengine/ai_model_manager.h"
 #include "hiaiengine/ai_types.h"
@@ -44,6 +46,7 @@
 #include "hiaiengine/data_type_reg.h"
 #include "hiaiengine/ai_tensor.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
+#include "ascenddk/ascend_tensor_arena/tensor_arena.h"
 
 #define INPUT_SIZE 2
 #define OUTPUT_SIZE 1
@@ -55,8 +58,14 @@ class PedestrianAttrInference : public hiai::Engine {
    * @brief PedestrianAttrInference constructor
    */
   PedestrianAttrInference()
-      : input_que_(INPUT_SIZE - 1) {
+      : input_que_(INPUT_SIZE - 1),
+        attribute_cache_(kDefaultCacheCapacity, kDefaultCacheIouThreshold,
+                         kDefaultCacheRefreshConfidence, kDefaultCacheMaxAge),
+        cache_frames_(0),
+        batcher_(kDefaultBatchSize, kDefaultBatchDeadline) {
     batch_size_ = kDefaultBatchSize;
+    attribute_threshold_ = kDefaultAttributeThreshold;
+    attribute_top_k_ = kDefaultAttributeTopK;
   }
 
   /**
@@ -77,14 +86,64 @@ HIAI_DEFINE_PROCESS(INPUT_SIZE, OUTPUT_SIZE)
  private:
   const int kDefaultBatchSize = 1; // default batch size
 
+  const size_t kDefaultCacheCapacity = 256; // default cached object number
+
+  // default min IoU to associate an object with a cached one
+  const float kDefaultCacheIouThreshold = 0.5f;
+
+  // default confidence below which cached attributes are inferred again
+  const float kDefaultCacheRefreshConfidence = 0.6f;
+
+  // default frames after which cached attributes are inferred again
+  const uint32_t kDefaultCacheMaxAge = 25;
+
+  // frames between two reports of the attribute cache hit rate
+  const uint64_t kCacheReportFrames = 100;
+
+  // default max waiting time of an object for a full batch, in milliseconds
+  const uint32_t kDefaultBatchDeadline = 50;
+
+  // default confidence above which an attribute is reported
+  const float kDefaultAttributeThreshold = 0.5f;
+
+  // default max number of reported attributes besides age, hair and gender,
+  // 0 means no limit
+  const int kDefaultAttributeTopK = 0;
+
   int batch_size_; // model inference batch size
 
+  float attribute_threshold_; // confidence to report an attribute
+
+  int attribute_top_k_; // max reported attributes, 0 means no limit
+
   // used for cache the input queue
   hiai::MultiTypeQueue input_que_;
 
   // used for AI model manage
   std::shared_ptr<hiai::AIModelManager> ai_model_manager_;
 
+  // used for reuse the last attribute result of each pedestrian
+  AttributeCache<PedestrianInfoT> attribute_cache_;
+
+  // frames looked up in the attribute cache, for the hit rate report
+  uint64_t cache_frames_;
+
+  // used for accumulate objects of different frames into model batches
+  DynamicBatcher batcher_;
+
+  // used for reuse model input and output tensors allocated at init
+  ascend::utils::TensorArena tensor_arena_;
+
+  /**
+   * @brief move objects whose attribute is cached and not due a refresh out
+   *        of the input batch
+   * @param [in] image_input: batch input images, cached objects are removed
+   * @param [out] cached_data: cached results of the removed objects
+   */
+  void FilterCachedObjects(
+      std::shared_ptr<BatchCroppedImageParaT> &image_input,
+      const std::shared_ptr<BatchPedestrianInfoT> &cached_data);
+
   /**
    * @brief batch resize image
    * @param [in] batch_image_input: batch input images
@@ -103,14 +162,27 @@ HIAI_DEFINE_PROCESS(INPUT_SIZE, OUTPUT_SIZE)
       const std::shared_ptr<BatchPedestrianInfoT> &tran_data);
 
   /**
-   * @brief send result data to next engine
-   * @param [in] image_handle: the image data after resized
-   * @param [in] tran_data: the data used for transmit
+   * @brief inference all batches which are ready in the batcher
+   * @param [in] flush: inference pending objects even if batch is not full
    * @return HIAI_OK: batch inference success; HIAI_ERROR:batch inference failed
    */
-  HIAI_StatusT BatchInferenceProcess(
-      const std::shared_ptr<BatchCroppedImageParaT> &image_handle,
-      std::shared_ptr<BatchPedestrianInfoT> tran_data);
+  HIAI_StatusT InferenceReadyBatches(bool flush);
+
+  /**
+   * @brief inference one batch and send result data to next engine
+   * @param [in] batch: objects of one batch, may belong to different frames
+   * @return HIAI_OK: batch inference success; HIAI_ERROR:batch inference failed
+   */
+  HIAI_StatusT BatchInferenceProcess(const std::vector<PendingObjectT> &batch);
+
+  /**
+   * @brief send results of a batch back to the frames of the objects
+   * @param [in] batch: objects of one batch
+   * @param [in] batch_result: inference result of each object of the batch
+   */
+  void ScatterResults(
+      const std::vector<PendingObjectT> &batch,
+      const std::shared_ptr<BatchPedestrianInfoT> &batch_result);
 
   /**
    * @brief send result data to next engine
@@ -138,12 +210,10 @@ HIAI_DEFINE_PROCESS(INPUT_SIZE, OUTPUT_SIZE)
 
   /**
    * @brief extract valid pedestrian attribute confidence
-   * @param [in] batch_result_index: batch result index
+   * @param [in] confidences: model output confidences of one pedestrian
    * @param [out] out_data: the out put data
-   * @param [in] result: the result of each pedestrian attribute confidence
    */
-  void ExtractResults(int batch_result_index, PedestrianInfoT &out_data,
-                      float* &result);
+  void ExtractResults(const float* confidences, PedestrianInfoT &out_data);
 };
 
 #endif /* PEDESTRIAN_ATTR_INFERENCE_H_ */
@@ -0,0 +1,205 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frame_join_buffer.h"
+
+using namespace std;
+
+namespace {
+const uint32_t kDeadlineMs = 20;
+const uint32_t kMaxPendingFrames = 4;
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+VideoImageInfoT MakeInfo(const string &channel_id, uint32_t frame_id) {
+  VideoImageInfoT info;
+  info.channel_id = channel_id;
+  info.frame_id = frame_id;
+  info.channel_name = channel_id;
+  info.is_finished = false;
+  return info;
+}
+
+shared_ptr<VideoDetectionImageParaT> MakeImage(const string &channel_id,
+                                               uint32_t frame_id,
+                                               uint32_t cars,
+                                               uint32_t pedestrians) {
+  shared_ptr<VideoDetectionImageParaT> image =
+      make_shared<VideoDetectionImageParaT>();
+  image->image.video_image_info = MakeInfo(channel_id, frame_id);
+  image->car_type_number = cars;
+  image->car_color_number = cars;
+  image->pedestrian_number = pedestrians;
+  return image;
+}
+
+shared_ptr<BatchCarInfoT> MakeCars(const string &channel_id,
+                                   uint32_t frame_id,
+                                   CarInferenceType attribute_name,
+                                   uint32_t number) {
+  shared_ptr<BatchCarInfoT> cars = make_shared<BatchCarInfoT>();
+  cars->video_image_info = MakeInfo(channel_id, frame_id);
+  for (uint32_t i = 0; i < number; ++i) {
+    CarInfoT car_info;
+    car_info.object_id = i;
+    car_info.label = 0;
+    car_info.attribute_name = attribute_name;
+    car_info.confidence = 1.0f;
+    cars->car_infos.push_back(car_info);
+  }
+  return cars;
+}
+
+shared_ptr<BatchPedestrianInfoT> MakePedestrians(const string &channel_id,
+                                                 uint32_t frame_id,
+                                                 uint32_t number) {
+  shared_ptr<BatchPedestrianInfoT> pedestrians =
+      make_shared<BatchPedestrianInfoT>();
+  pedestrians->video_image_info = MakeInfo(channel_id, frame_id);
+  pedestrians->pedestrian_info.resize(number);
+  return pedestrians;
+}
+
+void TestCompleteFrame() {
+  FrameJoinBuffer buffer(kDeadlineMs, kMaxPendingFrames);
+  vector<JoinedFrame> frames;
+  // results may arrive before the image and in split batches
+  buffer.AddCarInfo(MakeCars("1", 1, kCarType, 2), frames);
+  buffer.AddImage(MakeImage("1", 1, 2, 1), frames);
+  buffer.AddCarInfo(MakeCars("1", 1, kCarColor, 1), frames);
+  buffer.AddPedestrianInfo(MakePedestrians("1", 1, 1), frames);
+  Check(frames.empty(), "frame waits for all results");
+  buffer.AddCarInfo(MakeCars("1", 1, kCarColor, 1), frames);
+  Check(frames.size() == 1, "complete frame released");
+  if (frames.size() == 1) {
+    Check(frames[0].image != nullptr && frames[0].cars->car_infos.size() == 4
+          && frames[0].pedestrians->pedestrian_info.size() == 1,
+          "all parts joined");
+  }
+  Check(buffer.pending_number() == 0 && buffer.incomplete_number() == 0,
+        "nothing left");
+}
+
+void TestFrameWithoutObjects() {
+  FrameJoinBuffer buffer(kDeadlineMs, kMaxPendingFrames);
+  vector<JoinedFrame> frames;
+  // empty batches of classifiers do not create a pending frame
+  buffer.AddCarInfo(MakeCars("1", 1, kCarType, 0), frames);
+  buffer.AddPedestrianInfo(MakePedestrians("1", 1, 0), frames);
+  Check(buffer.pending_number() == 0, "empty batches ignored");
+  buffer.AddImage(MakeImage("1", 1, 0, 0), frames);
+  Check(frames.size() == 1, "frame without objects released on image");
+}
+
+void TestChannelsAreSeparate() {
+  FrameJoinBuffer buffer(kDeadlineMs, kMaxPendingFrames);
+  vector<JoinedFrame> frames;
+  buffer.AddImage(MakeImage("1", 7, 0, 1), frames);
+  buffer.AddPedestrianInfo(MakePedestrians("2", 7, 1), frames);
+  Check(frames.empty() && buffer.pending_number() == 2,
+        "same frame id of another channel is another frame");
+  buffer.AddPedestrianInfo(MakePedestrians("1", 7, 1), frames);
+  Check(frames.size() == 1 && frames[0].video_image_info.channel_id == "1",
+        "frame of its channel released");
+}
+
+void TestDeadline() {
+  FrameJoinBuffer buffer(kDeadlineMs, kMaxPendingFrames);
+  vector<JoinedFrame> frames;
+  buffer.AddImage(MakeImage("1", 1, 1, 0), frames);
+  buffer.PopExpired(false, frames);
+  Check(frames.empty(), "frame kept before deadline");
+  this_thread::sleep_for(chrono::milliseconds(kDeadlineMs * 2));
+  buffer.PopExpired(false, frames);
+  Check(frames.size() == 1 && buffer.incomplete_number() == 1,
+        "incomplete frame released after deadline");
+
+  // result of a released frame is forwarded alone
+  frames.clear();
+  buffer.AddCarInfo(MakeCars("1", 1, kCarType, 1), frames);
+  Check(frames.size() == 1 && frames[0].image == nullptr
+        && frames[0].cars->car_infos.size() == 1, "late result forwarded");
+  Check(buffer.late_number() == 1 && buffer.pending_number() == 0,
+        "late result counted");
+}
+
+void TestPendingBound() {
+  FrameJoinBuffer buffer(kDeadlineMs, kMaxPendingFrames);
+  vector<JoinedFrame> frames;
+  for (uint32_t frame_id = 0; frame_id <= kMaxPendingFrames; ++frame_id) {
+    buffer.AddImage(MakeImage("1", frame_id, 1, 0), frames);
+  }
+  Check(buffer.pending_number() == kMaxPendingFrames,
+        "pending frames bounded");
+  Check(frames.size() == 1 && frames[0].video_image_info.frame_id == 0,
+        "oldest frame released first");
+
+  frames.clear();
+  buffer.PopExpired(true, frames);
+  bool in_order = frames.size() == kMaxPendingFrames;
+  for (size_t i = 0; in_order && i < frames.size(); ++i) {
+    in_order = frames[i].video_image_info.frame_id == i + 1;
+  }
+  Check(in_order, "flush releases all frames in arrival order");
+  Check(buffer.incomplete_number() == kMaxPendingFrames + 1,
+        "released frames counted as incomplete");
+}
+}
+
+/**
+ * usage: frame_join_buffer_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestCompleteFrame();
+  TestFrameWithoutObjects();
+  TestChannelsAreSeparate();
+  TestDeadline();
+  TestPendingBound();
+  printf("frame_join_buffer_test: %s\n",
+         failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,263 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+// default workload, a 1080p jpeg frame with its object crops
+const uint32_t kDefaultFrames = 500;
+const uint32_t kDefaultObjects = 8;
+const uint32_t kDefaultAckWindow = 16;
+const uint32_t kImageSize = 64 * 1024;
+const uint32_t kCropSize = 4 * 1024;
+const uint32_t kResultSize = 128;
+const uint32_t kResponseSize = 32;
+
+// packet head of presenter agent: 4 bytes total size, 1 byte name length
+const uint32_t kPacketLengthSize = 4;
+
+// message names, only FrameResult is answered on demand
+const char *kImageSet = "ImageSet";
+const char *kInferenceResult = "InferenceResult";
+const char *kFrameResult = "FrameResult";
+
+bool SendAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t sent = send(fd, data, size, 0);
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+bool RecvAll(int fd, char *data, size_t size) {
+  while (size > 0) {
+    ssize_t received = recv(fd, data, size, 0);
+    if (received <= 0) {
+      return false;
+    }
+    data += received;
+    size -= received;
+  }
+  return true;
+}
+
+// sends a message like Connection::SendMessage, the head and the protobuf
+// message first and the tlv payload (images) in a second send
+bool SendMessage(int fd, const string &name, bool ack_required,
+                 uint32_t body_size, const vector<char> &payload) {
+  // the first byte of the body tells the stand-in server to answer
+  vector<char> head(kPacketLengthSize + 1 + name.size() + 1 + body_size, 0);
+  uint32_t size_field = htonl(head.size() + payload.size());
+  memcpy(head.data(), &size_field, kPacketLengthSize);
+  head[kPacketLengthSize] = static_cast<char>(name.size());
+  memcpy(&head[kPacketLengthSize + 1], name.data(), name.size());
+  head[kPacketLengthSize + 1 + name.size()] = ack_required ? 1 : 0;
+  return SendAll(fd, head.data(), head.size())
+      && (payload.empty() || SendAll(fd, payload.data(), payload.size()));
+}
+
+bool ReceiveResponse(int fd) {
+  char response[kResponseSize];
+  return RecvAll(fd, response, kResponseSize);
+}
+
+// stand-in presenter server: reads every message and answers the legacy
+// messages and the FrameResult messages asking for an ack
+void RunServer(int listen_fd, uint32_t delay_us) {
+  int fd = accept(listen_fd, nullptr, nullptr);
+  if (fd < 0) {
+    return;
+  }
+  vector<char> buffer;
+  char response[kResponseSize] = { 0 };
+  while (true) {
+    uint32_t size_field = 0;
+    if (!RecvAll(fd, reinterpret_cast<char*>(&size_field),
+                 kPacketLengthSize)) {
+      break;
+    }
+    buffer.resize(ntohl(size_field) - kPacketLengthSize);
+    if (!RecvAll(fd, buffer.data(), buffer.size())) {
+      break;
+    }
+    uint8_t name_size = static_cast<uint8_t>(buffer[0]);
+    string name(&buffer[1], name_size);
+    bool ack_required = buffer[1 + name_size] != 0;
+    if (name == kFrameResult && !ack_required) {
+      continue;
+    }
+    // processing time of the server and network latency
+    if (delay_us > 0) {
+      usleep(delay_us);
+    }
+    if (!SendAll(fd, response, kResponseSize)) {
+      break;
+    }
+  }
+  close(fd);
+}
+
+// legacy mode: the image set and every result wait for their response
+bool SendLegacyFrame(int fd, uint32_t objects) {
+  vector<char> images(kImageSize + objects * kCropSize);
+  if (!SendMessage(fd, kImageSet, false, 0, images)
+      || !ReceiveResponse(fd)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < objects; ++i) {
+    if (!SendMessage(fd, kInferenceResult, false, kResultSize, {})
+        || !ReceiveResponse(fd)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// stream mode: one FrameResult per frame, one response per window
+bool SendStreamFrame(int fd, uint32_t objects, uint32_t ack_window,
+                     uint32_t &unacked_number) {
+  vector<char> images(kImageSize + objects * kCropSize);
+  bool ack_required = (++unacked_number >= ack_window);
+  if (!SendMessage(fd, kFrameResult, ack_required, objects * kResultSize,
+                   images)) {
+    return false;
+  }
+  if (!ack_required) {
+    return true;
+  }
+  unacked_number = 0;
+  return ReceiveResponse(fd);
+}
+
+// runs one mode against a new stand-in server, returns frames/s or 0
+double Run(bool stream_mode, uint32_t frames, uint32_t objects,
+           uint32_t ack_window, uint32_t delay_us) {
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t address_size = sizeof(address);
+  if (listen_fd < 0
+      || bind(listen_fd, reinterpret_cast<sockaddr*>(&address),
+              address_size) != 0
+      || listen(listen_fd, 1) != 0
+      || getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address),
+                     &address_size) != 0) {
+    printf("start stand-in server failed\n");
+    return 0;
+  }
+  thread server(RunServer, listen_fd, delay_us);
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address),
+                        address_size) != 0) {
+    printf("connect stand-in server failed\n");
+    shutdown(listen_fd, SHUT_RDWR);
+    server.join();
+    close(listen_fd);
+    return 0;
+  }
+
+  bool sent = true;
+  uint32_t unacked_number = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < frames && sent; ++i) {
+    sent = stream_mode ?
+        SendStreamFrame(fd, objects, ack_window, unacked_number) :
+        SendLegacyFrame(fd, objects);
+  }
+  // the last window is acknowledged, so the server got every frame
+  if (sent && stream_mode && unacked_number > 0) {
+    sent = SendStreamFrame(fd, 0, 1, unacked_number);
+  }
+  double seconds = chrono::duration<double>(
+      chrono::steady_clock::now() - start).count();
+
+  close(fd);
+  server.join();
+  close(listen_fd);
+  if (!sent) {
+    printf("send frames failed\n");
+    return 0;
+  }
+  return frames / seconds;
+}
+}
+
+/**
+ * usage: frame_result_benchmark [frames] [objects] [ack_window] [delay_us]
+ * sends frames of objects to a stand-in presenter server on loopback, with
+ * a response per message as the legacy mode and with one FrameResult per
+ * frame as the stream mode, delay_us is added before each server response
+ * to model the network and the server. Prints frames/s of both modes.
+ */
+int main(int argc, char *argv[]) {
+  uint32_t frames = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultFrames;
+  uint32_t objects =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultObjects;
+  uint32_t ack_window =
+      argc > 3 ? strtoul(argv[3], nullptr, 10) : kDefaultAckWindow;
+  uint32_t delay_us = argc > 4 ? strtoul(argv[4], nullptr, 10) : 0;
+  if (frames == 0 || ack_window == 0) {
+    printf("frames and ack_window must be positive\n");
+    return -1;
+  }
+
+  double legacy_fps = Run(false, frames, objects, ack_window, delay_us);
+  double stream_fps = Run(true, frames, objects, ack_window, delay_us);
+  printf("frames %u, objects %u, ack window %u, server delay %u us\n",
+         frames, objects, ack_window, delay_us);
+  printf("legacy: %.1f frames/s, %u round trips/frame\n", legacy_fps,
+         1 + objects);
+  printf("stream: %.1f frames/s, 1/%u round trips/frame\n", stream_fps,
+         ack_window);
+  return (legacy_fps > 0 && stream_fps > 0) ? 0 : -1;
+}
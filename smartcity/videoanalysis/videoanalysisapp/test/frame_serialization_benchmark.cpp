@@ -0,0 +1,181 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "video_analysis_message.pb.h"
+#include "video_analysis_params.h"
+
+using ascend::presenter::video_analysis::CarInferenceResult;
+using ascend::presenter::video_analysis::FrameResult;
+using ascend::presenter::video_analysis::HumanInferenceResult;
+using ascend::presenter::video_analysis::MapType;
+using ascend::presenter::video_analysis::Object;
+using namespace std;
+
+namespace {
+const uint32_t kDefaultCars = 8;
+const uint32_t kDefaultPersons = 8;
+const uint32_t kDefaultRepeat = 20000;
+
+// reported attributes of a person, same as a typical pedestrian result
+const uint32_t kPersonAttributes = 8;
+
+double ElapsedUs(chrono::steady_clock::time_point start) {
+  return chrono::duration<double, micro>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+// object id as the engines made it before compact ids
+string FormatObjectId(const char *name, uint32_t index) {
+  stringstream ss;
+  ss << name << "_" << index;
+  return ss.str();
+}
+
+// fills a FrameResult without images as video_analysis_post does, ids are
+// "car_12" strings or compact numbers
+void FillFrameResult(uint32_t frame_id, uint32_t cars, uint32_t persons,
+                     bool compact_id, FrameResult &frame_result) {
+  frame_result.Clear();
+  frame_result.mutable_frame_index()->set_app_id("video_app1");
+  frame_result.mutable_frame_index()->set_channel_id("1");
+  frame_result.mutable_frame_index()->set_channel_name("channel1");
+  if (compact_id) {
+    frame_result.mutable_frame_index()->set_frame_number(frame_id);
+  } else {
+    frame_result.mutable_frame_index()->set_frame_id(to_string(frame_id));
+  }
+
+  for (uint32_t i = 0; i < cars + persons; ++i) {
+    bool is_car = i < cars;
+    uint32_t object_id = MakeObjectId(
+        is_car ? kObjectClassCar : kObjectClassPerson, frame_id * 16 + i);
+    Object *object = frame_result.add_object();
+    if (compact_id) {
+      object->set_compact_id(object_id);
+    } else {
+      object->set_id(FormatObjectId(is_car ? "car" : "person",
+                                    GetObjectIndex(object_id)));
+    }
+    object->set_confidence(0.9f);
+
+    if (is_car) {
+      for (int type = 0; type < 2; ++type) {
+        CarInferenceResult *car_result = frame_result.add_car_result();
+        if (compact_id) {
+          car_result->set_compact_object_id(object_id);
+        } else {
+          car_result->set_object_id(object->id());
+        }
+        car_result->set_type(
+            static_cast<ascend::presenter::video_analysis::CarInferenceType>(
+                type));
+        car_result->set_confidence(0.8f);
+        car_result->set_value(type == 0 ? "white" : "Volkswagen Passat");
+      }
+      continue;
+    }
+
+    HumanInferenceResult *human_result = frame_result.add_human_result();
+    if (compact_id) {
+      human_result->set_compact_object_id(object_id);
+    } else {
+      human_result->set_object_id(object->id());
+    }
+    for (uint32_t j = 0; j < kPersonAttributes; ++j) {
+      MapType *property = human_result->add_human_property();
+      property->set_key("Casual upper");
+      property->set_value(0.7f);
+    }
+  }
+}
+
+// returns serialized bytes of the last frame
+size_t Run(uint32_t cars, uint32_t persons, uint32_t repeat,
+           bool compact_id) {
+  FrameResult frame_result;
+  string buffer;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repeat; ++i) {
+    FillFrameResult(i, cars, persons, compact_id, frame_result);
+    frame_result.SerializeToString(&buffer);
+  }
+  double total_us = ElapsedUs(start);
+  printf("%s ids: %.2f us/frame, %zu bytes/frame\n",
+         compact_id ? "compact" : "string", total_us / repeat, buffer.size());
+  return buffer.size();
+}
+}
+
+/**
+ * usage: frame_serialization_benchmark [cars] [persons] [repeat]
+ * prints the time to fill and serialize a FrameResult without images and
+ * its size, with string object ids and with compact ids, and the time to
+ * make an object id both ways
+ */
+int main(int argc, char *argv[]) {
+  uint32_t cars = argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultCars;
+  uint32_t persons =
+      argc > 2 ? strtoul(argv[2], nullptr, 10) : kDefaultPersons;
+  uint32_t repeat = argc > 3 ? strtoul(argv[3], nullptr, 10) : kDefaultRepeat;
+  if (repeat == 0) {
+    printf("repeat must be positive\n");
+    return -1;
+  }
+
+  // object ids made per detection in object_detection_post
+  size_t length = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repeat; ++i) {
+    length += FormatObjectId("car", i).size();
+  }
+  double format_us = ElapsedUs(start);
+  uint32_t checksum = 0;
+  start = chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repeat; ++i) {
+    checksum += MakeObjectId(kObjectClassCar, i);
+  }
+  double make_us = ElapsedUs(start);
+  printf("object id: string %.3f us, compact %.3f us (%zu/%u)\n",
+         format_us / repeat, make_us / repeat, length, checksum);
+
+  printf("cars %u, persons %u\n", cars, persons);
+  size_t string_size = Run(cars, persons, repeat, false);
+  size_t compact_size = Run(cars, persons, repeat, true);
+  return (compact_size > 0 && compact_size <= string_size) ? 0 : -1;
+}
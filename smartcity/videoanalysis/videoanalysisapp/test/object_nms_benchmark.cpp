@@ -0,0 +1,108 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "object_nms.h"
+
+using namespace std;
+
+namespace {
+const float kNmsThreshold = 0.45f;
+const uint32_t kMaxPerClass = 20;
+const uint32_t kFrameWidth = 1920;
+const uint32_t kFrameHeight = 1080;
+const int32_t kLabelNumber = 4;
+
+// calls of each box number, enough for a stable mean of small sets
+const uint32_t kDefaultRepeat = 1000;
+
+// synthetic detections, boxes of 20 to 200 pixels over a 1080p frame
+vector<FilteredObject> MakeObjects(size_t count, mt19937 &generator) {
+  uniform_int_distribution<uint32_t> x(0, kFrameWidth - 200);
+  uniform_int_distribution<uint32_t> y(0, kFrameHeight - 200);
+  uniform_int_distribution<uint32_t> side(20, 200);
+  uniform_int_distribution<int32_t> label(0, kLabelNumber - 1);
+  uniform_real_distribution<float> score(0.3f, 1.0f);
+  vector<FilteredObject> objects(count);
+  for (FilteredObject &object : objects) {
+    object.attr = label(generator);
+    object.score = score(generator);
+    object.bbox.lt_x = x(generator);
+    object.bbox.lt_y = y(generator);
+    object.bbox.rb_x = object.bbox.lt_x + side(generator);
+    object.bbox.rb_y = object.bbox.lt_y + side(generator);
+  }
+  return objects;
+}
+}
+
+/**
+ * usage: object_nms_benchmark [repeat]
+ * prints the time of one SuppressOverlappedObjects call on 100 to 1000
+ * synthetic boxes, with and without the per class cap
+ */
+int main(int argc, char *argv[]) {
+  uint32_t repeat =
+      argc > 1 ? strtoul(argv[1], nullptr, 10) : kDefaultRepeat;
+  if (repeat == 0) {
+    printf("repeat must be positive\n");
+    return -1;
+  }
+
+  const size_t counts[] = { 100, 200, 500, 1000 };
+  const uint32_t caps[] = { 0, kMaxPerClass };
+  mt19937 generator(0);
+  size_t kept_total = 0;
+  for (size_t count : counts) {
+    vector<FilteredObject> objects = MakeObjects(count, generator);
+    for (uint32_t cap : caps) {
+      vector<FilteredObject> input;
+      double total_us = 0;
+      for (uint32_t i = 0; i < repeat; ++i) {
+        input = objects;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        SuppressOverlappedObjects(input, kNmsThreshold, cap);
+        total_us += chrono::duration<double, micro>(
+            chrono::steady_clock::now() - start).count();
+      }
+      kept_total += input.size();
+      printf("boxes %4zu, max per class %2u: %9.2f us/call, kept %zu\n",
+             count, cap, total_us / repeat, input.size());
+    }
+  }
+  return kept_total > 0 ? 0 : -1;
+}
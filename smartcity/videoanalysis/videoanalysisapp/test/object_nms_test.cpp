@@ -0,0 +1,229 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "object_nms.h"
+
+using namespace std;
+
+namespace {
+const float kNmsThreshold = 0.45f;
+const uint32_t kFrameWidth = 1920;
+const uint32_t kFrameHeight = 1080;
+const int32_t kLabelNumber = 4;
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+FilteredObject MakeObject(int32_t attr, float score, uint32_t lt_x,
+                          uint32_t lt_y, uint32_t rb_x, uint32_t rb_y) {
+  FilteredObject object;
+  object.attr = attr;
+  object.score = score;
+  object.bbox.lt_x = lt_x;
+  object.bbox.lt_y = lt_y;
+  object.bbox.rb_x = rb_x;
+  object.bbox.rb_y = rb_y;
+  return object;
+}
+
+vector<FilteredObject> MakeRandomObjects(size_t count, uint32_t seed) {
+  mt19937 generator(seed);
+  uniform_int_distribution<uint32_t> x(0, kFrameWidth - 200);
+  uniform_int_distribution<uint32_t> y(0, kFrameHeight - 200);
+  uniform_int_distribution<uint32_t> side(20, 200);
+  uniform_int_distribution<int32_t> label(0, kLabelNumber - 1);
+  uniform_real_distribution<float> score(0.3f, 1.0f);
+  vector<FilteredObject> objects;
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t lt_x = x(generator);
+    uint32_t lt_y = y(generator);
+    objects.push_back(MakeObject(label(generator), score(generator), lt_x,
+                                 lt_y, lt_x + side(generator),
+                                 lt_y + side(generator)));
+  }
+  return objects;
+}
+
+// straightforward NMS with a division, the reference of the optimized one
+float IoU(const BoundingBox &lhs, const BoundingBox &rhs) {
+  float inter_width = max(0.0f, static_cast<float>(min(lhs.rb_x, rhs.rb_x))
+      - static_cast<float>(max(lhs.lt_x, rhs.lt_x)));
+  float inter_height = max(0.0f, static_cast<float>(min(lhs.rb_y, rhs.rb_y))
+      - static_cast<float>(max(lhs.lt_y, rhs.lt_y)));
+  float inter_area = inter_width * inter_height;
+  float lhs_area = static_cast<float>(lhs.rb_x - lhs.lt_x)
+      * (lhs.rb_y - lhs.lt_y);
+  float rhs_area = static_cast<float>(rhs.rb_x - rhs.lt_x)
+      * (rhs.rb_y - rhs.lt_y);
+  return inter_area / (lhs_area + rhs_area - inter_area);
+}
+
+vector<FilteredObject> ReferenceNms(vector<FilteredObject> objects,
+                                    float nms_threshold,
+                                    uint32_t max_per_class) {
+  stable_sort(objects.begin(), objects.end(),
+              [](const FilteredObject &lhs, const FilteredObject &rhs) {
+                return lhs.score > rhs.score;
+              });
+  vector<FilteredObject> kept_objects;
+  for (const FilteredObject &object : objects) {
+    uint32_t kept_number = 0;
+    bool overlapped = false;
+    for (const FilteredObject &kept : kept_objects) {
+      if (kept.attr != object.attr) {
+        continue;
+      }
+      ++kept_number;
+      overlapped = overlapped || IoU(kept.bbox, object.bbox) > nms_threshold;
+    }
+    if (!overlapped && (max_per_class == 0 || kept_number < max_per_class)) {
+      kept_objects.push_back(object);
+    }
+  }
+  return kept_objects;
+}
+
+bool SameObjects(const vector<FilteredObject> &lhs,
+                 const vector<FilteredObject> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].attr != rhs[i].attr || lhs[i].score != rhs[i].score
+        || lhs[i].bbox.lt_x != rhs[i].bbox.lt_x
+        || lhs[i].bbox.lt_y != rhs[i].bbox.lt_y) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TestEmpty() {
+  vector<FilteredObject> objects;
+  SuppressOverlappedObjects(objects, kNmsThreshold, 0);
+  Check(objects.empty(), "empty input");
+}
+
+void TestOverlappedSameLabel() {
+  vector<FilteredObject> objects = {
+      MakeObject(1, 0.6f, 10, 10, 110, 110),
+      MakeObject(1, 0.9f, 12, 12, 112, 112),
+      MakeObject(1, 0.7f, 500, 500, 600, 600) };
+  SuppressOverlappedObjects(objects, kNmsThreshold, 0);
+  Check(objects.size() == 2, "overlapped box of the same label dropped");
+  Check(objects.size() == 2 && objects[0].score == 0.9f
+        && objects[1].score == 0.7f, "kept boxes sorted by score");
+}
+
+void TestOverlappedOtherLabel() {
+  vector<FilteredObject> objects = {
+      MakeObject(1, 0.9f, 10, 10, 110, 110),
+      MakeObject(2, 0.8f, 10, 10, 110, 110) };
+  SuppressOverlappedObjects(objects, kNmsThreshold, 0);
+  Check(objects.size() == 2, "overlapped box of another label kept");
+}
+
+void TestThreshold() {
+  // IoU of the two boxes is 1/3
+  vector<FilteredObject> objects = {
+      MakeObject(1, 0.9f, 0, 0, 100, 100),
+      MakeObject(1, 0.8f, 50, 0, 150, 100) };
+  vector<FilteredObject> loose = objects;
+  SuppressOverlappedObjects(loose, 0.5f, 0);
+  Check(loose.size() == 2, "IoU below threshold kept");
+  SuppressOverlappedObjects(objects, 0.3f, 0);
+  Check(objects.size() == 1, "IoU above threshold dropped");
+}
+
+void TestMaxPerClass() {
+  vector<FilteredObject> objects;
+  for (uint32_t i = 0; i < 5; ++i) {
+    objects.push_back(MakeObject(1, 0.5f + i * 0.1f, i * 200, 0,
+                                 i * 200 + 100, 100));
+    objects.push_back(MakeObject(2, 0.5f, i * 200, 500, i * 200 + 100, 600));
+  }
+  SuppressOverlappedObjects(objects, kNmsThreshold, 3);
+  uint32_t label_1 = 0;
+  uint32_t label_2 = 0;
+  float min_score_1 = 1.0f;
+  for (const FilteredObject &object : objects) {
+    if (object.attr == 1) {
+      ++label_1;
+      min_score_1 = min(min_score_1, object.score);
+    } else {
+      ++label_2;
+    }
+  }
+  Check(label_1 == 3 && label_2 == 3, "at most max_per_class per label");
+  Check(min_score_1 > 0.65f, "best scores of a label kept");
+}
+
+void TestSameAsReference() {
+  const size_t counts[] = { 100, 1000 };
+  const uint32_t caps[] = { 0, 20 };
+  for (size_t count : counts) {
+    for (uint32_t cap : caps) {
+      vector<FilteredObject> objects = MakeRandomObjects(count, count + cap);
+      vector<FilteredObject> expected = ReferenceNms(objects, kNmsThreshold,
+                                                     cap);
+      SuppressOverlappedObjects(objects, kNmsThreshold, cap);
+      Check(SameObjects(objects, expected), "same as reference NMS");
+    }
+  }
+}
+}
+
+/**
+ * usage: object_nms_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestEmpty();
+  TestOverlappedSameLabel();
+  TestOverlappedOtherLabel();
+  TestThreshold();
+  TestMaxPerClass();
+  TestSameAsReference();
+  printf("object_nms_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
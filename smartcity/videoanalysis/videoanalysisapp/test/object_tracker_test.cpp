@@ -0,0 +1,164 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "object_tracker.h"
+
+using namespace std;
+
+namespace {
+const float kIouThreshold = 0.3f;
+const uint32_t kMaxAge = 3;
+const uint32_t kRefreshInterval = 5;
+
+const uint32_t kCarLabel = 1;
+const uint32_t kPersonLabel = 2;
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+// detection of a 100x100 box whose left top corner is at x, y
+TrackDetection MakeDetection(uint32_t label, uint32_t x, uint32_t y) {
+  TrackDetection detection;
+  detection.label = label;
+  detection.bbox.lt_x = x;
+  detection.bbox.lt_y = y;
+  detection.bbox.rb_x = x + 100;
+  detection.bbox.rb_y = y + 100;
+  return detection;
+}
+
+vector<TrackResult> Track(ObjectTracker &tracker,
+                          const vector<TrackDetection> &detections) {
+  vector<TrackResult> results;
+  tracker.Update(detections, results);
+  return results;
+}
+
+void TestIdPersistence() {
+  ObjectTracker tracker(kIouThreshold, kMaxAge, kRefreshInterval);
+  vector<TrackResult> first = Track(tracker, {
+      MakeDetection(kCarLabel, 100, 100), MakeDetection(kPersonLabel, 600,
+                                                        100) });
+  Check(first.size() == 2 && first[0].track_id != first[1].track_id,
+        "new objects get different ids");
+
+  // both objects move 5 pixels a frame, the detection order is swapped
+  bool kept = true;
+  for (uint32_t frame = 1; frame <= 50; ++frame) {
+    vector<TrackResult> results = Track(tracker, {
+        MakeDetection(kPersonLabel, 600 - 5 * frame, 100),
+        MakeDetection(kCarLabel, 100 + 5 * frame, 100) });
+    kept = kept && results[0].track_id == first[1].track_id
+        && results[1].track_id == first[0].track_id;
+  }
+  Check(kept, "ids persist while objects move");
+
+  // an object of another label at the same place is another track
+  ObjectTracker labels(kIouThreshold, kMaxAge, kRefreshInterval);
+  uint32_t car_id = Track(labels, {
+      MakeDetection(kCarLabel, 100, 100) })[0].track_id;
+  vector<TrackResult> results = Track(labels, {
+      MakeDetection(kPersonLabel, 100, 100) });
+  Check(results[0].track_id != car_id, "label is not mixed up");
+  Check(Track(labels, { MakeDetection(kCarLabel, 100, 100) })[0].track_id
+            == car_id, "car keeps its id");
+}
+
+void TestExpiry() {
+  ObjectTracker tracker(kIouThreshold, kMaxAge, kRefreshInterval);
+  vector<TrackDetection> car = { MakeDetection(kCarLabel, 100, 100) };
+  uint32_t id = Track(tracker, car)[0].track_id;
+
+  // a track survives max age frames without a detection
+  for (uint32_t frame = 0; frame < kMaxAge; ++frame) {
+    Track(tracker, {});
+  }
+  Check(Track(tracker, car)[0].track_id == id, "track kept within max age");
+
+  // and is dropped after that
+  for (uint32_t frame = 0; frame <= kMaxAge; ++frame) {
+    Track(tracker, {});
+  }
+  uint32_t new_id = Track(tracker, car)[0].track_id;
+  Check(new_id != id, "track dropped after max age");
+  Check(Track(tracker, car)[0].track_id == new_id, "new track is followed");
+}
+
+void TestRefresh() {
+  ObjectTracker tracker(kIouThreshold, kMaxAge, kRefreshInterval);
+  vector<TrackDetection> car = { MakeDetection(kCarLabel, 100, 100) };
+  // attributes are inferred on the first frame and then every interval
+  bool cadence = true;
+  for (uint32_t frame = 0; frame < 4 * kRefreshInterval; ++frame) {
+    bool expected = frame % kRefreshInterval == 0;
+    cadence = cadence && Track(tracker, car)[0].need_inference == expected;
+  }
+  Check(cadence, "refresh interval");
+
+  // missed frames count towards the interval
+  ObjectTracker missing(kIouThreshold, kMaxAge, kRefreshInterval);
+  Check(Track(missing, car)[0].need_inference, "first frame");
+  Check(!Track(missing, car)[0].need_inference, "cached on next frame");
+  for (uint32_t frame = 0; frame < kMaxAge; ++frame) {
+    Track(missing, {});
+  }
+  Check(Track(missing, car)[0].need_inference, "refresh after missed frames");
+
+  ObjectTracker every_frame(kIouThreshold, kMaxAge, 0);
+  bool always = true;
+  for (uint32_t frame = 0; frame < 10; ++frame) {
+    always = always && Track(every_frame, car)[0].need_inference;
+  }
+  Check(always, "interval 0 infers every frame");
+}
+}
+
+/**
+ * usage: object_tracker_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestIdPersistence();
+  TestExpiry();
+  TestRefresh();
+  printf("object_tracker_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,118 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <cstdint>
+#include <cstdio>
+#include "overload_controller.h"
+
+namespace {
+const uint32_t kHighMs = 40;
+const uint32_t kLowMs = 20;
+const uint32_t kHoldFrames = 5;
+const uint32_t kMaxLevel = 2;
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+// feed frames of the same time, return the number of level changes
+uint32_t Feed(OverloadController &controller, float frame_ms,
+              uint32_t frames) {
+  uint32_t changes = 0;
+  for (uint32_t i = 0; i < frames; ++i) {
+    changes += controller.Update(frame_ms) ? 1 : 0;
+  }
+  return changes;
+}
+
+void TestDisabled() {
+  OverloadController controller;
+  Check(!controller.Enabled(), "disabled by default");
+  Check(Feed(controller, 1000.0f, 100) == 0 && controller.level() == 0,
+        "disabled controller keeps level 0");
+  OverloadMetrics metrics = controller.Metrics();
+  Check(metrics.frames == 100, "frames counted when disabled");
+  Check(metrics.peak_ms == 1000.0f, "peak kept when disabled");
+  Check(controller.Confidence(0.5f, 0.1f) == 0.5f, "base confidence");
+  Check(controller.ObjectsPerClass(0, 8) == 0, "no objects limit");
+}
+
+void TestLevels() {
+  OverloadController controller;
+  controller.SetParams(kHighMs, kLowMs, kHoldFrames, kMaxLevel);
+  Check(Feed(controller, 10.0f, 50) == 0, "light load");
+
+  // level moves up once per hold frames and stops at max level
+  Check(Feed(controller, 100.0f, kHoldFrames) == 1
+            && controller.level() == 1, "level 1");
+  Check(Feed(controller, 100.0f, kHoldFrames * 4) == 1
+            && controller.level() == kMaxLevel, "max level");
+  Check(controller.Confidence(0.5f, 0.1f) > 0.69f
+            && controller.Confidence(0.5f, 0.1f) < 0.71f,
+        "confidence raised per level");
+  Check(controller.Confidence(0.5f, 1.0f) < 1.0f, "confidence capped");
+  Check(controller.ObjectsPerClass(0, 8) == 4, "objects halved per level");
+  Check(controller.ObjectsPerClass(2, 8) == 2, "configured limit kept");
+
+  // between the watermarks the level is held
+  Check(Feed(controller, 30.0f, 100) == 0, "level held between watermarks");
+
+  Check(Feed(controller, 1.0f, 100) == 2 && controller.level() == 0,
+        "level back to 0");
+
+  OverloadMetrics metrics = controller.Metrics();
+  Check(metrics.frames == 50 + kHoldFrames * 5 + 200, "frames");
+  Check(metrics.level_changes == 4, "level changes");
+  Check(metrics.overloaded_frames > kHoldFrames * 4 + 100
+            && metrics.overloaded_frames < metrics.frames - 50,
+        "overloaded frames");
+  Check(metrics.peak_ms == 100.0f, "peak");
+  Check(metrics.level == 0 && metrics.average_ms < kLowMs, "current state");
+}
+}
+
+/**
+ * usage: overload_controller_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestDisabled();
+  TestLevels();
+  printf("overload_controller_test: %s\n",
+         failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
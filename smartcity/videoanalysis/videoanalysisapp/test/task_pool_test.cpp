@@ -0,0 +1,115 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "task_pool.h"
+
+using namespace std;
+
+namespace {
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+// true if every task of the last run is called exactly once
+bool RunOnce(TaskPool &pool, size_t task_number) {
+  vector<atomic<int>> calls(task_number);
+  for (atomic<int> &call : calls) {
+    call = 0;
+  }
+  pool.Run(task_number, [&calls](size_t index) { ++calls[index]; });
+  for (const atomic<int> &call : calls) {
+    if (call != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TestRunAll() {
+  TaskPool no_worker(0);
+  Check(RunOnce(no_worker, 10), "pool without worker");
+
+  TaskPool pool(3);
+  Check(RunOnce(pool, 0), "no task");
+  Check(RunOnce(pool, 1), "one task");
+  Check(RunOnce(pool, 1000), "more tasks than threads");
+  // pool is reused frame by frame
+  bool all_runs = true;
+  for (int run = 0; run < 200; ++run) {
+    all_runs = all_runs && RunOnce(pool, run % 7);
+  }
+  Check(all_runs, "repeated runs");
+}
+
+void TestParallel() {
+  const size_t kTaskNumber = 8;
+  TaskPool pool(3);
+  mutex thread_mutex;
+  set<thread::id> thread_ids;
+  atomic<int> finished(0);
+  pool.Run(kTaskNumber, [&](size_t) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    {
+      lock_guard<mutex> lock(thread_mutex);
+      thread_ids.insert(this_thread::get_id());
+    }
+    ++finished;
+  });
+  Check(finished == static_cast<int>(kTaskNumber),
+        "run returns after all tasks");
+  Check(thread_ids.size() > 1, "tasks run on workers");
+  Check(thread_ids.size() <= 4, "at most workers and caller");
+}
+}
+
+/**
+ * usage: task_pool_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestRunAll();
+  TestParallel();
+  printf("task_pool_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,161 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "zone_filter.h"
+
+using namespace std;
+
+namespace {
+const uint32_t kFrameWidth = 1920;
+const uint32_t kFrameHeight = 1080;
+
+// left half of a 1080p frame
+const char *kLeftHalf = "0,0;960,0;960,1080;0,1080";
+
+// vertical line in the middle of a 1080p frame
+const char *kMiddleLine = "960,0;960,1080";
+
+int failures = 0;
+
+void Check(bool condition, const char *message) {
+  if (!condition) {
+    printf("FAILED: %s\n", message);
+    ++failures;
+  }
+}
+
+BoundingBox MakeBox(uint32_t lt_x, uint32_t lt_y, uint32_t rb_x,
+                    uint32_t rb_y) {
+  BoundingBox bbox;
+  bbox.lt_x = lt_x;
+  bbox.lt_y = lt_y;
+  bbox.rb_x = rb_x;
+  bbox.rb_y = rb_y;
+  return bbox;
+}
+
+// box of 100x200 pixels whose anchor (bottom center) is at x, y
+BoundingBox BoxAt(uint32_t x, uint32_t y) {
+  return MakeBox(x - 50, y - 200, x + 50, y);
+}
+
+uint32_t Move(ZoneFilter &filter, uint32_t track_id, uint32_t x,
+              uint32_t y) {
+  return filter.CountCrossings(vector<uint32_t>(1, track_id),
+                               vector<BoundingBox>(1, BoxAt(x, y)));
+}
+
+void TestParse() {
+  ZoneFilter filter;
+  Check(filter.SetZones(kLeftHalf), "polygon zone");
+  Check(filter.SetZones("0,0;10,0;10,10|20,20;30,20;30,30"), "two zones");
+  Check(!filter.SetZones("0,0;10,0"), "zone with two points rejected");
+  Check(!filter.SetZones("0,0;10,x;10,10"), "bad coordinate rejected");
+  Check(!filter.SetZones("0,0;-10,0;10,10"), "negative coordinate rejected");
+  Check(filter.SetLines(kMiddleLine), "line");
+  Check(!filter.SetLines("0,0;10,0;10,10"), "line with three points rejected");
+  Check(filter.HasLines() && filter.line_counts().size() == 1,
+        "rejected lines keep the previous ones");
+}
+
+void TestContains() {
+  ZoneFilter filter;
+  Check(filter.Contains(BoxAt(1500, 500), kFrameWidth, kFrameHeight),
+        "no zone contains every box");
+
+  Check(filter.SetZones(kLeftHalf), "zone");
+  Check(filter.Contains(BoxAt(100, 500), kFrameWidth, kFrameHeight),
+        "box in zone");
+  Check(!filter.Contains(BoxAt(1500, 500), kFrameWidth, kFrameHeight),
+        "box out of zone");
+  // a box across the border is judged by its anchor
+  Check(filter.Contains(MakeBox(700, 0, 1100, 1000), kFrameWidth,
+                        kFrameHeight), "anchor in zone");
+  Check(!filter.Contains(MakeBox(900, 0, 1300, 1000), kFrameWidth,
+                         kFrameHeight), "anchor out of zone");
+  // boxes beyond the frame are clamped to it
+  Check(filter.Contains(MakeBox(0, 0, 100, 5000), kFrameWidth, kFrameHeight),
+        "box clamped to frame");
+
+  // raster is rebuilt for another frame size
+  Check(filter.Contains(BoxAt(700, 300), kFrameWidth / 2, kFrameHeight / 2),
+        "zone in pixels of the frame");
+  Check(!filter.Contains(BoxAt(1500, 500), kFrameWidth, kFrameHeight),
+        "raster rebuilt for frame size");
+}
+
+void TestCrossings() {
+  ZoneFilter filter;
+  filter.SetMaxAge(2);
+  Check(filter.SetLines(kMiddleLine), "line");
+  Check(Move(filter, 1, 900, 500) == 0, "first position not counted");
+  Check(Move(filter, 1, 1000, 500) == 1, "crossing counted");
+  Check(Move(filter, 1, 900, 500) == 1, "crossing back counted");
+
+  // touching the line from the positive side is not a crossing
+  Check(Move(filter, 1, 960, 500) == 0 && Move(filter, 1, 900, 500) == 0,
+        "touching the line not counted");
+  Check(filter.line_counts()[0] == 2, "counts of the line");
+
+  // movement crossing the extension of a line segment
+  ZoneFilter short_line;
+  Check(short_line.SetLines("960,0;960,400"), "short line");
+  Move(short_line, 1, 900, 800);
+  Check(Move(short_line, 1, 1000, 800) == 0, "beyond the segment");
+
+  // positions of dropped tracks are forgotten after max age
+  Move(filter, 2, 900, 800);
+  Move(filter, 1, 900, 500);
+  Move(filter, 1, 900, 500);
+  Move(filter, 1, 900, 500);
+  Check(Move(filter, 2, 1000, 800) == 0, "forgotten track starts again");
+
+  filter.Reset();
+  Check(filter.line_counts()[0] == 0, "counts reset");
+  Check(Move(filter, 1, 1000, 500) == 0, "positions reset");
+}
+}
+
+/**
+ * usage: zone_filter_test
+ * returns 0 if all checks pass
+ */
+int main() {
+  TestParse();
+  TestContains();
+  TestCrossings();
+  printf("zone_filter_test: %s\n", failures == 0 ? "passed" : "failed");
+  return failures == 0 ? 0 : -1;
+}
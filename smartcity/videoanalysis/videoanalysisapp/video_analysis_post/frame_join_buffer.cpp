@@ -0,0 +1,264 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+#include "frame_join_buffer.h"
+#include "hiaiengine/log.h"
+
+using namespace std;
+
+namespace {
+// number of released frame ids remembered for each channel
+const size_t kReleasedHistorySize = 256;
+}  // namespace
+
+FrameJoinBuffer::FrameJoinBuffer(uint32_t deadline_ms,
+                                 uint32_t max_pending_frames)
+    : deadline_(deadline_ms),
+      max_pending_frames_(max_pending_frames),
+      incomplete_number_(0),
+      late_number_(0) {
+}
+
+void FrameJoinBuffer::SetParams(uint32_t deadline_ms,
+                                uint32_t max_pending_frames) {
+  deadline_ = chrono::milliseconds(deadline_ms);
+  max_pending_frames_ = max_pending_frames;
+}
+
+void FrameJoinBuffer::AddImage(
+    const shared_ptr<VideoDetectionImageParaT>& image_para,
+    vector<JoinedFrame>& frames) {
+  const VideoImageInfoT& video_image_info = image_para->image.video_image_info;
+  list<PendingFrame>::iterator iter = GetPendingFrame(video_image_info,
+                                                      frames);
+  if (iter == pending_.end()) {
+    // results of the frame have been released without image, send it alone
+    ++late_number_;
+    HIAI_ENGINE_LOG("[FrameJoinBuffer] late image, channel: %s, frame: %u",
+                    video_image_info.channel_id.c_str(),
+                    video_image_info.frame_id);
+    JoinedFrame late_frame;
+    late_frame.video_image_info = video_image_info;
+    late_frame.image = image_para;
+    late_frame.cars = make_shared<BatchCarInfoT>();
+    late_frame.cars->video_image_info = video_image_info;
+    late_frame.pedestrians = make_shared<BatchPedestrianInfoT>();
+    late_frame.pedestrians->video_image_info = video_image_info;
+    frames.push_back(late_frame);
+    return;
+  }
+
+  iter->frame.image = image_para;
+  PopIfComplete(iter, frames);
+}
+
+void FrameJoinBuffer::AddCarInfo(
+    const shared_ptr<BatchCarInfoT>& car_info_para,
+    vector<JoinedFrame>& frames) {
+  // classifiers send an empty batch for frames without car
+  if (car_info_para->car_infos.empty()) {
+    return;
+  }
+
+  const VideoImageInfoT& video_image_info = car_info_para->video_image_info;
+  list<PendingFrame>::iterator iter = GetPendingFrame(video_image_info,
+                                                      frames);
+  if (iter == pending_.end()) {
+    late_number_ += car_info_para->car_infos.size();
+    HIAI_ENGINE_LOG("[FrameJoinBuffer] %zu late car results, channel: %s, "
+                    "frame: %u", car_info_para->car_infos.size(),
+                    video_image_info.channel_id.c_str(),
+                    video_image_info.frame_id);
+    JoinedFrame late_frame;
+    late_frame.video_image_info = video_image_info;
+    late_frame.cars = car_info_para;
+    late_frame.pedestrians = make_shared<BatchPedestrianInfoT>();
+    late_frame.pedestrians->video_image_info = video_image_info;
+    frames.push_back(late_frame);
+    return;
+  }
+
+  for (const CarInfoT& car_info : car_info_para->car_infos) {
+    if (car_info.attribute_name == kCarType) {
+      ++iter->car_type_received;
+    } else {
+      ++iter->car_color_received;
+    }
+    iter->frame.cars->car_infos.push_back(car_info);
+  }
+  PopIfComplete(iter, frames);
+}
+
+void FrameJoinBuffer::AddPedestrianInfo(
+    const shared_ptr<BatchPedestrianInfoT>& pedestrian_info_para,
+    vector<JoinedFrame>& frames) {
+  // pedestrian inference sends an empty batch for frames without person
+  if (pedestrian_info_para->pedestrian_info.empty()) {
+    return;
+  }
+
+  const VideoImageInfoT& video_image_info =
+      pedestrian_info_para->video_image_info;
+  list<PendingFrame>::iterator iter = GetPendingFrame(video_image_info,
+                                                      frames);
+  if (iter == pending_.end()) {
+    late_number_ += pedestrian_info_para->pedestrian_info.size();
+    HIAI_ENGINE_LOG("[FrameJoinBuffer] %zu late pedestrian results, "
+                    "channel: %s, frame: %u",
+                    pedestrian_info_para->pedestrian_info.size(),
+                    video_image_info.channel_id.c_str(),
+                    video_image_info.frame_id);
+    JoinedFrame late_frame;
+    late_frame.video_image_info = video_image_info;
+    late_frame.cars = make_shared<BatchCarInfoT>();
+    late_frame.cars->video_image_info = video_image_info;
+    late_frame.pedestrians = pedestrian_info_para;
+    frames.push_back(late_frame);
+    return;
+  }
+
+  iter->pedestrian_received += pedestrian_info_para->pedestrian_info.size();
+  vector<PedestrianInfoT>& pedestrian_info =
+      iter->frame.pedestrians->pedestrian_info;
+  pedestrian_info.insert(pedestrian_info.end(),
+                         pedestrian_info_para->pedestrian_info.begin(),
+                         pedestrian_info_para->pedestrian_info.end());
+  PopIfComplete(iter, frames);
+}
+
+void FrameJoinBuffer::PopExpired(bool flush, vector<JoinedFrame>& frames) {
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  // frames are in arrival order, so the first unexpired one ends the loop
+  while (!pending_.empty()) {
+    if (!flush && now - pending_.front().arrival < deadline_) {
+      break;
+    }
+    Pop(pending_.begin(), frames);
+  }
+}
+
+list<FrameJoinBuffer::PendingFrame>::iterator FrameJoinBuffer::GetPendingFrame(
+    const VideoImageInfoT& video_image_info, vector<JoinedFrame>& frames) {
+  for (list<PendingFrame>::iterator iter = pending_.begin();
+      iter != pending_.end(); ++iter) {
+    const VideoImageInfoT& pending_info = iter->frame.video_image_info;
+    if (pending_info.frame_id == video_image_info.frame_id &&
+        pending_info.channel_id == video_image_info.channel_id) {
+      return iter;
+    }
+  }
+
+  if (IsReleased(video_image_info)) {
+    return pending_.end();
+  }
+
+  // bound the memory, the oldest frame is released with what it has
+  if (pending_.size() >= max_pending_frames_) {
+    HIAI_ENGINE_LOG("[FrameJoinBuffer] %zu frames are pending, release the "
+                    "oldest one", pending_.size());
+    Pop(pending_.begin(), frames);
+  }
+
+  PendingFrame pending;
+  pending.frame.video_image_info = video_image_info;
+  pending.frame.cars = make_shared<BatchCarInfoT>();
+  pending.frame.cars->video_image_info = video_image_info;
+  pending.frame.pedestrians = make_shared<BatchPedestrianInfoT>();
+  pending.frame.pedestrians->video_image_info = video_image_info;
+  pending.car_type_received = 0;
+  pending.car_color_received = 0;
+  pending.pedestrian_received = 0;
+  pending.arrival = chrono::steady_clock::now();
+  pending_.push_back(pending);
+  return --pending_.end();
+}
+
+bool FrameJoinBuffer::IsComplete(const PendingFrame& pending) const {
+  const shared_ptr<VideoDetectionImageParaT>& image = pending.frame.image;
+  return image != nullptr &&
+      pending.car_type_received >= image->car_type_number &&
+      pending.car_color_received >= image->car_color_number &&
+      pending.pedestrian_received >= image->pedestrian_number;
+}
+
+void FrameJoinBuffer::PopIfComplete(list<PendingFrame>::iterator iter,
+                                    vector<JoinedFrame>& frames) {
+  if (IsComplete(*iter)) {
+    Pop(iter, frames);
+  }
+}
+
+void FrameJoinBuffer::Pop(list<PendingFrame>::iterator iter,
+                          vector<JoinedFrame>& frames) {
+  const VideoImageInfoT& video_image_info = iter->frame.video_image_info;
+  if (!IsComplete(*iter)) {
+    ++incomplete_number_;
+    const shared_ptr<VideoDetectionImageParaT>& image = iter->frame.image;
+    if (image == nullptr) {
+      HIAI_ENGINE_LOG("[FrameJoinBuffer] image is missing, channel: %s, "
+                      "frame: %u", video_image_info.channel_id.c_str(),
+                      video_image_info.frame_id);
+    } else {
+      HIAI_ENGINE_LOG("[FrameJoinBuffer] results are missing, channel: %s, "
+                      "frame: %u, car type: %u/%u, car color: %u/%u, "
+                      "pedestrian: %u/%u", video_image_info.channel_id.c_str(),
+                      video_image_info.frame_id, iter->car_type_received,
+                      image->car_type_number, iter->car_color_received,
+                      image->car_color_number, iter->pedestrian_received,
+                      image->pedestrian_number);
+    }
+  }
+
+  deque<uint32_t>& released = released_[video_image_info.channel_id];
+  released.push_back(video_image_info.frame_id);
+  if (released.size() > kReleasedHistorySize) {
+    released.pop_front();
+  }
+
+  frames.push_back(iter->frame);
+  pending_.erase(iter);
+}
+
+bool FrameJoinBuffer::IsReleased(
+    const VideoImageInfoT& video_image_info) const {
+  map<string, deque<uint32_t>>::const_iterator channel =
+      released_.find(video_image_info.channel_id);
+  if (channel == released_.end()) {
+    return false;
+  }
+  for (uint32_t frame_id : channel->second) {
+    if (frame_id == video_image_info.frame_id) {
+      return true;
+    }
+  }
+  return false;
+}
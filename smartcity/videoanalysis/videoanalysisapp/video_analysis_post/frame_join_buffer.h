@@ -0,0 +1,196 @@
+/**
+ * ============================================================================
+ *
+ * Copyright (C) 2018, Hisilicon Technologies Co., Ltd. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1 Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   2 Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ *   3 Neither the names of the copyright holders nor the names of the
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ============================================================================
+ */
+
+#ifndef VIDEO_ANALYSIS_POST_FRAME_JOIN_BUFFER_H_
+#define VIDEO_ANALYSIS_POST_FRAME_JOIN_BUFFER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "video_analysis_params.h"
+
+// results of one frame assembled from all input ports
+struct JoinedFrame {
+  VideoImageInfoT video_image_info;
+  // detection image of the frame, nullptr if it has not arrived
+  std::shared_ptr<VideoDetectionImageParaT> image;
+  // car type and car color results of the frame, never nullptr
+  std::shared_ptr<BatchCarInfoT> cars;
+  // pedestrian results of the frame, never nullptr
+  std::shared_ptr<BatchPedestrianInfoT> pedestrians;
+};
+
+/**
+ * joins the detection image and attribute results of a frame which arrive
+ * on separate ports. A frame is released when the image and as many results
+ * as objects sent to each inference engine have arrived, or when it has
+ * waited longer than the deadline. The number of pending frames is bounded,
+ * the oldest one is released first when the bound is reached.
+ */
+class FrameJoinBuffer {
+ public:
+  /**
+   * @brief constructor
+   * @param [in] deadline_ms: max time a frame waits for missing results
+   * @param [in] max_pending_frames: max number of frames waiting
+   */
+  FrameJoinBuffer(uint32_t deadline_ms, uint32_t max_pending_frames);
+
+  /**
+   * @brief set join params
+   * @param [in] deadline_ms: max time a frame waits for missing results
+   * @param [in] max_pending_frames: max number of frames waiting
+   */
+  void SetParams(uint32_t deadline_ms, uint32_t max_pending_frames);
+
+  /**
+   * @brief add the detection image of a frame
+   * @param [in] image_para: detection image with expected result numbers
+   * @param [out] frames: frames released by this call are appended
+   */
+  void AddImage(const std::shared_ptr<VideoDetectionImageParaT>& image_para,
+                std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief add car type or car color results of a frame
+   * @param [in] car_info_para: results, may be a part of the frame
+   * @param [out] frames: frames released by this call are appended
+   */
+  void AddCarInfo(const std::shared_ptr<BatchCarInfoT>& car_info_para,
+                  std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief add pedestrian results of a frame
+   * @param [in] pedestrian_info_para: results, may be a part of the frame
+   * @param [out] frames: frames released by this call are appended
+   */
+  void AddPedestrianInfo(
+      const std::shared_ptr<BatchPedestrianInfoT>& pedestrian_info_para,
+      std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief release frames which have waited longer than the deadline
+   * @param [in] flush: release all frames regardless of the deadline
+   * @param [out] frames: released frames are appended, in arrival order
+   */
+  void PopExpired(bool flush, std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief number of frames waiting for results
+   */
+  size_t pending_number() const {
+    return pending_.size();
+  }
+
+  /**
+   * @brief number of frames released with missing image or results
+   */
+  uint64_t incomplete_number() const {
+    return incomplete_number_;
+  }
+
+  /**
+   * @brief number of results arrived after their frame was released
+   */
+  uint64_t late_number() const {
+    return late_number_;
+  }
+
+ private:
+  struct PendingFrame {
+    JoinedFrame frame;
+    uint32_t car_type_received;
+    uint32_t car_color_received;
+    uint32_t pedestrian_received;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  /**
+   * @brief find the pending frame of results, create it if not exist
+   * @param [in] video_image_info: frame which the results belong to
+   * @param [out] frames: the oldest frame is appended if the bound is reached
+   * @return pending frame, end of pending_ if the frame has been released
+   */
+  std::list<PendingFrame>::iterator GetPendingFrame(
+      const VideoImageInfoT& video_image_info,
+      std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief whether the image and all results of the frame have arrived
+   * @param [in] pending: pending frame
+   * @return true: complete; false: some parts are missing
+   */
+  bool IsComplete(const PendingFrame& pending) const;
+
+  /**
+   * @brief release the pending frame if all of its results have arrived
+   * @param [in] iter: pending frame
+   * @param [out] frames: frame is appended if it is released
+   */
+  void PopIfComplete(std::list<PendingFrame>::iterator iter,
+                     std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief release a pending frame, missing parts are reported
+   * @param [in] iter: pending frame
+   * @param [out] frames: frame is appended
+   */
+  void Pop(std::list<PendingFrame>::iterator iter,
+           std::vector<JoinedFrame>& frames);
+
+  /**
+   * @brief whether the frame has been released recently
+   * @param [in] video_image_info: frame
+   * @return true: released; false: not released or forgotten
+   */
+  bool IsReleased(const VideoImageInfoT& video_image_info) const;
+
+  std::chrono::milliseconds deadline_;
+  size_t max_pending_frames_;
+  uint64_t incomplete_number_;
+  uint64_t late_number_;
+
+  // pending frames in arrival order, searched linearly as the number is small
+  std::list<PendingFrame> pending_;
+
+  // ids of recently released frames of each channel, used to tell late
+  // results from results of a new frame
+  std::map<std::string, std::deque<uint32_t>> released_;
+};
+
+#endif /* VIDEO_ANALYSIS_POST_FRAME_JOIN_BUFFER_H_ */
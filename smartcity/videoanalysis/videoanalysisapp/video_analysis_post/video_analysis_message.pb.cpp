@@ -62,6 +62,11 @@ class HumanInferenceResultDefaultTypeInternal {
   ::google::protobuf::internal::ExplicitlyConstructed<HumanInferenceResult>
       _instance;
 } _HumanInferenceResult_default_instance_;
+class FrameResultDefaultTypeInternal {
+ public:
+  ::google::protobuf::internal::ExplicitlyConstructed<FrameResult>
+      _instance;
+} _FrameResult_default_instance_;
 }  // namespace video_analysis
 }  // namespace presenter
 }  // namespace ascend
@@ -239,7 +244,32 @@ void InitDefaultsHumanInferenceResult() {
   ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsHumanInferenceResultImpl);
 }
 
-::google::protobuf::Metadata file_level_metadata[8];
+void InitDefaultsFrameResultImpl() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+#ifdef GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  ::google::protobuf::internal::InitProtobufDefaultsForceUnique();
+#else
+  ::google::protobuf::internal::InitProtobufDefaults();
+#endif  // GOOGLE_PROTOBUF_ENFORCE_UNIQUENESS
+  protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsFrameIndex();
+  protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsObject();
+  protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsCarInferenceResult();
+  protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsHumanInferenceResult();
+  {
+    void* ptr = &::ascend::presenter::video_analysis::_FrameResult_default_instance_;
+    new (ptr) ::ascend::presenter::video_analysis::FrameResult();
+    ::google::protobuf::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::ascend::presenter::video_analysis::FrameResult::InitAsDefaultInstance();
+}
+
+void InitDefaultsFrameResult() {
+  static GOOGLE_PROTOBUF_DECLARE_ONCE(once);
+  ::google::protobuf::GoogleOnceInit(&once, &InitDefaultsFrameResultImpl);
+}
+
+::google::protobuf::Metadata file_level_metadata[9];
 const ::google::protobuf::EnumDescriptor* file_level_enum_descriptors[2];
 
 const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
@@ -266,6 +296,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameIndex, channel_id_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameIndex, channel_name_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameIndex, frame_id_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameIndex, frame_number_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::Object, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -274,6 +305,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::Object, id_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::Object, confidence_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::Object, image_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::Object, compact_id_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::ImageSet, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -282,6 +314,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::ImageSet, frame_index_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::ImageSet, frame_image_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::ImageSet, object_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::ImageSet, object_image_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::CarInferenceResult, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -292,6 +325,7 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::CarInferenceResult, type_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::CarInferenceResult, confidence_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::CarInferenceResult, value_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::CarInferenceResult, compact_object_id_),
   ~0u,  // no _has_bits_
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::MapType, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -307,16 +341,30 @@ const ::google::protobuf::uint32 TableStruct::offsets[] GOOGLE_PROTOBUF_ATTRIBUT
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::HumanInferenceResult, frame_index_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::HumanInferenceResult, object_id_),
   GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::HumanInferenceResult, human_property_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::HumanInferenceResult, compact_object_id_),
+  ~0u,  // no _has_bits_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, frame_index_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, frame_image_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, object_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, object_image_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, car_result_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, human_result_),
+  GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(::ascend::presenter::video_analysis::FrameResult, ack_required_),
 };
 static const ::google::protobuf::internal::MigrationSchema schemas[] GOOGLE_PROTOBUF_ATTRIBUTE_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::ascend::presenter::video_analysis::RegisterApp)},
   { 7, -1, sizeof(::ascend::presenter::video_analysis::CommonResponse)},
   { 14, -1, sizeof(::ascend::presenter::video_analysis::FrameIndex)},
-  { 23, -1, sizeof(::ascend::presenter::video_analysis::Object)},
-  { 31, -1, sizeof(::ascend::presenter::video_analysis::ImageSet)},
-  { 39, -1, sizeof(::ascend::presenter::video_analysis::CarInferenceResult)},
-  { 49, -1, sizeof(::ascend::presenter::video_analysis::MapType)},
-  { 56, -1, sizeof(::ascend::presenter::video_analysis::HumanInferenceResult)},
+  { 24, -1, sizeof(::ascend::presenter::video_analysis::Object)},
+  { 33, -1, sizeof(::ascend::presenter::video_analysis::ImageSet)},
+  { 42, -1, sizeof(::ascend::presenter::video_analysis::CarInferenceResult)},
+  { 53, -1, sizeof(::ascend::presenter::video_analysis::MapType)},
+  { 60, -1, sizeof(::ascend::presenter::video_analysis::HumanInferenceResult)},
+  { 69, -1, sizeof(::ascend::presenter::video_analysis::FrameResult)},
 };
 
 static ::google::protobuf::Message const * const file_default_instances[] = {
@@ -328,6 +376,7 @@ static ::google::protobuf::Message const * const file_default_instances[] = {
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::video_analysis::_CarInferenceResult_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::video_analysis::_MapType_default_instance_),
   reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::video_analysis::_HumanInferenceResult_default_instance_),
+  reinterpret_cast<const ::google::protobuf::Message*>(&::ascend::presenter::video_analysis::_FrameResult_default_instance_),
 };
 
 void protobuf_AssignDescriptors() {
@@ -346,7 +395,7 @@ void protobuf_AssignDescriptorsOnce() {
 void protobuf_RegisterTypes(const ::std::string&) GOOGLE_PROTOBUF_ATTRIBUTE_COLD;
 void protobuf_RegisterTypes(const ::std::string&) {
   protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 8);
+  ::google::protobuf::internal::RegisterAllTypes(file_level_metadata, 9);
 }
 
 void AddDescriptorsImpl() {
@@ -356,36 +405,47 @@ void AddDescriptorsImpl() {
       "resenter.video_analysis\"\'\n\013RegisterApp\022\n"
       "\n\002id\030\001 \001(\t\022\014\n\004type\030\002 \001(\t\"Z\n\016CommonRespon"
       "se\0227\n\003ret\030\001 \001(\0162*.ascend.presenter.video"
-      "_analysis.ErrorCode\022\017\n\007message\030\002 \001(\t\"X\n\n"
+      "_analysis.ErrorCode\022\017\n\007message\030\002 \001(\t\"n\n\n"
       "FrameIndex\022\016\n\006app_id\030\001 \001(\t\022\022\n\nchannel_id"
       "\030\002 \001(\t\022\024\n\014channel_name\030\003 \001(\t\022\020\n\010frame_id"
-      "\030\004 \001(\t\"7\n\006Object\022\n\n\002id\030\001 \001(\t\022\022\n\nconfiden"
-      "ce\030\002 \001(\002\022\r\n\005image\030\003 \001(\014\"\232\001\n\010ImageSet\022@\n\013"
-      "frame_index\030\001 \001(\0132+.ascend.presenter.vid"
-      "eo_analysis.FrameIndex\022\023\n\013frame_image\030\002 "
-      "\001(\014\0227\n\006object\030\003 \003(\0132\'.ascend.presenter.v"
-      "ideo_analysis.Object\"\315\001\n\022CarInferenceRes"
-      "ult\022@\n\013frame_index\030\001 \001(\0132+.ascend.presen"
-      "ter.video_analysis.FrameIndex\022\021\n\tobject_"
-      "id\030\002 \001(\t\022\?\n\004type\030\003 \001(\01621.ascend.presente"
-      "r.video_analysis.CarInferenceType\022\022\n\ncon"
-      "fidence\030\004 \001(\002\022\r\n\005value\030\005 \001(\t\"%\n\007MapType\022"
-      "\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\002\"\255\001\n\024HumanInf"
-      "erenceResult\022@\n\013frame_index\030\001 \001(\0132+.asce"
-      "nd.presenter.video_analysis.FrameIndex\022\021"
-      "\n\tobject_id\030\002 \001(\t\022@\n\016human_property\030\003 \003("
-      "\0132(.ascend.presenter.video_analysis.MapT"
-      "ype*\337\001\n\tErrorCode\022\016\n\nkErrorNone\020\000\022\032\n\026kEr"
-      "rorAppRegisterExist\020\001\022\036\n\032kErrorAppRegist"
-      "erNoStorage\020\002\022\031\n\025kErrorAppRegisterType\020\003"
-      "\022\032\n\026kErrorAppRegisterLimit\020\004\022\023\n\017kErrorAp"
-      "pDelete\020\005\022\021\n\rkErrorAppLost\020\006\022\026\n\022kErrorSt"
-      "orageLimit\020\007\022\017\n\013kErrorOther\020\010*0\n\020CarInfe"
-      "renceType\022\r\n\tkCarColor\020\000\022\r\n\tkCarBrand\020\001b"
-      "\006proto3"
+      "\030\004 \001(\t\022\024\n\014frame_number\030\005 \001(\r\"K\n\006Object\022\n"
+      "\n\002id\030\001 \001(\t\022\022\n\nconfidence\030\002 \001(\002\022\r\n\005image\030"
+      "\003 \001(\014\022\022\n\ncompact_id\030\004 \001(\r\"\260\001\n\010ImageSet\022@"
+      "\n\013frame_index\030\001 \001(\0132+.ascend.presenter.v"
+      "ideo_analysis.FrameIndex\022\023\n\013frame_image\030"
+      "\002 \001(\014\0227\n\006object\030\003 \003(\0132\'.ascend.presenter"
+      ".video_analysis.Object\022\024\n\014object_image\030\004"
+      " \003(\014\"\350\001\n\022CarInferenceResult\022@\n\013frame_ind"
+      "ex\030\001 \001(\0132+.ascend.presenter.video_analys"
+      "is.FrameIndex\022\021\n\tobject_id\030\002 \001(\t\022\?\n\004type"
+      "\030\003 \001(\01621.ascend.presenter.video_analysis"
+      ".CarInferenceType\022\022\n\nconfidence\030\004 \001(\002\022\r\n"
+      "\005value\030\005 \001(\t\022\031\n\021compact_object_id\030\006 \001(\r\""
+      "%\n\007MapType\022\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\002\"\310"
+      "\001\n\024HumanInferenceResult\022@\n\013frame_index\030\001"
+      " \001(\0132+.ascend.presenter.video_analysis.F"
+      "rameIndex\022\021\n\tobject_id\030\002 \001(\t\022@\n\016human_pr"
+      "operty\030\003 \003(\0132(.ascend.presenter.video_an"
+      "alysis.MapType\022\031\n\021compact_object_id\030\004 \001("
+      "\r\"\337\002\n\013FrameResult\022@\n\013frame_index\030\001 \001(\0132+"
+      ".ascend.presenter.video_analysis.FrameIn"
+      "dex\022\023\n\013frame_image\030\002 \001(\014\0227\n\006object\030\003 \003(\013"
+      "2\'.ascend.presenter.video_analysis.Objec"
+      "t\022\024\n\014object_image\030\004 \003(\014\022G\n\ncar_result\030\005 "
+      "\003(\01323.ascend.presenter.video_analysis.Ca"
+      "rInferenceResult\022K\n\014human_result\030\006 \003(\01325"
+      ".ascend.presenter.video_analysis.HumanIn"
+      "ferenceResult\022\024\n\014ack_required\030\007 \001(\010*\337\001\n\t"
+      "ErrorCode\022\016\n\nkErrorNone\020\000\022\032\n\026kErrorAppRe"
+      "gisterExist\020\001\022\036\n\032kErrorAppRegisterNoStor"
+      "age\020\002\022\031\n\025kErrorAppRegisterType\020\003\022\032\n\026kErr"
+      "orAppRegisterLimit\020\004\022\023\n\017kErrorAppDelete\020"
+      "\005\022\021\n\rkErrorAppLost\020\006\022\026\n\022kErrorStorageLim"
+      "it\020\007\022\017\n\013kErrorOther\020\010*0\n\020CarInferenceTyp"
+      "e\022\r\n\tkCarColor\020\000\022\r\n\tkCarBrand\020\001b\006proto3"
   };
   ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-      descriptor, 1207);
+      descriptor, 1679);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "video_analysis_message.proto", &protobuf_RegisterTypes);
 }
@@ -1059,6 +1119,7 @@ const int FrameIndex::kAppIdFieldNumber;
 const int FrameIndex::kChannelIdFieldNumber;
 const int FrameIndex::kChannelNameFieldNumber;
 const int FrameIndex::kFrameIdFieldNumber;
+const int FrameIndex::kFrameNumberFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 FrameIndex::FrameIndex()
@@ -1090,6 +1151,7 @@ FrameIndex::FrameIndex(const FrameIndex& from)
   if (from.frame_id().size() > 0) {
     frame_id_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.frame_id_);
   }
+  frame_number_ = from.frame_number_;
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.video_analysis.FrameIndex)
 }
 
@@ -1098,6 +1160,7 @@ void FrameIndex::SharedCtor() {
   channel_id_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   channel_name_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   frame_id_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  frame_number_ = 0u;
   _cached_size_ = 0;
 }
 
@@ -1146,6 +1209,7 @@ void FrameIndex::Clear() {
   channel_id_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   channel_name_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   frame_id_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  frame_number_ = 0u;
   _internal_metadata_.Clear();
 }
 
@@ -1223,6 +1287,20 @@ bool FrameIndex::MergePartialFromCodedStream(
         break;
       }
 
+      // uint32 frame_number = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(40u /* 40 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &frame_number_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -1289,6 +1367,11 @@ void FrameIndex::SerializeWithCachedSizes(
       4, this->frame_id(), output);
   }
 
+  // uint32 frame_number = 5;
+  if (this->frame_number() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(5, this->frame_number(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -1347,6 +1430,11 @@ void FrameIndex::SerializeWithCachedSizes(
         4, this->frame_id(), target);
   }
 
+  // uint32 frame_number = 5;
+  if (this->frame_number() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(5, this->frame_number(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -1392,6 +1480,13 @@ size_t FrameIndex::ByteSizeLong() const {
         this->frame_id());
   }
 
+  // uint32 frame_number = 5;
+  if (this->frame_number() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->frame_number());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -1437,6 +1532,9 @@ void FrameIndex::MergeFrom(const FrameIndex& from) {
 
     frame_id_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.frame_id_);
   }
+  if (from.frame_number() != 0) {
+    set_frame_number(from.frame_number());
+  }
 }
 
 void FrameIndex::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1467,6 +1565,7 @@ void FrameIndex::InternalSwap(FrameIndex* other) {
   channel_id_.Swap(&other->channel_id_);
   channel_name_.Swap(&other->channel_name_);
   frame_id_.Swap(&other->frame_id_);
+  swap(frame_number_, other->frame_number_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -1485,6 +1584,7 @@ void Object::InitAsDefaultInstance() {
 const int Object::kIdFieldNumber;
 const int Object::kConfidenceFieldNumber;
 const int Object::kImageFieldNumber;
+const int Object::kCompactIdFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 Object::Object()
@@ -1508,14 +1608,18 @@ Object::Object(const Object& from)
   if (from.image().size() > 0) {
     image_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.image_);
   }
-  confidence_ = from.confidence_;
+  ::memcpy(&confidence_, &from.confidence_,
+    static_cast<size_t>(reinterpret_cast<char*>(&compact_id_) -
+    reinterpret_cast<char*>(&confidence_)) + sizeof(compact_id_));
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.video_analysis.Object)
 }
 
 void Object::SharedCtor() {
   id_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   image_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  confidence_ = 0;
+  ::memset(&confidence_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compact_id_) -
+      reinterpret_cast<char*>(&confidence_)) + sizeof(compact_id_));
   _cached_size_ = 0;
 }
 
@@ -1560,7 +1664,9 @@ void Object::Clear() {
 
   id_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   image_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  confidence_ = 0;
+  ::memset(&confidence_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compact_id_) -
+      reinterpret_cast<char*>(&confidence_)) + sizeof(compact_id_));
   _internal_metadata_.Clear();
 }
 
@@ -1616,6 +1722,20 @@ bool Object::MergePartialFromCodedStream(
         break;
       }
 
+      // uint32 compact_id = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &compact_id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -1663,6 +1783,11 @@ void Object::SerializeWithCachedSizes(
       3, this->image(), output);
   }
 
+  // uint32 compact_id = 4;
+  if (this->compact_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->compact_id(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -1700,6 +1825,11 @@ void Object::SerializeWithCachedSizes(
         3, this->image(), target);
   }
 
+  // uint32 compact_id = 4;
+  if (this->compact_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->compact_id(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -1736,6 +1866,13 @@ size_t Object::ByteSizeLong() const {
     total_size += 1 + 4;
   }
 
+  // uint32 compact_id = 4;
+  if (this->compact_id() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->compact_id());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -1776,6 +1913,9 @@ void Object::MergeFrom(const Object& from) {
   if (from.confidence() != 0) {
     set_confidence(from.confidence());
   }
+  if (from.compact_id() != 0) {
+    set_compact_id(from.compact_id());
+  }
 }
 
 void Object::CopyFrom(const ::google::protobuf::Message& from) {
@@ -1805,6 +1945,7 @@ void Object::InternalSwap(Object* other) {
   id_.Swap(&other->id_);
   image_.Swap(&other->image_);
   swap(confidence_, other->confidence_);
+  swap(compact_id_, other->compact_id_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -1825,6 +1966,7 @@ void ImageSet::InitAsDefaultInstance() {
 const int ImageSet::kFrameIndexFieldNumber;
 const int ImageSet::kFrameImageFieldNumber;
 const int ImageSet::kObjectFieldNumber;
+const int ImageSet::kObjectImageFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 ImageSet::ImageSet()
@@ -1839,6 +1981,7 @@ ImageSet::ImageSet(const ImageSet& from)
   : ::google::protobuf::Message(),
       _internal_metadata_(NULL),
       object_(from.object_),
+      object_image_(from.object_image_),
       _cached_size_(0) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
   frame_image_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
@@ -1899,6 +2042,7 @@ void ImageSet::Clear() {
   (void) cached_has_bits;
 
   object_.Clear();
+  object_image_.Clear();
   frame_image_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   if (GetArenaNoVirtual() == NULL && frame_index_ != NULL) {
     delete frame_index_;
@@ -1952,6 +2096,18 @@ bool ImageSet::MergePartialFromCodedStream(
         break;
       }
 
+      // repeated bytes object_image = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(34u /* 34 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_object_image()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -1997,6 +2153,12 @@ void ImageSet::SerializeWithCachedSizes(
       3, this->object(static_cast<int>(i)), output);
   }
 
+  // repeated bytes object_image = 4;
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      4, this->object_image(i), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -2033,6 +2195,12 @@ void ImageSet::SerializeWithCachedSizes(
         3, this->object(static_cast<int>(i)), deterministic, target);
   }
 
+  // repeated bytes object_image = 4;
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(4, this->object_image(i), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -2061,6 +2229,14 @@ size_t ImageSet::ByteSizeLong() const {
     }
   }
 
+  // repeated bytes object_image = 4;
+  total_size += 1 *
+      ::google::protobuf::internal::FromIntSize(this->object_image_size());
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->object_image(i));
+  }
+
   // bytes frame_image = 2;
   if (this->frame_image().size() > 0) {
     total_size += 1 +
@@ -2105,6 +2281,7 @@ void ImageSet::MergeFrom(const ImageSet& from) {
   (void) cached_has_bits;
 
   object_.MergeFrom(from.object_);
+  object_image_.MergeFrom(from.object_image_);
   if (from.frame_image().size() > 0) {
 
     frame_image_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.frame_image_);
@@ -2139,6 +2316,7 @@ void ImageSet::Swap(ImageSet* other) {
 void ImageSet::InternalSwap(ImageSet* other) {
   using std::swap;
   object_.InternalSwap(&other->object_);
+  object_image_.InternalSwap(&other->object_image_);
   frame_image_.Swap(&other->frame_image_);
   swap(frame_index_, other->frame_index_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
@@ -2163,6 +2341,7 @@ const int CarInferenceResult::kObjectIdFieldNumber;
 const int CarInferenceResult::kTypeFieldNumber;
 const int CarInferenceResult::kConfidenceFieldNumber;
 const int CarInferenceResult::kValueFieldNumber;
+const int CarInferenceResult::kCompactObjectIdFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 CarInferenceResult::CarInferenceResult()
@@ -2192,8 +2371,8 @@ CarInferenceResult::CarInferenceResult(const CarInferenceResult& from)
     frame_index_ = NULL;
   }
   ::memcpy(&type_, &from.type_,
-    static_cast<size_t>(reinterpret_cast<char*>(&confidence_) -
-    reinterpret_cast<char*>(&type_)) + sizeof(confidence_));
+    static_cast<size_t>(reinterpret_cast<char*>(&compact_object_id_) -
+    reinterpret_cast<char*>(&type_)) + sizeof(compact_object_id_));
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.video_analysis.CarInferenceResult)
 }
 
@@ -2201,8 +2380,8 @@ void CarInferenceResult::SharedCtor() {
   object_id_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   value_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   ::memset(&frame_index_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&confidence_) -
-      reinterpret_cast<char*>(&frame_index_)) + sizeof(confidence_));
+      reinterpret_cast<char*>(&compact_object_id_) -
+      reinterpret_cast<char*>(&frame_index_)) + sizeof(compact_object_id_));
   _cached_size_ = 0;
 }
 
@@ -2253,8 +2432,8 @@ void CarInferenceResult::Clear() {
   }
   frame_index_ = NULL;
   ::memset(&type_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&confidence_) -
-      reinterpret_cast<char*>(&type_)) + sizeof(confidence_));
+      reinterpret_cast<char*>(&compact_object_id_) -
+      reinterpret_cast<char*>(&type_)) + sizeof(compact_object_id_));
   _internal_metadata_.Clear();
 }
 
@@ -2341,6 +2520,20 @@ bool CarInferenceResult::MergePartialFromCodedStream(
         break;
       }
 
+      // uint32 compact_object_id = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(48u /* 48 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &compact_object_id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -2404,6 +2597,11 @@ void CarInferenceResult::SerializeWithCachedSizes(
       5, this->value(), output);
   }
 
+  // uint32 compact_object_id = 6;
+  if (this->compact_object_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(6, this->compact_object_id(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -2458,6 +2656,11 @@ void CarInferenceResult::SerializeWithCachedSizes(
         5, this->value(), target);
   }
 
+  // uint32 compact_object_id = 6;
+  if (this->compact_object_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(6, this->compact_object_id(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -2507,6 +2710,13 @@ size_t CarInferenceResult::ByteSizeLong() const {
     total_size += 1 + 4;
   }
 
+  // uint32 compact_object_id = 6;
+  if (this->compact_object_id() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->compact_object_id());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -2553,6 +2763,9 @@ void CarInferenceResult::MergeFrom(const CarInferenceResult& from) {
   if (from.confidence() != 0) {
     set_confidence(from.confidence());
   }
+  if (from.compact_object_id() != 0) {
+    set_compact_object_id(from.compact_object_id());
+  }
 }
 
 void CarInferenceResult::CopyFrom(const ::google::protobuf::Message& from) {
@@ -2584,6 +2797,7 @@ void CarInferenceResult::InternalSwap(CarInferenceResult* other) {
   swap(frame_index_, other->frame_index_);
   swap(type_, other->type_);
   swap(confidence_, other->confidence_);
+  swap(compact_object_id_, other->compact_object_id_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -2897,6 +3111,7 @@ void HumanInferenceResult::InitAsDefaultInstance() {
 const int HumanInferenceResult::kFrameIndexFieldNumber;
 const int HumanInferenceResult::kObjectIdFieldNumber;
 const int HumanInferenceResult::kHumanPropertyFieldNumber;
+const int HumanInferenceResult::kCompactObjectIdFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
 HumanInferenceResult::HumanInferenceResult()
@@ -2922,12 +3137,15 @@ HumanInferenceResult::HumanInferenceResult(const HumanInferenceResult& from)
   } else {
     frame_index_ = NULL;
   }
+  compact_object_id_ = from.compact_object_id_;
   // @@protoc_insertion_point(copy_constructor:ascend.presenter.video_analysis.HumanInferenceResult)
 }
 
 void HumanInferenceResult::SharedCtor() {
   object_id_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  frame_index_ = NULL;
+  ::memset(&frame_index_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&compact_object_id_) -
+      reinterpret_cast<char*>(&frame_index_)) + sizeof(compact_object_id_));
   _cached_size_ = 0;
 }
 
@@ -2976,6 +3194,7 @@ void HumanInferenceResult::Clear() {
     delete frame_index_;
   }
   frame_index_ = NULL;
+  compact_object_id_ = 0u;
   _internal_metadata_.Clear();
 }
 
@@ -3028,6 +3247,20 @@ bool HumanInferenceResult::MergePartialFromCodedStream(
         break;
       }
 
+      // uint32 compact_object_id = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(32u /* 32 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::uint32, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32>(
+                 input, &compact_object_id_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -3077,6 +3310,11 @@ void HumanInferenceResult::SerializeWithCachedSizes(
       3, this->human_property(static_cast<int>(i)), output);
   }
 
+  // uint32 compact_object_id = 4;
+  if (this->compact_object_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteUInt32(4, this->compact_object_id(), output);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
@@ -3117,6 +3355,11 @@ void HumanInferenceResult::SerializeWithCachedSizes(
         3, this->human_property(static_cast<int>(i)), deterministic, target);
   }
 
+  // uint32 compact_object_id = 4;
+  if (this->compact_object_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteUInt32ToArray(4, this->compact_object_id(), target);
+  }
+
   if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
     target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
         (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
@@ -3159,6 +3402,13 @@ size_t HumanInferenceResult::ByteSizeLong() const {
         *this->frame_index_);
   }
 
+  // uint32 compact_object_id = 4;
+  if (this->compact_object_id() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::UInt32Size(
+        this->compact_object_id());
+  }
+
   int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = cached_size;
@@ -3196,6 +3446,9 @@ void HumanInferenceResult::MergeFrom(const HumanInferenceResult& from) {
   if (from.has_frame_index()) {
     mutable_frame_index()->::ascend::presenter::video_analysis::FrameIndex::MergeFrom(from.frame_index());
   }
+  if (from.compact_object_id() != 0) {
+    set_compact_object_id(from.compact_object_id());
+  }
 }
 
 void HumanInferenceResult::CopyFrom(const ::google::protobuf::Message& from) {
@@ -3225,6 +3478,7 @@ void HumanInferenceResult::InternalSwap(HumanInferenceResult* other) {
   human_property_.InternalSwap(&other->human_property_);
   object_id_.Swap(&other->object_id_);
   swap(frame_index_, other->frame_index_);
+  swap(compact_object_id_, other->compact_object_id_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   swap(_cached_size_, other->_cached_size_);
 }
@@ -3235,6 +3489,501 @@ void HumanInferenceResult::InternalSwap(HumanInferenceResult* other) {
 }
 
 
+// ===================================================================
+
+void FrameResult::InitAsDefaultInstance() {
+  ::ascend::presenter::video_analysis::_FrameResult_default_instance_._instance.get_mutable()->frame_index_ = const_cast< ::ascend::presenter::video_analysis::FrameIndex*>(
+      ::ascend::presenter::video_analysis::FrameIndex::internal_default_instance());
+}
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int FrameResult::kFrameIndexFieldNumber;
+const int FrameResult::kFrameImageFieldNumber;
+const int FrameResult::kObjectFieldNumber;
+const int FrameResult::kObjectImageFieldNumber;
+const int FrameResult::kCarResultFieldNumber;
+const int FrameResult::kHumanResultFieldNumber;
+const int FrameResult::kAckRequiredFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+FrameResult::FrameResult()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  if (GOOGLE_PREDICT_TRUE(this != internal_default_instance())) {
+    ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsFrameResult();
+  }
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:ascend.presenter.video_analysis.FrameResult)
+}
+FrameResult::FrameResult(const FrameResult& from)
+  : ::google::protobuf::Message(),
+      _internal_metadata_(NULL),
+      object_(from.object_),
+      object_image_(from.object_image_),
+      car_result_(from.car_result_),
+      human_result_(from.human_result_),
+      _cached_size_(0) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  frame_image_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (from.frame_image().size() > 0) {
+    frame_image_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.frame_image_);
+  }
+  if (from.has_frame_index()) {
+    frame_index_ = new ::ascend::presenter::video_analysis::FrameIndex(*from.frame_index_);
+  } else {
+    frame_index_ = NULL;
+  }
+  ack_required_ = from.ack_required_;
+  // @@protoc_insertion_point(copy_constructor:ascend.presenter.video_analysis.FrameResult)
+}
+
+void FrameResult::SharedCtor() {
+  frame_image_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ::memset(&frame_index_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&ack_required_) -
+      reinterpret_cast<char*>(&frame_index_)) + sizeof(ack_required_));
+  _cached_size_ = 0;
+}
+
+FrameResult::~FrameResult() {
+  // @@protoc_insertion_point(destructor:ascend.presenter.video_analysis.FrameResult)
+  SharedDtor();
+}
+
+void FrameResult::SharedDtor() {
+  frame_image_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != internal_default_instance()) delete frame_index_;
+}
+
+void FrameResult::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* FrameResult::descriptor() {
+  ::protobuf_video_5fanalysis_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_video_5fanalysis_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages].descriptor;
+}
+
+const FrameResult& FrameResult::default_instance() {
+  ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsFrameResult();
+  return *internal_default_instance();
+}
+
+FrameResult* FrameResult::New(::google::protobuf::Arena* arena) const {
+  FrameResult* n = new FrameResult;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void FrameResult::Clear() {
+// @@protoc_insertion_point(message_clear_start:ascend.presenter.video_analysis.FrameResult)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  object_.Clear();
+  object_image_.Clear();
+  car_result_.Clear();
+  human_result_.Clear();
+  frame_image_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (GetArenaNoVirtual() == NULL && frame_index_ != NULL) {
+    delete frame_index_;
+  }
+  frame_index_ = NULL;
+  ack_required_ = false;
+  _internal_metadata_.Clear();
+}
+
+bool FrameResult::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:ascend.presenter.video_analysis.FrameResult)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoffNoLastTag(127u);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+      case 1: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(10u /* 10 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(
+               input, mutable_frame_index()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bytes frame_image = 2;
+      case 2: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(18u /* 18 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_frame_image()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .ascend.presenter.video_analysis.Object object = 3;
+      case 3: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(26u /* 26 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_object()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated bytes object_image = 4;
+      case 4: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(34u /* 34 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_object_image()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+      case 5: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(42u /* 42 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_car_result()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+      case 6: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(50u /* 50 & 0xFF */)) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessage(input, add_human_result()));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      // bool ack_required = 7;
+      case 7: {
+        if (static_cast< ::google::protobuf::uint8>(tag) ==
+            static_cast< ::google::protobuf::uint8>(56u /* 56 & 0xFF */)) {
+
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &ack_required_)));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormat::SkipField(
+              input, tag, _internal_metadata_.mutable_unknown_fields()));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:ascend.presenter.video_analysis.FrameResult)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:ascend.presenter.video_analysis.FrameResult)
+  return false;
+#undef DO_
+}
+
+void FrameResult::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:ascend.presenter.video_analysis.FrameResult)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+  if (this->has_frame_index()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, *this->frame_index_, output);
+  }
+
+  // bytes frame_image = 2;
+  if (this->frame_image().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      2, this->frame_image(), output);
+  }
+
+  // repeated .ascend.presenter.video_analysis.Object object = 3;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->object_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      3, this->object(static_cast<int>(i)), output);
+  }
+
+  // repeated bytes object_image = 4;
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      4, this->object_image(i), output);
+  }
+
+  // repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->car_result_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      5, this->car_result(static_cast<int>(i)), output);
+  }
+
+  // repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->human_result_size()); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      6, this->human_result(static_cast<int>(i)), output);
+  }
+
+  // bool ack_required = 7;
+  if (this->ack_required() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(7, this->ack_required(), output);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), output);
+  }
+  // @@protoc_insertion_point(serialize_end:ascend.presenter.video_analysis.FrameResult)
+}
+
+::google::protobuf::uint8* FrameResult::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  (void)deterministic; // Unused
+  // @@protoc_insertion_point(serialize_to_array_start:ascend.presenter.video_analysis.FrameResult)
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+  if (this->has_frame_index()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        1, *this->frame_index_, deterministic, target);
+  }
+
+  // bytes frame_image = 2;
+  if (this->frame_image().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        2, this->frame_image(), target);
+  }
+
+  // repeated .ascend.presenter.video_analysis.Object object = 3;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->object_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        3, this->object(static_cast<int>(i)), deterministic, target);
+  }
+
+  // repeated bytes object_image = 4;
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(4, this->object_image(i), target);
+  }
+
+  // repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->car_result_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        5, this->car_result(static_cast<int>(i)), deterministic, target);
+  }
+
+  // repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->human_result_size()); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageToArray(
+        6, this->human_result(static_cast<int>(i)), deterministic, target);
+  }
+
+  // bool ack_required = 7;
+  if (this->ack_required() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(7, this->ack_required(), target);
+  }
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()), target);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:ascend.presenter.video_analysis.FrameResult)
+  return target;
+}
+
+size_t FrameResult::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:ascend.presenter.video_analysis.FrameResult)
+  size_t total_size = 0;
+
+  if ((_internal_metadata_.have_unknown_fields() &&  ::google::protobuf::internal::GetProto3PreserveUnknownsDefault())) {
+    total_size +=
+      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
+        (::google::protobuf::internal::GetProto3PreserveUnknownsDefault()   ? _internal_metadata_.unknown_fields()   : _internal_metadata_.default_instance()));
+  }
+  // repeated .ascend.presenter.video_analysis.Object object = 3;
+  {
+    unsigned int count = static_cast<unsigned int>(this->object_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->object(static_cast<int>(i)));
+    }
+  }
+
+  // repeated bytes object_image = 4;
+  total_size += 1 *
+      ::google::protobuf::internal::FromIntSize(this->object_image_size());
+  for (int i = 0, n = this->object_image_size(); i < n; i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->object_image(i));
+  }
+
+  // repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+  {
+    unsigned int count = static_cast<unsigned int>(this->car_result_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->car_result(static_cast<int>(i)));
+    }
+  }
+
+  // repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+  {
+    unsigned int count = static_cast<unsigned int>(this->human_result_size());
+    total_size += 1UL * count;
+    for (unsigned int i = 0; i < count; i++) {
+      total_size +=
+        ::google::protobuf::internal::WireFormatLite::MessageSize(
+          this->human_result(static_cast<int>(i)));
+    }
+  }
+
+  // bytes frame_image = 2;
+  if (this->frame_image().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->frame_image());
+  }
+
+  // .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+  if (this->has_frame_index()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSize(
+        *this->frame_index_);
+  }
+
+  // bool ack_required = 7;
+  if (this->ack_required() != 0) {
+    total_size += 1 + 1;
+  }
+
+  int cached_size = ::google::protobuf::internal::ToCachedSize(total_size);
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = cached_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void FrameResult::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:ascend.presenter.video_analysis.FrameResult)
+  GOOGLE_DCHECK_NE(&from, this);
+  const FrameResult* source =
+      ::google::protobuf::internal::DynamicCastToGenerated<const FrameResult>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:ascend.presenter.video_analysis.FrameResult)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:ascend.presenter.video_analysis.FrameResult)
+    MergeFrom(*source);
+  }
+}
+
+void FrameResult::MergeFrom(const FrameResult& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:ascend.presenter.video_analysis.FrameResult)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::google::protobuf::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  object_.MergeFrom(from.object_);
+  object_image_.MergeFrom(from.object_image_);
+  car_result_.MergeFrom(from.car_result_);
+  human_result_.MergeFrom(from.human_result_);
+  if (from.frame_image().size() > 0) {
+
+    frame_image_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.frame_image_);
+  }
+  if (from.has_frame_index()) {
+    mutable_frame_index()->::ascend::presenter::video_analysis::FrameIndex::MergeFrom(from.frame_index());
+  }
+  if (from.ack_required() != 0) {
+    set_ack_required(from.ack_required());
+  }
+}
+
+void FrameResult::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:ascend.presenter.video_analysis.FrameResult)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void FrameResult::CopyFrom(const FrameResult& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:ascend.presenter.video_analysis.FrameResult)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool FrameResult::IsInitialized() const {
+  return true;
+}
+
+void FrameResult::Swap(FrameResult* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void FrameResult::InternalSwap(FrameResult* other) {
+  using std::swap;
+  object_.InternalSwap(&other->object_);
+  object_image_.InternalSwap(&other->object_image_);
+  car_result_.InternalSwap(&other->car_result_);
+  human_result_.InternalSwap(&other->human_result_);
+  frame_image_.Swap(&other->frame_image_);
+  swap(frame_index_, other->frame_index_);
+  swap(ack_required_, other->ack_required_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata FrameResult::GetMetadata() const {
+  protobuf_video_5fanalysis_5fmessage_2eproto::protobuf_AssignDescriptorsOnce();
+  return ::protobuf_video_5fanalysis_5fmessage_2eproto::file_level_metadata[kIndexInFileMessages];
+}
+
+
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace video_analysis
 }  // namespace presenter
@@ -37,7 +37,7 @@ namespace protobuf_video_5fanalysis_5fmessage_2eproto {
 struct TableStruct {
   static const ::google::protobuf::internal::ParseTableField entries[];
   static const ::google::protobuf::internal::AuxillaryParseTableField aux[];
-  static const ::google::protobuf::internal::ParseTable schema[8];
+  static const ::google::protobuf::internal::ParseTable schema[9];
   static const ::google::protobuf::internal::FieldMetadata field_metadata[];
   static const ::google::protobuf::internal::SerializationTable serialization_table[];
   static const ::google::protobuf::uint32 offsets[];
@@ -59,6 +59,8 @@ void InitDefaultsMapTypeImpl();
 void InitDefaultsMapType();
 void InitDefaultsHumanInferenceResultImpl();
 void InitDefaultsHumanInferenceResult();
+void InitDefaultsFrameResultImpl();
+void InitDefaultsFrameResult();
 inline void InitDefaults() {
   InitDefaultsRegisterApp();
   InitDefaultsCommonResponse();
@@ -68,6 +70,7 @@ inline void InitDefaults() {
   InitDefaultsCarInferenceResult();
   InitDefaultsMapType();
   InitDefaultsHumanInferenceResult();
+  InitDefaultsFrameResult();
 }
 }  // namespace protobuf_video_5fanalysis_5fmessage_2eproto
 namespace ascend {
@@ -82,6 +85,9 @@ extern CommonResponseDefaultTypeInternal _CommonResponse_default_instance_;
 class FrameIndex;
 class FrameIndexDefaultTypeInternal;
 extern FrameIndexDefaultTypeInternal _FrameIndex_default_instance_;
+class FrameResult;
+class FrameResultDefaultTypeInternal;
+extern FrameResultDefaultTypeInternal _FrameResult_default_instance_;
 class HumanInferenceResult;
 class HumanInferenceResultDefaultTypeInternal;
 extern HumanInferenceResultDefaultTypeInternal _HumanInferenceResult_default_instance_;
@@ -529,6 +535,12 @@ class FrameIndex : public ::google::protobuf::Message /* @@protoc_insertion_poin
   ::std::string* release_frame_id();
   void set_allocated_frame_id(::std::string* frame_id);
 
+  // uint32 frame_number = 5;
+  void clear_frame_number();
+  static const int kFrameNumberFieldNumber = 5;
+  ::google::protobuf::uint32 frame_number() const;
+  void set_frame_number(::google::protobuf::uint32 value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.FrameIndex)
  private:
 
@@ -537,6 +549,7 @@ class FrameIndex : public ::google::protobuf::Message /* @@protoc_insertion_poin
   ::google::protobuf::internal::ArenaStringPtr channel_id_;
   ::google::protobuf::internal::ArenaStringPtr channel_name_;
   ::google::protobuf::internal::ArenaStringPtr frame_id_;
+  ::google::protobuf::uint32 frame_number_;
   mutable int _cached_size_;
   friend struct ::protobuf_video_5fanalysis_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsFrameIndexImpl();
@@ -659,6 +672,12 @@ class Object : public ::google::protobuf::Message /* @@protoc_insertion_point(cl
   float confidence() const;
   void set_confidence(float value);
 
+  // uint32 compact_id = 4;
+  void clear_compact_id();
+  static const int kCompactIdFieldNumber = 4;
+  ::google::protobuf::uint32 compact_id() const;
+  void set_compact_id(::google::protobuf::uint32 value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.Object)
  private:
 
@@ -666,6 +685,7 @@ class Object : public ::google::protobuf::Message /* @@protoc_insertion_point(cl
   ::google::protobuf::internal::ArenaStringPtr id_;
   ::google::protobuf::internal::ArenaStringPtr image_;
   float confidence_;
+  ::google::protobuf::uint32 compact_id_;
   mutable int _cached_size_;
   friend struct ::protobuf_video_5fanalysis_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsObjectImpl();
@@ -766,6 +786,28 @@ class ImageSet : public ::google::protobuf::Message /* @@protoc_insertion_point(
   const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object >&
       object() const;
 
+  // repeated bytes object_image = 4;
+  int object_image_size() const;
+  void clear_object_image();
+  static const int kObjectImageFieldNumber = 4;
+  const ::std::string& object_image(int index) const;
+  ::std::string* mutable_object_image(int index);
+  void set_object_image(int index, const ::std::string& value);
+  #if LANG_CXX11
+  void set_object_image(int index, ::std::string&& value);
+  #endif
+  void set_object_image(int index, const char* value);
+  void set_object_image(int index, const void* value, size_t size);
+  ::std::string* add_object_image();
+  void add_object_image(const ::std::string& value);
+  #if LANG_CXX11
+  void add_object_image(::std::string&& value);
+  #endif
+  void add_object_image(const char* value);
+  void add_object_image(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& object_image() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_object_image();
+
   // bytes frame_image = 2;
   void clear_frame_image();
   static const int kFrameImageFieldNumber = 2;
@@ -794,6 +836,7 @@ class ImageSet : public ::google::protobuf::Message /* @@protoc_insertion_point(
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object > object_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> object_image_;
   ::google::protobuf::internal::ArenaStringPtr frame_image_;
   ::ascend::presenter::video_analysis::FrameIndex* frame_index_;
   mutable int _cached_size_;
@@ -933,6 +976,12 @@ class CarInferenceResult : public ::google::protobuf::Message /* @@protoc_insert
   float confidence() const;
   void set_confidence(float value);
 
+  // uint32 compact_object_id = 6;
+  void clear_compact_object_id();
+  static const int kCompactObjectIdFieldNumber = 6;
+  ::google::protobuf::uint32 compact_object_id() const;
+  void set_compact_object_id(::google::protobuf::uint32 value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.CarInferenceResult)
  private:
 
@@ -942,6 +991,7 @@ class CarInferenceResult : public ::google::protobuf::Message /* @@protoc_insert
   ::ascend::presenter::video_analysis::FrameIndex* frame_index_;
   int type_;
   float confidence_;
+  ::google::protobuf::uint32 compact_object_id_;
   mutable int _cached_size_;
   friend struct ::protobuf_video_5fanalysis_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsCarInferenceResultImpl();
@@ -1179,6 +1229,12 @@ class HumanInferenceResult : public ::google::protobuf::Message /* @@protoc_inse
   ::ascend::presenter::video_analysis::FrameIndex* mutable_frame_index();
   void set_allocated_frame_index(::ascend::presenter::video_analysis::FrameIndex* frame_index);
 
+  // uint32 compact_object_id = 4;
+  void clear_compact_object_id();
+  static const int kCompactObjectIdFieldNumber = 4;
+  ::google::protobuf::uint32 compact_object_id() const;
+  void set_compact_object_id(::google::protobuf::uint32 value);
+
   // @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.HumanInferenceResult)
  private:
 
@@ -1186,10 +1242,197 @@ class HumanInferenceResult : public ::google::protobuf::Message /* @@protoc_inse
   ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::MapType > human_property_;
   ::google::protobuf::internal::ArenaStringPtr object_id_;
   ::ascend::presenter::video_analysis::FrameIndex* frame_index_;
+  ::google::protobuf::uint32 compact_object_id_;
   mutable int _cached_size_;
   friend struct ::protobuf_video_5fanalysis_5fmessage_2eproto::TableStruct;
   friend void ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsHumanInferenceResultImpl();
 };
+// -------------------------------------------------------------------
+
+class FrameResult : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:ascend.presenter.video_analysis.FrameResult) */ {
+ public:
+  FrameResult();
+  virtual ~FrameResult();
+
+  FrameResult(const FrameResult& from);
+
+  inline FrameResult& operator=(const FrameResult& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  #if LANG_CXX11
+  FrameResult(FrameResult&& from) noexcept
+    : FrameResult() {
+    *this = ::std::move(from);
+  }
+
+  inline FrameResult& operator=(FrameResult&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+  #endif
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const FrameResult& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const FrameResult* internal_default_instance() {
+    return reinterpret_cast<const FrameResult*>(
+               &_FrameResult_default_instance_);
+  }
+  static PROTOBUF_CONSTEXPR int const kIndexInFileMessages =
+    8;
+
+  void Swap(FrameResult* other);
+  friend void swap(FrameResult& a, FrameResult& b) {
+    a.Swap(&b);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline FrameResult* New() const PROTOBUF_FINAL { return New(NULL); }
+
+  FrameResult* New(::google::protobuf::Arena* arena) const PROTOBUF_FINAL;
+  void CopyFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void MergeFrom(const ::google::protobuf::Message& from) PROTOBUF_FINAL;
+  void CopyFrom(const FrameResult& from);
+  void MergeFrom(const FrameResult& from);
+  void Clear() PROTOBUF_FINAL;
+  bool IsInitialized() const PROTOBUF_FINAL;
+
+  size_t ByteSizeLong() const PROTOBUF_FINAL;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input) PROTOBUF_FINAL;
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const PROTOBUF_FINAL;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* target) const PROTOBUF_FINAL;
+  int GetCachedSize() const PROTOBUF_FINAL { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const PROTOBUF_FINAL;
+  void InternalSwap(FrameResult* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return NULL;
+  }
+  inline void* MaybeArenaPtr() const {
+    return NULL;
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const PROTOBUF_FINAL;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .ascend.presenter.video_analysis.Object object = 3;
+  int object_size() const;
+  void clear_object();
+  static const int kObjectFieldNumber = 3;
+  const ::ascend::presenter::video_analysis::Object& object(int index) const;
+  ::ascend::presenter::video_analysis::Object* mutable_object(int index);
+  ::ascend::presenter::video_analysis::Object* add_object();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object >*
+      mutable_object();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object >&
+      object() const;
+
+  // repeated bytes object_image = 4;
+  int object_image_size() const;
+  void clear_object_image();
+  static const int kObjectImageFieldNumber = 4;
+  const ::std::string& object_image(int index) const;
+  ::std::string* mutable_object_image(int index);
+  void set_object_image(int index, const ::std::string& value);
+  #if LANG_CXX11
+  void set_object_image(int index, ::std::string&& value);
+  #endif
+  void set_object_image(int index, const char* value);
+  void set_object_image(int index, const void* value, size_t size);
+  ::std::string* add_object_image();
+  void add_object_image(const ::std::string& value);
+  #if LANG_CXX11
+  void add_object_image(::std::string&& value);
+  #endif
+  void add_object_image(const char* value);
+  void add_object_image(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& object_image() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_object_image();
+
+  // repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+  int car_result_size() const;
+  void clear_car_result();
+  static const int kCarResultFieldNumber = 5;
+  const ::ascend::presenter::video_analysis::CarInferenceResult& car_result(int index) const;
+  ::ascend::presenter::video_analysis::CarInferenceResult* mutable_car_result(int index);
+  ::ascend::presenter::video_analysis::CarInferenceResult* add_car_result();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::CarInferenceResult >*
+      mutable_car_result();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::CarInferenceResult >&
+      car_result() const;
+
+  // repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+  int human_result_size() const;
+  void clear_human_result();
+  static const int kHumanResultFieldNumber = 6;
+  const ::ascend::presenter::video_analysis::HumanInferenceResult& human_result(int index) const;
+  ::ascend::presenter::video_analysis::HumanInferenceResult* mutable_human_result(int index);
+  ::ascend::presenter::video_analysis::HumanInferenceResult* add_human_result();
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::HumanInferenceResult >*
+      mutable_human_result();
+  const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::HumanInferenceResult >&
+      human_result() const;
+
+  // bytes frame_image = 2;
+  void clear_frame_image();
+  static const int kFrameImageFieldNumber = 2;
+  const ::std::string& frame_image() const;
+  void set_frame_image(const ::std::string& value);
+  #if LANG_CXX11
+  void set_frame_image(::std::string&& value);
+  #endif
+  void set_frame_image(const char* value);
+  void set_frame_image(const void* value, size_t size);
+  ::std::string* mutable_frame_image();
+  ::std::string* release_frame_image();
+  void set_allocated_frame_image(::std::string* frame_image);
+
+  // .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+  bool has_frame_index() const;
+  void clear_frame_index();
+  static const int kFrameIndexFieldNumber = 1;
+  const ::ascend::presenter::video_analysis::FrameIndex& frame_index() const;
+  ::ascend::presenter::video_analysis::FrameIndex* release_frame_index();
+  ::ascend::presenter::video_analysis::FrameIndex* mutable_frame_index();
+  void set_allocated_frame_index(::ascend::presenter::video_analysis::FrameIndex* frame_index);
+
+  // bool ack_required = 7;
+  void clear_ack_required();
+  static const int kAckRequiredFieldNumber = 7;
+  bool ack_required() const;
+  void set_ack_required(bool value);
+
+  // @@protoc_insertion_point(class_scope:ascend.presenter.video_analysis.FrameResult)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object > object_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> object_image_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::CarInferenceResult > car_result_;
+  ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::HumanInferenceResult > human_result_;
+  ::google::protobuf::internal::ArenaStringPtr frame_image_;
+  ::ascend::presenter::video_analysis::FrameIndex* frame_index_;
+  bool ack_required_;
+  mutable int _cached_size_;
+  friend struct ::protobuf_video_5fanalysis_5fmessage_2eproto::TableStruct;
+  friend void ::protobuf_video_5fanalysis_5fmessage_2eproto::InitDefaultsFrameResultImpl();
+};
 // ===================================================================
 
 
@@ -1594,6 +1837,20 @@ inline void FrameIndex::set_allocated_frame_id(::std::string* frame_id) {
   // @@protoc_insertion_point(field_set_allocated:ascend.presenter.video_analysis.FrameIndex.frame_id)
 }
 
+// uint32 frame_number = 5;
+inline void FrameIndex::clear_frame_number() {
+  frame_number_ = 0u;
+}
+inline ::google::protobuf::uint32 FrameIndex::frame_number() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameIndex.frame_number)
+  return frame_number_;
+}
+inline void FrameIndex::set_frame_number(::google::protobuf::uint32 value) {
+  
+  frame_number_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.FrameIndex.frame_number)
+}
+
 // -------------------------------------------------------------------
 
 // Object
@@ -1718,6 +1975,20 @@ inline void Object::set_allocated_image(::std::string* image) {
   // @@protoc_insertion_point(field_set_allocated:ascend.presenter.video_analysis.Object.image)
 }
 
+// uint32 compact_id = 4;
+inline void Object::clear_compact_id() {
+  compact_id_ = 0u;
+}
+inline ::google::protobuf::uint32 Object::compact_id() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.Object.compact_id)
+  return compact_id_;
+}
+inline void Object::set_compact_id(::google::protobuf::uint32 value) {
+  
+  compact_id_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.Object.compact_id)
+}
+
 // -------------------------------------------------------------------
 
 // ImageSet
@@ -1855,6 +2126,75 @@ ImageSet::object() const {
   return object_;
 }
 
+// repeated bytes object_image = 4;
+inline int ImageSet::object_image_size() const {
+  return object_image_.size();
+}
+inline void ImageSet::clear_object_image() {
+  object_image_.Clear();
+}
+inline const ::std::string& ImageSet::object_image(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.ImageSet.object_image)
+  return object_image_.Get(index);
+}
+inline ::std::string* ImageSet::mutable_object_image(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.ImageSet.object_image)
+  return object_image_.Mutable(index);
+}
+inline void ImageSet::set_object_image(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.ImageSet.object_image)
+  object_image_.Mutable(index)->assign(value);
+}
+#if LANG_CXX11
+inline void ImageSet::set_object_image(int index, ::std::string&& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.ImageSet.object_image)
+  object_image_.Mutable(index)->assign(std::move(value));
+}
+#endif
+inline void ImageSet::set_object_image(int index, const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  object_image_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+inline void ImageSet::set_object_image(int index, const void* value, size_t size) {
+  object_image_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+inline ::std::string* ImageSet::add_object_image() {
+  // @@protoc_insertion_point(field_add_mutable:ascend.presenter.video_analysis.ImageSet.object_image)
+  return object_image_.Add();
+}
+inline void ImageSet::add_object_image(const ::std::string& value) {
+  object_image_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+#if LANG_CXX11
+inline void ImageSet::add_object_image(::std::string&& value) {
+  object_image_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+#endif
+inline void ImageSet::add_object_image(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  object_image_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+inline void ImageSet::add_object_image(const void* value, size_t size) {
+  object_image_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:ascend.presenter.video_analysis.ImageSet.object_image)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+ImageSet::object_image() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.video_analysis.ImageSet.object_image)
+  return object_image_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+ImageSet::mutable_object_image() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.video_analysis.ImageSet.object_image)
+  return &object_image_;
+}
+
 // -------------------------------------------------------------------
 
 // CarInferenceResult
@@ -2043,6 +2383,20 @@ inline void CarInferenceResult::set_allocated_value(::std::string* value) {
   // @@protoc_insertion_point(field_set_allocated:ascend.presenter.video_analysis.CarInferenceResult.value)
 }
 
+// uint32 compact_object_id = 6;
+inline void CarInferenceResult::clear_compact_object_id() {
+  compact_object_id_ = 0u;
+}
+inline ::google::protobuf::uint32 CarInferenceResult::compact_object_id() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.CarInferenceResult.compact_object_id)
+  return compact_object_id_;
+}
+inline void CarInferenceResult::set_compact_object_id(::google::protobuf::uint32 value) {
+  
+  compact_object_id_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.CarInferenceResult.compact_object_id)
+}
+
 // -------------------------------------------------------------------
 
 // MapType
@@ -2251,6 +2605,300 @@ HumanInferenceResult::human_property() const {
   return human_property_;
 }
 
+// uint32 compact_object_id = 4;
+inline void HumanInferenceResult::clear_compact_object_id() {
+  compact_object_id_ = 0u;
+}
+inline ::google::protobuf::uint32 HumanInferenceResult::compact_object_id() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.HumanInferenceResult.compact_object_id)
+  return compact_object_id_;
+}
+inline void HumanInferenceResult::set_compact_object_id(::google::protobuf::uint32 value) {
+  
+  compact_object_id_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.HumanInferenceResult.compact_object_id)
+}
+
+// -------------------------------------------------------------------
+
+// FrameResult
+
+// .ascend.presenter.video_analysis.FrameIndex frame_index = 1;
+inline bool FrameResult::has_frame_index() const {
+  return this != internal_default_instance() && frame_index_ != NULL;
+}
+inline void FrameResult::clear_frame_index() {
+  if (GetArenaNoVirtual() == NULL && frame_index_ != NULL) {
+    delete frame_index_;
+  }
+  frame_index_ = NULL;
+}
+inline const ::ascend::presenter::video_analysis::FrameIndex& FrameResult::frame_index() const {
+  const ::ascend::presenter::video_analysis::FrameIndex* p = frame_index_;
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.frame_index)
+  return p != NULL ? *p : *reinterpret_cast<const ::ascend::presenter::video_analysis::FrameIndex*>(
+      &::ascend::presenter::video_analysis::_FrameIndex_default_instance_);
+}
+inline ::ascend::presenter::video_analysis::FrameIndex* FrameResult::release_frame_index() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.video_analysis.FrameResult.frame_index)
+  
+  ::ascend::presenter::video_analysis::FrameIndex* temp = frame_index_;
+  frame_index_ = NULL;
+  return temp;
+}
+inline ::ascend::presenter::video_analysis::FrameIndex* FrameResult::mutable_frame_index() {
+  
+  if (frame_index_ == NULL) {
+    frame_index_ = new ::ascend::presenter::video_analysis::FrameIndex;
+  }
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.frame_index)
+  return frame_index_;
+}
+inline void FrameResult::set_allocated_frame_index(::ascend::presenter::video_analysis::FrameIndex* frame_index) {
+  ::google::protobuf::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == NULL) {
+    delete frame_index_;
+  }
+  if (frame_index) {
+    ::google::protobuf::Arena* submessage_arena = NULL;
+    if (message_arena != submessage_arena) {
+      frame_index = ::google::protobuf::internal::GetOwnedMessage(
+          message_arena, frame_index, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  frame_index_ = frame_index;
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.video_analysis.FrameResult.frame_index)
+}
+
+// bytes frame_image = 2;
+inline void FrameResult::clear_frame_image() {
+  frame_image_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& FrameResult::frame_image() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.frame_image)
+  return frame_image_.GetNoArena();
+}
+inline void FrameResult::set_frame_image(const ::std::string& value) {
+  
+  frame_image_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.FrameResult.frame_image)
+}
+#if LANG_CXX11
+inline void FrameResult::set_frame_image(::std::string&& value) {
+  
+  frame_image_.SetNoArena(
+    &::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:ascend.presenter.video_analysis.FrameResult.frame_image)
+}
+#endif
+inline void FrameResult::set_frame_image(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  
+  frame_image_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.video_analysis.FrameResult.frame_image)
+}
+inline void FrameResult::set_frame_image(const void* value, size_t size) {
+  
+  frame_image_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.video_analysis.FrameResult.frame_image)
+}
+inline ::std::string* FrameResult::mutable_frame_image() {
+  
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.frame_image)
+  return frame_image_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* FrameResult::release_frame_image() {
+  // @@protoc_insertion_point(field_release:ascend.presenter.video_analysis.FrameResult.frame_image)
+  
+  return frame_image_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void FrameResult::set_allocated_frame_image(::std::string* frame_image) {
+  if (frame_image != NULL) {
+    
+  } else {
+    
+  }
+  frame_image_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), frame_image);
+  // @@protoc_insertion_point(field_set_allocated:ascend.presenter.video_analysis.FrameResult.frame_image)
+}
+
+// repeated .ascend.presenter.video_analysis.Object object = 3;
+inline int FrameResult::object_size() const {
+  return object_.size();
+}
+inline void FrameResult::clear_object() {
+  object_.Clear();
+}
+inline const ::ascend::presenter::video_analysis::Object& FrameResult::object(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.object)
+  return object_.Get(index);
+}
+inline ::ascend::presenter::video_analysis::Object* FrameResult::mutable_object(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.object)
+  return object_.Mutable(index);
+}
+inline ::ascend::presenter::video_analysis::Object* FrameResult::add_object() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.FrameResult.object)
+  return object_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object >*
+FrameResult::mutable_object() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.video_analysis.FrameResult.object)
+  return &object_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::Object >&
+FrameResult::object() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.video_analysis.FrameResult.object)
+  return object_;
+}
+
+// repeated bytes object_image = 4;
+inline int FrameResult::object_image_size() const {
+  return object_image_.size();
+}
+inline void FrameResult::clear_object_image() {
+  object_image_.Clear();
+}
+inline const ::std::string& FrameResult::object_image(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.object_image)
+  return object_image_.Get(index);
+}
+inline ::std::string* FrameResult::mutable_object_image(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.object_image)
+  return object_image_.Mutable(index);
+}
+inline void FrameResult::set_object_image(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.FrameResult.object_image)
+  object_image_.Mutable(index)->assign(value);
+}
+#if LANG_CXX11
+inline void FrameResult::set_object_image(int index, ::std::string&& value) {
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.FrameResult.object_image)
+  object_image_.Mutable(index)->assign(std::move(value));
+}
+#endif
+inline void FrameResult::set_object_image(int index, const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  object_image_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+inline void FrameResult::set_object_image(int index, const void* value, size_t size) {
+  object_image_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+inline ::std::string* FrameResult::add_object_image() {
+  // @@protoc_insertion_point(field_add_mutable:ascend.presenter.video_analysis.FrameResult.object_image)
+  return object_image_.Add();
+}
+inline void FrameResult::add_object_image(const ::std::string& value) {
+  object_image_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+#if LANG_CXX11
+inline void FrameResult::add_object_image(::std::string&& value) {
+  object_image_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+#endif
+inline void FrameResult::add_object_image(const char* value) {
+  GOOGLE_DCHECK(value != NULL);
+  object_image_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+inline void FrameResult::add_object_image(const void* value, size_t size) {
+  object_image_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:ascend.presenter.video_analysis.FrameResult.object_image)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+FrameResult::object_image() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.video_analysis.FrameResult.object_image)
+  return object_image_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+FrameResult::mutable_object_image() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.video_analysis.FrameResult.object_image)
+  return &object_image_;
+}
+
+// repeated .ascend.presenter.video_analysis.CarInferenceResult car_result = 5;
+inline int FrameResult::car_result_size() const {
+  return car_result_.size();
+}
+inline void FrameResult::clear_car_result() {
+  car_result_.Clear();
+}
+inline const ::ascend::presenter::video_analysis::CarInferenceResult& FrameResult::car_result(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.car_result)
+  return car_result_.Get(index);
+}
+inline ::ascend::presenter::video_analysis::CarInferenceResult* FrameResult::mutable_car_result(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.car_result)
+  return car_result_.Mutable(index);
+}
+inline ::ascend::presenter::video_analysis::CarInferenceResult* FrameResult::add_car_result() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.FrameResult.car_result)
+  return car_result_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::CarInferenceResult >*
+FrameResult::mutable_car_result() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.video_analysis.FrameResult.car_result)
+  return &car_result_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::CarInferenceResult >&
+FrameResult::car_result() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.video_analysis.FrameResult.car_result)
+  return car_result_;
+}
+
+// repeated .ascend.presenter.video_analysis.HumanInferenceResult human_result = 6;
+inline int FrameResult::human_result_size() const {
+  return human_result_.size();
+}
+inline void FrameResult::clear_human_result() {
+  human_result_.Clear();
+}
+inline const ::ascend::presenter::video_analysis::HumanInferenceResult& FrameResult::human_result(int index) const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.human_result)
+  return human_result_.Get(index);
+}
+inline ::ascend::presenter::video_analysis::HumanInferenceResult* FrameResult::mutable_human_result(int index) {
+  // @@protoc_insertion_point(field_mutable:ascend.presenter.video_analysis.FrameResult.human_result)
+  return human_result_.Mutable(index);
+}
+inline ::ascend::presenter::video_analysis::HumanInferenceResult* FrameResult::add_human_result() {
+  // @@protoc_insertion_point(field_add:ascend.presenter.video_analysis.FrameResult.human_result)
+  return human_result_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::HumanInferenceResult >*
+FrameResult::mutable_human_result() {
+  // @@protoc_insertion_point(field_mutable_list:ascend.presenter.video_analysis.FrameResult.human_result)
+  return &human_result_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::ascend::presenter::video_analysis::HumanInferenceResult >&
+FrameResult::human_result() const {
+  // @@protoc_insertion_point(field_list:ascend.presenter.video_analysis.FrameResult.human_result)
+  return human_result_;
+}
+
+// bool ack_required = 7;
+inline void FrameResult::clear_ack_required() {
+  ack_required_ = false;
+}
+inline bool FrameResult::ack_required() const {
+  // @@protoc_insertion_point(field_get:ascend.presenter.video_analysis.FrameResult.ack_required)
+  return ack_required_;
+}
+inline void FrameResult::set_ack_required(bool value) {
+  
+  ack_required_ = value;
+  // @@protoc_insertion_point(field_set:ascend.presenter.video_analysis.FrameResult.ack_required)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -2268,6 +2916,8 @@ HumanInferenceResult::human_property() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -41,6 +41,7 @@
 #include <string.h>
 #include <cmath>
 #include <regex>
+#include <algorithm>
 #include "hiaiengine/log.h"
 #include "ascenddk/ascend_ezdvpp/dvpp_process.h"
 
@@ -64,8 +65,146 @@ HIAI_REGISTER_DATA_TYPE("DetectionEngineTransT", DetectionEngineTransT);
 HIAI_REGISTER_DATA_TYPE("PedestrianInfoT", PedestrianInfoT);
 HIAI_REGISTER_DATA_TYPE("BatchPedestrianInfoT", BatchPedestrianInfoT);
 
+namespace {
+// name of each object class, "car_12" is the string id of car 12
+const char* const kObjectClassNames[] = { "object", "car", "bus", "person" };
+
+// string id of an object, which is used by presenter server before compact
+// ids are supported
+string ObjectIdToString(uint32_t object_id) {
+  uint32_t object_class = GetObjectClass(object_id);
+  const char* name = kObjectClassNames[kObjectClassUnknown];
+  if (object_class < sizeof(kObjectClassNames) / sizeof(kObjectClassNames[0])) {
+    name = kObjectClassNames[object_class];
+  }
+  return string(name) + "_" + to_string(GetObjectIndex(object_id));
+}
+
+// fill index of the frame which the results belong to, frame id is sent
+// as a number when compact_id is set
+void FillFrameIndex(const string &app_name, bool compact_id,
+                    const VideoImageInfoT &video_image_info,
+                    FrameIndex* frame_index) {
+  frame_index->set_app_id(app_name);
+  frame_index->set_channel_id(video_image_info.channel_id);
+  frame_index->set_channel_name(video_image_info.channel_name);
+  if (compact_id) {
+    frame_index->set_frame_number(video_image_info.frame_id);
+  } else {
+    frame_index->set_frame_id(to_string(video_image_info.frame_id));
+  }
+}
+
+// frame id for logs, which is sent as a number when compact_id is set
+string FrameIndexToString(const FrameIndex &frame_index) {
+  if (!frame_index.frame_id().empty()) {
+    return frame_index.frame_id();
+  }
+  return to_string(frame_index.frame_number());
+}
+
+// fill objects of ImageSet or FrameResult, origin image and small images
+// are added to tlv_list
+template<typename ImageSetT>
+void FillImageSet(const VideoDetectionImageParaT &image_para, bool compact_id,
+                  ImageSetT &image_set, vector<Tlv> &tlv_list) {
+  // set up origin image buff in ImageSet Message
+  if (image_para.image.img.size > 0) {
+    Tlv frame_tlv;
+    frame_tlv.tag = ImageSetT::kFrameImageFieldNumber;
+    frame_tlv.length = static_cast<int>(image_para.image.img.size);
+    frame_tlv.value =
+        reinterpret_cast<const char*>(image_para.image.img.data.get());
+    tlv_list.push_back(frame_tlv);
+  }
+
+  // get small images after reasoning
+  for (const ObjectImageParaT &obj_img : image_para.obj_imgs) {
+    // object_image is matched to objects by order, empty one can not be sent
+    if (obj_img.img.size == 0) {
+      HIAI_ENGINE_LOG("skip object %s without image",
+                      ObjectIdToString(obj_img.object_info.object_id).c_str());
+      continue;
+    }
+
+    // set up id and confidence of small images
+    Object* object_img = image_set.add_object();
+    if (compact_id) {
+      object_img->set_compact_id(obj_img.object_info.object_id);
+    } else {
+      object_img->set_id(ObjectIdToString(obj_img.object_info.object_id));
+    }
+    object_img->set_confidence(obj_img.object_info.score);
+
+    // set up small image buff in ImageSet Message
+    Tlv object_tlv;
+    object_tlv.tag = ImageSetT::kObjectImageFieldNumber;
+    object_tlv.length = static_cast<int>(obj_img.img.size);
+    object_tlv.value = reinterpret_cast<const char*>(obj_img.img.data.get());
+    tlv_list.push_back(object_tlv);
+  }
+}
+
+// fill object_id, CarInferenceType, confidence and value of a car
+void FillCarResult(const CarInfoT &car_info, bool compact_id,
+                   CarInferenceResult* car_result) {
+  if (compact_id) {
+    car_result->set_compact_object_id(car_info.object_id);
+  } else {
+    car_result->set_object_id(ObjectIdToString(car_info.object_id));
+  }
+  if (car_info.attribute_name == kCarType) {
+    car_result->set_type(ascend::presenter::video_analysis::kCarBrand);
+  } else {
+    car_result->set_type(ascend::presenter::video_analysis::kCarColor);
+  }
+  car_result->set_confidence(car_info.confidence);
+  car_result->set_value(car_info.inference_result);
+}
+
+// pedestrian attribute names indexed by PedestrianAttribute
+const char* const kPedestrianAttributeNames[] = {
+    "Age16-30", "Age31-45", "Age46-60", "AgeAbove61", "Backpack",
+    "CarryingOther", "Casual lower", "Casual upper", "Formal lower",
+    "Formal upper", "Hat", "Jacket", "Jeans", "Leather Shoes", "Logo",
+    "Long hair", "Male", "Messenger Bag", "Muffler", "No accessory",
+    "No carrying", "Plaid", "PlasticBags", "Sandals", "Shoes", "Shorts",
+    "Short Sleeve", "Skirt", "Sneaker", "Stripes", "Sunglasses", "Trousers",
+    "Tshirt", "UpperOther", "V-Neck", "Short hair", "Female" };
+static_assert(sizeof(kPedestrianAttributeNames)
+              / sizeof(kPedestrianAttributeNames[0]) == kPedAttrNumber,
+              "every pedestrian attribute needs a name");
+
+// fill object_id and human_property of a person
+void FillHumanResult(const PedestrianInfoT &pedestrian_info, bool compact_id,
+                     HumanInferenceResult* person_result) {
+  if (compact_id) {
+    person_result->set_compact_object_id(pedestrian_info.object_id);
+  } else {
+    person_result->set_object_id(ObjectIdToString(pedestrian_info.object_id));
+  }
+  size_t attribute_number = min(pedestrian_info.attributes.size(),
+                                static_cast<size_t>(kPedAttrNumber));
+  for (size_t index = 0; index < attribute_number; ++index) {
+    // set up human_property of reported attributes
+    float confidence = pedestrian_info.attributes[index];
+    if (confidence <= 0.0f) {
+      continue;
+    }
+    MapType* property_map = person_result->add_human_property();
+    property_map->set_key(kPedestrianAttributeNames[index]);
+    property_map->set_value(confidence);
+  }
+}
+}  // namespace
+
 VideoAnalysisPost::~VideoAnalysisPost() {
   if (agent_channel_ != nullptr) {
+    // results sent after the last response are acknowledged before close
+    if (stream_mode_ && FlushFrameResults() != kOperationOk) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                      "flush frame results failed on close");
+    }
     delete agent_channel_;
   }
 }
@@ -104,6 +243,8 @@ HIAI_StatusT VideoAnalysisPost::Init(
     app_config_ = make_shared<RegisterAppParam>();
   }
 
+  uint32_t max_pending_frames = kDefaultMaxPendingFrames;
+
   // get engine config and save to app_config_
   for (int index = 0; index < config.items_size(); index++) {
     const ::hiai::AIConfigItem& item = config.items(index);
@@ -137,14 +278,59 @@ HIAI_StatusT VideoAnalysisPost::Init(
         return HIAI_ERROR;
       }
       app_config_->app_name = value;
+    } else if (name == kStreamMode) {
+      stream_mode_ = (value == "true");
+    } else if (name == kAckWindow) {
+      // validate number of messages acknowledged by one response
+      int ack_window = atoi(value.data());
+      if (ack_window <= 0) {
+        HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                        "ack_window = %s which configured is invalid.",
+                        value.c_str());
+        return HIAI_ERROR;
+      }
+      ack_window_ = static_cast<uint32_t>(ack_window);
+    } else if (name == kCompactId) {
+      compact_id_ = (value == "true");
+    } else if (name == kJoinDeadline) {
+      // validate join deadline, 0 means results are not joined
+      int join_deadline = atoi(value.data());
+      if (join_deadline < 0) {
+        HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                        "join_deadline_ms = %s which configured is invalid.",
+                        value.c_str());
+        return HIAI_ERROR;
+      }
+      join_deadline_ms_ = static_cast<uint32_t>(join_deadline);
+    } else if (name == kMaxPendingFrames) {
+      // validate max number of frames waiting for results
+      int pending_frames = atoi(value.data());
+      if (pending_frames <= 0) {
+        HIAI_ENGINE_LOG(HIAI_GRAPH_INVALID_VALUE,
+                        "max_pending_frames = %s which configured is invalid.",
+                        value.c_str());
+        return HIAI_ERROR;
+      }
+      max_pending_frames = static_cast<uint32_t>(pending_frames);
     } else {
       HIAI_ENGINE_LOG("unused config name: %s", name.c_str());
     }
   }
   app_config_->app_type = kAppType;
+
+  // a frame is sent in one FrameResult in streaming mode, so results of
+  // all ports are always joined
+  if (stream_mode_ && join_deadline_ms_ == 0) {
+    join_deadline_ms_ = kDefaultStreamJoinDeadline;
+  }
   HIAI_ENGINE_LOG("host_ip = %s,port = %d,app_name = %s",
                   app_config_->host_ip.c_str(), app_config_->port,
                   app_config_->app_name.c_str());
+  HIAI_ENGINE_LOG("stream_mode = %d,ack_window = %u,compact_id = %d",
+                  stream_mode_, ack_window_, compact_id_);
+  HIAI_ENGINE_LOG("join_deadline_ms = %u,max_pending_frames = %u",
+                  join_deadline_ms_, max_pending_frames);
+  join_buffer_.SetParams(join_deadline_ms_, max_pending_frames);
 
   // create agent channel by host_ip and port
   ChannelFactory channel_factory;
@@ -210,41 +396,22 @@ OperationCode VideoAnalysisPost::SendDetectionImage(
 
   // Construct Message ImageSet,which has FrameIndex,image and Object
   ImageSet image_set;
-  FrameIndex* frame_image = new FrameIndex();
+  FillFrameIndex(app_config_->app_name, compact_id_,
+                 image_para->image.video_image_info,
+                 image_set.mutable_frame_index());
 
-  // fill content of FrameIndex
-  frame_image->set_app_id(app_config_->app_name);
-  frame_image->set_channel_id(image_para->image.video_image_info.channel_id);
-  frame_image->set_channel_name(
-      image_para->image.video_image_info.channel_name);
-  frame_image->set_frame_id(
-      to_string(image_para->image.video_image_info.frame_id));
-  image_set.set_allocated_frame_index(frame_image);
-
-  // set up origin image buff in ImageSet Message
-  image_set.set_frame_image(
-      string(reinterpret_cast<char*>(image_para->image.img.data.get()),
-             image_para->image.img.size));
-
-  // get small images after reasoning
-  for (vector<ObjectImageParaT>::iterator iter = image_para->obj_imgs.begin();
-      iter != image_para->obj_imgs.end(); ++iter) {
-    // set up id and confidence of small images
-    Object* object_img = image_set.add_object();
-    object_img->set_id(iter->object_info.object_id);
-    object_img->set_confidence(iter->object_info.score);
-
-    // set up small image buff in ImageSet Message
-    object_img->set_image(
-        string(reinterpret_cast<char*>(iter->img.data.get()), iter->img.size));
-  }
+  // origin image and small images are sent as tlvs which refer to the
+  // image buffers directly, so they are not copied into the message
+  PartialMessageWithTlvs image_set_message;
+  image_set_message.message = &image_set;
+  FillImageSet(*image_para, compact_id_, image_set, image_set_message.tlv_list);
 
   // construct callback Messages
   unique_ptr < google::protobuf::Message > response_detection;
 
   // send infomation images to server
   PresenterErrorCode detection_image_err = agent_channel_->SendMessage(
-      image_set, response_detection);
+      image_set_message, response_detection);
   if (detection_image_err != PresenterErrorCode::kNone) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
                     "send detection image failed, error code=%d",
@@ -288,25 +455,10 @@ OperationCode VideoAnalysisPost::SendCarInfo(
     // Construct Message CarInferenceResult,which has FrameIndex,object_id,
     // CarInferenceType,confidence and value
     CarInferenceResult car_result;
-    FrameIndex* frame_car = new FrameIndex();
-
-    // set up relevant infomations of origin image
-    frame_car->set_app_id(app_config_->app_name);
-    frame_car->set_channel_id(car_info_para->video_image_info.channel_id);
-    frame_car->set_channel_name(car_info_para->video_image_info.channel_name);
-    frame_car->set_frame_id(
-        to_string(car_info_para->video_image_info.frame_id));
-    car_result.set_allocated_frame_index(frame_car);
-
-    // set up relevant infomations of small image
-    car_result.set_object_id(iter->object_id);
-    if (iter->attribute_name == kCarType) {
-      car_result.set_type(ascend::presenter::video_analysis::kCarBrand);
-    } else {
-      car_result.set_type(ascend::presenter::video_analysis::kCarColor);
-    }
-    car_result.set_confidence(iter->confidence);
-    car_result.set_value(iter->inference_result);
+    FillFrameIndex(app_config_->app_name, compact_id_,
+                   car_info_para->video_image_info,
+                   car_result.mutable_frame_index());
+    FillCarResult(*iter, compact_id_, &car_result);
 
     // construct callback Messages,send to presenter server
     unique_ptr < google::protobuf::Message > response_objcar;
@@ -315,7 +467,7 @@ OperationCode VideoAnalysisPost::SendCarInfo(
     if (car_err != PresenterErrorCode::kNone) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
                       "send car result failed, error code=%d,object_id = %s",
-                      car_err, iter->object_id.c_str());
+                      car_err, ObjectIdToString(iter->object_id).c_str());
       return kSendDataFailed;
     }
 
@@ -333,7 +485,7 @@ OperationCode VideoAnalysisPost::SendCarInfo(
       HIAI_ENGINE_LOG(
           HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
           "[SendCarInfo]server response failed, error code=%d,object_id = %s",
-          response_code, iter->object_id.c_str());
+          response_code, ObjectIdToString(iter->object_id).c_str());
       return kSendDataFailed;
     }
   }
@@ -358,28 +510,10 @@ OperationCode VideoAnalysisPost::SendPedestrianInfo(
     // Construct Message HumanInferenceResult,which has FrameIndex,object_id,
     // and human_property
     HumanInferenceResult person_result;
-    FrameIndex* frame_person = new FrameIndex();
-
-    // set up relevant infomations of origin image
-    frame_person->set_app_id(app_config_->app_name);
-    frame_person->set_channel_id(
-        pedestrian_info_para->video_image_info.channel_id);
-    frame_person->set_channel_name(
-        pedestrian_info_para->video_image_info.channel_name);
-    frame_person->set_frame_id(
-        to_string(pedestrian_info_para->video_image_info.frame_id));
-    person_result.set_allocated_frame_index(frame_person);
-
-    // set up relevant infomations of small image
-    person_result.set_object_id(iter->object_id);
-    map<string, float>::iterator iter_map;
-    for (iter_map = iter->pedestrian_attribute_map.begin();
-        iter_map != iter->pedestrian_attribute_map.end(); ++iter_map) {
-      // set up human_property
-      MapType* property_map = person_result.add_human_property();
-      property_map->set_key(iter_map->first);
-      property_map->set_value(iter_map->second);
-    }
+    FillFrameIndex(app_config_->app_name, compact_id_,
+                   pedestrian_info_para->video_image_info,
+                   person_result.mutable_frame_index());
+    FillHumanResult(*iter, compact_id_, &person_result);
 
     // construct callback Messages,send to presenter server
     unique_ptr < google::protobuf::Message > response_objper;
@@ -388,7 +522,7 @@ OperationCode VideoAnalysisPost::SendPedestrianInfo(
     if (person_err != PresenterErrorCode::kNone) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
                       "send person result failed, error code=%d,object_id = %s",
-                      person_err, iter->object_id.c_str());
+                      person_err, ObjectIdToString(iter->object_id).c_str());
       return kSendDataFailed;
     }
 
@@ -405,7 +539,7 @@ OperationCode VideoAnalysisPost::SendPedestrianInfo(
     if (response_code != kErrorNone) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, "[SendPersonInfo]server "
                       "response failed, error code=%d,object_id = %s",
-                      response_code, iter->object_id.c_str());
+                      response_code, ObjectIdToString(iter->object_id).c_str());
       return kSendDataFailed;
     }
   }
@@ -413,6 +547,193 @@ OperationCode VideoAnalysisPost::SendPedestrianInfo(
   return kOperationOk;
 }
 
+OperationCode VideoAnalysisPost::SendFrameResult(
+    FrameResult &frame_result, PartialMessageWithTlvs &message) {
+  // the last message of a window asks server for the response of the window
+  ++unacked_number_;
+  bool ack_required = (unacked_number_ >= ack_window_);
+  frame_result.set_ack_required(ack_required);
+
+  PresenterErrorCode send_err = agent_channel_->SendMessage(message);
+  if (send_err != PresenterErrorCode::kNone) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "send frame result failed, error code=%d,frame_id = %s",
+                    send_err,
+                    FrameIndexToString(frame_result.frame_index()).c_str());
+    // server drops the window of a broken connection, start a new one
+    unacked_number_ = 0;
+    return kSendDataFailed;
+  }
+
+  if (!ack_required) {
+    return kOperationOk;
+  }
+
+  unacked_number_ = 0;
+  return ReceiveWindowResponse();
+}
+
+OperationCode VideoAnalysisPost::FlushFrameResults() {
+  if (unacked_number_ == 0) {
+    return kOperationOk;
+  }
+
+  // a FrameResult without frame index only asks for the response
+  unacked_number_ = 0;
+  FrameResult frame_result;
+  frame_result.set_ack_required(true);
+  PresenterErrorCode send_err = agent_channel_->SendMessage(frame_result);
+  if (send_err != PresenterErrorCode::kNone) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "send flush request failed, error code=%d", send_err);
+    return kSendDataFailed;
+  }
+  return ReceiveWindowResponse();
+}
+
+OperationCode VideoAnalysisPost::ReceiveWindowResponse() {
+  unique_ptr < google::protobuf::Message > response;
+  PresenterErrorCode receive_err = agent_channel_->ReceiveMessage(response);
+  if (receive_err != PresenterErrorCode::kNone) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "receive frame result response failed, error code=%d",
+                    receive_err);
+    return kSendDataFailed;
+  }
+
+  // get responded Message and judge result of the window
+  CommonResponse* window_response =
+      dynamic_cast<CommonResponse*>(response.get());
+  if (window_response == nullptr) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "[SendFrameResult]window_response is nullptr");
+    return kSendDataFailed;
+  }
+
+  ErrorCode response_code = window_response->ret();
+  if (response_code != kErrorNone) {
+    HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,
+                    "[SendFrameResult]server response failed, error code=%d,"
+                    "message = %s", response_code,
+                    window_response->message().c_str());
+    return kSendDataFailed;
+  }
+
+  return kOperationOk;
+}
+
+OperationCode VideoAnalysisPost::JoinDetectionImage(
+    const shared_ptr<VideoDetectionImageParaT> &image_para) {
+  if (image_para == nullptr) {
+    return kInvalidParam;
+  }
+
+  // exit app when data has been transferred
+  if (image_para->image.video_image_info.is_finished) {
+    return kExitApp;
+  }
+
+  join_buffer_.AddImage(image_para, joined_frames_);
+  return kOperationOk;
+}
+
+OperationCode VideoAnalysisPost::JoinCarInfo(
+    const shared_ptr<BatchCarInfoT> &car_info_para) {
+  if (car_info_para == nullptr) {
+    return kInvalidParam;
+  }
+
+  // exit app when data has been transferred
+  if (car_info_para->video_image_info.is_finished) {
+    return kExitApp;
+  }
+
+  join_buffer_.AddCarInfo(car_info_para, joined_frames_);
+  return kOperationOk;
+}
+
+OperationCode VideoAnalysisPost::JoinPedestrianInfo(
+    const shared_ptr<BatchPedestrianInfoT> &pedestrian_info_para) {
+  if (pedestrian_info_para == nullptr) {
+    return kInvalidParam;
+  }
+
+  // exit app when data has been transferred
+  if (pedestrian_info_para->video_image_info.is_finished) {
+    return kExitApp;
+  }
+
+  join_buffer_.AddPedestrianInfo(pedestrian_info_para, joined_frames_);
+  return kOperationOk;
+}
+
+void VideoAnalysisPost::SendJoinedFrames(bool flush) {
+  // the deadline is checked when any port has data, so a frame may wait a
+  // little longer than the deadline when all ports are idle
+  join_buffer_.PopExpired(flush, joined_frames_);
+  for (const JoinedFrame &frame : joined_frames_) {
+    OperationCode ret = SendJoinedFrame(frame);
+    if (ret != kOperationOk) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT, "[VideoAnalysePost]"
+          "SendJoinedFrame failed,error code: %d,frame_id = %u", ret,
+          frame.video_image_info.frame_id);
+    }
+  }
+  joined_frames_.clear();
+
+  if (flush) {
+    HIAI_ENGINE_LOG("[VideoAnalysePost]incomplete frames: %llu,"
+                    "late results: %llu",
+                    static_cast<unsigned long long>(
+                        join_buffer_.incomplete_number()),
+                    static_cast<unsigned long long>(
+                        join_buffer_.late_number()));
+  }
+}
+
+OperationCode VideoAnalysisPost::SendJoinedFrame(const JoinedFrame &frame) {
+  if (stream_mode_) {
+    FrameResult frame_result;
+    PartialMessageWithTlvs frame_result_message;
+    frame_result_message.message = &frame_result;
+    FillFrameIndex(app_config_->app_name, compact_id_, frame.video_image_info,
+                   frame_result.mutable_frame_index());
+    if (frame.image != nullptr) {
+      FillImageSet(*frame.image, compact_id_, frame_result,
+                   frame_result_message.tlv_list);
+    }
+    for (const CarInfoT &car_info : frame.cars->car_infos) {
+      FillCarResult(car_info, compact_id_, frame_result.add_car_result());
+    }
+    for (const PedestrianInfoT &pedestrian_info :
+        frame.pedestrians->pedestrian_info) {
+      FillHumanResult(pedestrian_info, compact_id_,
+                      frame_result.add_human_result());
+    }
+    return SendFrameResult(frame_result, frame_result_message);
+  }
+
+  // image is sent first, so server has the frame before its results
+  if (frame.image != nullptr) {
+    OperationCode image_ret = SendDetectionImage(frame.image);
+    if (image_ret != kOperationOk) {
+      return image_ret;
+    }
+  }
+
+  if (!frame.cars->car_infos.empty()) {
+    OperationCode car_ret = SendCarInfo(frame.cars);
+    if (car_ret != kOperationOk) {
+      return car_ret;
+    }
+  }
+
+  if (!frame.pedestrians->pedestrian_info.empty()) {
+    return SendPedestrianInfo(frame.pedestrians);
+  }
+  return kOperationOk;
+}
+
 HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   //arg0:image detection; arg1:car type; arg2:car color; arg3:person info
   input_que_.PushData(0, arg0);
@@ -427,11 +748,16 @@ HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   shared_ptr<void> input_arg2;
   shared_ptr<void> input_arg3;
 
+  // results are joined into frames before sending when deadline is set
+  bool join_enabled = (join_deadline_ms_ > 0);
+
   // if the image detection channel has data,then send to presenter server
   if (input_que_.FrontData(0, input_arg0)) {
     input_que_.PopData(0, input_arg0);
-    image_ret_ = SendDetectionImage(
-        static_pointer_cast<VideoDetectionImageParaT>(input_arg0));
+    shared_ptr<VideoDetectionImageParaT> image_para =
+        static_pointer_cast<VideoDetectionImageParaT>(input_arg0);
+    image_ret_ = join_enabled ?
+        JoinDetectionImage(image_para) : SendDetectionImage(image_para);
     if ((image_ret_ != kOperationOk) && (image_ret_ != kExitApp)) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
           "SendDetectionImage failed,error code: %d", image_ret_);
@@ -441,8 +767,10 @@ HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   // if the car type channel has data,then send to presenter server
   if (input_que_.FrontData(1, input_arg1)) {
     input_que_.PopData(1, input_arg1);
-    car_type_ret_ = SendCarInfo(
-        static_pointer_cast<BatchCarInfoT>(input_arg1));
+    shared_ptr<BatchCarInfoT> car_type_para =
+        static_pointer_cast<BatchCarInfoT>(input_arg1);
+    car_type_ret_ = join_enabled ?
+        JoinCarInfo(car_type_para) : SendCarInfo(car_type_para);
     if ((car_type_ret_ != kOperationOk) && (car_type_ret_ != kExitApp)) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
           "SendCarType failed,error code: %d",car_type_ret_);
@@ -452,8 +780,10 @@ HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   // if the car color channel has data,then send to presenter server
   if (input_que_.FrontData(2, input_arg2)) {
     input_que_.PopData(2, input_arg2);
-    car_color_ret_ = SendCarInfo(
-        static_pointer_cast<BatchCarInfoT>(input_arg2));
+    shared_ptr<BatchCarInfoT> car_color_para =
+        static_pointer_cast<BatchCarInfoT>(input_arg2);
+    car_color_ret_ = join_enabled ?
+        JoinCarInfo(car_color_para) : SendCarInfo(car_color_para);
     if ((car_color_ret_ != kOperationOk) && (car_color_ret_ != kExitApp)) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
           "SendCarColor failed,error code: %d",car_color_ret_);
@@ -463,8 +793,11 @@ HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   // if the person info channel has data,then send to presenter server
   if (input_que_.FrontData(3, input_arg3)) {
     input_que_.PopData(3, input_arg3);
-    pedestrian_ret_ = SendPedestrianInfo(
-        static_pointer_cast<BatchPedestrianInfoT>(input_arg3));
+    shared_ptr<BatchPedestrianInfoT> pedestrian_para =
+        static_pointer_cast<BatchPedestrianInfoT>(input_arg3);
+    pedestrian_ret_ = join_enabled ?
+        JoinPedestrianInfo(pedestrian_para) :
+        SendPedestrianInfo(pedestrian_para);
     if ((pedestrian_ret_ != kOperationOk) && (pedestrian_ret_ != kExitApp)) {
       HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
           "SendPedestrianInfo failed,error code: %d",pedestrian_ret_);
@@ -472,8 +805,24 @@ HIAI_IMPL_ENGINE_PROCESS("video_analysis_post", VideoAnalysisPost, INPUT_SIZE) {
   }
 
   // if all channel transmissions are completed,then exit app
-  if ((image_ret_ == kExitApp) && (car_type_ret_ == kExitApp) &&
-      (car_color_ret_ == kExitApp) && (pedestrian_ret_ == kExitApp)) {
+  bool finished = (image_ret_ == kExitApp) && (car_type_ret_ == kExitApp) &&
+      (car_color_ret_ == kExitApp) && (pedestrian_ret_ == kExitApp);
+
+  // send joined frames, all pending frames are sent before exit
+  if (join_enabled) {
+    SendJoinedFrames(finished);
+  }
+
+  // the last window of streaming mode is acknowledged before exit
+  if (finished && stream_mode_) {
+    OperationCode flush_ret = FlushFrameResults();
+    if (flush_ret != kOperationOk) {
+      HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
+          "FlushFrameResults failed,error code: %d", flush_ret);
+    }
+  }
+
+  if (finished) {
     HIAI_ENGINE_LOG(HIAI_ENGINE_RUN_ARGS_NOT_RIGHT,"[VideoAnalysePost]"
         "app will exit...");
     shared_ptr<string> result_data(new string);
@@ -45,6 +45,7 @@
 #include "video_analysis_params.h"
 #include "ascenddk/presenter/agent/channel.h"
 #include "video_analysis_message.pb.h"
+#include "frame_join_buffer.h"
 
 #define INPUT_SIZE 4
 #define OUTPUT_SIZE 1
@@ -97,6 +98,37 @@ const std::string kAppName = "app_name";
 // app type
 const std::string kAppType = "video_analysis";
 
+// streaming mode switch, results of a frame are sent in one message
+// without waiting for response of each message
+const std::string kStreamMode = "stream_mode";
+
+// number of messages acknowledged by one response in streaming mode
+const std::string kAckWindow = "ack_window";
+
+// default number of messages acknowledged by one response
+const uint32_t kDefaultAckWindow = 16;
+
+// send frame id and object ids as numbers instead of strings
+const std::string kCompactId = "compact_id";
+
+// max time in milliseconds a frame waits for results from all ports,
+// 0 means results are sent as soon as they arrive, which is only allowed
+// in legacy mode
+const std::string kJoinDeadline = "join_deadline_ms";
+
+// max number of frames waiting for results
+const std::string kMaxPendingFrames = "max_pending_frames";
+
+// default join deadline, results are not joined
+const uint32_t kDefaultJoinDeadline = 0;
+
+// join deadline used in streaming mode when join_deadline_ms is 0, a frame
+// is always sent in one FrameResult in streaming mode
+const uint32_t kDefaultStreamJoinDeadline = 100;
+
+// default max number of frames waiting for results
+const uint32_t kDefaultMaxPendingFrames = 32;
+
 class VideoAnalysisPost : public hiai::Engine {
 public:
   /**
@@ -109,7 +141,13 @@ public:
         image_ret_(kOperationOk),
         car_type_ret_(kOperationOk),
         car_color_ret_(kOperationOk),
-        pedestrian_ret_(kOperationOk) {
+        pedestrian_ret_(kOperationOk),
+        stream_mode_(false),
+        ack_window_(kDefaultAckWindow),
+        unacked_number_(0),
+        compact_id_(false),
+        join_deadline_ms_(kDefaultJoinDeadline),
+        join_buffer_(kDefaultJoinDeadline, kDefaultMaxPendingFrames) {
   }
 
   /**
@@ -174,6 +212,68 @@ public:
   OperationCode SendPedestrianInfo(
       const std::shared_ptr<BatchPedestrianInfoT> &pedestrian_info_para);
 
+  /**
+   * @brief  send results of a frame to presenter server in streaming mode,
+   *         wait for the response when a window of messages is sent
+   * @param [in]  frame_result: results of the frame
+   * @param [in]  message: frame_result with images as tlvs
+   * @return  OperationCode
+   */
+  OperationCode SendFrameResult(
+      ascend::presenter::video_analysis::FrameResult &frame_result,
+      ascend::presenter::PartialMessageWithTlvs &message);
+
+  /**
+   * @brief  ask presenter server for the response of the messages sent
+   *         since last response, used at end of stream and on close
+   * @return  OperationCode
+   */
+  OperationCode FlushFrameResults();
+
+  /**
+   * @brief  receive the response of a window of FrameResult messages
+   * @return  OperationCode
+   */
+  OperationCode ReceiveWindowResponse();
+
+  /**
+   * @brief  add detection image to the join buffer
+   * @param [in]  image infomation from detected engine
+   * @return  OperationCode
+   */
+  OperationCode JoinDetectionImage(
+      const std::shared_ptr<VideoDetectionImageParaT> &image_para);
+
+  /**
+   * @brief  add car inference to the join buffer
+   * @param [in]  car infomation from car inferential engine
+   * @return  OperationCode
+   */
+  OperationCode JoinCarInfo(
+      const std::shared_ptr<BatchCarInfoT> &car_info_para);
+
+  /**
+   * @brief  add person inference to the join buffer
+   * @param [in]  person infomation from person inferential engine
+   * @return  OperationCode
+   */
+  OperationCode JoinPedestrianInfo(
+      const std::shared_ptr<BatchPedestrianInfoT> &pedestrian_info_para);
+
+  /**
+   * @brief  send frames released by the join buffer to presenter server
+   * @param [in]  flush: release all pending frames
+   */
+  void SendJoinedFrames(bool flush);
+
+  /**
+   * @brief  send image and results of a joined frame to presenter server,
+   *         in one FrameResult in streaming mode
+   * @param [in]  frame: joined frame
+   * @return  OperationCode
+   */
+  OperationCode SendJoinedFrame(const JoinedFrame &frame);
+
   /**
    * @brief  reload Engine Process
    * @param [in]  define the number of input and output
@@ -202,6 +302,27 @@ private:
 
   // ret of SendPedestrianInfo function
   OperationCode pedestrian_ret_;
+
+  // send results as FrameResult without waiting for each response
+  bool stream_mode_;
+
+  // number of FrameResult messages acknowledged by one response
+  uint32_t ack_window_;
+
+  // number of FrameResult messages sent since last response
+  uint32_t unacked_number_;
+
+  // send frame id and object ids as numbers
+  bool compact_id_;
+
+  // max time a frame waits for results from all ports, 0 means no join
+  uint32_t join_deadline_ms_;
+
+  // joins image and results of a frame from all ports
+  FrameJoinBuffer join_buffer_;
+
+  // frames released by join buffer and not sent yet
+  std::vector<JoinedFrame> joined_frames_;
 };
 
 #endif